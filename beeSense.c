@@ -1,35 +1,78 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 #include "hardware/adc.h"
 #include "hardware/pio.h"
 #include "hardware/gpio.h"
 #include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "hardware/uart.h"
 #include "pico/time.h"
 #include "inc/ssd1306.h"
 #include "inc/matriz_leds.h"
+#include "inc/anomalia.h"
+#include "inc/tendencia.h"
+#include "inc/eventos.h"
+#include "inc/energia.h"
+#include "inc/relogio.h"
+#include "inc/grafico.h"
+#include "inc/hx711.h"
+#include "inc/balanca.h"
+#include "inc/calibracao.h"
+#include "inc/persistencia.h"
+#include "inc/comandos.h"
+#include "inc/dht22.h"
+#include "inc/onewire.h"
+#include "inc/ds18b20.h"
+#include "inc/especies.h"
+#include "inc/pontuacao.h"
+#include "inc/estado.h"
+#include "inc/classificador.h"
+#include "inc/captura.h"
+#include "inc/campo_uart.h"
+#include "inc/espelho.h"
+#include "inc/perfil.h"
+#include "inc/sram.h"
+#include "inc/placa.h"
 #include "math.h"
 
-// I2C definições
-#define I2C_PORT i2c1
-#define SDA_PIN 14
-#define SCL_PIN 15
-#define SSD1306_ADDR 0x3C
-#define LCD_WIDTH 128
-#define LCD_HEIGHT 64
+// Balança (HX711) na PIO1; sem conversor ligado o peso continua simulado
+#define HX711_DOUT 8
+#define HX711_SCK 9
 
-#define MATRIX_PIN 7
+// DHT22 (temperatura/umidade do ar) e barramento 1-Wire dos DS18B20 do ninho;
+// sem eles, temperatura e umidade continuam vindo dos potenciômetros
+#define DHT22_PIN 16
+#define ONEWIRE_PIN 17
+#define DS18B20_PERIODO_MS 5000
+#define DHT22_VALIDADE_MS 10000
 
 // Potenciômetro (GPIO26 = ADC0)
 #define POT_ADC_TEMP 0
 #define POT_ADC_UMID 1
 
+// Captura bruta: microfone da placa (GPIO28 = ADC2) e o piezo da colmeia no
+// ADC1 (GPIO27, o eixo X do joystick na placa de desenvolvimento)
+#define MIC_ADC 2
+#define PIEZO_ADC 1
+#define CAPTURA_CANAIS ((1u << MIC_ADC) | (1u << PIEZO_ADC))
+#define CAPTURA_TAXA_HZ 8000
+
+// Sensores analógicos opcionais, convertidos pelas curvas de calibração: o
+// MQ-135 (VOC) e a saída de envelope do piezo (vibração). A BitDogLab não tem
+// ADC livre; -1 mantém o valor configurado pela interface
+#define MQ135_ADC -1
+#define VIBRA_ADC -1
+
+// Barramento de campo na UART do stdio: DE/RE do transceptor RS-485
+#define CAMPO_DE_PIN 20
+
 // Botões
 #define BUTTON_A 5
 #define BUTTON_B 6
-#define DEBOUNCE_MS 200
 
 // LED (opcional, não usado no menu)
 #define LED_RED 13
@@ -54,46 +97,20 @@ typedef enum
     STATE_WELCOME,
     STATE_MENU,
     STATE_CONFIRM,
-    STATE_CONFIG
+    STATE_CONFIG,
+    STATE_GRAFICO
 } SystemState;
 
-volatile bool alarm_active = true;
+// Cópia do escritor: só a tarefa altera estes campos e os publica em
+// inc/estado.h; a renderização lê um instantâneo coerente de lá
+bool alarm_active = true;
 volatile int simulation_mode = 0;
-volatile int state = STATE_WELCOME;
-volatile uint32_t last_button_a_time = 0;
-volatile uint32_t last_button_b_time = 0;
-volatile int especie_index = 0;
-volatile int sensor_index = 0;
+int state = STATE_WELCOME;
+volatile uint32_t isr_us_max = 0;
+int especie_index = 0;
+int sensor_index = 0;
 bool is_configuring = false;
 
-#define NUM_especies 12
-
-// Especies de Abelhas
-typedef struct
-{
-    const char *nome;
-    float min_temp;
-    float max_temp;
-    int unidade_ideal;
-    float peso_mel_anual;
-    float max_luz;
-    const char *genero;
-} Beeespecies;
-
-const Beeespecies especies[NUM_especies] = {
-    {"Africana", 30.0, 36.0, 65, 50.0, 5.0, "Apis Mellifera"},
-    {"Irai", 26.0, 34.0, 70, 3.5, 2.8, "Frieseomelitta"},
-    {"Limao", 26.0, 34.0, 70, 0.7, 1.4, "Lestrimelitta"},
-    {"Tiuba", 26.0, 34.0, 70, 2.8, 2.8, "Melipona"},
-    {"Mandacaia", 22.0, 32.0, 70, 3.5, 4.2, "Melipona"},
-    {"Urucu", 26.0, 34.0, 70, 7.0, 4.2, "Melipona"},
-    {"Tataira", 22.0, 32.0, 70, 1.4, 2.8, "Oxytrigona"},
-    {"Mirim", 22.0, 32.0, 70, 0.7, 1.4, "Plebeia"},
-    {"Jandaira", 26.0, 34.0, 70, 2.8, 4.2, "Scaptotrigona"},
-    {"Bora", 26.0, 34.0, 70, 4.2, 4.2, "Tetragona"},
-    {"Jatai", 22.0, 32.0, 70, 1.4, 2.8, "Tetragonisca"},
-    {"Mandaguari", 22.0, 32.0, 70, 1.4, 2.8, "Trigona"}};
-
 // Sensores Extras
 typedef struct
 {
@@ -103,16 +120,132 @@ typedef struct
     float value;
 } Sensores;
 
-#define NUM_SENSORES 4
+#define NUM_SENSORES ESTADO_SENSORES
 
-volatile Sensores sensores[] = {
+Sensores sensores[] = {
     {"Peso", 0.0, 60.0, 2.0},
     {"Luminosidade", 0.0, 100.0, 3.0},
-    {"Gas VOC", 0.0, 15.0, 0.5},
-    {"Vibracao", 0.0, 100.0, 50.0},
+    {"Gás VOC", 0.0, 15.0, 0.5},
+    {"Vibração", 0.0, 100.0, 50.0},
+};
+
+// Detectores de anomalia (canais e sensibilidade em pontuacao.h)
+anomalia_canal_t detectores[NUM_CANAIS];
+
+// Tendência do peso da colmeia (período em pontuacao.h)
+tendencia_t tendencia_peso;
+
+// Amostragem adaptativa: 10 Hz com atividade, até 0,5 Hz em regime estável
+const energia_config_t energia_config = {
+    .periodo_min_ms = 100,
+    .periodo_max_ms = 2000,
+    .estaveis_para_reduzir = 50,
+    .apagar_display_ms = 60000,
+};
+#define TELEMETRIA_PERIODO_MS 1000
+
+// Gráficos da última hora: uma coluna a cada 30 s em 120 colunas (páginas 1 a 7)
+#define GRAFICO_PERIODO_MS 30000
+#define GRAFICO_COLUNAS 120
+enum
+{
+    GRAFICO_TEMP,
+    GRAFICO_UMID,
+    GRAFICO_PESO,
+    NUM_GRAFICOS
+};
+const char *grafico_nomes[NUM_GRAFICOS] = {"Temp", "Umid", "Peso"};
+_Static_assert(NUM_GRAFICOS == ESTADO_GRAFICOS && NUM_CANAIS == ESTADO_CANAIS, "grupos de inc/estado.h");
+int grafico_index = 0;
+
+// Histórico dos gráficos, só da renderização: ela acrescenta cada coluna
+// publicada no instantâneo (estado_medidas_t.grafico)
+grafico_t graficos[NUM_GRAFICOS];
+
+// Calibração da balança: a tara e a escala usam a média de várias amostras
+#define BALANCA_AMOSTRAS_CALIBRACAO 16
+typedef enum
+{
+    CALIBRAR_NADA,
+    CALIBRAR_TARA,
+    CALIBRAR_ESCALA
+} CalibracaoAcao;
+
+balanca_calibracao_t calibracao = BALANCA_CALIBRACAO_PADRAO;
+int32_t balanca_bruto = 0;
+CalibracaoAcao calibracao_acao = CALIBRAR_NADA;
+q16_t calibracao_kg = 0;
+balanca_media_t calibracao_media;
+int calibracao_amostras = 0;
+
+ssd1306_t *ssd;
+
+// Escolhas da interface gravadas na flash (com CRC, em persistencia.c): com
+// uma configuração válida o boot vai direto ao monitoramento
+#define CONFIGURACAO_VERSAO 1
+typedef struct
+{
+    uint8_t versao;
+    uint8_t especie;
+    bool alarme;
+    float sensores[NUM_SENSORES];
+} Configuracao;
+
+bool configuracao_alterada = false;
+
+// Curvas dos canais analógicos (inc/calibracao.h): compiladas em tabelas no
+// boot e a cada recalibração pelo comando "calibra"
+typedef enum
+{
+    CAL_TEMP,
+    CAL_UMID,
+    CAL_VOC,
+    CAL_VIBRA,
+    NUM_CALIBRACOES
+} CanalCalibrado;
+
+const char *nomes_calibracao[NUM_CALIBRACOES] = {"temp", "umid", "voc", "vibra"};
+const int adc_calibracao[NUM_CALIBRACOES] = {POT_ADC_TEMP, POT_ADC_UMID, MQ135_ADC, VIBRA_ADC};
+
+// Padrões: as retas dos potenciômetros (-6 a 45 °C e 0 a 100 %), a curva de
+// CO2 da folha de dados do MQ-135 (carga de 10 kΩ, R0 típico em ar limpo;
+// para outro gás, "calibra voc potencia") e o piezo de 0 a 100 %
+const calibracao_curva_t calibracao_padrao[NUM_CALIBRACOES] = {
+    [CAL_TEMP] = {.tipo = CURVA_LINEAR, .coef = {-6.0f, 51.0f}},
+    [CAL_UMID] = {.tipo = CURVA_LINEAR, .coef = {0.0f, 100.0f}},
+    [CAL_VOC] = {.tipo = CURVA_POTENCIA, .compensar = 1, .coef = {116.602f, -2.769f, 10.0f, 76.63f}},
+    [CAL_VIBRA] = {.tipo = CURVA_LINEAR, .coef = {0.0f, 100.0f}},
 };
 
-ssd1306_t ssd;
+#define CALIBRACAO_VERSAO 1
+typedef struct
+{
+    uint8_t versao;
+    uint8_t reservado[3];
+    calibracao_curva_t curvas[NUM_CALIBRACOES];
+} Calibracoes;
+
+_Static_assert(sizeof(Calibracoes) <= PERSISTENCIA_TAMANHO_MAX, "curvas devem caber num registro");
+
+Calibracoes calibracoes;
+calibracao_tabela_t tabelas_calibracao[NUM_CALIBRACOES];
+uint16_t bruto_calibracao[NUM_CALIBRACOES]; // última leitura, para os pontos de campo
+// Primeiro ponto de um canal que ainda não tem curva de pontos
+calibracao_curva_t calibracao_rascunho;
+int calibracao_rascunho_canal = -1;
+
+// Estado da colônia pela rede int8 (inc/classificador.h), uma vez por janela
+#define CLASSIFICADOR_PERIODO_MS 10000
+classificador_t classificador;
+bool classificador_ok = false;
+uint8_t colonia_classe = COLONIA_SAUDAVEL;
+int8_t colonia_logits[NUM_CLASSES_COLONIA];
+uint32_t colonia_us = 0;
+
+// Tempo desde o reset até a primeira amostra e até a interface responder
+uint64_t boot_amostra_us = 0;
+uint64_t boot_interface_us = 0;
+bool configuracao_restaurada = false;
 
 // Função tone usando PWM para gerar som no buzzer
 void tone(uint buzzer_pin, uint frequency, uint duration_ms)
@@ -122,7 +255,7 @@ void tone(uint buzzer_pin, uint frequency, uint duration_ms)
     uint slice_num = pwm_gpio_to_slice_num(buzzer_pin);
     uint channel = pwm_gpio_to_channel(buzzer_pin);
     float divider = 1.0f;
-    float base_clk = 125000000.0f;
+    float base_clk = (float)clock_get_hz(clk_sys);
     uint32_t wrap = (uint32_t)(base_clk / (divider * frequency)) - 1;
     if (wrap > 65535)
     {
@@ -140,13 +273,584 @@ void tone(uint buzzer_pin, uint frequency, uint duration_ms)
     gpio_put(buzzer_pin, 0);                      // Garante nível baixo
 }
 
-// Callback dos botões
-void gpio_callback(uint gpio, uint32_t events)
+// Callback dos botões: só registra a borda; o debounce e as ações rodam na tarefa
+void NA_RAM(gpio_callback)(uint gpio, uint32_t events)
+{
+    PERFIL_INICIO(marca);
+    uint32_t inicio = time_us_32();
+    eventos_isr_borda(gpio, events);
+    energia_acordar();
+    PERFIL_FIM(PERFIL_ISR_GPIO, marca);
+    uint32_t duracao = time_us_32() - inicio;
+    if (duracao > isr_us_max)
+        isr_us_max = duracao;
+}
+
+// Após o sono profundo o clk_sys está no XOSC (pll_usb, clk_usb, clk_adc e
+// clk_rtc já foram refeitos em inc/energia.c): reaplica o nível e os divisores
+void restaurar_clocks(void)
+{
+    relogio_reaplicar();
+}
+
+// Frequência do PWM dos LEDs RGB, mantida a cada troca de clock
+#define PWM_LEDS_HZ 1000
+
+// Recalcula os divisores da UART e do PWM dos LEDs para o novo clk_sys
+// (o I2C é retemporizado pelo gerenciador do barramento)
+void retemporizar_perifericos(relogio_fase_t fase, uint32_t sys_hz, void *contexto)
+{
+    if (fase == RELOGIO_ANTES)
+    {
+        // Não troca o clock com bytes ainda saindo pela UART
+        uart_tx_wait_blocking(uart_default);
+        return;
+    }
+
+    uart_set_baudrate(uart_default,
+                      campo_uart_modo() == CAMPO_DESLIGADO ? PICO_DEFAULT_UART_BAUD_RATE : campo_uart_baud());
+
+    float divisor = sys_hz / (PWM_LEDS_HZ * 65536.0f);
+    if (divisor < 1.0f)
+        divisor = 1.0f;
+    pwm_set_clkdiv(pwm_gpio_to_slice_num(LED_RED), divisor);
+    pwm_set_clkdiv(pwm_gpio_to_slice_num(LED_GREEN), divisor);
+    pwm_set_clkdiv(pwm_gpio_to_slice_num(LED_BLUE), divisor);
+}
+
+bool restaurar_configuracao(void)
+{
+    Configuracao cfg;
+    if (!persistencia_ler(PERSISTENCIA_CONFIGURACAO, &cfg, sizeof(cfg)) || cfg.versao != CONFIGURACAO_VERSAO ||
+        cfg.especie >= NUM_especies)
+        return false;
+    especie_index = cfg.especie;
+    alarm_active = cfg.alarme;
+    for (int i = 0; i < NUM_SENSORES; i++)
+        sensores[i].value = cfg.sensores[i];
+    return true;
+}
+
+void salvar_configuracao(void)
+{
+    Configuracao cfg = {.versao = CONFIGURACAO_VERSAO, .especie = especie_index, .alarme = alarm_active};
+    for (int i = 0; i < NUM_SENSORES; i++)
+        cfg.sensores[i] = sensores[i].value;
+    persistencia_gravar(PERSISTENCIA_CONFIGURACAO, &cfg, sizeof(cfg));
+}
+
+// Display, matriz, LED RGB e buzzer: só sobem depois da primeira amostra.
+// Retorna a máquina de estado da matriz.
+uint iniciar_interface(PIO pio)
+{
+    // Inicializa I2C e Display
+    i2c_init(I2C_PORT, 400 * 1000);
+    gpio_set_function(SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(SDA_PIN);
+    gpio_pull_up(SCL_PIN);
+    if (!barramento_i2c_init(I2C_PORT, 400 * 1000))
+        panic("i2c: sem canal de DMA livre para o barramento do display");
+    ssd = ssd1306_placa_iniciar();
+
+    // Configura LED
+    gpio_init(LED_RED);
+    gpio_init(LED_GREEN);
+    gpio_init(LED_BLUE);
+    gpio_set_dir(LED_RED, GPIO_OUT);
+    gpio_set_dir(LED_GREEN, GPIO_OUT);
+    gpio_set_dir(LED_BLUE, GPIO_OUT);
+    gpio_put(LED_RED, false);
+    gpio_put(LED_GREEN, false);
+    gpio_put(LED_BLUE, false);
+
+    gpio_set_function(LED_RED, GPIO_FUNC_PWM);
+    gpio_set_function(LED_GREEN, GPIO_FUNC_PWM);
+    gpio_set_function(LED_BLUE, GPIO_FUNC_PWM);
+
+    pwm_set_enabled(pwm_gpio_to_slice_num(LED_RED), true);
+    pwm_set_enabled(pwm_gpio_to_slice_num(LED_GREEN), true);
+    pwm_set_enabled(pwm_gpio_to_slice_num(LED_BLUE), true);
+
+    relogio_registrar(retemporizar_perifericos, NULL);
+
+    // Configura buzzer para PWM
+    gpio_set_function(BUZZER_A, GPIO_FUNC_PWM);
+
+    // Configura matrix de leds
+    uint sm = configurar_matriz(pio);
+    clearMatriz(pio, sm);
+    return sm;
+}
+
+void comando_colonia(const char *argumentos)
+{
+    if (!classificador_ok)
+    {
+        printf("{ \"colonia\": null }\n");
+        return;
+    }
+    printf("{ \"colonia\": \"%s\", \"logits\": [", classe_colonia_nomes[colonia_classe]);
+    for (int i = 0; i < NUM_CLASSES_COLONIA; i++)
+        printf(i ? ", %d" : "%d", colonia_logits[i]);
+    printf("], \"us\": %lu, \"macs\": %lu }\n", (unsigned long)colonia_us, (unsigned long)classificador.macs);
+}
+
+// captura <ms> [taxa] [canais]: grava agora; captura armar <ms> <pre_ms> [taxa]
+// [canais]: espera uma anomalia (ou "captura agora"); "captura para" desarma.
+// Sem argumentos, só o estado.
+void comando_captura(const char *argumentos)
+{
+    static const char *const estados[] = {"livre", "armada", "gravando", "enviando"};
+    bool ok = true;
+    if (campo_uart_modo() != CAMPO_DESLIGADO)
+    {
+        printf("{ \"erro\": \"UART no barramento de campo\" }\n");
+        return;
+    }
+    if (strcmp(argumentos, "agora") == 0)
+        ok = captura_disparar(CAPTURA_COMANDO);
+    else if (strcmp(argumentos, "para") == 0)
+        ok = captura_cancelar();
+    else if (*argumentos)
+    {
+        bool armar = strncmp(argumentos, "armar", 5) == 0;
+        char *p = (char *)argumentos + (armar ? 5 : 0);
+        captura_config_t cfg = {.canais = CAPTURA_CANAIS, .taxa_hz = CAPTURA_TAXA_HZ};
+        cfg.duracao_ms = strtoul(p, &p, 10);
+        if (armar)
+            cfg.pre_ms = strtoul(p, &p, 10);
+        uint32_t taxa = strtoul(p, &p, 10);
+        uint32_t canais = strtoul(p, &p, 0);
+        if (taxa)
+            cfg.taxa_hz = taxa;
+        if (canais)
+            cfg.canais = canais;
+        ok = captura_armar(&cfg) && (armar || captura_disparar(CAPTURA_COMANDO));
+    }
+    if (!ok)
+        printf("{ \"erro\": \"uso: captura <ms> [taxa] [canais] | armar <ms> <pre_ms> [taxa] [canais] | agora | para\" }\n");
+    printf("{ \"captura\": \"%s\", \"quadros\": %lu }\n", estados[captura_estado()], (unsigned long)captura_quadros());
+}
+
+// Barramento de campo (inc/campo_uart.h): modo, endereço e baud na flash
+campo_config_t campo_config = {.modo = CAMPO_DESLIGADO, .endereco = 1, .n_nos = 8, .baud = CAMPO_BAUD_PADRAO};
+
+bool iniciar_campo(const campo_config_t *cfg)
+{
+    bool ok = campo_uart_iniciar(uart_default, CAMPO_DE_PIN, cfg);
+    energia_permitir_sono_profundo(campo_uart_modo() == CAMPO_DESLIGADO);
+    return ok;
+}
+
+// "campo no <endereço> [baud]", "campo mestre <nós> [baud]" ou "campo desliga";
+// sem argumentos, as estatísticas. A UART sai do stdio: use o USB.
+void comando_campo(const char *argumentos)
+{
+    char modo[8];
+    unsigned valor = 0, baud = 0;
+    int n = sscanf(argumentos, "%7s %u %u", modo, &valor, &baud);
+    if (n < 1)
+    {
+        campo_uart_relatorio();
+        return;
+    }
+    campo_config_t cfg = campo_config;
+    bool ok = valor <= UINT8_MAX && !captura_ativa();
+    if (strcmp(modo, "no") == 0 && n >= 2)
+    {
+        cfg.modo = CAMPO_NO;
+        cfg.endereco = valor;
+    }
+    else if (strcmp(modo, "mestre") == 0 && n >= 2)
+    {
+        cfg.modo = CAMPO_MESTRE;
+        cfg.n_nos = valor;
+    }
+    else if (strcmp(modo, "desliga") == 0)
+        cfg.modo = CAMPO_DESLIGADO;
+    else
+        ok = false;
+    if (baud)
+        cfg.baud = baud;
+
+    ok = ok && iniciar_campo(&cfg);
+    if (ok)
+    {
+        campo_config = cfg;
+        persistencia_gravar(PERSISTENCIA_CAMPO, &campo_config, sizeof(campo_config));
+    }
+    else
+        printf("{ \"erro\": \"uso: campo no <1-247> [baud] | mestre <1-%d> [baud] | desliga (sem captura em curso)\" }\n",
+               CAMPO_NOS_MAX);
+    campo_uart_relatorio();
+}
+
+uint16_t para_u16(float v)
+{
+    return v <= 0.0f ? 0 : v >= UINT16_MAX ? UINT16_MAX : (uint16_t)(v + 0.5f);
+}
+
+// Amostra desta volta no formato do barramento
+campo_amostra_t amostra_campo(float temp, float umid)
+{
+    campo_amostra_t a = {
+        .tempo_ms = to_ms_since_boot(get_absolute_time()),
+        .peso_g = (int32_t)lroundf(sensores[0].value * 1000.0f),
+        .temp = (int16_t)lroundf(temp * 100.0f),
+        .umid = para_u16(umid * 100.0f),
+        .luz = para_u16(sensores[1].value * 10.0f),
+        .voc = para_u16(sensores[2].value * 100.0f),
+        .vibra = para_u16(sensores[3].value * 10.0f),
+    };
+    for (int i = 0; i < NUM_CANAIS; i++)
+        if (detectores[i].estado)
+            a.anomalias |= 1u << i;
+    return a;
+}
+
+// Com a captura usando o ADC, os canais dela vêm do último quadro gravado e
+// os outros mantêm o último valor
+uint16_t ler_adc(uint canal)
 {
-    uint32_t now = to_ms_since_boot(get_absolute_time());
-    if (gpio == BUTTON_A && (now - last_button_a_time >= DEBOUNCE_MS))
+    static uint16_t ultimo[CAPTURA_CANAIS_MAX];
+    if (!captura_adc_ocupado())
     {
-        if (state == STATE_WELCOME)
+        adc_select_input(canal);
+        ultimo[canal] = adc_read();
+    }
+    else
+        captura_ultima(canal, &ultimo[canal]);
+    return ultimo[canal];
+}
+
+// Leitura bruta na unidade do canal: uma consulta à tabela e uma interpolação
+q16_t calibrar(CanalCalibrado canal, uint16_t bruto)
+{
+    bruto_calibracao[canal] = bruto;
+    return calibracao_aplicar(&tabelas_calibracao[canal], bruto);
+}
+
+// Curvas da flash; as ausentes ou inválidas voltam ao padrão
+void restaurar_calibracoes(void)
+{
+    if (!persistencia_ler(PERSISTENCIA_CALIBRACAO, &calibracoes, sizeof(calibracoes)) ||
+        calibracoes.versao != CALIBRACAO_VERSAO)
+    {
+        calibracoes.versao = CALIBRACAO_VERSAO;
+        memcpy(calibracoes.curvas, calibracao_padrao, sizeof(calibracao_padrao));
+    }
+    for (int i = 0; i < NUM_CALIBRACOES; i++)
+        if (!calibracao_compilar(&tabelas_calibracao[i], &calibracoes.curvas[i]))
+        {
+            calibracoes.curvas[i] = calibracao_padrao[i];
+            calibracao_compilar(&tabelas_calibracao[i], &calibracoes.curvas[i]);
+        }
+}
+
+void imprimir_calibracao(int canal)
+{
+    static const char *const tipos[NUM_CURVAS] = {"linear", "poli", "potencia", "pontos"};
+    const calibracao_curva_t *c = &calibracoes.curvas[canal];
+    printf("{ \"canal\": \"%s\", \"curva\": \"%s\"", nomes_calibracao[canal], tipos[c->tipo]);
+    if (c->tipo == CURVA_PONTOS)
+    {
+        printf(", \"pontos\": [");
+        for (int i = 0; i < c->n_pontos; i++)
+            printf("%s[%.0f, %.3f]", i ? ", " : "", c->pontos[i].x, c->pontos[i].y);
+        printf("]");
+    }
+    else
+        printf(", \"coef\": [%g, %g, %g, %g]", c->coef[0], c->coef[1], c->coef[2], c->coef[3]);
+    if (c->tipo == CURVA_POTENCIA)
+        printf(", \"th\": %d", c->compensar);
+    printf(", \"sensor\": %d, \"bruto\": %u, \"valor\": %.3f }\n", adc_calibracao[canal] >= 0,
+           bruto_calibracao[canal],
+           q16_para_float(calibracao_aplicar(&tabelas_calibracao[canal], bruto_calibracao[canal])));
+}
+
+// Recalibração em campo: coeficientes de uma curva, pontos com a leitura
+// atual contra um valor de referência, R0 do MQ-135 em ar limpo ou o padrão.
+// A curva nova só entra (e vai para a flash) se compilar.
+void comando_calibra(const char *argumentos)
+{
+    char nome[8], acao[10];
+    int consumidos = 0;
+    int n = sscanf(argumentos, "%7s %9s %n", nome, acao, &consumidos);
+    if (n < 1)
+    {
+        for (int i = 0; i < NUM_CALIBRACOES; i++)
+            imprimir_calibracao(i);
+        return;
+    }
+    int canal = 0;
+    while (canal < NUM_CALIBRACOES && strcmp(nome, nomes_calibracao[canal]) != 0)
+        canal++;
+    if (canal == NUM_CALIBRACOES)
+    {
+        printf("{ \"erro\": \"canais: temp, umid, voc, vibra\" }\n");
+        return;
+    }
+    if (n < 2)
+    {
+        imprimir_calibracao(canal);
+        return;
+    }
+
+    const char *p = argumentos + consumidos;
+    bool presente = adc_calibracao[canal] >= 0;
+    uint16_t bruto = bruto_calibracao[canal];
+    calibracao_curva_t curva = calibracoes.curvas[canal];
+    bool ok = false;
+    if (strcmp(acao, "linear") == 0 || strcmp(acao, "poli") == 0 || strcmp(acao, "potencia") == 0)
+    {
+        memset(&curva, 0, sizeof(curva));
+        curva.tipo = strcmp(acao, "linear") == 0 ? CURVA_LINEAR
+                     : strcmp(acao, "poli") == 0 ? CURVA_POLINOMIO
+                                                 : CURVA_POTENCIA;
+        int compensar = 0;
+        int lidos = sscanf(p, "%f %f %f %f %d", &curva.coef[0], &curva.coef[1], &curva.coef[2], &curva.coef[3],
+                           &compensar);
+        curva.compensar = compensar != 0;
+        ok = lidos >= (curva.tipo == CURVA_LINEAR ? 2 : 4);
+    }
+    else if (strcmp(acao, "ponto") == 0)
+    {
+        float valor;
+        if (presente && sscanf(p, "%f", &valor) == 1)
+        {
+            if (curva.tipo != CURVA_PONTOS)
+            {
+                if (calibracao_rascunho_canal != canal)
+                    memset(&calibracao_rascunho, 0, sizeof(calibracao_rascunho));
+                curva = calibracao_rascunho;
+            }
+            ok = calibracao_adicionar_ponto(&curva, bruto, valor);
+            if (ok && curva.n_pontos < 2)
+            {
+                // Uma reta precisa de dois pontos: a curva atual continua valendo
+                calibracao_rascunho = curva;
+                calibracao_rascunho_canal = canal;
+                printf("{ \"canal\": \"%s\", \"ponto\": [%u, %.3f], \"faltam\": 1 }\n", nome, bruto, valor);
+                return;
+            }
+        }
+    }
+    else if (strcmp(acao, "ar") == 0)
+    {
+        float ppm = 400.0f;
+        sscanf(p, "%f", &ppm);
+        ok = presente && calibracao_ajustar_r0(&curva, &tabelas_calibracao[canal], bruto, ppm);
+    }
+    else if (strcmp(acao, "padrao") == 0)
+    {
+        curva = calibracao_padrao[canal];
+        ok = true;
+    }
+
+    if (ok)
+        ok = calibracao_compilar(&tabelas_calibracao[canal], &curva);
+    if (ok)
+    {
+        calibracoes.curvas[canal] = curva;
+        if (calibracao_rascunho_canal == canal)
+            calibracao_rascunho_canal = -1;
+        ok = persistencia_gravar(PERSISTENCIA_CALIBRACAO, &calibracoes, sizeof(calibracoes));
+    }
+    if (!ok)
+        printf("{ \"erro\": \"uso: calibra <canal> linear c0 c1 | poli c0 c1 c2 c3 | potencia a b rl r0 [th] | "
+               "ponto <valor> | ar [ppm] | padrao (ponto e ar precisam do sensor)\" }\n");
+    imprimir_calibracao(canal);
+}
+
+void comando_boot(const char *argumentos)
+{
+    printf("{ \"boot_amostra_us\": %llu, \"boot_interface_us\": %llu, \"configuracao\": \"%s\" }\n",
+           (unsigned long long)boot_amostra_us, (unsigned long long)boot_interface_us,
+           configuracao_restaurada ? "restaurada" : "padrao");
+}
+
+// Geometria fixa do display contra a variável, nas mesmas cenas
+void comando_desenho(const char *argumentos)
+{
+    ssd1306_bancada();
+}
+
+// Espelho do display e da matriz pela telemetria (inc/espelho.h), desligado
+// no boot; o orçamento conta o baud do stdio mesmo quando a saída é o USB
+espelho_t espelho;
+bool espelho_ligado = false;
+
+// "espelho <parte %>" liga, "espelho chave" pede um quadro inteiro, "espelho
+// desliga"; sem argumentos, as estatísticas
+void comando_espelho(const char *argumentos)
+{
+    if (strcmp(argumentos, "desliga") == 0)
+        espelho_ligado = false;
+    else if (strcmp(argumentos, "chave") == 0)
+        espelho_pedir_chave(&espelho);
+    else if (*argumentos)
+    {
+        long parte = strtol(argumentos, NULL, 10);
+        if (parte < 1 || parte > 100)
+        {
+            printf("{ \"erro\": \"uso: espelho <1..100 %% do link> | chave | desliga\" }\n");
+            return;
+        }
+        espelho_init(&espelho, PICO_DEFAULT_UART_BAUD_RATE, (uint8_t)parte, to_ms_since_boot(get_absolute_time()));
+        espelho_ligado = true;
+    }
+    printf("{ \"espelho\": %s, \"parte\": %u, \"bytes_s\": %lu, \"quadros\": %lu, \"chaves\": %lu, "
+           "\"carga_media\": %lu, \"linha_media\": %lu, \"adiados\": %lu }\n",
+           espelho_ligado ? "true" : "false", espelho.parte, (unsigned long)espelho.bytes_s,
+           (unsigned long)espelho.quadros, (unsigned long)espelho.chaves,
+           (unsigned long)(espelho.quadros ? espelho.carga_bytes / espelho.quadros : 0),
+           (unsigned long)(espelho.quadros ? espelho.linha_bytes / espelho.quadros : 0), (unsigned long)espelho.adiados);
+}
+
+// Diferença do quadro atual, se mudou e couber no orçamento. Durante o envio
+// de uma captura a UART está fora do stdio: espera o fim.
+void enviar_espelho(void)
+{
+    static uint8_t carga[ESPELHO_CARGA_MAX];
+    static char texto[ESPELHO_BASE64_MAX];
+    uint8_t matriz_rgb[ESPELHO_MATRIZ_BYTES];
+
+    if (!espelho_ligado || captura_estado() == CAPTURA_ENVIANDO)
+        return;
+    matriz_ler_rgb(matriz_rgb);
+    size_t n = espelho_codificar(&espelho, &ssd->ram_buffer[1], matriz_rgb, to_ms_since_boot(get_absolute_time()), carga);
+    if (!n)
+        return;
+    espelho_base64(carga, n, texto);
+    printf(ESPELHO_PREFIXO "%s" ESPELHO_SUFIXO, texto);
+}
+
+#if BEESENSE_PERFIL
+// Ciclos e faltas do cache XIP por etapa; "perfil zera" recomeça a contagem
+void comando_perfil(const char *argumentos)
+{
+    if (strcmp(argumentos, "zera") == 0)
+        perfil_zerar();
+    else
+        perfil_relatorio();
+}
+#endif
+
+// Comandos da balança pelo stdio
+void comando_tara(const char *argumentos)
+{
+    calibracao_acao = CALIBRAR_TARA;
+    calibracao_media = (balanca_media_t){0};
+    calibracao_amostras = 0;
+}
+
+void comando_escala(const char *argumentos)
+{
+    float kg = strtof(argumentos, NULL);
+    if (kg <= 0.0f)
+    {
+        printf("{ \"erro\": \"uso: escala <kg da massa de referencia>\" }\n");
+        return;
+    }
+    calibracao_acao = CALIBRAR_ESCALA;
+    calibracao_kg = Q16(kg);
+    calibracao_media = (balanca_media_t){0};
+    calibracao_amostras = 0;
+}
+
+void comando_balanca(const char *argumentos)
+{
+    printf("{ \"bruto\": %ld, \"kg\": %.3f, \"tara\": %ld, \"escala\": %ld, \"presente\": %d, \"perdidas\": %lu }\n",
+           (long)balanca_bruto, q16_para_float(balanca_kg(&calibracao, balanca_bruto)), (long)calibracao.tara,
+           (long)calibracao.contagens_por_kg, hx711_presente(), (unsigned long)hx711_perdidas());
+}
+
+// Uso do barramento I2C por dispositivo
+void comando_i2c(const char *argumentos)
+{
+    const i2c_dispositivo_t *lista;
+    uint n = barramento_i2c_dispositivos(I2C_PORT, &lista);
+    printf("{ \"i2c\": [");
+    for (uint i = 0; i < n; i++)
+        printf("%s{ \"end\": %u, \"trans\": %lu, \"blocos\": %lu, \"bytes\": %lu, \"erros\": %lu, \"ocupado_ms\": %lu, \"espera_max_us\": %lu }",
+               i ? ", " : "", lista[i].endereco, (unsigned long)lista[i].transacoes, (unsigned long)lista[i].blocos,
+               (unsigned long)lista[i].bytes, (unsigned long)lista[i].erros, (unsigned long)(lista[i].ocupado_us / 1000),
+               (unsigned long)lista[i].espera_max_us);
+    printf("] }\n");
+}
+
+// Acumula a média pedida por "tara" ou "escala" e grava a calibração na flash
+void calibrar_balanca(int32_t bruto)
+{
+    if (calibracao_acao == CALIBRAR_NADA)
+        return;
+    balanca_media_somar(&calibracao_media, bruto);
+    if (++calibracao_amostras < BALANCA_AMOSTRAS_CALIBRACAO)
+        return;
+
+    // Só leituras saturadas: célula desconectada, nada a calibrar
+    int32_t media;
+    bool ok = balanca_media(&calibracao_media, &media);
+    if (ok && calibracao_acao == CALIBRAR_TARA)
+        balanca_tarar(&calibracao, media);
+    else if (ok)
+        ok = balanca_calibrar_escala(&calibracao, media, calibracao_kg);
+    calibracao_acao = CALIBRAR_NADA;
+
+    if (ok)
+        ok = persistencia_gravar(PERSISTENCIA_BALANCA, &calibracao, sizeof(calibracao));
+    printf("{ \"calibracao\": %s, \"tara\": %ld, \"escala\": %ld }\n", ok ? "true" : "false",
+           (long)calibracao.tara, (long)calibracao.contagens_por_kg);
+}
+
+// Linha acesa (0 = topo) de um indicador de 0 a 1 na coluna da matriz
+static uint8_t linha_indicador(float fracao)
+{
+    int nivel = (int)(fracao * 4.0f);
+    if (nivel < 0)
+        nivel = 0;
+    if (nivel > 4)
+        nivel = 4;
+    return (uint8_t)(4 - nivel);
+}
+
+// Linha do peso no monitor: "Peso:" + 4 + " " + 5 = 15 caracteres, colunas 0
+// a 119; a 120 é do indicador de anomalia. Fora de -9.9..99.9 kg o peso perde
+// a casa decimal e a tendência, fora de ±9.99 kg/dia, uma casa (até ±99.9)
+static void formatar_peso(char *info, size_t tamanho, float kg, float kg_dia)
+{
+    char peso[8], tendencia[8];
+    if (kg > -9.95f && kg < 99.95f)
+        snprintf(peso, sizeof(peso), "%4.1f", kg);
+    else
+        snprintf(peso, sizeof(peso), "%4.0f", fminf(fmaxf(kg, -999.0f), 9999.0f));
+    if (fabsf(kg_dia) < 9.995f)
+        snprintf(tendencia, sizeof(tendencia), "%+5.2f", kg_dia);
+    else
+        snprintf(tendencia, sizeof(tendencia), "%+5.1f", fminf(fmaxf(kg_dia, -99.9f), 99.9f));
+    snprintf(info, tamanho, "Peso:%s %s", peso, tendencia);
+}
+
+// Indicadores da matriz no alarme, por coluna: peso, luminosidade, gás VOC,
+// vibração e saúde
+void indicadores_matriz(const Beeespecies *especie, const float *valores, float saude, uint8_t *linhas)
+{
+    linhas[0] = linha_indicador(valores[0] / especie->peso_mel_anual);
+    linhas[1] = linha_indicador((sensores[1].max - especie->max_luz) / (sensores[1].max - sensores[1].min));
+    linhas[2] = linha_indicador((8.0f - valores[2]) / 8.0f);
+    linhas[3] = linha_indicador(valores[3] / 100.0f);
+    linhas[4] = linha_indicador(saude);
+}
+
+// Máquina de estados da interface, executada apenas em contexto de tarefa
+void tratar_evento(const evento_t *evento)
+{
+    bool repeticao = evento->tipo == EVENTO_LONGO || evento->tipo == EVENTO_REPETICAO;
+
+    if (evento->origem == BUTTON_A && (evento->tipo == EVENTO_CLIQUE || repeticao))
+    {
+        if (state == STATE_WELCOME && !repeticao)
         {
             beep_frequency = 500;
             beep_duration = 100;
@@ -167,19 +871,35 @@ void gpio_callback(uint gpio, uint32_t events)
             beep_duration = 5;
             play_tone = true;
         }
-        else if (state == STATE_CONFIRM)
+        else if (state == STATE_CONFIRM && evento->tipo == EVENTO_LONGO)
+        {
+            // Segurar A no monitoramento abre os gráficos
+            state = STATE_GRAFICO;
+            beep_frequency = 800;
+            beep_duration = 50;
+            play_tone = true;
+        }
+        else if (state == STATE_CONFIRM && !repeticao)
         {
             alarm_active = !alarm_active;
+            configuracao_alterada = true;
+        }
+        else if (state == STATE_GRAFICO && !repeticao)
+        {
+            grafico_index = (grafico_index + 1) % NUM_GRAFICOS;
+            beep_frequency = 500;
+            beep_duration = 5;
+            play_tone = true;
         }
-        last_button_a_time = now;
     }
-    if (gpio == BUTTON_B && (now - last_button_b_time >= DEBOUNCE_MS))
+    else if (evento->origem == BUTTON_B && evento->tipo == EVENTO_CLIQUE)
     {
         beep_duration = 5;
         if (state == STATE_MENU)
         {
             beep_duration = 200;
             state = STATE_CONFIRM;
+            configuracao_alterada = true;
         }
         else if (state == STATE_CONFIRM)
         {
@@ -187,269 +907,548 @@ void gpio_callback(uint gpio, uint32_t events)
             state = STATE_CONFIG;
             // simulation_mode = (simulation_mode + 1) % 2;
         }
-        else if (state == STATE_CONFIG)
+        else if (state == STATE_CONFIG || state == STATE_GRAFICO)
         {
             beep_duration = 200;
             state = STATE_CONFIRM;
         }
         beep_frequency = (state == STATE_MENU) ? 800 : 1000;
         play_tone = true;
-        last_button_b_time = now;
+    }
+    else if (state == STATE_MENU && (evento->tipo == EVENTO_JOY_CIMA || evento->tipo == EVENTO_JOY_DIREITA))
+    {
+        especie_index = (especie_index + 1) % NUM_especies;
+        beep_frequency = 500;
+        beep_duration = 5;
+        play_tone = true;
+    }
+    else if (state == STATE_MENU && (evento->tipo == EVENTO_JOY_BAIXO || evento->tipo == EVENTO_JOY_ESQUERDA))
+    {
+        especie_index = (especie_index + NUM_especies - 1) % NUM_especies;
+        beep_frequency = 500;
+        beep_duration = 5;
+        play_tone = true;
     }
 }
 
 int main()
 {
+    // Clock inicial de desempenho, antes de qualquer periférico calcular divisores
+    relogio_definir_nivel(RELOGIO_DESEMPENHO);
     stdio_init_all();
+#if BEESENSE_PERFIL
+    perfil_init();
+#endif
 
-    // Inicializa I2C e Display
-    i2c_init(I2C_PORT, 400 * 1000);
-    gpio_set_function(SDA_PIN, GPIO_FUNC_I2C);
-    gpio_set_function(SCL_PIN, GPIO_FUNC_I2C);
-    gpio_pull_up(SDA_PIN);
-    gpio_pull_up(SCL_PIN);
-    ssd1306_init(&ssd, LCD_WIDTH, LCD_HEIGHT, false, SSD1306_ADDR, I2C_PORT);
-    ssd1306_config(&ssd);
+    // Configura ADC JOY
+    adc_init();
+    adc_gpio_init(JOY_Y);
+    adc_gpio_init(JOY_X);
+#if MQ135_ADC >= 0
+    adc_gpio_init(26 + MQ135_ADC);
+#endif
+#if VIBRA_ADC >= 0
+    adc_gpio_init(26 + VIBRA_ADC);
+#endif
 
-    // Configura LED
-    gpio_init(LED_RED);
-    gpio_init(LED_GREEN);
-    gpio_init(LED_BLUE);
-    gpio_set_dir(LED_RED, GPIO_OUT);
-    gpio_set_dir(LED_GREEN, GPIO_OUT);
-    gpio_set_dir(LED_BLUE, GPIO_OUT);
-    gpio_put(LED_RED, false);
-    gpio_put(LED_GREEN, false);
-    gpio_put(LED_BLUE, false);
+    // Configura botões A e B (bordas de descida e subida para o debounce)
+    eventos_registrar_botao(BUTTON_A);
+    eventos_registrar_botao(BUTTON_B);
+    gpio_set_irq_enabled_with_callback(BUTTON_A, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, &gpio_callback);
+    gpio_set_irq_enabled(BUTTON_B, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
 
-    gpio_set_function(LED_RED, GPIO_FUNC_PWM);
-    gpio_set_function(LED_GREEN, GPIO_FUNC_PWM);
-    gpio_set_function(LED_BLUE, GPIO_FUNC_PWM);
+    // Curvas dos canais analógicos, antes da primeira amostra
+    restaurar_calibracoes();
 
-    uint slice_num_red = pwm_gpio_to_slice_num(LED_RED);
-    uint channel_red = pwm_gpio_to_channel(LED_RED);
-    pwm_set_enabled(slice_num_red, true);
+    // Balança: calibração salva na flash e conversor lido pela PIO1 + DMA
+    persistencia_ler(PERSISTENCIA_BALANCA, &calibracao, sizeof(calibracao));
+    hx711_config_t hx711_config = {
+        .pio = pio1,
+        .pino_dout = HX711_DOUT,
+        .pino_sck = HX711_SCK,
+        .pino_taxa = -1,
+        .ganho = HX711_A_128,
+        .taxa_80sps = false,
+    };
+    hx711_init(&hx711_config);
+    // Sensores de temperatura: DHT22 na PIO0 e DS18B20 na PIO1 (IRQ + timer)
+    dht22_init(pio0, DHT22_PIN);
+    dht22_leitura_t ambiente = {0};
+    absolute_time_t ambiente_valido_ate = get_absolute_time();
+    if (onewire_init(pio1, ONEWIRE_PIN))
+        ds18b20_iniciar(DS18B20_PERIODO_MS);
 
-    uint slice_num_green = pwm_gpio_to_slice_num(LED_GREEN);
-    uint channel_green = pwm_gpio_to_channel(LED_GREEN);
-    pwm_set_enabled(slice_num_green, true);
+    comandos_registrar("tara", comando_tara, "zera a balanca vazia");
+    comandos_registrar("escala", comando_escala, "<kg> calibra com massa conhecida");
+    comandos_registrar("balanca", comando_balanca, "leitura bruta e calibracao");
+    comandos_registrar("i2c", comando_i2c, "uso do barramento por dispositivo");
+    comandos_registrar("boot", comando_boot, "tempo ate a primeira amostra");
+    comandos_registrar("colonia", comando_colonia, "classe e logits do estado da colonia");
+    comandos_registrar("calibra", comando_calibra, "[canal [linear|poli|potencia coef | ponto v | ar [ppm] | padrao]]");
+    comandos_registrar("captura", comando_captura, "<ms> [taxa] [canais] | armar <ms> <pre_ms> | agora | para");
+    // Canais de DMA da rajada; sem eles o comando só responde com erro
+    captura_init(uart_default);
+    comandos_registrar("campo", comando_campo, "no <end> [baud] | mestre <nos> [baud] | desliga");
 
-    uint slice_num_blue = pwm_gpio_to_slice_num(LED_BLUE);
-    uint channel_blue = pwm_gpio_to_channel(LED_BLUE);
-    pwm_set_enabled(slice_num_blue, true);
+    // Rede da colônia direto da flash; um blob inválido só desliga a classificação
+    classificador_ok = classificador_carregar(&classificador, modelo_colonia, modelo_colonia_bytes);
+    comandos_registrar("desenho", comando_desenho, "tempo do desenho com a geometria fixa e a variavel");
+    comandos_registrar("espelho", comando_espelho, "<parte %> | chave | desliga: display e matriz pela telemetria");
+#if BEESENSE_PERFIL
+    comandos_registrar("perfil", comando_perfil, "[zera] ciclos e faltas do XIP por etapa");
+#endif
 
-    // Configura ADC JOY
-    adc_init();
-    adc_gpio_init(JOY_Y);
-    adc_gpio_init(JOY_X);
+    // Espécie, alarme e sensores da última sessão: pula a seleção
+    configuracao_restaurada = restaurar_configuracao();
+    if (configuracao_restaurada)
+        state = STATE_CONFIRM;
 
-    // Configura botões A e B
-    gpio_init(BUTTON_A);
-    gpio_set_dir(BUTTON_A, GPIO_IN);
-    gpio_pull_up(BUTTON_A);
-    gpio_init(BUTTON_B);
-    gpio_set_dir(BUTTON_B, GPIO_IN);
-    gpio_pull_up(BUTTON_B);
-    gpio_set_irq_enabled_with_callback(BUTTON_A, GPIO_IRQ_EDGE_FALL, true, &gpio_callback);
-    gpio_set_irq_enabled(BUTTON_B, GPIO_IRQ_EDGE_FALL, true);
+    // Inicializa os detectores de anomalia
+    for (int i = 0; i < NUM_CANAIS; i++)
+        anomalia_init(&detectores[i], &anomalia_config[i]);
+    tendencia_init(&tendencia_peso, TENDENCIA_PERIODO_MS);
+    absolute_time_t proxima_tendencia = get_absolute_time();
+    for (int i = 0; i < NUM_GRAFICOS; i++)
+        grafico_init(&graficos[i], (LCD_WIDTH - GRAFICO_COLUNAS) / 2, GRAFICO_COLUNAS, 1, 7);
+    absolute_time_t proximo_grafico = get_absolute_time();
+    q16_t grafico_valores[NUM_GRAFICOS] = {0};
+    uint32_t grafico_amostras = 0;
+    absolute_time_t proxima_telemetria = get_absolute_time();
+    absolute_time_t proxima_classificacao = make_timeout_time_ms(CLASSIFICADOR_PERIODO_MS);
 
-    // Configura buzzer para PWM
-    gpio_set_function(BUZZER_A, GPIO_FUNC_PWM);
+    energia_init(&energia_config);
+    energia_ao_acordar(restaurar_clocks);
 
-    // Configura matrix de leds
+    // Barramento de campo da última sessão (a UART sai do stdio)
+    if (persistencia_ler(PERSISTENCIA_CAMPO, &campo_config, sizeof(campo_config)))
+        iniciar_campo(&campo_config);
+    bool display_ligado = true;
+
+    // A interface sobe na primeira volta do laço, depois da primeira amostra
     PIO pio = pio0;
-    uint sm = configurar_matriz(pio);
-    clearMatriz(pio, sm);
+    uint sm = 0;
+    uint32_t amostras = 0;
+    bool havia_anomalia = false;
 
-    uint32_t loop_counter = 0;
     while (true)
     {
-        loop_counter++;
-        if (loop_counter >= 10)
-            loop_counter = 0;
-
-        // Leitura do potenciômetro (valor -6 ate 45)
-        adc_select_input(POT_ADC_TEMP);
-        uint16_t pot_val = adc_read();
-        float temp = -6.0f + (pot_val * (45.0f + 6.0f)) / 4095.0f;
+        absolute_time_t inicio_amostra = get_absolute_time();
+        PERFIL_INICIO(marca_amostra);
+        bool estavel = true;
+
+        // Potenciômetros pelas curvas de calibração (padrão: -6 a 45 °C e 0 a 100 %)
+        uint16_t pot_val = ler_adc(POT_ADC_TEMP);
+        float temp = q16_para_float(calibrar(CAL_TEMP, pot_val));
         float valor_sensor = sensores[sensor_index].min + (pot_val * (sensores[sensor_index].max + sensores[sensor_index].min)) / 4095.0f;
 
-        adc_select_input(POT_ADC_UMID);
-        uint16_t umid_val = adc_read();
-        float umid = umid_val * (100.0f / 4095.0f);
+        uint16_t umid_val = ler_adc(POT_ADC_UMID);
+        float umid = q16_para_float(calibrar(CAL_UMID, umid_val));
+
+        // DHT22: recolhe a leitura anterior (se chegou) e dispara a próxima
+        dht22_leitura_t leitura_dht;
+        if (dht22_resultado(&leitura_dht) == DHT22_OK)
+        {
+            ambiente = leitura_dht;
+            ambiente_valido_ate = make_timeout_time_ms(DHT22_VALIDADE_MS);
+        }
+        dht22_iniciar();
+        if (!time_reached(ambiente_valido_ate))
+        {
+            temp = q16_para_float(ambiente.temperatura);
+            umid = q16_para_float(ambiente.umidade);
+        }
+
+        // MQ-135 com a correção pela temperatura e umidade desta amostra
+#if MQ135_ADC >= 0
+        calibracao_ambiente(&tabelas_calibracao[CAL_VOC], Q16(temp), Q16(umid));
+        sensores[2].value = q16_para_float(calibrar(CAL_VOC, ler_adc(MQ135_ADC)));
+#endif
+#if VIBRA_ADC >= 0
+        sensores[3].value = q16_para_float(calibrar(CAL_VIBRA, ler_adc(VIBRA_ADC)));
+#endif
+
+        // Eventos de entrada: joystick (limiares) e botões (debounce na tarefa).
+        // Antes de esvaziar a fila: uma borda que chegue depois acorda o sono
+        energia_consumir_despertar();
+        eventos_joystick(JOY_X, umid_val, JOY_Y, pot_val);
+        evento_t evento;
+        while (eventos_processar(&evento))
+        {
+            tratar_evento(&evento);
+            energia_atividade();
+        }
+
+        comandos_processar();
+        captura_tarefa();
+
+        // Peso pela célula de carga, quando o HX711 estiver respondendo
+        int32_t bruto;
+        if (hx711_media(&bruto))
+        {
+            balanca_bruto = bruto;
+            sensores[0].value = q16_para_float(balanca_kg(&calibracao, bruto));
+            calibrar_balanca(bruto);
+        }
+
+        // Atualiza os detectores de anomalia de todos os canais
+        anomalia_atualizar(&detectores[CANAL_TEMP], Q16(temp));
+        anomalia_atualizar(&detectores[CANAL_UMID], Q16(umid));
+        for (int i = 0; i < NUM_SENSORES; i++)
+            anomalia_atualizar(&detectores[CANAL_SENSORES + i], Q16(sensores[i].value));
+        for (int i = 0; i < NUM_CANAIS; i++)
+            if (detectores[i].estado)
+                estavel = false;
+        // Captura armada: a borda de subida de qualquer anomalia a dispara
+        if (!estavel && !havia_anomalia && captura_estado() == CAPTURA_ARMADA)
+            captura_disparar(CAPTURA_ANOMALIA);
+        havia_anomalia = !estavel;
+        PERFIL_FIM(PERFIL_AMOSTRA, marca_amostra);
+
+        // Valor ajustado na tela de configuração entra ao voltar ao monitoramento
+        if (state == STATE_CONFIG)
+            is_configuring = true;
+        else if (state == STATE_CONFIRM && is_configuring)
+        {
+            is_configuring = false;
+            sensores[sensor_index].value = valor_sensor;
+            configuracao_alterada = true;
+        }
+
+        // Efeitos dos eventos ficam na tarefa: a renderização só lê o instantâneo
+        if (configuracao_alterada)
+        {
+            configuracao_alterada = false;
+            salvar_configuracao();
+        }
+        if (play_tone)
+        {
+            tone(BUZZER_A, beep_frequency, beep_duration);
+            play_tone = false;
+        }
+
+        // Nó do barramento guarda a amostra para o próximo lote; o mestre
+        // publica as recebidas, uma linha JSON por amostra
+        if (campo_uart_modo() == CAMPO_NO)
+        {
+            campo_amostra_t amostra = amostra_campo(temp, umid);
+            campo_uart_guardar(&amostra);
+        }
+        uint8_t no_campo;
+        campo_amostra_t recebida;
+        while (campo_uart_recebida(&no_campo, &recebida))
+            printf("{ \"no\": %u, \"t\": %lu, \"temp\": %.2f, \"umid\": %.2f, \"peso\": %.3f, \"luz\": %.1f, "
+                   "\"voc\": %.2f, \"vibra\": %.1f, \"anom\": %u }\n",
+                   no_campo, (unsigned long)recebida.tempo_ms, recebida.temp / 100.0f, recebida.umid / 100.0f,
+                   recebida.peso_g / 1000.0f, recebida.luz / 10.0f, recebida.voc / 100.0f, recebida.vibra / 10.0f,
+                   recebida.anomalias);
+
+        // Alimenta a tendência de peso no seu próprio período
+        if (time_reached(proxima_tendencia))
+        {
+            tendencia_adicionar(&tendencia_peso, Q16(sensores[0].value));
+            proxima_tendencia = delayed_by_ms(proxima_tendencia, TENDENCIA_PERIODO_MS);
+        }
+        // Coluna nova dos gráficos no seu próprio período, publicada com as medidas
+        if (time_reached(proximo_grafico))
+        {
+            grafico_valores[GRAFICO_TEMP] = Q16(temp);
+            grafico_valores[GRAFICO_UMID] = Q16(umid);
+            grafico_valores[GRAFICO_PESO] = Q16(sensores[0].value);
+            grafico_amostras++;
+            proximo_grafico = delayed_by_ms(proximo_grafico, GRAFICO_PERIODO_MS);
+        }
+        if (!boot_amostra_us)
+        {
+            boot_amostra_us = time_us_64();
+            sm = iniciar_interface(pio);
+            boot_interface_us = time_us_64();
+            comando_boot(NULL);
+        }
+
+        float peso_por_dia = q16_para_float(tendencia_por_dia(&tendencia_peso));
+        int32_t dias_reserva = tendencia_dias_ate(&tendencia_peso, Q16(especies[especie_index].reserva_min));
+
+        // Classificação da colônia: custo fixo (classificador.macs) por janela
+        if (classificador_ok && time_reached(proxima_classificacao))
+        {
+            q16_t caracteristicas[NUM_CARACTERISTICAS] = {
+                [CARAC_TEMP] = Q16(temp),
+                [CARAC_UMID] = Q16(umid),
+                [CARAC_PESO_TEND] = Q16(peso_por_dia),
+                [CARAC_VOC] = Q16(sensores[2].value),
+                [CARAC_VIBRA] = Q16(sensores[3].value),
+                [CARAC_Z_TEMP] = detectores[CANAL_TEMP].z,
+                [CARAC_Z_PESO] = detectores[CANAL_PESO].z,
+                [CARAC_Z_VIBRA] = detectores[CANAL_VIBRA].z,
+            };
+            uint32_t inicio = time_us_32();
+            colonia_classe = classificador_executar(&classificador, caracteristicas, colonia_logits);
+            colonia_us = time_us_32() - inicio;
+            proxima_classificacao = delayed_by_ms(proxima_classificacao, CLASSIFICADOR_PERIODO_MS);
+        }
+
+        // Publica os dois grupos desta volta; daqui em diante a renderização
+        // só lê o instantâneo (e as tabelas constantes)
+        estado_interface_t interface = {
+            .tela = state,
+            .especie = especie_index,
+            .sensor = sensor_index,
+            .grafico = grafico_index,
+            .modo = simulation_mode,
+            .alarme = alarm_active,
+            .display = display_ligado,
+            .sensor_nome = sensores[sensor_index].nome,
+        };
+        estado_publicar_interface(&interface);
+        estado_medidas_t medidas = {
+            .amostra = ++amostras,
+            .temp = temp,
+            .umid = umid,
+            .valor_sensor = valor_sensor,
+            .peso_por_dia = peso_por_dia,
+            .dias_reserva = dias_reserva,
+            .grafico_amostras = grafico_amostras,
+        };
+        for (int i = 0; i < NUM_SENSORES; i++)
+            medidas.sensores[i] = sensores[i].value;
+        for (int i = 0; i < NUM_CANAIS; i++)
+            medidas.anomalias[i] = detectores[i].estado;
+        for (int i = 0; i < NUM_GRAFICOS; i++)
+            medidas.grafico[i] = grafico_valores[i];
+        if (alarm_active)
+        {
+            // Saúde abaixo do limiar mantém a amostragem na taxa cheia
+            medidas.saude = pontuacao_saude(&especies[especie_index], temp, umid);
+            if (medidas.saude < LIMIAR_ALARME)
+                estavel = false;
+            indicadores_matriz(&especies[especie_index], medidas.sensores, medidas.saude, medidas.indicadores);
+        }
+        estado_publicar_medidas(&medidas);
 
         float red = 0;
         float green = 0;
         float blue = 0;
 
-        float final_ratio = 0.0f;
+        PERFIL_INICIO(marca_render);
+        static estado_t e;
+        estado_ler(&e);
 
-        ssd1306_fill(&ssd, false);
-        if (state == STATE_WELCOME)
+        // Colunas novas dos gráficos entram no histórico da renderização. Um
+        // gráfico é redesenhado ao entrar na tela, ao trocar de gráfico ou
+        // quando a escala muda; senão só a coluna nova vai ao display
+        static uint32_t grafico_vistas = 0;
+        static uint8_t tela_anterior = STATE_WELCOME, grafico_anterior = 0;
+        bool grafico_coluna_nova = false;
+        bool grafico_redesenhar = e.interface.tela == STATE_GRAFICO &&
+                                  (tela_anterior != STATE_GRAFICO || grafico_anterior != e.interface.grafico);
+        if (e.medidas.grafico_amostras != grafico_vistas)
         {
-            ssd1306_draw_string(&ssd, "   Bem-vindo   ", 3, 10);
-            ssd1306_draw_string(&ssd, "-", 0, 15);
-            ssd1306_draw_string(&ssd, "-", 119, 15);
-            ssd1306_draw_string(&ssd, "   Bee Sense    ", 3, 20);
-            ssd1306_draw_string(&ssd, "  Pressione A", 3, 40);
+            grafico_vistas = e.medidas.grafico_amostras;
+            for (int i = 0; i < NUM_GRAFICOS; i++)
+                if (grafico_adicionar(&graficos[i], e.medidas.grafico[i]) && i == e.interface.grafico)
+                    grafico_redesenhar = true;
+            grafico_coluna_nova = true;
         }
-        else if (state == STATE_MENU)
+        tela_anterior = e.interface.tela;
+        grafico_anterior = e.interface.grafico;
+
+        // O gráfico é incremental: o framebuffer só é limpo ao redesenhá-lo
+        if (e.interface.tela != STATE_GRAFICO)
+            ssd1306_fill(ssd, false);
+        if (e.interface.tela == STATE_WELCOME)
         {
-            ssd1306_draw_string(&ssd, "Especie:", 0, 0);
+            ssd1306_draw_string(ssd, "   Bem-vindo   ", 3, 10);
+            ssd1306_draw_string(ssd, "-", 0, 15);
+            ssd1306_draw_string(ssd, "-", 119, 15);
+            ssd1306_draw_string(ssd, "   Bee Sense    ", 3, 20);
+            ssd1306_draw_string(ssd, "  Pressione A", 3, 40);
+        }
+        else if (e.interface.tela == STATE_MENU)
+        {
+            ssd1306_draw_string(ssd, "Espécie:", 0, 0);
             char buffer[32];
-            snprintf(buffer, sizeof(buffer), "%d: %s", especie_index + 1, especies[especie_index].nome);
-            ssd1306_draw_string(&ssd, buffer, 0, 20);
-            ssd1306_draw_string(&ssd, "A: Proximo", 0, 40);
-            ssd1306_draw_string(&ssd, "B: Selecionar", 0, 50);
+            snprintf(buffer, sizeof(buffer), "%d: %s", e.interface.especie + 1, especies[e.interface.especie].nome);
+            ssd1306_draw_string(ssd, buffer, 0, 20);
+            ssd1306_draw_string(ssd, "A: Próximo", 0, 40);
+            ssd1306_draw_string(ssd, "B: Selecionar", 0, 50);
         }
-        else if (state == STATE_CONFIG)
+        else if (e.interface.tela == STATE_CONFIG)
         {
-            is_configuring = true;
             char buffer[32];
-            snprintf(buffer, sizeof(buffer), "Sensor: %.1f", valor_sensor);
-            ssd1306_draw_string(&ssd, buffer, 0, 0);
-            snprintf(buffer, sizeof(buffer), "%d: %s", sensor_index + 1, sensores[sensor_index].nome);
-            ssd1306_draw_string(&ssd, buffer, 0, 20);
-            ssd1306_draw_string(&ssd, "A: Proximo", 0, 40);
-            ssd1306_draw_string(&ssd, "B: Selecionar", 0, 50);
+            snprintf(buffer, sizeof(buffer), "%d: %s", e.interface.sensor + 1, e.interface.sensor_nome);
+            ssd1306_draw_string(ssd, buffer, 0, 0);
+
+            // Valor em ajuste em destaque, com a fonte grande
+            snprintf(buffer, sizeof(buffer), "%.1f", e.medidas.valor_sensor);
+            ssd1306_draw_string_font(ssd, &fonte_8x16, buffer, 0, 16);
+            ssd1306_draw_string(ssd, "A: Próximo", 0, 40);
+            ssd1306_draw_string(ssd, "B: Selecionar", 0, 50);
         }
-        else if (state == STATE_CONFIRM)
+        else if (e.interface.tela == STATE_GRAFICO)
         {
-            if (is_configuring)
+            if (grafico_redesenhar)
+            {
+                ssd1306_fill(ssd, false);
+                char titulo[32];
+                const grafico_t *g = &graficos[e.interface.grafico];
+                snprintf(titulo, sizeof(titulo), "%s %.1f-%.1f", grafico_nomes[e.interface.grafico],
+                         q16_para_float(g->escala_min), q16_para_float(g->escala_max));
+                ssd1306_draw_string(ssd, titulo, 0, 0);
+                grafico_desenhar(g, ssd);
+            }
+            else if (grafico_coluna_nova)
             {
-                is_configuring = false;
-                sensores[sensor_index].value = valor_sensor;
+                grafico_desenhar_coluna(&graficos[e.interface.grafico], ssd);
             }
+        }
+        else if (e.interface.tela == STATE_CONFIRM)
+        {
             // LEDs indicam estado do alarme
 
-            if (alarm_active)
+            if (e.interface.alarme)
             {
-                // Valores ideais
-                float ideal_umid = 70.0f;
-                float ideal_temp = (especies[especie_index].min_temp + especies[especie_index].max_temp) / 2.0f;
-
-                // Índice de temperatura (assimétrico)
-                // Se temp <= ideal: mapeia de ideal a (ideal -15) para índice de 1.0 a 0.0
-                // Se temp > ideal:  mapeia de ideal a (ideal +3) para índice de 1.0 a 0.0
-                float T_ratio;
-                if (temp <= ideal_temp)
-                {
-                    T_ratio = 1.0f + (temp - ideal_temp) / 15.0f;
-                }
-                else
-                {
-                    T_ratio = 1.0f - (temp - ideal_temp) / 3.0f;
-                }
-                if (T_ratio < 0)
-                    T_ratio = 0;
-                if (T_ratio > 1)
-                    T_ratio = 1;
-
-                // Índice de umidade (simétrico: 70 ±25)
-                float H_ratio = 1.0f - (fabs(umid - ideal_umid) / 25.0f);
-                if (H_ratio < 0)
-                    H_ratio = 0;
-                if (H_ratio > 1)
-                    H_ratio = 1;
-
-                // Combinação ponderada: temperatura tem mais peso
-                final_ratio = (0.85f * T_ratio + 0.15f * H_ratio) / (0.85f + 0.15f);
-
-                // final_ratio vai de 0 a 1
-
-                // Degradê de cor:  final_ratio = 1 -> verde; = 0 -> vermelho; intermediário = amarelo
-                green = final_ratio * 10.0f;
-                red = (1.0f - final_ratio) * 10.0f;
+                // Degradê de cor: saúde 1 -> verde; 0 -> vermelho; intermediário = amarelo
+                green = e.medidas.saude * 10.0f;
+                red = (1.0f - e.medidas.saude) * 10.0f;
             }
 
-            if (simulation_mode == 0)
+            if (e.interface.modo == 0)
             {
                 // Atualiza display
                 char info[32];
-                snprintf(info, sizeof(info), "Temp : %.1f C", temp);
-                ssd1306_draw_string(&ssd, info, 0, 0);
-                snprintf(info, sizeof(info), "Umid : %.1f %%", umid);
-                ssd1306_draw_string(&ssd, info, 0, 10);
-                snprintf(info, sizeof(info), "Luz  : %.1f %%", sensores[1].value);
-                ssd1306_draw_string(&ssd, info, 0, 20);
-                snprintf(info, sizeof(info), "VOC  : %.1f ppm", sensores[2].value);
-                ssd1306_draw_string(&ssd, info, 0, 30);
-                snprintf(info, sizeof(info), "Peso : %.1f Kg", sensores[0].value);
-                ssd1306_draw_string(&ssd, info, 0, 40);
-                snprintf(info, sizeof(info), "Alarm: %s", alarm_active ? "ON" : "OFF");
-                ssd1306_draw_string(&ssd, info, 0, 55);
-                // snprintf(info, sizeof(info), "Mode  : %d", simulation_mode);
-                // ssd1306_draw_string(&ssd, info, 0, 60);
-
-                // Matriz 5x5 varia conforme simulation_mode
-                bool matrix_pattern[5][5];
-                if (!alarm_active)
-                {
-                    // LIMPANDO MATRIZ
-                    for (int i = 0; i < 5; i++)
-                        for (int j = 0; j < 5; j++)
-                            matrix_pattern[i][j] = false;
-                }
+                snprintf(info, sizeof(info), "Temp : %.1f °C", e.medidas.temp);
+                ssd1306_draw_string(ssd, info, 0, 0);
+                snprintf(info, sizeof(info), "Umid : %.1f %%", e.medidas.umid);
+                ssd1306_draw_string(ssd, info, 0, 10);
+                snprintf(info, sizeof(info), "Luz  : %.1f %%", e.medidas.sensores[1]);
+                ssd1306_draw_string(ssd, info, 0, 20);
+                snprintf(info, sizeof(info), "VOC  : %.1f ppm", e.medidas.sensores[2]);
+                ssd1306_draw_string(ssd, info, 0, 30);
+                formatar_peso(info, sizeof(info), e.medidas.sensores[0], e.medidas.peso_por_dia);
+                ssd1306_draw_string(ssd, info, 0, 40);
+
+                // Dias até a reserva de mel cruzar o mínimo da espécie
+                char reserva[8];
+                if (e.medidas.dias_reserva < 0)
+                    snprintf(reserva, sizeof(reserva), "--");
+                else if (e.medidas.dias_reserva > 99)
+                    snprintf(reserva, sizeof(reserva), ">99");
                 else
-                {
-
-                    // DEFININDO INDICADORES DA MATRIZ
-                    // 0 Peso
-                    // 1 Luminosidade
-                    // 2 Gas VOC"
-                    // 3 Vibracao
-                    for (int i = 0; i < 5; i++)
-                        for (int j = 0; j < 5; j++)
-                            matrix_pattern[i][j] = false;
-
-                    int peso_ideal = (int)((sensores[0].value - 0) / (especies[especie_index].peso_mel_anual - 0) * 4.0f);
-                    matrix_pattern[4 - peso_ideal][0] = true;
-                    int luminosidade_ideal = (int)((sensores[1].max - especies[especie_index].max_luz) / (sensores[1].max - sensores[1].min) * 4.0f);
-                    matrix_pattern[4 - luminosidade_ideal][1] = true;
-                    int voc_ideal = (int)((8.0f - sensores[2].value) / (8.0f - 0) * 4.0f);
-                    matrix_pattern[4 - voc_ideal][2] = true;
-                    int vibracao_ideal = (int)((sensores[3].value - 0) / (100.0f - 0) * 4.0f);
-                    matrix_pattern[4 - vibracao_ideal][3] = true;
-
-                    int final_ratio_index = (int)(final_ratio * 4.0f);
-                    matrix_pattern[4 - final_ratio_index][4] = true;
-                }
-                actionMatrizPattern(matrix_pattern, pio, sm);
+                    snprintf(reserva, sizeof(reserva), "%ldd", (long)e.medidas.dias_reserva);
+                snprintf(info, sizeof(info), "Alarm:%-3s R:%s", e.interface.alarme ? "ON" : "OFF", reserva);
+                ssd1306_draw_string(ssd, info, 0, 55);
+
+                // Indicadores de anomalia na última coluna de cada linha
+                ssd1306_draw_char(ssd, anomalia_simbolo(e.medidas.anomalias[CANAL_TEMP]), 120, 0);
+                ssd1306_draw_char(ssd, anomalia_simbolo(e.medidas.anomalias[CANAL_UMID]), 120, 10);
+                ssd1306_draw_char(ssd, anomalia_simbolo(e.medidas.anomalias[CANAL_LUZ]), 120, 20);
+                ssd1306_draw_char(ssd, anomalia_simbolo(e.medidas.anomalias[CANAL_VOC]), 120, 30);
+                ssd1306_draw_char(ssd, anomalia_simbolo(e.medidas.anomalias[CANAL_PESO]), 120, 40);
+                // snprintf(info, sizeof(info), "Mode  : %d", simulation_mode);
+                // ssd1306_draw_string(ssd, info, 0, 60);
+
+                // Matriz 5x5: com o alarme, um indicador aceso por coluna
+                bool matrix_pattern[5][5] = {false};
+                if (e.interface.alarme)
+                    for (int j = 0; j < ESTADO_INDICADORES; j++)
+                        matrix_pattern[e.medidas.indicadores[j]][j] = true;
+                if (e.interface.display)
+                    actionMatrizPattern(matrix_pattern, pio, sm);
             }
-            else if (simulation_mode == 1)
+            else if (e.interface.modo == 1)
             {
-                ssd1306_draw_string(&ssd, especies[especie_index].nome, 15, 0);
-                ssd1306_draw_char(&ssd, '>', 0, 0);
+                ssd1306_draw_string(ssd, especies[e.interface.especie].nome, 15, 0);
+                ssd1306_draw_char(ssd, '>', 0, 0);
                 char buffer[32];
-                snprintf(buffer, sizeof(buffer), "%s", especies[especie_index].genero);
-                ssd1306_draw_string(&ssd, buffer, 0, 10);
-                snprintf(buffer, sizeof(buffer), "Max: %.1f C", especies[especie_index].max_temp);
-                ssd1306_draw_string(&ssd, buffer, 0, 30);
-                snprintf(buffer, sizeof(buffer), "Min: %.1f C", especies[especie_index].min_temp);
-                ssd1306_draw_string(&ssd, buffer, 0, 40);
-                snprintf(buffer, sizeof(buffer), "Peso: %.1f", especies[especie_index].peso_mel_anual);
-                ssd1306_draw_string(&ssd, buffer, 0, 50);
+                snprintf(buffer, sizeof(buffer), "%s", especies[e.interface.especie].genero);
+                ssd1306_draw_string(ssd, buffer, 0, 10);
+                snprintf(buffer, sizeof(buffer), "Max: %.1f °C", especies[e.interface.especie].max_temp);
+                ssd1306_draw_string(ssd, buffer, 0, 30);
+                snprintf(buffer, sizeof(buffer), "Min: %.1f °C", especies[e.interface.especie].min_temp);
+                ssd1306_draw_string(ssd, buffer, 0, 40);
+                snprintf(buffer, sizeof(buffer), "Peso: %.1f", especies[e.interface.especie].peso_mel_anual);
+                ssd1306_draw_string(ssd, buffer, 0, 50);
             }
         }
 
-        if (play_tone)
+        PERFIL_FIM(PERFIL_RENDER, marca_render);
+
+        // Inatividade: apaga display, matriz e LED até a próxima entrada. Com
+        // uma rajada em curso fica na taxa cheia: o envio sai logo depois da
+        // gravação e o período curto nunca chega ao sono profundo
+        energia_amostra(estavel && !captura_ativa());
+
+        // Regime estável roda em 48 MHz; a taxa cheia volta ao clock de desempenho
+        relogio_definir_nivel(energia_periodo_ms() > energia_config.periodo_min_ms ? RELOGIO_ECONOMIA : RELOGIO_DESEMPENHO);
+        // Ao religar, o painel ainda mostra o quadro de quando apagou: as
+        // colunas desenhadas nesse meio-tempo nunca foram enviadas
+        bool display_religado = false;
+        if (energia_display_ligado() != display_ligado)
         {
-            tone(BUZZER_A, beep_frequency, beep_duration);
-            play_tone = false;
+            display_ligado = energia_display_ligado();
+            display_religado = display_ligado;
+            ssd1306_display(ssd, display_ligado);
+            if (!display_ligado)
+                clearMatriz(pio, sm);
         }
+        if (!display_ligado)
+            red = green = blue = 0;
 
         pwm_set_gpio_level(LED_RED, red / 255.0 * 65535);
         pwm_set_gpio_level(LED_GREEN, green / 255.0 * 65535);
         pwm_set_gpio_level(LED_BLUE, blue / 255.0 * 65535);
 
-        if (loop_counter == 0)
+        if (time_reached(proxima_telemetria))
         {
-            printf("{ \"temp\": %.1f, \"umid\": %.1f, \"peso\": %.1f, \"luz\": %.1f, \"voc\": %.1f, \"vibra\": %.1f }\n",
+            proxima_telemetria = make_timeout_time_ms(TELEMETRIA_PERIODO_MS);
+            printf("{ \"temp\": %.1f, \"umid\": %.1f, \"peso\": %.1f, \"luz\": %.1f, \"voc\": %.1f, \"vibra\": %.1f",
                    temp, umid, sensores[0].value, sensores[1].value, sensores[2].value, sensores[3].value);
+
+            // Estado dos detectores: z-score e bits de anomalia por canal
+            printf(", \"z\": [");
+            for (int i = 0; i < NUM_CANAIS; i++)
+                printf(i ? ", %.1f" : "%.1f", q16_para_float(detectores[i].z));
+            printf("], \"anom\": [");
+            for (int i = 0; i < NUM_CANAIS; i++)
+                printf(i ? ", %u" : "%u", detectores[i].estado);
+            // Perfil de temperatura do ninho (null para sensor sem leitura)
+            printf("], \"perfil\": [");
+            for (uint i = 0; i < ds18b20_quantidade(); i++)
+            {
+                q16_t t;
+                if (ds18b20_temperatura(i, &t))
+                    printf(i ? ", %.2f" : "%.2f", q16_para_float(t));
+                else
+                    printf(i ? ", null" : "null");
+            }
+            if (classificador_ok)
+                printf("], \"colonia\": \"%s\"", classe_colonia_nomes[colonia_classe]);
+            else
+                printf("]");
+            printf(", \"tend\": %.3f, \"dias\": %ld, \"isr_us\": %lu, \"periodo\": %lu, \"acordado\": %lu, \"mhz\": %lu }\n",
+                   peso_por_dia, (long)dias_reserva, (unsigned long)isr_us_max,
+                   (unsigned long)energia_periodo_ms(), (unsigned long)energia_acordado_permil(),
+                   (unsigned long)(relogio_hz() / 1000000));
         }
 
-        ssd1306_send_data(&ssd);
-        sleep_ms(100);
+        PERFIL_INICIO(marca_envio);
+        if (display_ligado && e.interface.tela == STATE_GRAFICO)
+        {
+            // Gráfico: quadro inteiro só ao redesenhar; senão, só a coluna nova
+            const grafico_t *g = &graficos[e.interface.grafico];
+            if (grafico_redesenhar || display_religado)
+                ssd1306_send_data(ssd);
+            else if (grafico_coluna_nova)
+            {
+                uint8_t x = g->x0 + (g->total - 1) % g->largura;
+                ssd1306_send_region(ssd, x, x, g->pagina0, g->pagina0 + g->paginas - 1);
+            }
+        }
+        else if (display_ligado)
+            ssd1306_send_data(ssd);
+        PERFIL_FIM(PERFIL_ENVIO, marca_envio);
+        enviar_espelho();
+        energia_dormir_ate(delayed_by_ms(inicio_amostra, energia_periodo_ms()));
     }
     return 0;
 }
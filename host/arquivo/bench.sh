@@ -0,0 +1,42 @@
+#!/bin/sh
+# Compara a vazão de uma consulta de histórico no arquivo .bsc com grep+awk
+# sobre o log JSON do gateway. Gera um log sintético no formato do gateway.
+# uso: bench.sh [colmeias] [linhas por colmeia] [diretório do build]
+
+COLMEIAS=${1:-20}
+LINHAS=${2:-50000}
+BUILD=${3:-build-host}
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+export LC_ALL=C
+
+# Uma linha por segundo por colmeia, intercaladas como o gateway grava
+awk -v h="$COLMEIAS" -v n="$LINHAS" 'BEGIN {
+    srand(7); t0 = 1700000000000
+    for (i = 0; i < n; i++)
+        for (c = 0; c < h; c++) {
+            temp = 34 + 3 * sin(i / 3600.0) + rand() - 0.5
+            printf "{\"colmeia\":\"colmeia-%02d\",\"t\":%.0f,\"t_rx\":%.0f,\"dados\":{ \"temp\": %.1f, \"umid\": %.1f, \"peso\": %.1f, \"luz\": %.1f, \"voc\": %.1f, \"vibra\": %.1f, \"z\": [%.1f, 0.0, 0.1, 0.0], \"anom\": [0, 0, 0, 0], \"perfil\": [], \"tend\": 0.010, \"dias\": -1 }}\n",
+                c, t0 + i * 1000 + c, i * 1000000000, temp, 60 + rand() * 5, 40 + i / 10000.0, 400 + rand() * 50, 120, rand(), rand() * 4
+        }
+}' > "$TMP/log.jsonl"
+
+"$BUILD/beesense_converter" "$TMP/log.bsc" "$TMP/log.jsonl"
+
+# Metade do período de uma colmeia: média da temperatura
+DE=$((1700000000000 + LINHAS * 250))
+ATE=$((1700000000000 + LINHAS * 750))
+
+echo "--- grep + awk no JSON"
+INICIO=$(date +%s%N)
+sh -c "grep -F '\"colmeia\":\"colmeia-03\"' '$TMP/log.jsonl' | awk -v de=$DE -v ate=$ATE '
+    { split(\$0, a, \"\\\"t\\\":\"); t = a[2] + 0; if (t < de || t > ate) next
+      split(\$0, b, \"\\\"temp\\\": \"); s += b[2]; n++ }
+    END { printf \"linhas %d media %.3f\\n\", n, s / n }'"
+echo "consulta_us: $((($(date +%s%N) - INICIO) / 1000))"
+
+echo "--- .bsc, uma colmeia"
+"$BUILD/beesense_consulta" "$TMP/log.bsc" --canal temp --colmeia colmeia-03 --de $DE --ate $ATE --repetir 20
+echo "--- .bsc, todas as colmeias, com temp > 36"
+"$BUILD/beesense_consulta" "$TMP/log.bsc" --canal temp --de $DE --ate $ATE --acima 36 --repetir 20
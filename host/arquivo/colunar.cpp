@@ -0,0 +1,437 @@
+#include "colunar.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+const char *const NOMES_COLUNAS[NUM_COLUNAS] = {"tempo", "temp", "umid", "peso", "luz", "voc", "vibra", "score"};
+
+static const char MAGICA[8] = {'B', 'E', 'E', 'S', 'C', 'O', 'L', 0};
+
+Coluna coluna_por_nome(const std::string &nome)
+{
+    for (int c = 0; c < NUM_COLUNAS; c++)
+        if (nome == NOMES_COLUNAS[c])
+            return (Coluna)c;
+    return NUM_COLUNAS;
+}
+
+// ---------------------------------------------------------------------------
+// Gravação
+
+Gravador::Gravador(const std::string &caminho) : arquivo(fopen(caminho.c_str(), "wb"))
+{
+    if (!arquivo)
+        return;
+    Cabecalho c{};
+    memcpy(c.magica, MAGICA, sizeof MAGICA);
+    c.versao = VERSAO;
+    c.colunas = NUM_COLUNAS;
+    c.bloco_linhas = BLOCO_LINHAS;
+    c.escala = ESCALA;
+    fwrite(&c, sizeof c, 1, arquivo);
+    pos = sizeof c;
+}
+
+Gravador::~Gravador()
+{
+    if (arquivo)
+        fechar();
+}
+
+void Gravador::adicionar(const std::string &colmeia, int64_t t_ms, const double *valores)
+{
+    auto &p = pendentes[colmeia];
+    if (!p)
+    {
+        p.reset(new Pendente);
+        p->id = nomes.size();
+        nomes.push_back(colmeia);
+        for (auto &c : p->colunas)
+            c.reserve(BLOCO_LINHAS);
+    }
+
+    // A coluna de tempo precisa caber em 32 bits acima da base do bloco
+    auto &tempo = p->colunas[COLUNA_TEMPO];
+    if (!tempo.empty() && (uint64_t)(t_ms - tempo.front()) > UINT32_MAX)
+        gravar_grupo(*p);
+
+    tempo.push_back(t_ms);
+    for (int c = COLUNA_TEMP; c < NUM_COLUNAS; c++)
+    {
+        // Em escala e limitado a 32 bits com sinal: a diferença cabe na largura máxima
+        double v = std::round(valores[c - COLUNA_TEMP] * ESCALA);
+        v = std::min(std::max(v, (double)INT32_MIN), (double)INT32_MAX);
+        p->colunas[c].push_back((int64_t)v);
+    }
+    total++;
+
+    if (tempo.size() == BLOCO_LINHAS)
+        gravar_grupo(*p);
+}
+
+void Gravador::alinhar()
+{
+    static const uint8_t zeros[64] = {};
+    size_t resto = pos % 64;
+    if (resto)
+    {
+        fwrite(zeros, 64 - resto, 1, arquivo);
+        pos += 64 - resto;
+    }
+}
+
+void Gravador::gravar_bloco(const std::vector<int64_t> &valores)
+{
+    Bloco b{};
+    b.linhas = valores.size();
+    b.min = *std::min_element(valores.begin(), valores.end());
+    b.max = *std::max_element(valores.begin(), valores.end());
+    for (int64_t v : valores)
+        b.soma += v;
+    b.base = b.min;
+
+    uint64_t faixa = (uint64_t)(b.max - b.min);
+    b.largura = faixa == 0 ? 0 : faixa <= UINT8_MAX ? 1 : faixa <= UINT16_MAX ? 2 : 4;
+
+    buffer.resize((size_t)b.linhas * b.largura);
+    uint8_t *d = buffer.data();
+    for (size_t i = 0; i < valores.size(); i++)
+    {
+        uint32_t delta = (uint32_t)(valores[i] - b.base);
+        if (b.largura == 1)
+            d[i] = (uint8_t)delta;
+        else if (b.largura == 2)
+            ((uint16_t *)d)[i] = (uint16_t)delta;
+        else if (b.largura == 4)
+            ((uint32_t *)d)[i] = delta;
+    }
+
+    fwrite(&b, sizeof b, 1, arquivo);
+    if (!buffer.empty())
+        fwrite(buffer.data(), buffer.size(), 1, arquivo);
+    pos += sizeof b + buffer.size();
+    alinhar();
+}
+
+void Gravador::gravar_grupo(Pendente &p)
+{
+    auto &tempo = p.colunas[COLUNA_TEMPO];
+    if (tempo.empty())
+        return;
+
+    Grupo g{};
+    g.colmeia = p.id;
+    g.linhas = tempo.size();
+    g.t_min = *std::min_element(tempo.begin(), tempo.end());
+    g.t_max = *std::max_element(tempo.begin(), tempo.end());
+    for (int c = 0; c < NUM_COLUNAS; c++)
+    {
+        g.blocos[c] = pos;
+        gravar_bloco(p.colunas[c]);
+        p.colunas[c].clear();
+    }
+    grupos.push_back(g);
+}
+
+bool Gravador::fechar()
+{
+    if (!arquivo)
+        return false;
+    for (auto &p : pendentes)
+        gravar_grupo(*p.second);
+
+    Rodape r{};
+    r.grupos_pos = pos;
+    r.n_grupos = grupos.size();
+    fwrite(grupos.data(), sizeof(Grupo), grupos.size(), arquivo);
+    pos += sizeof(Grupo) * grupos.size();
+
+    r.nomes_pos = pos;
+    r.n_colmeias = nomes.size();
+    for (auto &n : nomes)
+    {
+        fwrite(n.c_str(), n.size() + 1, 1, arquivo);
+        pos += n.size() + 1;
+    }
+    memcpy(r.magica, MAGICA, sizeof MAGICA);
+    fwrite(&r, sizeof r, 1, arquivo);
+
+    bool ok = !ferror(arquivo);
+    ok &= fclose(arquivo) == 0;
+    arquivo = nullptr;
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Leitura
+
+Arquivo::~Arquivo()
+{
+    if (base)
+        munmap((void *)base, bytes);
+}
+
+bool Arquivo::abrir(const std::string &caminho)
+{
+    int fd = open(caminho.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(Cabecalho) + sizeof(Rodape))
+    {
+        close(fd);
+        return false;
+    }
+    bytes = st.st_size;
+    void *m = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED)
+        return false;
+    base = (const uint8_t *)m;
+
+    const Cabecalho *c = (const Cabecalho *)base;
+    const Rodape *r = (const Rodape *)(base + bytes - sizeof(Rodape));
+    if (memcmp(c->magica, MAGICA, sizeof MAGICA) || memcmp(r->magica, MAGICA, sizeof MAGICA) ||
+        c->versao != VERSAO || c->colunas != NUM_COLUNAS || c->escala != ESCALA ||
+        r->grupos_pos + r->n_grupos * sizeof(Grupo) > r->nomes_pos || r->nomes_pos > bytes - sizeof(Rodape))
+        return false;
+
+    lista = (const Grupo *)(base + r->grupos_pos);
+    n_grupos = r->n_grupos;
+    const char *nome = (const char *)(base + r->nomes_pos);
+    const char *fim = (const char *)r;
+    for (uint64_t i = 0; i < r->n_colmeias && nome < fim; i++)
+    {
+        nomes.emplace_back(nome, strnlen(nome, fim - nome));
+        nome += nomes.back().size() + 1;
+    }
+
+    // As consultas percorrem os blocos em ordem: pede leitura antecipada
+    madvise(m, bytes, MADV_SEQUENTIAL);
+    return nomes.size() == r->n_colmeias;
+}
+
+int Arquivo::colmeia(const std::string &nome) const
+{
+    for (size_t i = 0; i < nomes.size(); i++)
+        if (nomes[i] == nome)
+            return (int)i;
+    return -1;
+}
+
+// ---------------------------------------------------------------------------
+// Varredura
+
+namespace
+{
+
+// Acumulado de um bloco, em deltas sobre a base
+struct Parcial
+{
+    uint64_t linhas = 0;
+    uint64_t soma = 0;
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+};
+
+void decodificar(const Bloco *b, const uint8_t *d, uint32_t *saida)
+{
+    uint32_t n = b->linhas;
+    switch (b->largura)
+    {
+    case 0:
+        std::fill(saida, saida + n, 0u);
+        break;
+    case 1:
+        for (uint32_t i = 0; i < n; i++)
+            saida[i] = d[i];
+        break;
+    case 2:
+        for (uint32_t i = 0; i < n; i++)
+            saida[i] = ((const uint16_t *)d)[i];
+        break;
+    default:
+        memcpy(saida, d, n * sizeof(uint32_t));
+        break;
+    }
+}
+
+// Linhas com t em [t_de, t_ate] e v >= v_de
+void varrer_escalar(const uint32_t *t, const uint32_t *v, uint32_t n, uint32_t t_de, uint32_t t_ate,
+                    uint32_t v_de, Parcial &p)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (t[i] < t_de || t[i] > t_ate || v[i] < v_de)
+            continue;
+        p.linhas++;
+        p.soma += v[i];
+        p.min = std::min(p.min, v[i]);
+        p.max = std::max(p.max, v[i]);
+    }
+}
+
+#if defined(__x86_64__)
+// Oito linhas por iteração; a comparação sem sinal sai de max/min_epu32
+__attribute__((target("avx2"))) void varrer_avx2(const uint32_t *t, const uint32_t *v, uint32_t n, uint32_t t_de,
+                                                 uint32_t t_ate, uint32_t v_de, Parcial &p)
+{
+    const __m256i de = _mm256_set1_epi32((int)t_de);
+    const __m256i ate = _mm256_set1_epi32((int)t_ate);
+    const __m256i vde = _mm256_set1_epi32((int)v_de);
+    const __m256i todos = _mm256_set1_epi32(-1);
+    __m256i contagem = _mm256_setzero_si256();
+    __m256i soma = _mm256_setzero_si256();
+    __m256i vmin = todos;
+    __m256i vmax = _mm256_setzero_si256();
+
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i tt = _mm256_loadu_si256((const __m256i *)(t + i));
+        __m256i vv = _mm256_loadu_si256((const __m256i *)(v + i));
+        __m256i m = _mm256_and_si256(_mm256_cmpeq_epi32(_mm256_max_epu32(tt, de), tt),
+                                     _mm256_cmpeq_epi32(_mm256_min_epu32(tt, ate), tt));
+        m = _mm256_and_si256(m, _mm256_cmpeq_epi32(_mm256_max_epu32(vv, vde), vv));
+
+        contagem = _mm256_sub_epi32(contagem, m);
+        __m256i sel = _mm256_and_si256(vv, m);
+        soma = _mm256_add_epi64(soma, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(sel)));
+        soma = _mm256_add_epi64(soma, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(sel, 1)));
+        vmax = _mm256_max_epu32(vmax, sel);
+        vmin = _mm256_min_epu32(vmin, _mm256_or_si256(vv, _mm256_xor_si256(m, todos)));
+    }
+
+    alignas(32) uint32_t c[8], mn[8], mx[8];
+    alignas(32) uint64_t s[4];
+    _mm256_store_si256((__m256i *)c, contagem);
+    _mm256_store_si256((__m256i *)mn, vmin);
+    _mm256_store_si256((__m256i *)mx, vmax);
+    _mm256_store_si256((__m256i *)s, soma);
+    for (int k = 0; k < 8; k++)
+    {
+        p.linhas += c[k];
+        p.min = std::min(p.min, mn[k]);
+        p.max = std::max(p.max, mx[k]);
+    }
+    p.soma += s[0] + s[1] + s[2] + s[3];
+    varrer_escalar(t + i, v + i, n - i, t_de, t_ate, v_de, p);
+}
+#endif
+
+using Varredura = void (*)(const uint32_t *, const uint32_t *, uint32_t, uint32_t, uint32_t, uint32_t, Parcial &);
+
+Varredura escolher()
+{
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2"))
+        return varrer_avx2;
+#endif
+    return varrer_escalar;
+}
+
+const Varredura varrer = escolher();
+
+// Limite em delta sobre a base, saturado em [0, UINT32_MAX]
+uint32_t delta(int64_t valor, int64_t base)
+{
+    if (valor <= base)
+        return 0;
+    uint64_t d = (uint64_t)valor - (uint64_t)base;
+    return d > UINT32_MAX ? UINT32_MAX : (uint32_t)d;
+}
+
+} // namespace
+
+uint32_t ler_coluna(const Arquivo &arquivo, const Grupo &grupo, Coluna coluna, int64_t *saida)
+{
+    const Bloco *b = arquivo.bloco(grupo, coluna);
+    alignas(32) uint32_t deltas[BLOCO_LINHAS];
+    decodificar(b, arquivo.dados(b), deltas);
+    for (uint32_t i = 0; i < b->linhas; i++)
+        saida[i] = b->base + deltas[i];
+    return b->linhas;
+}
+
+const char *varredura_simd()
+{
+#if defined(__x86_64__)
+    if (varrer == varrer_avx2)
+        return "avx2";
+#endif
+    return "escalar";
+}
+
+Resultado agregar(const Arquivo &arquivo, const Consulta &consulta)
+{
+    Resultado r;
+    int64_t min = INT64_MAX, max = INT64_MIN, soma = 0;
+    // valor > limiar, em centésimos inteiros
+    int64_t limiar = consulta.com_limiar ? (int64_t)std::floor(consulta.limiar * ESCALA) : INT64_MIN;
+    alignas(32) uint32_t t[BLOCO_LINHAS], v[BLOCO_LINHAS];
+
+    for (size_t i = 0; i < arquivo.num_grupos(); i++)
+    {
+        const Grupo &g = arquivo.grupos()[i];
+        if ((consulta.colmeia >= 0 && g.colmeia != (uint32_t)consulta.colmeia) || g.t_max < consulta.de ||
+            g.t_min > consulta.ate)
+        {
+            r.pulados++;
+            continue;
+        }
+        const Bloco *b = arquivo.bloco(g, consulta.coluna);
+        if (b->max <= limiar)
+        {
+            r.pulados++;
+            continue;
+        }
+
+        // Grupo inteiro dentro da consulta: o rodapé já é a resposta
+        if (consulta.de <= g.t_min && g.t_max <= consulta.ate && b->min > limiar)
+        {
+            r.linhas += b->linhas;
+            soma += b->soma;
+            min = std::min(min, b->min);
+            max = std::max(max, b->max);
+            r.por_rodape++;
+            continue;
+        }
+
+        const Bloco *bt = arquivo.bloco(g, COLUNA_TEMPO);
+        decodificar(bt, arquivo.dados(bt), t);
+        decodificar(b, arquivo.dados(b), v);
+        uint32_t t_de = delta(consulta.de, bt->base);
+        uint32_t t_ate = consulta.ate >= bt->max ? UINT32_MAX : delta(consulta.ate, bt->base);
+        uint32_t v_de = limiar == INT64_MIN ? 0 : delta(limiar + 1, b->base);
+
+        Parcial p;
+        varrer(t, v, b->linhas, t_de, t_ate, v_de, p);
+        r.varridos++;
+        if (p.linhas)
+        {
+            r.linhas += p.linhas;
+            soma += (int64_t)p.soma + (int64_t)p.linhas * b->base;
+            min = std::min(min, b->base + (int64_t)p.min);
+            max = std::max(max, b->base + (int64_t)p.max);
+        }
+    }
+
+    if (r.linhas)
+    {
+        r.min = (double)min / ESCALA;
+        r.max = (double)max / ESCALA;
+        r.soma = (double)soma / ESCALA;
+    }
+    return r;
+}
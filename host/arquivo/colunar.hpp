@@ -0,0 +1,210 @@
+#ifndef COLUNAR_HPP
+#define COLUNAR_HPP
+
+// Arquivo colunar da telemetria das colmeias (.bsc), para consultas de
+// histórico sem varrer JSON.
+//
+// As linhas de cada colmeia são juntadas em grupos de até BLOCO_LINHAS. Cada
+// grupo guarda uma coluna por canal, e cada coluna é um bloco comprimido por
+// referência de quadro (FOR): o bloco leva base = mínimo e os valores - base
+// em 0, 8, 16 ou 32 bits, a menor largura que couber. O cabeçalho de cada
+// bloco é o rodapé de estatística dele (mín, máx, soma). Um índice no fim do
+// arquivo lista os grupos com colmeia e intervalo de tempo.
+//
+// Layout:
+//   Cabecalho | grupo 0: Bloco+dados por coluna | grupo 1 ... |
+//   Grupo[n_grupos] | nomes das colmeias ('\0' no fim de cada) | Rodape
+// Todos os blocos começam alinhados em 64 bytes, e o arquivo é lido com mmap
+// sem nenhuma cópia nem decodificação prévia.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum Coluna
+{
+    COLUNA_TEMPO, // ms desde a época Unix
+    COLUNA_TEMP,
+    COLUNA_UMID,
+    COLUNA_PESO,
+    COLUNA_LUZ,
+    COLUNA_VOC,
+    COLUNA_VIBRA,
+    COLUNA_SCORE, // maior |z| entre os detectores de anomalia
+    NUM_COLUNAS
+};
+
+extern const char *const NOMES_COLUNAS[NUM_COLUNAS];
+
+// Coluna pelo nome ("temp", "peso"...); NUM_COLUNAS se não existir
+Coluna coluna_por_nome(const std::string &nome);
+
+constexpr uint32_t BLOCO_LINHAS = 1024;
+constexpr int ESCALA = 100; // canais gravados em centésimos
+constexpr uint32_t VERSAO = 1;
+
+struct Cabecalho
+{
+    char magica[8]; // "BEESCOL\0"
+    uint32_t versao;
+    uint32_t colunas;
+    uint32_t bloco_linhas;
+    uint32_t escala;
+    uint8_t reservado[40];
+};
+
+// Cabeçalho e rodapé de estatística de um bloco (valores já em escala)
+struct Bloco
+{
+    int64_t min;
+    int64_t max;
+    int64_t soma;
+    int64_t base;
+    uint32_t linhas;
+    uint32_t largura; // bytes por valor: 0, 1, 2 ou 4
+    uint8_t reservado[24];
+};
+
+struct Grupo
+{
+    uint32_t colmeia; // índice na tabela de nomes
+    uint32_t linhas;
+    int64_t t_min;
+    int64_t t_max;
+    uint64_t blocos[NUM_COLUNAS]; // posição de cada Bloco no arquivo
+};
+
+struct Rodape
+{
+    uint64_t grupos_pos;
+    uint64_t n_grupos;
+    uint64_t nomes_pos;
+    uint64_t n_colmeias;
+    char magica[8];
+};
+
+static_assert(sizeof(Cabecalho) == 64 && sizeof(Bloco) == 64, "layout do arquivo");
+
+// Grava um arquivo novo; as linhas de cada colmeia devem vir em ordem de tempo
+class Gravador
+{
+public:
+    explicit Gravador(const std::string &caminho);
+    ~Gravador();
+
+    bool ok() const
+    {
+        return arquivo != nullptr;
+    }
+
+    // valores: os canais de COLUNA_TEMP a COLUNA_SCORE, em unidades reais
+    void adicionar(const std::string &colmeia, int64_t t_ms, const double *valores);
+
+    // Grava os grupos pendentes e o índice; false em erro de E/S
+    bool fechar();
+
+    uint64_t linhas() const
+    {
+        return total;
+    }
+
+private:
+    struct Pendente
+    {
+        uint32_t id;
+        std::vector<int64_t> colunas[NUM_COLUNAS];
+    };
+
+    void gravar_grupo(Pendente &p);
+    void gravar_bloco(const std::vector<int64_t> &valores);
+    void alinhar();
+
+    FILE *arquivo;
+    uint64_t pos = 0;
+    uint64_t total = 0;
+    std::unordered_map<std::string, std::unique_ptr<Pendente>> pendentes;
+    std::vector<std::string> nomes;
+    std::vector<Grupo> grupos;
+    std::vector<uint8_t> buffer;
+};
+
+// Arquivo aberto com mmap, só leitura
+class Arquivo
+{
+public:
+    ~Arquivo();
+
+    // false se não existir ou não for um .bsc válido
+    bool abrir(const std::string &caminho);
+
+    const Grupo *grupos() const
+    {
+        return lista;
+    }
+    size_t num_grupos() const
+    {
+        return n_grupos;
+    }
+    const std::vector<std::string> &colmeias() const
+    {
+        return nomes;
+    }
+    // Índice da colmeia ou -1
+    int colmeia(const std::string &nome) const;
+
+    const Bloco *bloco(const Grupo &g, Coluna c) const
+    {
+        return (const Bloco *)(base + g.blocos[c]);
+    }
+    const uint8_t *dados(const Bloco *b) const
+    {
+        return (const uint8_t *)(b + 1);
+    }
+    size_t tamanho() const
+    {
+        return bytes;
+    }
+
+private:
+    const uint8_t *base = nullptr;
+    size_t bytes = 0;
+    const Grupo *lista = nullptr;
+    size_t n_grupos = 0;
+    std::vector<std::string> nomes;
+};
+
+struct Consulta
+{
+    Coluna coluna = COLUNA_TEMP;
+    int colmeia = -1; // -1 = todas
+    int64_t de = INT64_MIN; // intervalo de tempo fechado, ms
+    int64_t ate = INT64_MAX;
+    bool com_limiar = false; // só as linhas com valor > limiar
+    double limiar = 0;
+};
+
+struct Resultado
+{
+    uint64_t linhas = 0;
+    double min = 0, max = 0, soma = 0;
+
+    // Como cada grupo foi resolvido
+    uint64_t pulados = 0;    // descartados pelo índice ou pelo rodapé
+    uint64_t por_rodape = 0; // respondidos só com o rodapé
+    uint64_t varridos = 0;   // decodificados e varridos
+};
+
+Resultado agregar(const Arquivo &arquivo, const Consulta &consulta);
+
+// Decodifica uma coluna inteira do grupo em valores na escala do arquivo
+// (tempo em ms, canais em centésimos); saida precisa de BLOCO_LINHAS posições
+uint32_t ler_coluna(const Arquivo &arquivo, const Grupo &grupo, Coluna coluna, int64_t *saida);
+
+// Nome do conjunto de instruções usado na varredura ("avx2" ou "escalar")
+const char *varredura_simd();
+
+#endif
@@ -0,0 +1,84 @@
+// Agregação de um canal num arquivo .bsc: linhas, mínimo, máximo, soma e média
+// no intervalo de tempo, de uma colmeia ou de todas.
+// uso: beesense_consulta arquivo.bsc [--canal temp] [--colmeia nome] [--de ms]
+//                        [--ate ms] [--acima valor] [--repetir n]
+
+#include "colunar.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr,
+                "uso: %s arquivo.bsc [--canal temp] [--colmeia nome] [--de ms] [--ate ms] [--acima valor] "
+                "[--repetir n]\n",
+                argv[0]);
+        return 2;
+    }
+    Arquivo a;
+    if (!a.abrir(argv[1]))
+    {
+        fprintf(stderr, "%s: arquivo .bsc inválido\n", argv[1]);
+        return 1;
+    }
+
+    Consulta q;
+    int repetir = 1;
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        std::string op = argv[i];
+        const char *valor = argv[i + 1];
+        if (op == "--canal")
+            q.coluna = coluna_por_nome(valor);
+        else if (op == "--colmeia")
+        {
+            q.colmeia = a.colmeia(valor);
+            if (q.colmeia < 0)
+            {
+                fprintf(stderr, "colmeia desconhecida: %s\n", valor);
+                return 1;
+            }
+        }
+        else if (op == "--de")
+            q.de = strtoll(valor, nullptr, 10);
+        else if (op == "--ate")
+            q.ate = strtoll(valor, nullptr, 10);
+        else if (op == "--acima")
+        {
+            q.com_limiar = true;
+            q.limiar = atof(valor);
+        }
+        else if (op == "--repetir")
+            repetir = atoi(valor);
+        else
+        {
+            fprintf(stderr, "opção desconhecida: %s\n", op.c_str());
+            return 2;
+        }
+    }
+    if (q.coluna == NUM_COLUNAS || q.coluna == COLUNA_TEMPO || repetir < 1)
+    {
+        fprintf(stderr, "canal inválido (temp, umid, peso, luz, voc, vibra, score)\n");
+        return 2;
+    }
+
+    Resultado r;
+    auto inicio = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetir; i++)
+        r = agregar(a, q);
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count() / repetir;
+
+    printf("{\"canal\":\"%s\",\"linhas\":%llu,\"min\":%.2f,\"max\":%.2f,\"soma\":%.2f,\"media\":%.3f,"
+           "\"grupos\":%zu,\"pulados\":%llu,\"por_rodape\":%llu,\"varridos\":%llu,\"simd\":\"%s\","
+           "\"consulta_us\":%.1f}\n",
+           NOMES_COLUNAS[q.coluna], (unsigned long long)r.linhas, r.min, r.max, r.soma,
+           r.linhas ? r.soma / r.linhas : 0.0, a.num_grupos(), (unsigned long long)r.pulados,
+           (unsigned long long)r.por_rodape, (unsigned long long)r.varridos, varredura_simd(), s * 1e6);
+    return 0;
+}
@@ -0,0 +1,133 @@
+// Converte os logs JSON do gateway (uma linha por mensagem) num arquivo .bsc.
+// uso: beesense_converter saida.bsc entrada.jsonl... ("-" lê a entrada padrão)
+
+#include "colunar.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace
+{
+
+const char *const CAMPOS[] = {"\"temp\":", "\"umid\":", "\"peso\":", "\"luz\":", "\"voc\":", "\"vibra\":"};
+
+bool numero(const char *linha, const char *campo, double &valor)
+{
+    const char *p = strstr(linha, campo);
+    if (!p)
+        return false;
+    char *fim;
+    valor = strtod(p + strlen(campo), &fim);
+    return fim != p + strlen(campo);
+}
+
+// Maior |z| da lista "z": [..]; 0 se a linha não tiver detectores
+double score(const char *linha)
+{
+    const char *p = strstr(linha, "\"z\":");
+    double maior = 0;
+    if (!p || !(p = strchr(p, '[')))
+        return 0;
+    for (p++; *p && *p != ']';)
+    {
+        char *fim;
+        double z = strtod(p, &fim);
+        if (fim == p)
+            break;
+        maior = std::max(maior, std::fabs(z));
+        p = fim;
+        while (*p == ',' || *p == ' ')
+            p++;
+    }
+    return maior;
+}
+
+// Linha do gateway: {"colmeia":"..","t":ms,"t_rx":ns,"dados":{...}}
+bool converter(const char *linha, Gravador &g)
+{
+    const char *c = strstr(linha, "\"colmeia\":\"");
+    if (!c)
+        return false;
+    c += strlen("\"colmeia\":\"");
+    const char *fim = strchr(c, '"');
+    if (!fim)
+        return false;
+    std::string colmeia(c, fim);
+
+    double t;
+    if (!numero(linha, "\"t\":", t))
+    {
+        // Logs sem horário Unix: usa o relógio do gateway
+        if (!numero(linha, "\"t_rx\":", t))
+            return false;
+        t /= 1e6;
+    }
+
+    const char *dados = strstr(linha, "\"dados\":");
+    if (!dados)
+        return false;
+    double valores[NUM_COLUNAS - 1];
+    for (int i = 0; i < 6; i++)
+        if (!numero(dados, CAMPOS[i], valores[i]))
+            return false;
+    valores[COLUNA_SCORE - COLUNA_TEMP] = score(dados);
+
+    g.adicionar(colmeia, (int64_t)t, valores);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "uso: %s saida.bsc entrada.jsonl...\n", argv[0]);
+        return 2;
+    }
+    Gravador g(argv[1]);
+    if (!g.ok())
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    uint64_t ignoradas = 0, bytes = 0;
+    char *linha = nullptr;
+    size_t cap = 0;
+    for (int i = 2; i < argc; i++)
+    {
+        FILE *f = strcmp(argv[i], "-") ? fopen(argv[i], "r") : stdin;
+        if (!f)
+        {
+            perror(argv[i]);
+            return 1;
+        }
+        ssize_t n;
+        while ((n = getline(&linha, &cap, f)) > 0)
+        {
+            bytes += n;
+            if (!converter(linha, g))
+                ignoradas++;
+        }
+        if (f != stdin)
+            fclose(f);
+    }
+    free(linha);
+
+    uint64_t linhas = g.linhas();
+    if (!g.fechar())
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    Arquivo a;
+    size_t tamanho = a.abrir(argv[1]) ? a.tamanho() : 0;
+    fprintf(stderr, "{\"linhas\":%llu,\"ignoradas\":%llu,\"json_bytes\":%llu,\"bsc_bytes\":%zu,\"razao\":%.1f}\n",
+            (unsigned long long)linhas, (unsigned long long)ignoradas, (unsigned long long)bytes, tamanho,
+            tamanho ? (double)bytes / tamanho : 0);
+    return 0;
+}
@@ -0,0 +1,143 @@
+// Confere a matemática da balança do firmware (inc/balanca.c): decodificação
+// das palavras de 24 bits do HX711 (extensão de sinal e saturação), média das
+// leituras para a tara, escala com uma massa conhecida e a volta de contagens
+// para kg. Uma linha JSON por caso; sai com status 1 se algum falhar.
+
+extern "C"
+{
+#include "balanca.h"
+}
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+
+namespace
+{
+
+int falhas = 0;
+
+void conferir(const char *caso, bool condicao)
+{
+    printf("{\"caso\":\"%s\",\"ok\":%s}\n", caso, condicao ? "true" : "false");
+    if (!condicao)
+        falhas++;
+}
+
+void decodificacao()
+{
+    struct
+    {
+        uint32_t palavra;
+        int32_t bruto;
+        bool saturada;
+    } casos[] = {
+        {0x000000, 0, false},        {0x000001, 1, false},          {0x7FFFFE, 8388606, false},
+        {0x7FFFFF, 8388607, true},   {0x800000, -8388608, true},    {0x800001, -8388607, false},
+        {0xFFFFFF, -1, false},       {0xFF000005, 5, false}, // byte de cima ignorado
+    };
+    bool ok = true;
+    for (auto &c : casos)
+    {
+        int32_t bruto = balanca_decodificar(c.palavra);
+        bool saturada = balanca_saturada(bruto);
+        if (bruto != c.bruto || saturada != c.saturada)
+        {
+            printf("{\"caso\":\"decodificar\",\"palavra\":\"0x%06X\",\"bruto\":%d,\"esperado\":%d,\"saturada\":%s}\n",
+                   (unsigned)c.palavra, (int)bruto, (int)c.bruto, saturada ? "true" : "false");
+            ok = false;
+        }
+    }
+    conferir("decodificar", ok);
+}
+
+void media_e_tara()
+{
+    balanca_media_t m{};
+    int32_t media;
+    conferir("media_vazia", !balanca_media(&m, &media));
+
+    // 1000 + 1002 + 1003 = 3005 / 3 = 1001,67: arredonda para 1002; as
+    // saturadas (célula desconectada) ficam de fora
+    for (int32_t bruto : {1000, 0x7FFFFF, 1002, -0x800000, 1003})
+        balanca_media_somar(&m, bruto);
+    conferir("media_arredondada", balanca_media(&m, &media) && media == 1002 && m.n == 3);
+
+    balanca_media_t negativa{};
+    for (int32_t bruto : {-1000, -1001})
+        balanca_media_somar(&negativa, bruto);
+    conferir("media_negativa", balanca_media(&negativa, &media) && media == -1001);
+
+    // Tara pela média de leituras ruidosas: o peso médio fica em zero
+    balanca_media_t vazia{};
+    int64_t ruido = 0;
+    for (int i = 0; i < 80; i++)
+    {
+        int32_t r = (i * 37 % 21) - 10;
+        ruido += r;
+        balanca_media_somar(&vazia, -123456 + r);
+    }
+    balanca_calibracao_t cal = BALANCA_CALIBRACAO_PADRAO;
+    bool ok = balanca_media(&vazia, &media);
+    balanca_tarar(&cal, media);
+    int32_t esperada = (int32_t)std::lround(-123456 + ruido / 80.0);
+    conferir("tara_media", ok && cal.tara == esperada && balanca_kg(&cal, media) == 0);
+}
+
+void escala()
+{
+    // 2,5 kg sobre uma célula de 21000 contagens/kg
+    balanca_calibracao_t cal = {50000, 1};
+    conferir("escala", balanca_calibrar_escala(&cal, 50000 + 52500, Q16(2.5)) && cal.contagens_por_kg == 21000);
+
+    // Célula montada invertida: escala negativa, peso positivo
+    balanca_calibracao_t invertida = {50000, 1};
+    bool ok = balanca_calibrar_escala(&invertida, 50000 - 52500, Q16(2.5));
+    conferir("escala_invertida", ok && invertida.contagens_por_kg == -21000 &&
+                                     balanca_kg(&invertida, 50000 - 21000) == Q16_UM);
+
+    // Diferença pequena demais ou massa inválida: a calibração não muda
+    balanca_calibracao_t recusada = {50000, 777};
+    bool recusas = !balanca_calibrar_escala(&recusada, 50000 + 999, Q16(1.0)) &&
+                   !balanca_calibrar_escala(&recusada, 50000 + 52500, 0) &&
+                   !balanca_calibrar_escala(&recusada, 50000 + 52500, Q16(-1.0));
+    conferir("escala_recusada", recusas && recusada.contagens_por_kg == 777 && recusada.tara == 50000);
+}
+
+void ida_e_volta()
+{
+    // kg -> contagens -> kg em toda a faixa de uma célula de 50 kg: erro de no
+    // máximo uma contagem mais o arredondamento do Q16
+    balanca_calibracao_t cal = {-83000, 21000};
+    double pior = 0;
+    for (int g = -10000; g <= 60000; g += 7)
+    {
+        double kg = g / 1000.0;
+        int32_t bruto = cal.tara + (int32_t)std::lround(kg * cal.contagens_por_kg);
+        double obtido = q16_para_float(balanca_kg(&cal, bruto));
+        pior = std::fmax(pior, std::fabs(obtido - kg));
+    }
+    double tolerancia = 0.5 / 21000 + 1.0 / Q16_UM;
+    printf("{\"caso\":\"ida_e_volta\",\"erro_max_kg\":%.7f,\"tolerancia\":%.7f,\"ok\":%s}\n", pior, tolerancia,
+           pior <= tolerancia ? "true" : "false");
+    if (pior > tolerancia)
+        falhas++;
+
+    // Sem escala, zero; fora da faixa do Q16, satura
+    balanca_calibracao_t zero = {0, 0}, fina = {0, 1};
+    conferir("kg_sem_escala", balanca_kg(&zero, 5000) == 0);
+    conferir("kg_saturado", balanca_kg(&fina, 8388607) == INT32_MAX && balanca_kg(&fina, -8388608) == INT32_MIN);
+}
+
+} // namespace
+
+int main()
+{
+    decodificacao();
+    media_e_tara();
+    escala();
+    ida_e_volta();
+    printf("{\"falhas\":%d}\n", falhas);
+    return falhas ? 1 : 0;
+}
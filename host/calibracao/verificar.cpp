@@ -0,0 +1,204 @@
+// Confere as tabelas de calibração do firmware (inc/calibracao.c) contra as
+// curvas calculadas em double, em todas as 4096 leituras do ADC: retas,
+// polinômio, pontos e a curva de potência do MQ-135, com e sem a correção de
+// temperatura/umidade numa grade de T e H. Confere também a inserção de
+// pontos e o ajuste de R0 em ar de referência. Uma linha JSON por caso; sai
+// com status 1 se algum erro passar da tolerância.
+
+extern "C"
+{
+#include "calibracao.h"
+}
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+
+namespace
+{
+
+constexpr int LEITURAS = 1 << CALIBRACAO_BITS;
+constexpr double FUNDO_ESCALA = LEITURAS - 1;
+
+// MQ-135, curva de CO2 da folha de dados e resistor de carga de 10 kΩ
+constexpr double MQ135_A = 116.6020682;
+constexpr double MQ135_B = -2.769034857;
+constexpr double MQ135_RL = 10.0;
+constexpr double MQ135_R0 = 76.63;
+// Faixa útil do sensor (ppm), onde vale o erro relativo
+constexpr double MQ135_MIN = 10.0;
+constexpr double MQ135_MAX = 1000.0;
+
+int falhas = 0;
+
+double mq135(double x, double temp, double umid, bool compensar)
+{
+    double u = std::min(std::max(x / FUNDO_ESCALA, 0.5 / FUNDO_ESCALA), 1.0 - 0.5 / FUNDO_ESCALA);
+    double rs = MQ135_RL * (1.0 - u) / u;
+    double fator = compensar ? 0.00035 * temp * temp - 0.02718 * temp + 1.39538 - 0.0018 * (umid - 33.0) : 1.0;
+    return MQ135_A * std::pow(rs / (MQ135_R0 * fator), MQ135_B);
+}
+
+// Erro absoluto máximo (e relativo, onde a referência está em [rel_min, rel_max])
+struct Erro
+{
+    double absoluto = 0, relativo = 0;
+    int pior = 0;
+};
+
+Erro medir(const calibracao_tabela_t &t, const std::function<double(double)> &referencia, double rel_min = 0,
+           double rel_max = 0)
+{
+    Erro e;
+    for (int x = 0; x < LEITURAS; x++)
+    {
+        double ref = referencia(x);
+        double obtido = q16_para_float(calibracao_aplicar(&t, (uint16_t)x));
+        if (ref >= CALIBRACAO_LIMITE)
+            continue; // saturação
+        double erro = std::fabs(obtido - ref);
+        if (rel_max > 0)
+        {
+            if (ref < rel_min || ref > rel_max)
+                continue;
+            erro /= ref;
+        }
+        if (erro > e.absoluto)
+        {
+            e.absoluto = erro;
+            e.pior = x;
+        }
+    }
+    if (rel_max > 0)
+        std::swap(e.absoluto, e.relativo);
+    return e;
+}
+
+void relatar(const char *caso, const Erro &e, double tolerancia)
+{
+    bool ok = (e.relativo > 0 ? e.relativo : e.absoluto) <= tolerancia;
+    if (e.relativo > 0)
+        printf("{\"caso\":\"%s\",\"erro_rel_max\":%.5f,\"leitura\":%d,\"tolerancia\":%g,\"ok\":%s}\n", caso,
+               e.relativo, e.pior, tolerancia, ok ? "true" : "false");
+    else
+        printf("{\"caso\":\"%s\",\"erro_abs_max\":%.6f,\"leitura\":%d,\"tolerancia\":%g,\"ok\":%s}\n", caso,
+               e.absoluto, e.pior, tolerancia, ok ? "true" : "false");
+    if (!ok)
+        falhas++;
+}
+
+bool compilar(calibracao_tabela_t &t, const calibracao_curva_t &c, const char *caso)
+{
+    if (calibracao_compilar(&t, &c))
+        return true;
+    printf("{\"caso\":\"%s\",\"erro\":\"curva recusada\",\"ok\":false}\n", caso);
+    falhas++;
+    return false;
+}
+
+void conferir(bool condicao, const char *caso)
+{
+    printf("{\"caso\":\"%s\",\"ok\":%s}\n", caso, condicao ? "true" : "false");
+    if (!condicao)
+        falhas++;
+}
+
+} // namespace
+
+int main()
+{
+    calibracao_tabela_t t;
+
+    // Retas: só o arredondamento do Q16
+    calibracao_curva_t temp = {};
+    temp.tipo = CURVA_LINEAR;
+    temp.coef[0] = -6.0f;
+    temp.coef[1] = 51.0f;
+    if (compilar(t, temp, "linear_temp"))
+        relatar("linear_temp", medir(t, [](double x) { return -6.0 + 51.0 * x / FUNDO_ESCALA; }), 1e-3);
+
+    calibracao_curva_t poli = {};
+    poli.tipo = CURVA_POLINOMIO;
+    const double p[4] = {80.0, -150.0, 120.0, -45.0};
+    for (int i = 0; i < 4; i++)
+        poli.coef[i] = (float)p[i];
+    if (compilar(t, poli, "polinomio"))
+        relatar("polinomio",
+                medir(t,
+                      [&](double x)
+                      {
+                          double u = x / FUNDO_ESCALA;
+                          return p[0] + u * (p[1] + u * (p[2] + u * p[3]));
+                      }),
+                2e-3);
+
+    // Pontos de um piezo com condicionador de pico, extrapolando nas pontas; o
+    // canto entre dois trechos que cai no meio de um trecho da tabela fica
+    // arredondado em até 1/4 de trecho vezes a mudança de inclinação
+    const double px[] = {200, 800, 1800, 3000, 3900}, py[] = {2, 10, 30, 65, 100};
+    calibracao_curva_t piezo = {};
+    for (int i = 4; i >= 0; i--) // fora de ordem de propósito
+        calibracao_adicionar_ponto(&piezo, (float)px[i], (float)py[i]);
+    conferir(piezo.tipo == CURVA_PONTOS && piezo.n_pontos == 5, "pontos_ordenados");
+    calibracao_adicionar_ponto(&piezo, (float)px[2] + 5, (float)py[2]); // mesma leitura: substitui
+    calibracao_adicionar_ponto(&piezo, (float)px[2], (float)py[2]);
+    conferir(piezo.n_pontos == 5, "pontos_substituidos");
+    if (compilar(t, piezo, "pontos_piezo"))
+        relatar("pontos_piezo",
+                medir(t,
+                      [&](double x)
+                      {
+                          int i = 0;
+                          while (i + 2 < 5 && x > px[i + 1])
+                              i++;
+                          return py[i] + (py[i + 1] - py[i]) * (x - px[i]) / (px[i + 1] - px[i]);
+                      }),
+                0.05);
+
+    calibracao_curva_t invalida = {};
+    invalida.tipo = CURVA_PONTOS;
+    invalida.n_pontos = 1;
+    conferir(!calibracao_compilar(&t, &invalida), "recusa_um_ponto");
+    invalida.tipo = CURVA_POTENCIA;
+    conferir(!calibracao_compilar(&t, &invalida), "recusa_potencia_sem_r0");
+
+    // MQ-135: erro relativo na faixa útil, sem e com a correção de T/H
+    calibracao_curva_t mq = {};
+    mq.tipo = CURVA_POTENCIA;
+    mq.coef[0] = (float)MQ135_A;
+    mq.coef[1] = (float)MQ135_B;
+    mq.coef[2] = (float)MQ135_RL;
+    mq.coef[3] = (float)MQ135_R0;
+    if (compilar(t, mq, "mq135"))
+        relatar("mq135", medir(t, [](double x) { return mq135(x, 0, 0, false); }, MQ135_MIN, MQ135_MAX), 0.005);
+
+    mq.compensar = 1;
+    if (compilar(t, mq, "mq135_th"))
+    {
+        Erro pior;
+        for (int temp_c = -10; temp_c <= 45; temp_c += 5)
+            for (int umid = 20; umid <= 100; umid += 20)
+            {
+                calibracao_ambiente(&t, Q16(temp_c), Q16(umid));
+                Erro e = medir(t, [&](double x) { return mq135(x, temp_c, umid, true); }, MQ135_MIN, MQ135_MAX);
+                if (e.relativo > pior.relativo)
+                    pior = e;
+            }
+        relatar("mq135_th", pior, 0.015);
+    }
+
+    // R0 em ar limpo (400 ppm) a 25 °C e 60 %: a leitura volta a dar 400
+    calibracao_ambiente(&t, Q16(25), Q16(60));
+    const uint16_t leitura_ar = 1000;
+    bool ajustado = calibracao_ajustar_r0(&mq, &t, leitura_ar, 400.0f) && calibracao_compilar(&t, &mq);
+    calibracao_ambiente(&t, Q16(25), Q16(60));
+    double ppm = q16_para_float(calibracao_aplicar(&t, leitura_ar));
+    printf("{\"caso\":\"ajuste_r0\",\"r0\":%.3f,\"ppm\":%.2f,\"ok\":%s}\n", mq.coef[3], ppm,
+           ajustado && std::fabs(ppm - 400.0) < 4.0 ? "true" : "false");
+    if (!ajustado || std::fabs(ppm - 400.0) >= 4.0)
+        falhas++;
+
+    printf("{\"falhas\":%d}\n", falhas);
+    return falhas ? 1 : 0;
+}
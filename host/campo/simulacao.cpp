@@ -0,0 +1,271 @@
+// Simulação do barramento de campo (inc/campo.c) com o núcleo do firmware:
+// um mestre e N nós em threads, ligados por pipes como um RS-485 multiponto.
+// Cada consulta do mestre vai para todos os nós e as respostas voltam por um
+// pipe comum. Com baud, cada quadro espera o tempo que levaria no fio antes
+// de ser entregue; com erro, um byte de cada quadro é trocado com essa
+// probabilidade, nos dois sentidos. Os últimos "ausentes" endereços não têm
+// nó, para exercitar as janelas expiradas.
+//
+//   beesense_campo [nos=64] [segundos=5] [baud=460800] [taxa_hz=10] [erro=0] [ausentes=0]
+//
+// Cada nó numera as amostras que gera; o mestre confere a sequência de cada
+// nó, e as lacunas precisam bater com as descartadas pela fila do nó. Sai em
+// stdout um resumo JSON com vazão e latência das consultas; status 1 se
+// alguma amostra se perder ou duplicar no caminho.
+
+#include "../gateway/metricas.hpp"
+
+extern "C"
+{
+#include "campo.h"
+}
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr uint32_t FOLGA_US = 2000; // acordar uma thread não é virar um transceptor
+constexpr uint32_t JANELA_SEM_BAUD_US = 20000;
+
+struct Parametros
+{
+    int nos = 64;
+    double segundos = 5;
+    uint32_t baud = 460800;
+    double taxa_hz = 10;
+    double erro = 0;
+    int ausentes = 0;
+};
+
+Parametros parametros;
+
+// Tempo do quadro no fio e, às vezes, um byte trocado
+void enviar(int fd, uint8_t *quadro, size_t n, std::mt19937 &aleatorio)
+{
+    if (parametros.baud)
+        std::this_thread::sleep_for(std::chrono::microseconds(n * 10 * 1000000 / parametros.baud));
+    if (parametros.erro > 0 && std::uniform_real_distribution<>(0, 1)(aleatorio) < parametros.erro)
+        quadro[std::uniform_int_distribution<size_t>(0, n - 1)(aleatorio)] ^= 0x5A;
+    (void)!write(fd, quadro, n); // até PIPE_BUF a escrita é atômica: quadros não se misturam
+}
+
+struct No
+{
+    campo_no_t no;
+    int entrada[2];
+    uint32_t geradas = 0;
+    std::thread thread;
+};
+
+void rodar_no(No *n, int saida, unsigned semente)
+{
+    std::mt19937 aleatorio(semente);
+    int64_t periodo_ns = (int64_t)(1e9 / parametros.taxa_hz);
+    int64_t proxima = agora_ns();
+    uint8_t buffer[512], resposta[CAMPO_QUADRO_MAX];
+    while (true)
+    {
+        int64_t agora = agora_ns();
+        for (; proxima <= agora; proxima += periodo_ns)
+        {
+            campo_amostra_t a = {};
+            a.tempo_ms = n->geradas++; // número de sequência, para o mestre conferir
+            a.temp = 3450;
+            a.umid = 6000;
+            campo_no_guardar(&n->no, &a);
+        }
+        pollfd p = {n->entrada[0], POLLIN, 0};
+        int espera_ms = (int)((proxima - agora) / 1000000) + 1;
+        if (poll(&p, 1, espera_ms) <= 0)
+            continue;
+        ssize_t lidos = read(n->entrada[0], buffer, sizeof buffer);
+        if (lidos <= 0)
+            return; // mestre fechou o barramento
+        for (ssize_t i = 0; i < lidos; i++)
+        {
+            size_t tamanho = campo_no_byte(&n->no, buffer[i], resposta);
+            if (tamanho)
+                enviar(saida, resposta, tamanho, aleatorio);
+        }
+    }
+}
+
+// Conferência da sequência de amostras de cada nó
+struct Conferencia
+{
+    std::vector<uint32_t> esperado;
+    uint64_t lacunas = 0, fora_de_ordem = 0, entregues = 0;
+};
+
+void entregar(void *contexto, uint8_t endereco, const campo_amostra_t *amostras, size_t n)
+{
+    auto *c = static_cast<Conferencia *>(contexto);
+    uint32_t &esperado = c->esperado[endereco - 1];
+    for (size_t i = 0; i < n; i++)
+    {
+        uint32_t seq = amostras[i].tempo_ms;
+        if (seq < esperado)
+            c->fora_de_ordem++;
+        else
+        {
+            c->lacunas += seq - esperado;
+            esperado = seq + 1;
+        }
+        c->entregues++;
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+        parametros.nos = atoi(argv[1]);
+    if (argc > 2)
+        parametros.segundos = atof(argv[2]);
+    if (argc > 3)
+        parametros.baud = (uint32_t)atol(argv[3]);
+    if (argc > 4)
+        parametros.taxa_hz = atof(argv[4]);
+    if (argc > 5)
+        parametros.erro = atof(argv[5]);
+    if (argc > 6)
+        parametros.ausentes = atoi(argv[6]);
+    if (parametros.nos < 1 || parametros.nos > CAMPO_NOS_MAX || parametros.ausentes < 0 ||
+        parametros.ausentes >= parametros.nos || parametros.taxa_hz <= 0)
+    {
+        fprintf(stderr, "uso: %s [nos=64 (1-%d)] [segundos=5] [baud=460800, 0 sem tempo de fio] [taxa_hz=10] "
+                        "[erro=0] [ausentes=0]\n",
+                argv[0], CAMPO_NOS_MAX);
+        return 2;
+    }
+
+    int respostas[2];
+    if (pipe(respostas) != 0)
+    {
+        perror("pipe");
+        return 1;
+    }
+    int presentes = parametros.nos - parametros.ausentes;
+    std::vector<No> nos(presentes);
+    for (int i = 0; i < presentes; i++)
+    {
+        if (pipe(nos[i].entrada) != 0)
+        {
+            perror("pipe");
+            return 1;
+        }
+        campo_no_init(&nos[i].no, (uint8_t)(i + 1), (uint8_t)(i * 37));
+    }
+    for (int i = 0; i < presentes; i++)
+        nos[i].thread = std::thread(rodar_no, &nos[i], respostas[1], 1000u + i);
+
+    Conferencia conferencia;
+    conferencia.esperado.assign(parametros.nos, 0);
+    std::vector<uint8_t> enderecos(parametros.nos);
+    for (int i = 0; i < parametros.nos; i++)
+        enderecos[i] = (uint8_t)(i + 1);
+    uint32_t janela = parametros.baud ? campo_janela_us(parametros.baud, FOLGA_US) : JANELA_SEM_BAUD_US;
+    static campo_mestre_t mestre;
+    campo_mestre_init(&mestre, enderecos.data(), (uint8_t)parametros.nos, janela, 1, entregar, &conferencia);
+
+    // Mestre: consulta, espera a resposta ou o fim da janela, e segue
+    std::mt19937 aleatorio(7);
+    Histograma latencias;
+    uint8_t consulta[CAMPO_QUADRO_MAX], buffer[512];
+    int64_t inicio = agora_ns();
+    int64_t fim = inicio + (int64_t)(parametros.segundos * 1e9);
+    while (agora_ns() < fim)
+    {
+        int64_t enviado = agora_ns();
+        size_t n = campo_mestre_consultar(&mestre, enviado / 1000, consulta);
+        if (parametros.baud)
+            std::this_thread::sleep_for(std::chrono::microseconds(n * 10 * 1000000 / parametros.baud));
+        if (parametros.erro > 0 && std::uniform_real_distribution<>(0, 1)(aleatorio) < parametros.erro)
+            consulta[std::uniform_int_distribution<size_t>(0, n - 1)(aleatorio)] ^= 0x5A;
+        for (int i = 0; i < presentes; i++)
+            (void)!write(nos[i].entrada[1], consulta, n);
+
+        bool respondeu = false;
+        while (!respondeu)
+        {
+            int64_t agora = agora_ns();
+            int64_t restante_ns = (int64_t)campo_mestre_prazo(&mestre) * 1000 - agora;
+            if (restante_ns <= 0)
+                break;
+            pollfd p = {respostas[0], POLLIN, 0};
+            timespec espera = {(time_t)(restante_ns / 1000000000), (long)(restante_ns % 1000000000)};
+            if (ppoll(&p, 1, &espera, nullptr) <= 0)
+                continue;
+            ssize_t lidos = read(respostas[0], buffer, sizeof buffer);
+            agora = agora_ns();
+            for (ssize_t i = 0; i < lidos; i++)
+                if (campo_mestre_byte(&mestre, buffer[i], agora / 1000))
+                {
+                    respondeu = true;
+                    latencias.registrar(agora - enviado);
+                }
+        }
+        if (!respondeu)
+            campo_mestre_expirar(&mestre);
+    }
+    double decorrido = (agora_ns() - inicio) / 1e9;
+
+    for (auto &n : nos)
+        close(n.entrada[1]);
+    for (auto &n : nos)
+        n.thread.join();
+
+    // Totais do mestre e dos nós; o que foi gerado tem de ter sido entregue,
+    // descartado pela fila cheia ou ainda estar na fila. O último lote de um
+    // nó pode ter chegado ao mestre sem que a confirmação voltasse: está na
+    // fila e entregue ao mesmo tempo
+    campo_remoto_t total = {};
+    for (int i = 0; i < parametros.nos; i++)
+    {
+        const campo_remoto_t &r = mestre.remotos[i];
+        total.consultas += r.consultas;
+        total.respostas += r.respostas;
+        total.expiradas += r.expiradas;
+        total.retentativas += r.retentativas;
+        total.falhas += r.falhas;
+        total.duplicados += r.duplicados;
+    }
+    uint64_t geradas = 0, descartadas = 0, na_fila = 0, retransmissoes = 0;
+    for (int i = 0; i < presentes; i++)
+    {
+        const campo_no_t &n = nos[i].no;
+        geradas += nos[i].geradas;
+        descartadas += n.est.descartadas;
+        na_fila += n.quantidade;
+        if (n.n_pendente && mestre.recebeu[i] && mestre.ultimo_seq[i] == n.seq)
+            na_fila -= n.n_pendente;
+        retransmissoes += n.est.retransmissoes;
+    }
+    bool ok = conferencia.fora_de_ordem == 0 && conferencia.lacunas == descartadas &&
+              conferencia.entregues + descartadas + na_fila == geradas;
+
+    printf("{\"nos\":%d,\"presentes\":%d,\"baud\":%u,\"janela_us\":%u,\"segundos\":%.2f,\"ciclos\":%u,"
+           "\"ciclo_ms\":%.1f,\"consultas\":%u,\"consultas_s\":%.0f,\"respostas\":%u,\"expiradas\":%u,"
+           "\"retentativas\":%u,\"falhas\":%u,\"duplicados\":%u,\"retransmissoes\":%llu,\"erros_crc\":%u,"
+           "\"amostras\":%llu,\"amostras_s\":%.0f,\"latencia_us\":{\"p50\":%.0f,\"p99\":%.0f,\"max\":%.0f},"
+           "\"geradas\":%llu,\"descartadas\":%llu,\"na_fila\":%llu,\"lacunas\":%llu,\"fora_de_ordem\":%llu,"
+           "\"ok\":%s}\n",
+           parametros.nos, presentes, parametros.baud, janela, decorrido, mestre.ciclos,
+           mestre.ciclos ? decorrido * 1000 / mestre.ciclos : 0.0, total.consultas, total.consultas / decorrido,
+           total.respostas, total.expiradas, total.retentativas, total.falhas, total.duplicados,
+           (unsigned long long)retransmissoes, mestre.dec.erros_crc, (unsigned long long)conferencia.entregues,
+           conferencia.entregues / decorrido, latencias.percentil(0.5) / 1e3, latencias.percentil(0.99) / 1e3,
+           latencias.maximo() / 1e3, (unsigned long long)geradas, (unsigned long long)descartadas,
+           (unsigned long long)na_fila, (unsigned long long)conferencia.lacunas,
+           (unsigned long long)conferencia.fora_de_ordem, ok ? "true" : "false");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+// Exporta capturas brutas (.bsq, gravadas pelo gateway) para CSV: uma linha
+// por instante, com o tempo em ms relativo ao disparo e uma coluna por canal
+// do ADC. O quadro é validado (mágica, tamanho e CRC) com o mesmo código do
+// firmware; o resumo sai em stderr.
+
+extern "C"
+{
+#include "quadro.h"
+}
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "uso: %s captura.bsq [saida.csv]\n", argv[0]);
+        return 2;
+    }
+    std::ifstream entrada(argv[1], std::ios::binary);
+    if (!entrada)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    // uint32_t garante o alinhamento que quadro_validar espera
+    std::vector<char> bytes((std::istreambuf_iterator<char>(entrada)), std::istreambuf_iterator<char>());
+    std::vector<uint32_t> quadro((bytes.size() + 3) / 4);
+    memcpy(quadro.data(), bytes.data(), bytes.size());
+
+    const quadro_cabecalho_t *cab;
+    const uint8_t *carga;
+    captura_meta_t meta;
+    if (!quadro_validar(quadro.data(), bytes.size(), &cab, &carga) || cab->tipo != QUADRO_CAPTURA ||
+        cab->bytes < sizeof meta)
+    {
+        fprintf(stderr, "%s: quadro invalido\n", argv[1]);
+        return 1;
+    }
+    memcpy(&meta, carga, sizeof meta);
+    if (meta.taxa_hz == 0 || meta.n_canais == 0 ||
+        cab->bytes != sizeof meta + (size_t)meta.quadros * meta.n_canais * sizeof(uint16_t))
+    {
+        fprintf(stderr, "%s: metadados inconsistentes\n", argv[1]);
+        return 1;
+    }
+
+    FILE *saida = stdout;
+    if (argc > 2 && !(saida = fopen(argv[2], "w")))
+    {
+        perror(argv[2]);
+        return 1;
+    }
+    int canais[8], n = 0;
+    for (int i = 0; i < 8; i++)
+        if (meta.canais & (1u << i))
+            canais[n++] = i;
+    if (n != meta.n_canais)
+    {
+        fprintf(stderr, "%s: mascara de canais nao bate com n_canais\n", argv[1]);
+        return 1;
+    }
+
+    fprintf(saida, "t_ms");
+    for (int i = 0; i < n; i++)
+        fprintf(saida, ",adc%d", canais[i]);
+    fprintf(saida, "\n");
+    const uint8_t *p = carga + sizeof meta;
+    for (uint32_t q = 0; q < meta.quadros; q++)
+    {
+        fprintf(saida, "%.4f", ((double)q - meta.disparo) * 1000.0 / meta.taxa_hz);
+        for (int i = 0; i < n; i++, p += sizeof(uint16_t))
+        {
+            uint16_t v;
+            memcpy(&v, p, sizeof v);
+            fprintf(saida, ",%u", v);
+        }
+        fprintf(saida, "\n");
+    }
+    if (saida != stdout)
+        fclose(saida);
+
+    fprintf(stderr,
+            "{\"seq\":%u,\"taxa\":%u,\"quadros\":%u,\"disparo\":%u,\"inicio_ms\":%u,\"canais\":%u,\"motivo\":\"%s\"}\n",
+            cab->sequencia, meta.taxa_hz, meta.quadros, meta.disparo, meta.inicio_ms, meta.canais,
+            meta.motivo == CAPTURA_ANOMALIA ? "anomalia" : "comando");
+    return 0;
+}
@@ -0,0 +1,459 @@
+// Ferramenta do classificador de estado da colônia:
+//
+//   beesense_modelo treinar <modelo.bin> [arquivo.c]
+//     Treina em float uma MLP pequena (8 -> 16 -> 12 -> 5) sobre dados
+//     sintéticos de cada classe, quantiza para int8 (pesos simétricos por
+//     camada, escalas das ativações calibradas no conjunto de treino) e grava
+//     o blob; com arquivo.c, gera também o inc/modelo_dados.c do firmware.
+//
+//   beesense_modelo verificar <modelo.bin> [casos]
+//     Roda o motor do firmware (inc/classificador.c) e a referência em C++
+//     sobre entradas aleatórias, no modelo dado e em modelos aleatórios com
+//     convoluções 1-D, e exige saídas idênticas bit a bit. Confere também que
+//     blobs corrompidos são recusados. Sai com status 1 em qualquer diferença.
+
+#include "referencia.hpp"
+
+extern "C"
+{
+#include "classificador.h"
+}
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using referencia::Camada;
+using referencia::Modelo;
+
+constexpr int ENTRADAS = NUM_CARACTERISTICAS;
+constexpr int CLASSES = NUM_CLASSES_COLONIA;
+
+// ---------------------------------------------------------------------------
+// Dados sintéticos: média e desvio de cada característica por classe
+
+struct Perfil
+{
+    double media[ENTRADAS];
+    double desvio[ENTRADAS];
+};
+
+// temp, umid, peso/dia, voc, vibra, z_temp, z_peso, z_vibra
+const Perfil PERFIS[CLASSES] = {
+    {{34.5, 60, 0.10, 2.0, 30, 0.0, 0.0, 0.0}, {0.7, 5, 0.15, 0.8, 8, 0.7, 0.7, 0.7}},   // saudável
+    {{33.0, 62, -0.05, 1.5, 20, 0.0, 0.0, -0.5}, {1.2, 6, 0.10, 0.6, 6, 0.8, 0.6, 0.7}}, // com rainha
+    {{32.0, 65, -0.10, 2.5, 55, 2.0, 0.0, 1.5}, {2.5, 8, 0.15, 1.0, 10, 1.0, 0.8, 1.0}}, // órfã
+    {{36.0, 58, -1.50, 3.0, 75, 1.0, -3.0, 3.0}, {1.0, 6, 0.50, 1.0, 10, 1.0, 1.0, 1.0}},// enxameando
+    {{34.0, 60, -0.80, 6.0, 60, 0.0, -2.0, 1.5}, {1.0, 6, 0.30, 1.5, 10, 0.8, 0.8, 1.0}},// pilhagem
+};
+
+struct Exemplo
+{
+    double x[ENTRADAS];
+    int classe;
+};
+
+std::vector<Exemplo> gerar(int por_classe, std::mt19937 &rng)
+{
+    std::vector<Exemplo> dados;
+    std::normal_distribution<double> normal(0, 1);
+    for (int c = 0; c < CLASSES; c++)
+        for (int n = 0; n < por_classe; n++)
+        {
+            Exemplo e;
+            e.classe = c;
+            for (int i = 0; i < ENTRADAS; i++)
+                e.x[i] = PERFIS[c].media[i] + PERFIS[c].desvio[i] * normal(rng);
+            dados.push_back(e);
+        }
+    std::shuffle(dados.begin(), dados.end(), rng);
+    return dados;
+}
+
+// ---------------------------------------------------------------------------
+// MLP em float
+
+struct Densa
+{
+    int entradas, saidas;
+    bool relu;
+    std::vector<double> w, b; // w [o][i]
+};
+
+struct Rede
+{
+    std::vector<Densa> camadas;
+    double media[ENTRADAS], desvio[ENTRADAS];
+
+    // Ativações de todas as camadas (a primeira é a entrada padronizada)
+    std::vector<std::vector<double>> avancar(const double *x) const
+    {
+        std::vector<std::vector<double>> a(1, std::vector<double>(ENTRADAS));
+        for (int i = 0; i < ENTRADAS; i++)
+            a[0][i] = (x[i] - media[i]) / desvio[i];
+        for (const Densa &c : camadas)
+        {
+            std::vector<double> y(c.saidas);
+            for (int o = 0; o < c.saidas; o++)
+            {
+                double s = c.b[o];
+                for (int i = 0; i < c.entradas; i++)
+                    s += c.w[o * c.entradas + i] * a.back()[i];
+                y[o] = c.relu ? std::max(0.0, s) : s;
+            }
+            a.push_back(std::move(y));
+        }
+        return a;
+    }
+};
+
+Rede treinar(const std::vector<Exemplo> &dados, std::mt19937 &rng)
+{
+    Rede r;
+    for (int i = 0; i < ENTRADAS; i++)
+    {
+        double s = 0, s2 = 0;
+        for (const Exemplo &e : dados)
+        {
+            s += e.x[i];
+            s2 += e.x[i] * e.x[i];
+        }
+        r.media[i] = s / dados.size();
+        r.desvio[i] = std::sqrt(std::max(1e-9, s2 / dados.size() - r.media[i] * r.media[i]));
+    }
+
+    const int tamanhos[] = {ENTRADAS, 16, 12, CLASSES};
+    for (int l = 0; l < 3; l++)
+    {
+        Densa c{tamanhos[l], tamanhos[l + 1], l < 2, {}, {}};
+        std::normal_distribution<double> init(0, std::sqrt(2.0 / c.entradas));
+        for (int k = 0; k < c.entradas * c.saidas; k++)
+            c.w.push_back(init(rng));
+        c.b.assign(c.saidas, 0);
+        r.camadas.push_back(c);
+    }
+
+    // SGD com entropia cruzada sobre o softmax
+    double taxa = 0.05;
+    for (int epoca = 0; epoca < 40; epoca++, taxa *= 0.95)
+        for (const Exemplo &e : dados)
+        {
+            auto a = r.avancar(e.x);
+            std::vector<double> delta = a.back();
+            double maximo = *std::max_element(delta.begin(), delta.end()), soma = 0;
+            for (double &d : delta)
+                soma += d = std::exp(d - maximo);
+            for (double &d : delta)
+                d /= soma;
+            delta[e.classe] -= 1;
+
+            for (int l = (int)r.camadas.size() - 1; l >= 0; l--)
+            {
+                Densa &c = r.camadas[l];
+                std::vector<double> anterior(c.entradas, 0);
+                for (int o = 0; o < c.saidas; o++)
+                {
+                    for (int i = 0; i < c.entradas; i++)
+                    {
+                        anterior[i] += c.w[o * c.entradas + i] * delta[o];
+                        c.w[o * c.entradas + i] -= taxa * delta[o] * a[l][i];
+                    }
+                    c.b[o] -= taxa * delta[o];
+                }
+                if (l > 0)
+                    for (int i = 0; i < c.entradas; i++)
+                        if (a[l][i] <= 0)
+                            anterior[i] = 0;
+                delta.swap(anterior);
+            }
+        }
+    return r;
+}
+
+int argmax(const std::vector<double> &v)
+{
+    return (int)(std::max_element(v.begin(), v.end()) - v.begin());
+}
+
+int32_t q16(double v)
+{
+    return (int32_t)std::llround(v * 65536.0);
+}
+
+// ---------------------------------------------------------------------------
+// Quantização
+
+// A entrada padronizada z vira int8 como z * 127 / FAIXA_Z (±FAIXA_Z desvios)
+constexpr double FAIXA_Z = 4.0;
+
+Modelo quantizar(const Rede &r, const std::vector<Exemplo> &calibracao)
+{
+    Modelo m;
+    double escala_x = FAIXA_Z / 127.0; // valor real de uma unidade int8 na entrada
+    for (int i = 0; i < ENTRADAS; i++)
+    {
+        m.centro.push_back(q16(r.media[i]));
+        m.ganho.push_back(q16(1.0 / (r.desvio[i] * escala_x)));
+    }
+
+    // Escala de cada camada: maior ativação vista na calibração
+    std::vector<double> maximo(r.camadas.size(), 1e-6);
+    for (const Exemplo &e : calibracao)
+    {
+        auto a = r.avancar(e.x);
+        for (size_t l = 0; l < r.camadas.size(); l++)
+            for (double v : a[l + 1])
+                maximo[l] = std::max(maximo[l], std::fabs(v));
+    }
+
+    for (size_t l = 0; l < r.camadas.size(); l++)
+    {
+        const Densa &d = r.camadas[l];
+        double maior_w = 1e-9;
+        for (double w : d.w)
+            maior_w = std::max(maior_w, std::fabs(w));
+        double escala_w = maior_w / 127.0;
+        double escala_y = maximo[l] / 127.0;
+
+        Camada c;
+        c.tipo = referencia::DENSA;
+        c.relu = d.relu;
+        c.entradas = d.entradas;
+        c.saidas = d.saidas;
+        for (double w : d.w)
+            c.pesos.push_back((int8_t)std::lround(w / escala_w));
+        for (double b : d.b)
+            c.bias.push_back((int32_t)std::llround(b / (escala_w * escala_x)));
+        referencia::quantizar_escala(escala_w * escala_x / escala_y, c.multiplicador, c.deslocamento);
+        m.camadas.push_back(c);
+        escala_x = escala_y;
+    }
+    return m;
+}
+
+std::vector<int32_t> entradas_q16(const double *x)
+{
+    std::vector<int32_t> v(ENTRADAS);
+    for (int i = 0; i < ENTRADAS; i++)
+        v[i] = q16(x[i]);
+    return v;
+}
+
+bool gravar_arquivo(const std::string &caminho, const std::vector<uint8_t> &blob)
+{
+    std::ofstream f(caminho, std::ios::binary);
+    f.write((const char *)blob.data(), blob.size());
+    return (bool)f;
+}
+
+bool gravar_c(const std::string &caminho, const std::vector<uint8_t> &blob)
+{
+    FILE *f = fopen(caminho.c_str(), "w");
+    if (!f)
+        return false;
+    fprintf(f, "// Gerado por host/classificador (beesense_modelo treinar) -- não edite à mão.\n\n");
+    fprintf(f, "#include \"classificador.h\"\n\n");
+    fprintf(f, "const uint8_t modelo_colonia[] __attribute__((aligned(4))) = {\n");
+    for (size_t i = 0; i < blob.size(); i++)
+        fprintf(f, "%s0x%02X,%s", i % 16 ? " " : "    ", blob[i], i % 16 == 15 || i + 1 == blob.size() ? "\n" : "");
+    fprintf(f, "};\n\nconst size_t modelo_colonia_bytes = sizeof(modelo_colonia);\n");
+    return fclose(f) == 0;
+}
+
+int comando_treinar(int argc, char **argv)
+{
+    std::mt19937 rng(2024);
+    auto treino = gerar(2000, rng);
+    auto teste = gerar(500, rng);
+    Rede r = treinar(treino, rng);
+    Modelo m = quantizar(r, treino);
+    std::vector<uint8_t> blob = referencia::serializar(m);
+
+    int acertos_float = 0, acertos_int8 = 0;
+    std::vector<int> confusao(CLASSES * CLASSES, 0);
+    for (const Exemplo &e : teste)
+    {
+        acertos_float += argmax(r.avancar(e.x).back()) == e.classe;
+        auto y = referencia::executar(m, entradas_q16(e.x));
+        int c = (int)(std::max_element(y.begin(), y.end()) - y.begin());
+        acertos_int8 += c == e.classe;
+        confusao[e.classe * CLASSES + c]++;
+    }
+
+    classificador_t c;
+    bool carregou = classificador_carregar(&c, blob.data(), blob.size());
+    printf("{\"bytes\":%zu,\"macs\":%u,\"carregou\":%s,\"acerto_float\":%.4f,\"acerto_int8\":%.4f,\"confusao\":[",
+           blob.size(), c.macs, carregou ? "true" : "false", (double)acertos_float / teste.size(),
+           (double)acertos_int8 / teste.size());
+    for (int i = 0; i < CLASSES; i++)
+    {
+        printf(i ? ",[" : "[");
+        for (int j = 0; j < CLASSES; j++)
+            printf(j ? ",%d" : "%d", confusao[i * CLASSES + j]);
+        printf("]");
+    }
+    printf("]}\n");
+
+    if (!carregou || !gravar_arquivo(argv[2], blob) || (argc > 3 && !gravar_c(argv[3], blob)))
+    {
+        fprintf(stderr, "falha ao validar ou gravar o modelo\n");
+        return 1;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Verificação bit a bit
+
+Modelo modelo_aleatorio(std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int> peso(-128, 127), bias(-4000, 4000), desl(38, 44);
+    std::uniform_int_distribution<int32_t> mult(1 << 30, INT32_MAX);
+    auto faixa = [&rng](int a, int b) { return std::uniform_int_distribution<int>(a, b)(rng); };
+
+    Modelo m;
+    int canais = faixa(1, 4), comprimento = faixa(8, 32);
+    for (int i = 0; i < canais * comprimento; i++)
+    {
+        m.centro.push_back(faixa(-100000, 100000));
+        m.ganho.push_back(faixa(-(1 << 22), 1 << 22));
+    }
+
+    auto completar = [&](Camada &c) {
+        c.multiplicador = mult(rng);
+        c.deslocamento = desl(rng);
+        c.bias.resize(c.saidas);
+        for (auto &b : c.bias)
+            b = bias(rng);
+        c.pesos.resize((size_t)c.saidas * c.entradas * (c.tipo == referencia::CONV1D ? c.kernel : 1));
+        for (auto &w : c.pesos)
+            w = (int8_t)peso(rng);
+    };
+
+    // Uma ou duas convoluções sobre a série, depois densas até as classes
+    for (int n = faixa(1, 2); n > 0 && comprimento >= 3; n--)
+    {
+        Camada c;
+        c.tipo = referencia::CONV1D;
+        c.relu = faixa(0, 1);
+        c.kernel = faixa(1, std::min(5, comprimento));
+        c.passo = faixa(1, 2);
+        c.entradas = canais;
+        c.comprimento = comprimento;
+        c.saidas = faixa(1, 6);
+        completar(c);
+        if (c.tamanho_saida() > CLASSIFICADOR_MAX_ATIVACOES)
+            break;
+        m.camadas.push_back(c);
+        canais = c.saidas;
+        comprimento = c.comprimento_saida();
+    }
+    int entradas = canais * comprimento;
+    for (int n = faixa(1, 2); n >= 0; n--)
+    {
+        Camada c;
+        c.relu = n > 0;
+        c.entradas = entradas;
+        c.saidas = n > 0 ? faixa(4, 24) : CLASSES;
+        completar(c);
+        m.camadas.push_back(c);
+        entradas = c.saidas;
+    }
+    return m;
+}
+
+// Compara firmware e referência; devolve o número de diferenças
+int comparar(const Modelo &m, const std::vector<uint8_t> &blob, int casos, std::mt19937 &rng, uint32_t *macs)
+{
+    classificador_t c;
+    if (!classificador_carregar(&c, blob.data(), blob.size()))
+    {
+        fprintf(stderr, "firmware recusou um blob válido\n");
+        return 1;
+    }
+    *macs = c.macs;
+
+    std::uniform_int_distribution<int32_t> q16_aleatorio(-(50 << 16), 50 << 16);
+    int diferencas = 0;
+    std::vector<int8_t> saidas(m.n_saidas());
+    for (int k = 0; k < casos; k++)
+    {
+        std::vector<int32_t> x(m.n_entradas());
+        for (auto &v : x)
+            v = q16_aleatorio(rng);
+        uint8_t classe = classificador_executar(&c, x.data(), saidas.data());
+        auto esperado = referencia::executar(m, x);
+        uint8_t classe_ref = (uint8_t)(std::max_element(esperado.begin(), esperado.end()) - esperado.begin());
+        if (saidas != esperado || classe != classe_ref)
+            diferencas++;
+    }
+    return diferencas;
+}
+
+int comando_verificar(int argc, char **argv)
+{
+    std::ifstream f(argv[2], std::ios::binary);
+    std::vector<uint8_t> blob((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    int casos = argc > 3 ? atoi(argv[3]) : 10000;
+    std::mt19937 rng(7);
+
+    Modelo m;
+    if (!referencia::ler(blob.data(), blob.size(), m))
+    {
+        fprintf(stderr, "%s: blob inválido\n", argv[2]);
+        return 1;
+    }
+    uint32_t macs;
+    int diferencas = comparar(m, blob, casos, rng, &macs);
+
+    // Modelos aleatórios com convolução, ida e volta pelo blob
+    int aleatorios = 200, diferencas_aleatorios = 0;
+    uint64_t casos_aleatorios = 0;
+    for (int i = 0; i < aleatorios; i++)
+    {
+        Modelo a = modelo_aleatorio(rng);
+        std::vector<uint8_t> b = referencia::serializar(a);
+        uint32_t macs_a;
+        diferencas_aleatorios += comparar(a, b, casos / 20 + 1, rng, &macs_a);
+        casos_aleatorios += casos / 20 + 1;
+    }
+
+    // Blob corrompido: cada byte alterado precisa ser recusado
+    int aceitos_corrompidos = 0;
+    for (size_t i = 0; i < blob.size(); i++)
+    {
+        std::vector<uint8_t> ruim = blob;
+        ruim[i] ^= 0x5A;
+        classificador_t c;
+        aceitos_corrompidos += classificador_carregar(&c, ruim.data(), ruim.size());
+    }
+
+    printf("{\"casos\":%d,\"macs\":%u,\"diferencas\":%d,\"modelos_aleatorios\":%d,\"casos_aleatorios\":%llu,"
+           "\"diferencas_aleatorios\":%d,\"corrompidos_aceitos\":%d}\n",
+           casos, macs, diferencas, aleatorios, (unsigned long long)casos_aleatorios, diferencas_aleatorios,
+           aceitos_corrompidos);
+    return diferencas || diferencas_aleatorios || aceitos_corrompidos ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc >= 3 && !strcmp(argv[1], "treinar"))
+        return comando_treinar(argc, argv);
+    if (argc >= 3 && !strcmp(argv[1], "verificar"))
+        return comando_verificar(argc, argv);
+    fprintf(stderr, "uso: %s treinar <modelo.bin> [modelo_dados.c]\n"
+                    "     %s verificar <modelo.bin> [casos]\n",
+            argv[0], argv[0]);
+    return 2;
+}
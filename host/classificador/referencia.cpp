@@ -0,0 +1,189 @@
+#include "referencia.hpp"
+
+extern "C"
+{
+#include "crc32.h"
+}
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace referencia
+{
+
+namespace
+{
+
+constexpr uint32_t MAGICA = 0x4C4D5342; // "BSML"
+constexpr uint16_t VERSAO = 1;
+constexpr size_t CABECALHO = 20;
+constexpr size_t CAMADA = 16;
+
+template <typename T>
+void colocar(std::vector<uint8_t> &b, T v)
+{
+    uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &v, sizeof(T));
+    b.insert(b.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T tirar(const uint8_t *p)
+{
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+int8_t sat8(int64_t v)
+{
+    return (int8_t)std::min<int64_t>(127, std::max<int64_t>(-128, v));
+}
+
+} // namespace
+
+std::vector<uint8_t> serializar(const Modelo &modelo)
+{
+    std::vector<uint8_t> corpo;
+    for (int32_t c : modelo.centro)
+        colocar(corpo, c);
+    for (int32_t g : modelo.ganho)
+        colocar(corpo, g);
+    for (const Camada &c : modelo.camadas)
+    {
+        size_t inicio = corpo.size();
+        colocar<uint8_t>(corpo, c.tipo);
+        colocar<uint8_t>(corpo, c.relu);
+        colocar<uint8_t>(corpo, (uint8_t)c.kernel);
+        colocar<uint8_t>(corpo, (uint8_t)c.passo);
+        colocar<uint16_t>(corpo, (uint16_t)c.entradas);
+        colocar<uint16_t>(corpo, (uint16_t)c.saidas);
+        colocar<uint16_t>(corpo, (uint16_t)c.comprimento);
+        colocar<uint8_t>(corpo, (uint8_t)c.deslocamento);
+        colocar<uint8_t>(corpo, 0);
+        colocar<int32_t>(corpo, c.multiplicador);
+        for (int32_t b : c.bias)
+            colocar(corpo, b);
+        for (int8_t w : c.pesos)
+            colocar(corpo, w);
+        while ((corpo.size() - inicio) % 4)
+            corpo.push_back(0);
+    }
+
+    std::vector<uint8_t> blob;
+    colocar<uint32_t>(blob, MAGICA);
+    colocar<uint16_t>(blob, VERSAO);
+    colocar<uint8_t>(blob, (uint8_t)modelo.n_entradas());
+    colocar<uint8_t>(blob, (uint8_t)modelo.n_saidas());
+    colocar<uint8_t>(blob, (uint8_t)modelo.camadas.size());
+    blob.insert(blob.end(), 3, 0);
+    colocar<uint32_t>(blob, (uint32_t)(CABECALHO + corpo.size()));
+    colocar<uint32_t>(blob, crc32_calcular(corpo.data(), corpo.size()));
+    blob.insert(blob.end(), corpo.begin(), corpo.end());
+    return blob;
+}
+
+bool ler(const uint8_t *blob, size_t bytes, Modelo &modelo)
+{
+    if (bytes < CABECALHO || tirar<uint32_t>(blob) != MAGICA || tirar<uint16_t>(blob + 4) != VERSAO ||
+        tirar<uint32_t>(blob + 12) != bytes ||
+        tirar<uint32_t>(blob + 16) != crc32_calcular(blob + CABECALHO, bytes - CABECALHO))
+        return false;
+    int n_entradas = blob[6], n_camadas = blob[8];
+
+    modelo = Modelo();
+    size_t pos = CABECALHO;
+    if (pos + 8 * n_entradas > bytes)
+        return false;
+    for (int i = 0; i < n_entradas; i++)
+        modelo.centro.push_back(tirar<int32_t>(blob + pos + 4 * i));
+    pos += 4 * n_entradas;
+    for (int i = 0; i < n_entradas; i++)
+        modelo.ganho.push_back(tirar<int32_t>(blob + pos + 4 * i));
+    pos += 4 * n_entradas;
+
+    for (int l = 0; l < n_camadas; l++)
+    {
+        if (pos + CAMADA > bytes)
+            return false;
+        const uint8_t *p = blob + pos;
+        Camada c;
+        c.tipo = (Tipo)p[0];
+        c.relu = p[1];
+        c.kernel = p[2];
+        c.passo = p[3];
+        c.entradas = tirar<uint16_t>(p + 4);
+        c.saidas = tirar<uint16_t>(p + 6);
+        c.comprimento = tirar<uint16_t>(p + 8);
+        c.deslocamento = p[10];
+        c.multiplicador = tirar<int32_t>(p + 12);
+        size_t n_pesos = (size_t)c.saidas * c.entradas * (c.tipo == CONV1D ? c.kernel : 1);
+        size_t tamanho = (CAMADA + 4 * c.saidas + n_pesos + 3) & ~(size_t)3;
+        if (pos + tamanho > bytes)
+            return false;
+        for (int o = 0; o < c.saidas; o++)
+            c.bias.push_back(tirar<int32_t>(p + CAMADA + 4 * o));
+        const int8_t *w = (const int8_t *)(p + CAMADA + 4 * c.saidas);
+        c.pesos.assign(w, w + n_pesos);
+        modelo.camadas.push_back(std::move(c));
+        pos += tamanho;
+    }
+    return pos == bytes;
+}
+
+std::vector<int8_t> executar(const Modelo &modelo, const std::vector<int32_t> &entradas)
+{
+    std::vector<int8_t> x(modelo.n_entradas());
+    for (int i = 0; i < modelo.n_entradas(); i++)
+    {
+        int64_t produto = ((int64_t)entradas[i] - modelo.centro[i]) * modelo.ganho[i];
+        x[i] = sat8((produto + (1LL << 31)) >> 32);
+    }
+
+    for (const Camada &c : modelo.camadas)
+    {
+        auto requantizar = [&c](int32_t acc) {
+            int64_t v = ((int64_t)acc * c.multiplicador + (1LL << (c.deslocamento - 1))) >> c.deslocamento;
+            int8_t y = sat8(v);
+            return c.relu && y < 0 ? (int8_t)0 : y;
+        };
+
+        std::vector<int8_t> y(c.tamanho_saida());
+        for (int p = 0; p < c.comprimento_saida(); p++)
+            for (int o = 0; o < c.saidas; o++)
+            {
+                int32_t acc = c.bias[o];
+                if (c.tipo == DENSA)
+                {
+                    for (int i = 0; i < c.entradas; i++)
+                        acc += c.pesos[o * c.entradas + i] * x[i];
+                }
+                else
+                {
+                    for (int k = 0; k < c.kernel; k++)
+                        for (int i = 0; i < c.entradas; i++)
+                            acc += c.pesos[(o * c.kernel + k) * c.entradas + i] * x[(p * c.passo + k) * c.entradas + i];
+                }
+                y[p * c.saidas + o] = requantizar(acc);
+            }
+        x.swap(y);
+    }
+    return x;
+}
+
+void quantizar_escala(double escala, int32_t &multiplicador, int &deslocamento)
+{
+    int expoente;
+    double mantissa = std::frexp(escala, &expoente); // escala = mantissa * 2^expoente, mantissa em [0,5, 1)
+    int64_t m = std::llround(mantissa * (1LL << 31));
+    if (m == (1LL << 31))
+    {
+        m /= 2;
+        expoente++;
+    }
+    multiplicador = (int32_t)m;
+    deslocamento = std::min(62, std::max(1, 31 - expoente));
+}
+
+} // namespace referencia
@@ -0,0 +1,76 @@
+#ifndef REFERENCIA_HPP
+#define REFERENCIA_HPP
+
+// Implementação de referência do classificador int8 do firmware
+// (inc/classificador.h), escrita à parte e com tensores explícitos, para
+// conferir o motor do firmware bit a bit. Também lê e grava o blob.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace referencia
+{
+
+enum Tipo : uint8_t
+{
+    DENSA = 0,
+    CONV1D = 1,
+};
+
+struct Camada
+{
+    Tipo tipo = DENSA;
+    bool relu = false;
+    int kernel = 1;
+    int passo = 1;
+    int entradas = 0;    // densa: neurônios; conv1d: canais
+    int saidas = 0;      // densa: neurônios; conv1d: canais
+    int comprimento = 1; // conv1d: posições da entrada
+    int deslocamento = 31;
+    int32_t multiplicador = 1 << 30;
+    std::vector<int32_t> bias;
+    std::vector<int8_t> pesos; // densa [o][i]; conv1d [o][k][i]
+
+    int comprimento_saida() const
+    {
+        return tipo == DENSA ? 1 : (comprimento - kernel) / passo + 1;
+    }
+    int tamanho_entrada() const
+    {
+        return tipo == DENSA ? entradas : comprimento * entradas;
+    }
+    int tamanho_saida() const
+    {
+        return comprimento_saida() * saidas;
+    }
+};
+
+struct Modelo
+{
+    std::vector<int32_t> centro; // Q16, por entrada
+    std::vector<int32_t> ganho;  // Q16, por entrada
+    std::vector<Camada> camadas;
+
+    int n_entradas() const
+    {
+        return (int)centro.size();
+    }
+    int n_saidas() const
+    {
+        return camadas.empty() ? 0 : camadas.back().tamanho_saida();
+    }
+};
+
+std::vector<uint8_t> serializar(const Modelo &modelo);
+bool ler(const uint8_t *blob, size_t bytes, Modelo &modelo);
+
+// Logits int8 para as entradas em Q16
+std::vector<int8_t> executar(const Modelo &modelo, const std::vector<int32_t> &entradas);
+
+// multiplicador * 2^-deslocamento ≈ escala, com multiplicador em [2^30, 2^31)
+void quantizar_escala(double escala, int32_t &multiplicador, int &deslocamento);
+
+} // namespace referencia
+
+#endif
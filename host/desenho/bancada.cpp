@@ -0,0 +1,347 @@
+// Bancada do desenho do firmware (inc/desenho.hpp) no host: as mesmas cenas
+// com a geometria fixa do display da placa (128x64), com a geometria lida em
+// tempo de execução e com o driver em C de antes dos templates (um
+// ssd1306_pixel por ponto, reproduzido em Referencia). Antes de medir, as três
+// versões desenham cada cena num quadro zerado e os quadros têm de ser iguais
+// byte a byte. Depois, o mapa da matriz WS2812: a serpentina calculada a cada
+// pixel (inc/fitas_leds.c) contra a tabela de MapaMatriz.
+//
+//   beesense_desenho [ms_por_medida=200]
+//
+// Sai uma linha JSON por cena com ns por repetição; status 1 se algum quadro
+// ou mapa divergir. Os tempos são do host: no RP2040 o comando "desenho" do
+// firmware mede a geometria fixa contra a variável.
+
+#include "../gateway/metricas.hpp"
+#include "desenho.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+
+constexpr unsigned LARGURA = 128, ALTURA = 64;
+constexpr size_t BYTES = LARGURA * ALTURA / 8 + 1; // com o byte de controle 0x40
+
+// Dimensões que o compilador não enxerga, como as de um ssd1306_t
+volatile uint8_t largura_execucao = LARGURA, altura_execucao = ALTURA;
+
+// O desenho de inc/ssd1306.c antes dos templates, sobre o mesmo framebuffer
+struct Referencia
+{
+    uint8_t *ram_buffer;
+    uint8_t width, height, pages;
+
+    void pixel(uint8_t x, uint8_t y, bool value)
+    {
+        uint16_t index = (y >> 3) + (x << 3) + 1;
+        uint8_t pixel = (y & 0b111);
+        if (value)
+            ram_buffer[index] |= (1 << pixel);
+        else
+            ram_buffer[index] &= ~(1 << pixel);
+    }
+
+    void fill(bool value)
+    {
+        for (uint8_t y = 0; y < height; ++y)
+            for (uint8_t x = 0; x < width; ++x)
+                pixel(x, y, value);
+    }
+
+    void rect(uint8_t top, uint8_t left, uint8_t w, uint8_t h, bool value, bool cheio)
+    {
+        for (uint8_t x = left; x < left + w; ++x)
+        {
+            pixel(x, top, value);
+            pixel(x, top + h - 1, value);
+        }
+        for (uint8_t y = top; y < top + h; ++y)
+        {
+            pixel(left, y, value);
+            pixel(left + w - 1, y, value);
+        }
+        if (cheio)
+            for (uint8_t x = left + 1; x < left + w - 1; ++x)
+                for (uint8_t y = top + 1; y < top + h - 1; ++y)
+                    pixel(x, y, value);
+    }
+
+    void line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value)
+    {
+        int dx = abs(x1 - x0);
+        int dy = abs(y1 - y0);
+        int sx = (x0 < x1) ? 1 : -1;
+        int sy = (y0 < y1) ? 1 : -1;
+        int err = dx - dy;
+        while (true)
+        {
+            pixel(x0, y0, value);
+            if (x0 == x1 && y0 == y1)
+                break;
+            int e2 = err * 2;
+            if (e2 > -dy)
+            {
+                err -= dy;
+                x0 += sx;
+            }
+            if (e2 < dx)
+            {
+                err += dx;
+                y0 += sy;
+            }
+        }
+    }
+
+    void blit_coluna(uint8_t x, uint8_t y, uint32_t bits, uint8_t altura)
+    {
+        if (x >= width || y >= height)
+            return;
+        uint8_t desloc = y & 0b111;
+        uint64_t mascara = ((((uint64_t)1) << altura) - 1) << desloc;
+        uint64_t dados = ((uint64_t)bits << desloc) & mascara;
+        uint8_t *coluna = &ram_buffer[(x << 3) + 1];
+        for (uint8_t p = y >> 3; mascara && p < pages; ++p)
+        {
+            coluna[p] = (coluna[p] & ~(uint8_t)mascara) | (uint8_t)dados;
+            mascara >>= 8;
+            dados >>= 8;
+        }
+    }
+
+    uint8_t glyph(const fonte_t *fonte, uint32_t codigo, uint8_t x, uint8_t y)
+    {
+        uint8_t largura;
+        const uint8_t *glifo = fonte_glifo(fonte, codigo, &largura);
+        uint8_t avanco = fonte_avanco(fonte, codigo);
+        for (uint8_t i = 0; i < avanco; ++i)
+        {
+            uint32_t bits = 0;
+            if (i < largura)
+            {
+                const uint8_t *coluna = &glifo[i * fonte->bytes_coluna];
+                for (uint8_t b = 0; b < fonte->bytes_coluna; ++b)
+                    bits |= (uint32_t)coluna[b] << (8 * b);
+            }
+            blit_coluna(x + i, y, bits, fonte->altura);
+        }
+        return avanco;
+    }
+
+    void string(const char *str, uint8_t x, uint8_t y)
+    {
+        while (*str)
+        {
+            glyph(&fonte_8x8, utf8_proximo(&str), x, y);
+            x += 8;
+            if (x + 8 >= width)
+            {
+                x = 0;
+                y += 8;
+            }
+            if (y + 8 >= height)
+                break;
+        }
+    }
+
+    uint8_t string_font(const fonte_t *fonte, const char *str, uint8_t x, uint8_t y)
+    {
+        while (*str && x < width)
+            x += glyph(fonte, utf8_proximo(&str), x, y);
+        return x;
+    }
+};
+
+// Mesmos nomes para as cenas rodarem sobre as três versões
+struct Antigo
+{
+    Referencia r;
+
+    void preencher(bool v) { r.fill(v); }
+    void pixel(unsigned x, unsigned y, bool v) { r.pixel(x, y, v); }
+    void retangulo(unsigned t, unsigned l, unsigned w, unsigned h, bool v, bool c) { r.rect(t, l, w, h, v, c); }
+    void linha(int x0, int y0, int x1, int y1, bool v) { r.line(x0, y0, x1, y1, v); }
+    void texto(const char *s, unsigned x, unsigned y) { r.string(s, x, y); }
+    unsigned texto_fonte(const fonte_t *f, const char *s, unsigned x, unsigned y) { return r.string_font(f, s, x, y); }
+};
+
+// As cenas do comando "desenho" do firmware, mais o preenchimento
+template <class D>
+void cena_preencher(D &d, unsigned i)
+{
+    d.preencher(i & 1);
+}
+
+template <class D>
+void cena_pixels(D &d, unsigned i)
+{
+    for (unsigned y = 0; y < ALTURA; y++)
+        for (unsigned x = 0; x < LARGURA; x++)
+            d.pixel(x, y, (x ^ y ^ i) & 1);
+}
+
+template <class D>
+void cena_retangulos(D &d, unsigned i)
+{
+    d.retangulo(1 + (i & 1), 2, LARGURA - 4, ALTURA - 3, true, true);
+    d.retangulo(4, 6, LARGURA - 12, ALTURA - 8, false, false);
+}
+
+template <class D>
+void cena_linhas(D &d, unsigned i)
+{
+    for (unsigned k = 0; k < 16; k++)
+        d.linha(k * 8, 0, LARGURA - 1 - k * 8, ALTURA - 1, (k ^ i) & 1);
+}
+
+template <class D>
+void cena_texto(D &d, unsigned i)
+{
+    d.texto("Temp: 34.5 °C   Umid: 61 %      Peso: 42.1 kg   VOC: 1.2 ppm", 0, i & 1);
+    d.texto_fonte(&fonte_5x7, "Apis mellifera ligustica", 0, 48);
+    d.texto_fonte(&fonte_8x16, "42.1", 80, 40);
+}
+
+int64_t duracao_ns = 200000000;
+
+// ns por repetição: a melhor de 5 rodadas, cada uma repetindo a cena até
+// passar de 1/5 do tempo da medida (o host divide a CPU com outros processos)
+template <class F>
+double medir(F cena)
+{
+    double melhor = 0;
+    for (int rodada = 0; rodada < 5; rodada++)
+    {
+        unsigned repeticoes = 0;
+        int64_t inicio = agora_ns(), decorrido;
+        do
+        {
+            for (unsigned k = 0; k < 64; k++, repeticoes++)
+            {
+                cena(repeticoes);
+                asm volatile("" ::: "memory");
+            }
+            decorrido = agora_ns() - inicio;
+        } while (decorrido < duracao_ns / 5);
+        double ns = (double)decorrido / repeticoes;
+        if (rodada == 0 || ns < melhor)
+            melhor = ns;
+    }
+    return melhor;
+}
+
+struct Versoes
+{
+    uint8_t quadro_antigo[BYTES] = {}, quadro_variavel[BYTES] = {}, quadro_fixo[BYTES] = {};
+    Antigo antigo{{quadro_antigo, largura_execucao, altura_execucao, (uint8_t)(altura_execucao / 8)}};
+    Desenho<GeometriaVariavel> variavel{&quadro_variavel[1], GeometriaVariavel(largura_execucao, altura_execucao)};
+    Desenho<GeometriaFixa<LARGURA, ALTURA>> fixo{&quadro_fixo[1]};
+
+    void zerar()
+    {
+        memset(quadro_antigo, 0, BYTES);
+        memset(quadro_variavel, 0, BYTES);
+        memset(quadro_fixo, 0, BYTES);
+    }
+
+    bool iguais() const
+    {
+        return memcmp(quadro_antigo, quadro_variavel, BYTES) == 0 && memcmp(quadro_antigo, quadro_fixo, BYTES) == 0;
+    }
+};
+
+Versoes versoes;
+bool tudo_ok = true;
+
+#define CENA(nome)                                                                                            \
+    comparar(#nome, [](auto &d, unsigned i) { cena_##nome(d, i); })
+
+template <class C>
+void comparar(const char *nome, C cena)
+{
+    versoes.zerar();
+    cena(versoes.antigo, 0);
+    cena(versoes.variavel, 0);
+    cena(versoes.fixo, 0);
+    bool iguais = versoes.iguais();
+    tudo_ok &= iguais;
+
+    double antigo = medir([&](unsigned i) { cena(versoes.antigo, i); });
+    double variavel = medir([&](unsigned i) { cena(versoes.variavel, i); });
+    double fixo = medir([&](unsigned i) { cena(versoes.fixo, i); });
+    printf("{\"cena\":\"%s\",\"antigo_ns\":%.0f,\"variavel_ns\":%.0f,\"fixa_ns\":%.0f,"
+           "\"ganho_antigo\":%.2f,\"ganho_variavel\":%.2f,\"iguais\":%s}\n",
+           nome, antigo, variavel, fixo, antigo / fixo, variavel / fixo, iguais ? "true" : "false");
+}
+
+// Matriz: fitas_indice de inc/fitas_leds.c, com as dimensões da fita em tempo de execução
+struct FitaVariavel
+{
+    unsigned largura, altura;
+    uint32_t *buffer;
+
+    void pixel(unsigned x, unsigned y, uint32_t cor)
+    {
+        if (x >= largura || y >= altura)
+            return;
+        unsigned linha = altura - 1 - y;
+        unsigned coluna = (linha % 2) ? x : largura - 1 - x;
+        buffer[linha * largura + coluna] = cor;
+    }
+};
+
+template <unsigned L, unsigned A>
+void comparar_matriz()
+{
+    using Mapa = MapaMatriz<L, A, true>;
+    static uint32_t quadro_variavel[L * A], quadro_fixo[L * A];
+    volatile unsigned l = L, a = A;
+    FitaVariavel variavel = {l, a, quadro_variavel};
+
+    // Cada pixel numa cor própria: o mapa tem de bater LED a LED
+    for (unsigned y = 0; y < A; y++)
+        for (unsigned x = 0; x < L; x++)
+        {
+            variavel.pixel(x, y, y * L + x + 1);
+            quadro_fixo[Mapa::tabela[y * L + x]] = y * L + x + 1;
+        }
+    bool iguais = memcmp(quadro_variavel, quadro_fixo, sizeof(quadro_fixo)) == 0;
+    tudo_ok &= iguais;
+
+    // Padrão de pontos, como actionMatrizPattern
+    static bool pontos[A][L];
+    for (unsigned y = 0; y < A; y++)
+        for (unsigned x = 0; x < L; x++)
+            pontos[y][x] = (x + y) % 3 == 0;
+    double t_variavel = medir([&](unsigned i) {
+        for (unsigned y = 0; y < A; y++)
+            for (unsigned x = 0; x < L; x++)
+                variavel.pixel(x, y, pontos[y][x] ? i : 0);
+    });
+    double t_fixo = medir([&](unsigned i) {
+        for (unsigned y = 0; y < A; y++)
+            for (unsigned x = 0; x < L; x++)
+                quadro_fixo[Mapa::indice(x, y)] = pontos[y][x] ? i : 0;
+    });
+    printf("{\"cena\":\"matriz_%ux%u\",\"variavel_ns\":%.0f,\"fixa_ns\":%.0f,\"ganho_variavel\":%.2f,\"iguais\":%s}\n",
+           L, A, t_variavel, t_fixo, t_variavel / t_fixo, iguais ? "true" : "false");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+        duracao_ns = (int64_t)(atof(argv[1]) * 1e6);
+
+    CENA(preencher);
+    CENA(pixels);
+    CENA(retangulos);
+    CENA(linhas);
+    CENA(texto);
+    comparar_matriz<5, 5>();
+    comparar_matriz<16, 16>();
+    return tudo_ok ? 0 : 1;
+}
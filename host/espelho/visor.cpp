@@ -0,0 +1,473 @@
+// Visor do espelho remoto (inc/espelho.h): reconstrói o display e a matriz a
+// partir das linhas { "espelho": "..." } e os desenha no terminal (meios
+// blocos Unicode, dois pixels por caractere; a matriz em cor de 24 bits). A
+// entrada é a porta da placa, um log do gateway (uma colmeia por vez, com
+// --colmeia) ou a entrada padrão, como em tail -f saida.jsonl | beesense_espelho -.
+//
+//   beesense_espelho [--colmeia caminho] [--baud n] [--ppm arquivo] [entrada]
+//
+// --ppm grava o último quadro reconstruído como imagem a cada atualização.
+//
+//   beesense_espelho --medir [--parte %] [--baud n]
+//   beesense_espelho --gerar [--parte %] [--baud n]
+//
+// Mede os bytes por quadro nas telas do firmware, redesenhadas aqui com o
+// mesmo código de desenho (inc/desenho.hpp) a 10 quadros/s, o laço principal
+// na taxa cheia. Cada tela é medida sem limite (bytes por quadro) e com o
+// orçamento de --parte % do link (quadros que saem). Todos os quadros
+// recebidos são conferidos contra os desenhados, byte a byte. --gerar escreve
+// as linhas dessas telas como a placa, para o visor.
+
+#include "../gateway/serial.hpp"
+#include "desenho.hpp"
+
+extern "C"
+{
+#include "anomalia.h"
+#include "espelho.h"
+#include "especies.h"
+}
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace
+{
+
+using Tela = Desenho<GeometriaFixa<LCD_WIDTH, LCD_HEIGHT>>;
+
+// ---------------------------------------------------------------------------
+// Visor
+
+bool pixel(const uint8_t *quadro, unsigned x, unsigned y)
+{
+    return quadro[x * ESPELHO_PAGINAS + y / 8] >> (y % 8) & 1;
+}
+
+void desenhar_terminal(const espelho_receptor_t &r, const std::string &origem)
+{
+    static const char *const blocos[4] = {" ", "▀", "▄", "█"};
+    std::string s = "\x1b[H";
+    s += "┌";
+    for (unsigned x = 0; x < LCD_WIDTH; x++)
+        s += "─";
+    s += "┐\n";
+    for (unsigned y = 0; y < LCD_HEIGHT; y += 2)
+    {
+        s += "│";
+        for (unsigned x = 0; x < LCD_WIDTH; x++)
+            s += blocos[pixel(r.quadro, x, y) | pixel(r.quadro, x, y + 1) << 1];
+        s += "│\n";
+    }
+    s += "└";
+    for (unsigned x = 0; x < LCD_WIDTH; x++)
+        s += "─";
+    s += "┘\n";
+
+    // Os LEDs ficam em 10% a 40% do máximo: realçados para a tela
+    const uint8_t *rgb = r.quadro + ESPELHO_TELA_BYTES;
+    for (unsigned y = 0; y < MATRIX_HEIGHT; y++)
+    {
+        s += "  ";
+        for (unsigned x = 0; x < MATRIX_WIDTH; x++, rgb += 3)
+        {
+            char cor[48];
+            snprintf(cor, sizeof cor, "\x1b[38;2;%d;%d;%dm██\x1b[0m ", std::min(255, rgb[0] * 4),
+                     std::min(255, rgb[1] * 4), std::min(255, rgb[2] * 4));
+            s += cor;
+        }
+        s += "\n";
+    }
+    char estado[160];
+    snprintf(estado, sizeof estado, "%s  seq %u  quadros %u  falhas %u  %s\x1b[K\n", origem.c_str(), r.seq,
+             r.aplicados, r.falhas, r.sincronizado ? "sincronizado" : "esperando chave");
+    s += estado;
+    fwrite(s.data(), 1, s.size(), stdout);
+    fflush(stdout);
+}
+
+// Display em 4x (branco no preto) e, embaixo, a matriz em quadrados de 16 px
+bool gravar_ppm(const espelho_receptor_t &r, const std::string &caminho)
+{
+    constexpr unsigned E = 4, LED = 16;
+    unsigned largura = LCD_WIDTH * E, altura = LCD_HEIGHT * E + LED * (MATRIX_HEIGHT + 1);
+    std::string img(largura * altura * 3, '\0');
+    for (unsigned y = 0; y < LCD_HEIGHT * E; y++)
+        for (unsigned x = 0; x < largura; x++)
+            if (pixel(r.quadro, x / E, y / E))
+                memset(&img[(y * largura + x) * 3], 0xFF, 3);
+    const uint8_t *rgb = r.quadro + ESPELHO_TELA_BYTES;
+    for (unsigned y = 0; y < LED * MATRIX_HEIGHT; y++)
+        for (unsigned x = 0; x < LED * MATRIX_WIDTH; x++)
+        {
+            if (x % LED == LED - 1 || y % LED == LED - 1)
+                continue;
+            const uint8_t *c = &rgb[((y / LED) * MATRIX_WIDTH + x / LED) * 3];
+            size_t i = ((LCD_HEIGHT * E + LED / 2 + y) * largura + x + LED / 2) * 3;
+            for (int k = 0; k < 3; k++)
+                img[i + k] = (char)std::min(255, c[k] * 4);
+        }
+    std::string tmp = caminho + ".tmp";
+    FILE *f = fopen(tmp.c_str(), "wb");
+    if (!f)
+        return false;
+    fprintf(f, "P6\n%u %u\n255\n", largura, altura);
+    bool ok = fwrite(img.data(), 1, img.size(), f) == img.size();
+    ok &= fclose(f) == 0;
+    return ok && rename(tmp.c_str(), caminho.c_str()) == 0;
+}
+
+// Carga de uma linha { "espelho": "..." }, direta da placa ou dentro do
+// "dados" de uma linha do gateway; 0 se a linha não for do espelho
+size_t extrair(const char *linha, size_t n, uint8_t *carga)
+{
+    const char *p = (const char *)memmem(linha, n, "\"espelho\":", 10);
+    if (!p)
+        return 0;
+    const char *fim = linha + n;
+    p += 10;
+    while (p < fim && *p == ' ')
+        p++;
+    if (p == fim || *p != '"')
+        return 0;
+    const char *texto = ++p;
+    while (p < fim && *p != '"')
+        p++;
+    return espelho_base64_decodificar(texto, p - texto, carga, ESPELHO_CARGA_MAX);
+}
+
+int visor(const std::string &entrada, const std::string &colmeia, int baud, const std::string &ppm)
+{
+    int fd = STDIN_FILENO;
+    if (entrada != "-")
+    {
+        // Porta da placa em modo cru; arquivo lido como está
+        fd = open(entrada.c_str(), O_RDONLY | O_CLOEXEC | O_NOCTTY);
+        if (fd >= 0 && isatty(fd))
+        {
+            close(fd);
+            fd = serial_abrir(entrada, baud);
+        }
+        if (fd < 0)
+        {
+            perror(entrada.c_str());
+            return 1;
+        }
+    }
+    bool terminal = isatty(STDOUT_FILENO);
+    if (terminal)
+        printf("\x1b[2J");
+
+    espelho_receptor_t r;
+    espelho_receptor_init(&r);
+    static uint8_t carga[ESPELHO_CARGA_MAX];
+    std::string filtro = "\"colmeia\":\"" + colmeia + "\"";
+    std::string pendente;
+    char buf[8192];
+    for (;;)
+    {
+        ssize_t n = read(fd, buf, sizeof buf);
+        if (n < 0 && errno == EAGAIN)
+        {
+            pollfd p{fd, POLLIN, 0};
+            poll(&p, 1, -1);
+            continue;
+        }
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        pendente.append(buf, n);
+        size_t inicio = 0, nl;
+        while ((nl = pendente.find('\n', inicio)) != std::string::npos)
+        {
+            const char *linha = pendente.data() + inicio;
+            size_t tam = nl - inicio;
+            inicio = nl + 1;
+            if (!colmeia.empty() && !memmem(linha, tam, filtro.data(), filtro.size()))
+                continue;
+            size_t bytes = extrair(linha, tam, carga);
+            if (!bytes || !espelho_aplicar(&r, carga, bytes))
+                continue;
+            if (terminal)
+                desenhar_terminal(r, entrada);
+            if (!ppm.empty() && !gravar_ppm(r, ppm))
+                perror(ppm.c_str());
+        }
+        pendente.erase(0, inicio);
+    }
+    fprintf(stderr, "{\"aplicados\":%u,\"falhas\":%u,\"ignorados\":%u,\"sincronizado\":%s}\n", r.aplicados, r.falhas,
+            r.ignorados, r.sincronizado ? "true" : "false");
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Medida: as telas do laço principal (beeSense.c)
+
+struct Quadro
+{
+    uint8_t tela[ESPELHO_TELA_BYTES];
+    uint8_t matriz[ESPELHO_MATRIZ_BYTES];
+};
+
+// Cores das linhas da matriz no alarme (inc/matriz_leds.cpp)
+const uint8_t CORES[MATRIX_HEIGHT][3] = {{0, 102, 0}, {25, 76, 0}, {76, 51, 0}, {51, 25, 0}, {25, 0, 0}};
+
+void boas_vindas(Quadro &q, unsigned)
+{
+    Tela d(q.tela);
+    d.preencher(false);
+    d.texto("   Bem-vindo   ", 3, 10);
+    d.texto("-", 0, 15);
+    d.texto("-", 119, 15);
+    d.texto("   Bee Sense    ", 3, 20);
+    d.texto("  Pressione A", 3, 40);
+}
+
+// A espécie muda a cada segundo (botão A)
+void menu(Quadro &q, unsigned k)
+{
+    Tela d(q.tela);
+    d.preencher(false);
+    d.texto("Espécie:", 0, 0);
+    char buffer[32];
+    unsigned e = k / 10 % NUM_especies;
+    snprintf(buffer, sizeof buffer, "%u: %s", e + 1, especies[e].nome);
+    d.texto(buffer, 0, 20);
+    d.texto("A: Próximo", 0, 40);
+    d.texto("B: Selecionar", 0, 50);
+}
+
+// Valor em ajuste mudando a cada quadro
+void configuracao(Quadro &q, unsigned k)
+{
+    Tela d(q.tela);
+    d.preencher(false);
+    d.texto("2: Luminosidade", 0, 0);
+    char buffer[32];
+    snprintf(buffer, sizeof buffer, "%.1f", 40.0 + 0.5 * (k % 40));
+    d.texto_fonte(&fonte_8x16, buffer, 0, 16);
+    d.texto("A: Próximo", 0, 40);
+    d.texto("B: Selecionar", 0, 50);
+}
+
+// Gráfico incremental (inc/grafico.c): uma coluna nova por amostra, na região
+// de 120 colunas das páginas 1 a 7, com o título por cima
+void grafico(Quadro &q, unsigned k)
+{
+    constexpr unsigned X0 = (LCD_WIDTH - 120) / 2, COLUNAS = 120, Y0 = 8, ALTURA = 56;
+    auto y = [](unsigned k) { return (unsigned)(ALTURA / 2 + (ALTURA / 2 - 2) * sin(k * 0.07) * cos(k * 0.011)); };
+    Tela d(q.tela);
+    if (k == 0)
+    {
+        d.preencher(false);
+        d.texto("Temp 30.0-38.0", 0, 0);
+    }
+    unsigned x = X0 + k % COLUNAS;
+    unsigned y0 = y(k ? k - 1 : 0), y1 = y(k);
+    d.vline(x, Y0, Y0 + ALTURA - 1, false);
+    d.vline(x, Y0 + std::min(y0, y1), Y0 + std::max(y0, y1), true);
+}
+
+// Monitoramento: leituras a 0.1 de resolução, com ruído de sensor real, e a
+// matriz com os indicadores do alarme
+void monitor(Quadro &q, unsigned k)
+{
+    static unsigned semente = 1;
+    auto ruido = [] { return (int)((semente = semente * 1103515245 + 12345) >> 16) % 3 - 1; };
+    static int temp = 345, umid = 612, luz = 420, voc = 12, peso = 421;
+    temp += ruido();
+    umid += ruido();
+    luz += ruido();
+    if (k % 20 == 0)
+        voc += ruido();
+    if (k % 50 == 0)
+        peso += ruido();
+
+    Tela d(q.tela);
+    d.preencher(false);
+    char info[32];
+    snprintf(info, sizeof info, "Temp : %.1f °C", temp / 10.0);
+    d.texto(info, 0, 0);
+    snprintf(info, sizeof info, "Umid : %.1f %%", umid / 10.0);
+    d.texto(info, 0, 10);
+    snprintf(info, sizeof info, "Luz  : %.1f %%", luz / 10.0);
+    d.texto(info, 0, 20);
+    snprintf(info, sizeof info, "VOC  : %.1f ppm", voc / 10.0);
+    d.texto(info, 0, 30);
+    snprintf(info, sizeof info, "Peso:%.1f %+.2f", peso / 10.0, 0.12);
+    d.texto(info, 0, 40);
+    d.texto("Alarm:ON  R:42d", 0, 55);
+    d.glifo(&fonte_8x8, (uint8_t)anomalia_simbolo(k % 30 < 5 ? ANOMALIA_Z : 0), 120, 0);
+    for (unsigned y = 10; y <= 40; y += 10)
+        d.glifo(&fonte_8x8, ' ', 120, y);
+
+    // Uma linha acesa por coluna, na altura do indicador
+    memset(q.matriz, 0, sizeof q.matriz);
+    unsigned linhas[MATRIX_WIDTH] = {1, 2, (unsigned)(4 - voc / 30 % 5), 4, (unsigned)(k % 100 < 50 ? 0 : 1)};
+    for (unsigned x = 0; x < MATRIX_WIDTH; x++)
+        memcpy(&q.matriz[(linhas[x] * MATRIX_WIDTH + x) * 3], CORES[linhas[x]], 3);
+}
+
+// Ficha da espécie (modo de simulação 1)
+void especie(Quadro &q, unsigned)
+{
+    const Beeespecies &e = especies[0];
+    Tela d(q.tela);
+    d.preencher(false);
+    d.texto(e.nome, 15, 0);
+    d.glifo(&fonte_8x8, '>', 0, 0);
+    d.texto(e.genero, 0, 10);
+    char buffer[32];
+    snprintf(buffer, sizeof buffer, "Max: %.1f °C", e.max_temp);
+    d.texto(buffer, 0, 30);
+    snprintf(buffer, sizeof buffer, "Min: %.1f °C", e.min_temp);
+    d.texto(buffer, 0, 40);
+    snprintf(buffer, sizeof buffer, "Peso: %.1f", e.peso_mel_anual);
+    d.texto(buffer, 0, 50);
+}
+
+struct Resultado
+{
+    unsigned quadros = 0, diferencas = 0;
+    size_t chave = 0, carga = 0, carga_max = 0, linha = 0;
+    size_t fio = 0; // linhas inteiras, chaves inclusive
+    bool ok = true;
+};
+
+// quadros a 10/s pelo codificador e de volta pelo receptor
+Resultado passar(const std::function<void(Quadro &, unsigned)> &tela, unsigned quadros, uint32_t baud,
+                 uint8_t parte)
+{
+    static espelho_t e;
+    static espelho_receptor_t r;
+    static uint8_t carga[ESPELHO_CARGA_MAX];
+    Quadro q{};
+    espelho_init(&e, baud, parte, 0);
+    espelho_receptor_init(&r);
+    Resultado res;
+    for (unsigned k = 0; k < quadros; k++)
+    {
+        tela(q, k);
+        size_t n = espelho_codificar(&e, q.tela, q.matriz, k * 100, carga);
+        if (!n)
+            continue;
+        res.ok &= espelho_aplicar(&r, carga, n) && memcmp(r.quadro, &q, sizeof q) == 0;
+        res.quadros++;
+        res.fio += espelho_linha_bytes(n);
+        if (carga[0] == 'K')
+        {
+            res.chave = std::max(res.chave, n);
+            continue;
+        }
+        res.diferencas++;
+        res.carga += n;
+        res.carga_max = std::max(res.carga_max, n);
+        res.linha += espelho_linha_bytes(n);
+    }
+    return res;
+}
+
+const struct
+{
+    const char *nome;
+    void (*tela)(Quadro &, unsigned);
+} TELAS[] = {{"boas_vindas", boas_vindas}, {"menu", menu},       {"configuracao", configuracao},
+             {"grafico", grafico},         {"monitor", monitor}, {"especie", especie}};
+
+// As linhas que a placa mandaria, 60 s de cada tela em sequência, para testar o
+// visor sem placa: beesense_espelho --gerar | beesense_espelho -
+int gerar(uint32_t baud, uint8_t parte)
+{
+    static espelho_t e;
+    static uint8_t carga[ESPELHO_CARGA_MAX];
+    static char texto[ESPELHO_BASE64_MAX];
+    Quadro q{};
+    espelho_init(&e, baud, parte, 0);
+    uint32_t agora_ms = 0;
+    for (auto &t : TELAS)
+        for (unsigned k = 0; k < 600; k++, agora_ms += 100)
+        {
+            t.tela(q, k);
+            size_t n = espelho_codificar(&e, q.tela, q.matriz, agora_ms, carga);
+            if (!n)
+                continue;
+            espelho_base64(carga, n, texto);
+            printf(ESPELHO_PREFIXO "%s" ESPELHO_SUFIXO, texto);
+        }
+    return 0;
+}
+
+int medir(uint32_t baud, uint8_t parte)
+{
+    constexpr unsigned QUADROS = 600; // 60 s
+    bool ok = true;
+    for (auto &t : TELAS)
+    {
+        Resultado livre = passar(t.tela, QUADROS, UINT32_MAX / 2, 100);
+        Resultado limitado = passar(t.tela, QUADROS, baud, parte);
+        ok &= livre.ok && limitado.ok;
+        double bytes_s = livre.fio / (QUADROS / 10.0);
+        printf("{\"tela\":\"%s\",\"chave\":%zu,\"chave_linha\":%zu,\"diferencas\":%u,\"carga_media\":%.1f,"
+               "\"carga_max\":%zu,\"linha_media\":%.1f,\"bytes_s\":%.0f,\"link_pct\":%.2f,"
+               "\"quadros_s_limitado\":%.2f,\"parte\":%u,\"ok\":%s}\n",
+               t.nome, livre.chave, espelho_linha_bytes(livre.chave), livre.diferencas,
+               livre.diferencas ? (double)livre.carga / livre.diferencas : 0.0, livre.carga_max,
+               livre.diferencas ? (double)livre.linha / livre.diferencas : 0.0, bytes_s, 100.0 * bytes_s / (baud / 10.0),
+               limitado.quadros / (QUADROS / 10.0), parte, livre.ok && limitado.ok ? "true" : "false");
+    }
+    printf("{\"quadro_bruto\":%d,\"chave_max\":%d,\"baud\":%u}\n", ESPELHO_QUADRO_BYTES, ESPELHO_CARGA_MAX, baud);
+    return ok ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string entrada = "-", colmeia, ppm;
+    int baud = 115200, parte = ESPELHO_PARTE_PADRAO;
+    bool medida = false, geracao = false;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string a = argv[i];
+        bool tem_valor = i + 1 < argc;
+        if (a == "--medir")
+            medida = true;
+        else if (a == "--gerar")
+            geracao = true;
+        else if (a == "--parte" && tem_valor)
+            parte = atoi(argv[++i]);
+        else if (a == "--baud" && tem_valor)
+            baud = atoi(argv[++i]);
+        else if (a == "--colmeia" && tem_valor)
+            colmeia = argv[++i];
+        else if (a == "--ppm" && tem_valor)
+            ppm = argv[++i];
+        else if (a.size() > 1 && a[0] == '-')
+        {
+            fprintf(stderr,
+                    "uso: %s [--colmeia caminho] [--baud n] [--ppm arquivo] [entrada]\n"
+                    "     %s --medir|--gerar [--parte %%] [--baud n]\n",
+                    argv[0], argv[0]);
+            return 2;
+        }
+        else
+            entrada = a;
+    }
+    uint8_t p = (uint8_t)std::min(std::max(parte, 1), 100);
+    if (medida)
+        return medir(baud, p);
+    if (geracao)
+        return gerar(baud, p);
+    return visor(entrada, colmeia, baud, ppm);
+}
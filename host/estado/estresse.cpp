@@ -0,0 +1,186 @@
+// Teste de estresse do armazenamento de estado do firmware (inc/estado.c),
+// compilado para o computador: um escritor por grupo, como no firmware, e
+// vários leitores em threads. Cada publicação grava campos derivados de um
+// mesmo contador, então um instantâneo misturado (metade antes, metade
+// depois) é detectado na hora. Também confere que a versão e o número da
+// amostra nunca voltam no tempo para um mesmo leitor.
+//
+// Sai com status 1 se algum instantâneo incoerente for lido.
+
+extern "C"
+{
+#include "estado.h"
+}
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+std::atomic<bool> parar{false};
+
+const char *const NOMES[4] = {"Peso", "Luminosidade", "Gás VOC", "Vibração"};
+
+estado_interface_t interface_de(uint32_t n)
+{
+    estado_interface_t i;
+    i.tela = (uint8_t)n;
+    i.especie = (uint8_t)(n * 3);
+    i.sensor = (uint8_t)(n * 5);
+    i.grafico = (uint8_t)(n * 7);
+    i.modo = (uint8_t)(n * 11);
+    i.alarme = n & 1;
+    i.display = n & 2;
+    i.sensor_nome = NOMES[n % 4];
+    return i;
+}
+
+// Valores exatos em float enquanto m < 2^20
+estado_medidas_t medidas_de(uint32_t m)
+{
+    estado_medidas_t e;
+    e.amostra = m;
+    e.temp = (float)(m & 0xFFFFF);
+    e.umid = -e.temp;
+    for (int i = 0; i < ESTADO_SENSORES; i++)
+        e.sensores[i] = e.temp * (i + 2);
+    e.valor_sensor = e.temp + 0.5f;
+    for (int i = 0; i < ESTADO_CANAIS; i++)
+        e.anomalias[i] = (uint8_t)(m >> i);
+    e.saude = e.temp * 0.25f;
+    for (int i = 0; i < ESTADO_INDICADORES; i++)
+        e.indicadores[i] = (uint8_t)(m + i);
+    e.peso_por_dia = -e.saude;
+    e.dias_reserva = (int32_t)m;
+    for (int i = 0; i < ESTADO_GRAFICOS; i++)
+        e.grafico[i] = (q16_t)(m * (i + 3));
+    e.grafico_amostras = ~m;
+    return e;
+}
+
+bool coerente(const estado_t &e)
+{
+    estado_interface_t i = interface_de(e.interface.tela);
+    if (e.interface.especie != i.especie || e.interface.sensor != i.sensor ||
+        e.interface.grafico != i.grafico || e.interface.alarme != i.alarme || e.interface.modo != i.modo ||
+        e.interface.display != i.display || e.interface.sensor_nome != i.sensor_nome)
+        return false;
+    estado_medidas_t m = medidas_de(e.medidas.amostra);
+    if (e.medidas.temp != m.temp || e.medidas.umid != m.umid || e.medidas.valor_sensor != m.valor_sensor ||
+        e.medidas.saude != m.saude || e.medidas.peso_por_dia != m.peso_por_dia ||
+        e.medidas.dias_reserva != m.dias_reserva || e.medidas.grafico_amostras != m.grafico_amostras)
+        return false;
+    if (memcmp(e.medidas.anomalias, m.anomalias, sizeof m.anomalias) ||
+        memcmp(e.medidas.indicadores, m.indicadores, sizeof m.indicadores) ||
+        memcmp(e.medidas.grafico, m.grafico, sizeof m.grafico))
+        return false;
+    for (int i = 0; i < ESTADO_SENSORES; i++)
+        if (e.medidas.sensores[i] != m.sensores[i])
+            return false;
+    return true;
+}
+
+struct Leitor
+{
+    uint64_t leituras = 0;
+    uint64_t incoerentes = 0;
+    uint64_t regressoes = 0;
+    uint64_t tentativas_falhas = 0; // só no leitor que imita uma interrupção
+};
+
+void ler(Leitor &l, bool so_tentar)
+{
+    uint32_t ultima_versao = 0, ultima_amostra = 0;
+    while (!parar.load(std::memory_order_relaxed))
+    {
+        estado_t e;
+        if (so_tentar)
+        {
+            if (!estado_tentar_ler(&e))
+            {
+                l.tentativas_falhas++;
+                continue;
+            }
+        }
+        else
+            estado_ler(&e);
+
+        l.leituras++;
+        if (!coerente(e))
+            l.incoerentes++;
+        if (e.versao < ultima_versao || e.medidas.amostra < ultima_amostra)
+            l.regressoes++;
+        ultima_versao = e.versao;
+        ultima_amostra = e.medidas.amostra;
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && (argv[1][0] < '0' || argv[1][0] > '9'))
+    {
+        fprintf(stderr, "uso: %s [leitores] [segundos]\n", argv[0]);
+        return 2;
+    }
+    int n_leitores = argc > 1 ? atoi(argv[1]) : 4;
+    double segundos = argc > 2 ? atof(argv[2]) : 2;
+
+    estado_interface_t i0 = interface_de(0);
+    estado_medidas_t m0 = medidas_de(0);
+    estado_publicar_interface(&i0);
+    estado_publicar_medidas(&m0);
+
+    std::atomic<uint64_t> publicacoes{0};
+    std::thread interface([&] {
+        for (uint32_t n = 1; !parar.load(std::memory_order_relaxed); n++)
+        {
+            estado_interface_t i = interface_de(n);
+            estado_publicar_interface(&i);
+            publicacoes.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    std::thread medidas([&] {
+        for (uint32_t m = 1; !parar.load(std::memory_order_relaxed); m++)
+        {
+            estado_medidas_t e = medidas_de(m);
+            estado_publicar_medidas(&e);
+            publicacoes.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // O último leitor só tenta uma vez, como uma interrupção faria
+    std::vector<Leitor> leitores(n_leitores + 1);
+    std::vector<std::thread> threads;
+    for (int i = 0; i <= n_leitores; i++)
+        threads.emplace_back(ler, std::ref(leitores[i]), i == n_leitores);
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(segundos));
+    parar = true;
+    interface.join();
+    medidas.join();
+    for (auto &t : threads)
+        t.join();
+
+    Leitor total;
+    for (const auto &l : leitores)
+    {
+        total.leituras += l.leituras;
+        total.incoerentes += l.incoerentes;
+        total.regressoes += l.regressoes;
+        total.tentativas_falhas += l.tentativas_falhas;
+    }
+    printf("{\"leitores\":%d,\"publicacoes\":%llu,\"leituras\":%llu,\"incoerentes\":%llu,\"regressoes\":%llu,"
+           "\"tentativas_falhas\":%llu}\n",
+           n_leitores + 1, (unsigned long long)publicacoes.load(), (unsigned long long)total.leituras,
+           (unsigned long long)total.incoerentes, (unsigned long long)total.regressoes,
+           (unsigned long long)total.tentativas_falhas);
+    return total.incoerentes || total.regressoes ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+#ifndef ANEL_HPP
+#define ANEL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sys/uio.h>
+
+// Anel de bytes de uma colmeia, com um produtor (thread de leitura) e um
+// consumidor (thread de escrita). As posições são contadores de 64 bits que
+// só crescem; o índice no buffer é posição & máscara. O produtor lê do
+// descritor direto para o espaço livre (readv em até dois trechos) e o
+// consumidor escreve direto dos trechos ocupados: nenhum byte é copiado.
+class AnelBytes
+{
+public:
+    // capacidade precisa ser potência de 2
+    explicit AnelBytes(size_t capacidade)
+        : dados(new uint8_t[capacidade]), mascara(capacidade - 1)
+    {
+    }
+
+    size_t capacidade() const
+    {
+        return mascara + 1;
+    }
+
+    // Produtor: espaço livre em até dois trechos contíguos
+    size_t livre(iovec iov[2]) const
+    {
+        uint64_t e = escrita.load(std::memory_order_relaxed);
+        uint64_t l = leitura.load(std::memory_order_acquire);
+        size_t n = capacidade() - (size_t)(e - l);
+        return trechos(e, n, iov);
+    }
+
+    void confirmar_escrita(size_t n)
+    {
+        escrita.store(escrita.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    uint64_t posicao_escrita() const
+    {
+        return escrita.load(std::memory_order_relaxed);
+    }
+
+    // Trechos contíguos do intervalo [inicio, inicio + n); retorna n
+    size_t trechos(uint64_t inicio, size_t n, iovec iov[2]) const
+    {
+        size_t i = (size_t)(inicio & mascara);
+        size_t primeiro = capacidade() - i < n ? capacidade() - i : n;
+        iov[0].iov_base = dados.get() + i;
+        iov[0].iov_len = primeiro;
+        iov[1].iov_base = dados.get();
+        iov[1].iov_len = n - primeiro;
+        return n;
+    }
+
+    // Consumidor: devolve ao produtor tudo antes de pos
+    void liberar_ate(uint64_t pos)
+    {
+        leitura.store(pos, std::memory_order_release);
+    }
+
+private:
+    std::unique_ptr<uint8_t[]> dados;
+    size_t mascara;
+    alignas(64) std::atomic<uint64_t> escrita{0};
+    alignas(64) std::atomic<uint64_t> leitura{0};
+};
+
+// Fila de tamanho fixo, um produtor e um consumidor, sem locks
+template <typename T>
+class FilaSpsc
+{
+public:
+    // capacidade precisa ser potência de 2
+    explicit FilaSpsc(size_t capacidade)
+        : itens(new T[capacidade]), mascara(capacidade - 1)
+    {
+    }
+
+    bool colocar(const T &item)
+    {
+        uint64_t f = fim.load(std::memory_order_relaxed);
+        if (f - inicio.load(std::memory_order_acquire) > mascara)
+            return false;
+        itens[f & mascara] = item;
+        fim.store(f + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: olha sem retirar
+    const T *frente() const
+    {
+        uint64_t i = inicio.load(std::memory_order_relaxed);
+        if (i == fim.load(std::memory_order_acquire))
+            return nullptr;
+        return &itens[i & mascara];
+    }
+
+    void retirar()
+    {
+        inicio.store(inicio.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    std::unique_ptr<T[]> itens;
+    size_t mascara;
+    alignas(64) std::atomic<uint64_t> fim{0};
+    alignas(64) std::atomic<uint64_t> inicio{0};
+};
+
+#endif
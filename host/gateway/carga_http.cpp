@@ -0,0 +1,304 @@
+// Gerador de carga do servidor de consultas do gateway (--http).
+//
+// Várias conexões keep-alive num laço epoll. Sem --taxa, cada conexão manda a
+// próxima requisição assim que a resposta chega (laço fechado: mede a vazão
+// máxima). Com --taxa, as requisições têm horário marcado, repartido entre as
+// conexões, e a latência conta do horário marcado (uma resposta lenta não
+// esconde as que ficaram esperando atrás dela).
+//
+// Sem alvos na linha de comando, pede /colmeias e sorteia entre as consultas
+// de painel de cada colmeia: último valor, 24 h com série por hora, saúde e
+// alarmes.
+//
+// uso: beesense_carga_http porta [--conexoes n] [--segundos s] [--taxa req/s] [alvo...]
+
+#include "metricas.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct Conexao
+{
+    int fd = -1;
+    std::string entrada;
+    std::deque<int64_t> marcadas; // horário de cada requisição sem resposta
+    int64_t proxima = 0;          // próxima requisição com --taxa
+};
+
+int conectar(int porta)
+{
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in endereco{};
+    endereco.sin_family = AF_INET;
+    endereco.sin_port = htons(porta);
+    endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (sockaddr *)&endereco, sizeof endereco) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+    int um = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &um, sizeof um);
+    return fd;
+}
+
+// Tamanho da primeira resposta completa no buffer; 0 se ainda falta
+size_t resposta_completa(const std::string &s, int &status)
+{
+    size_t fim = s.find("\r\n\r\n");
+    if (fim == std::string::npos)
+        return 0;
+    const char *cl = strcasestr(s.c_str(), "content-length:");
+    size_t corpo = cl && cl < s.c_str() + fim ? strtoul(cl + 15, nullptr, 10) : 0;
+    if (s.size() < fim + 4 + corpo)
+        return 0;
+    status = s.size() > 12 ? atoi(s.c_str() + 9) : 0;
+    return fim + 4 + corpo;
+}
+
+// GET bloqueante numa conexão nova; corpo da resposta, vazio se falhar
+std::string buscar(int porta, const std::string &alvo)
+{
+    int fd = conectar(porta);
+    if (fd < 0)
+        return "";
+    std::string req = "GET " + alvo + " HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+    if (write(fd, req.data(), req.size()) != (ssize_t)req.size())
+    {
+        close(fd);
+        return "";
+    }
+    std::string r;
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof buf)) > 0)
+        r.append(buf, n);
+    close(fd);
+    size_t fim = r.find("\r\n\r\n");
+    if (fim == std::string::npos)
+        return "";
+    r.erase(0, fim + 4);
+    while (!r.empty() && r.back() == '\n')
+        r.pop_back();
+    return r;
+}
+
+std::string codificar(const std::string &s)
+{
+    std::string r;
+    for (unsigned char c : s)
+    {
+        if (isalnum(c) || c == '-' || c == '_' || c == '.')
+            r += (char)c;
+        else
+        {
+            char hex[4];
+            snprintf(hex, sizeof hex, "%%%02X", c);
+            r += hex;
+        }
+    }
+    return r;
+}
+
+// Consultas de painel de cada colmeia listada em /colmeias
+std::vector<std::string> alvos_padrao(int porta)
+{
+    std::vector<std::string> alvos;
+    std::string lista = buscar(porta, "/colmeias");
+    static const char campo[] = "\"colmeia\":\"";
+    for (size_t p = lista.find(campo); p != std::string::npos; p = lista.find(campo, p))
+    {
+        p += sizeof campo - 1;
+        size_t fim = lista.find('"', p);
+        std::string c = codificar(lista.substr(p, fim - p));
+        alvos.push_back("/ultimo?colmeia=" + c);
+        alvos.push_back("/agregado?colmeia=" + c + "&horas=24&passo=60");
+        alvos.push_back("/saude?colmeia=" + c);
+        alvos.push_back("/alarmes?colmeia=" + c);
+    }
+    if (!alvos.empty())
+    {
+        alvos.push_back("/saude");
+        alvos.push_back("/alarmes");
+    }
+    return alvos;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "uso: %s porta [--conexoes n] [--segundos s] [--taxa req/s] [alvo...]\n", argv[0]);
+        return 2;
+    }
+    int porta = atoi(argv[1]);
+    int n_conexoes = 16;
+    double segundos = 10, taxa = 0;
+    std::vector<std::string> alvos;
+    for (int i = 2; i < argc; i++)
+    {
+        std::string a = argv[i];
+        bool tem_valor = i + 1 < argc;
+        if (a == "--conexoes" && tem_valor)
+            n_conexoes = atoi(argv[++i]);
+        else if (a == "--segundos" && tem_valor)
+            segundos = atof(argv[++i]);
+        else if (a == "--taxa" && tem_valor)
+            taxa = atof(argv[++i]);
+        else
+            alvos.push_back(a);
+    }
+    if (alvos.empty())
+        alvos = alvos_padrao(porta);
+    if (alvos.empty() || n_conexoes < 1)
+    {
+        fprintf(stderr, "sem alvos: o gateway está com --http %d?\n", porta);
+        return 1;
+    }
+
+    // Requisições prontas: só o sorteio no laço
+    std::vector<std::string> requisicoes;
+    for (auto &a : alvos)
+        requisicoes.push_back("GET " + a + " HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    std::mt19937 aleatorio(1);
+    std::uniform_int_distribution<size_t> sorteio(0, requisicoes.size() - 1);
+
+    int ep = epoll_create1(EPOLL_CLOEXEC);
+    std::vector<Conexao> conexoes(n_conexoes);
+    int64_t inicio = agora_ns();
+    int64_t intervalo = taxa > 0 ? (int64_t)(1e9 * n_conexoes / taxa) : 0;
+    for (int i = 0; i < n_conexoes; i++)
+    {
+        Conexao &c = conexoes[i];
+        if ((c.fd = conectar(porta)) < 0)
+        {
+            perror("connect");
+            return 1;
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u32 = i;
+        epoll_ctl(ep, EPOLL_CTL_ADD, c.fd, &ev);
+        // Conexões defasadas dentro do intervalo
+        c.proxima = inicio + intervalo * i / n_conexoes;
+    }
+
+    Histograma latencia;
+    uint64_t erros = 0, enviadas = 0;
+    int64_t fim = inicio + (int64_t)(segundos * 1e9);
+    auto enviar = [&](Conexao &c, int64_t marcada)
+    {
+        const std::string &r = requisicoes[sorteio(aleatorio)];
+        if (write(c.fd, r.data(), r.size()) != (ssize_t)r.size())
+        {
+            erros++;
+            return;
+        }
+        c.marcadas.push_back(marcada);
+        enviadas++;
+    };
+    if (!intervalo)
+        for (auto &c : conexoes)
+            enviar(c, agora_ns());
+
+    // Horários marcados com precisão de ns: o timeout do epoll_wait é em ms
+    const uint32_t TEMPO = n_conexoes;
+    int tfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u32 = TEMPO;
+    epoll_ctl(ep, EPOLL_CTL_ADD, tfd, &ev);
+
+    epoll_event eventos[256];
+    char buf[65536];
+    for (;;)
+    {
+        int64_t agora = agora_ns();
+        int64_t espera = fim;
+        if (intervalo && agora < fim)
+            for (auto &c : conexoes)
+            {
+                while (c.proxima <= agora)
+                {
+                    enviar(c, c.proxima);
+                    c.proxima += intervalo;
+                }
+                espera = std::min(espera, c.proxima);
+            }
+        bool pendentes = false;
+        for (auto &c : conexoes)
+            pendentes |= !c.marcadas.empty();
+        if (agora >= fim && !pendentes)
+            break;
+        if (agora >= fim + 2000000000LL)
+        {
+            fprintf(stderr, "respostas faltando ao fim do teste\n");
+            break;
+        }
+        itimerspec quando{{0, 0}, {(time_t)(espera / 1000000000), (long)(espera % 1000000000)}};
+        timerfd_settime(tfd, TFD_TIMER_ABSTIME, &quando, nullptr);
+        int n = epoll_wait(ep, eventos, 256, agora >= fim ? 100 : -1);
+        for (int k = 0; k < n; k++)
+        {
+            if (eventos[k].data.u32 == TEMPO)
+            {
+                uint64_t expiracoes;
+                (void)!read(tfd, &expiracoes, sizeof expiracoes);
+                continue;
+            }
+            Conexao &c = conexoes[eventos[k].data.u32];
+            ssize_t lidos = read(c.fd, buf, sizeof buf);
+            if (lidos <= 0)
+            {
+                fprintf(stderr, "conexão fechada pelo servidor\n");
+                return 1;
+            }
+            c.entrada.append(buf, lidos);
+            int status;
+            while (size_t tam = resposta_completa(c.entrada, status))
+            {
+                int64_t recebida = agora_ns();
+                latencia.registrar(recebida - c.marcadas.front());
+                c.marcadas.pop_front();
+                erros += status != 200;
+                c.entrada.erase(0, tam);
+                if (!intervalo && recebida < fim)
+                    enviar(c, recebida);
+            }
+        }
+    }
+    double duracao = (agora_ns() - inicio) / 1e9;
+    for (auto &c : conexoes)
+        close(c.fd);
+    close(tfd);
+    close(ep);
+
+    printf("{\"carga\":\"%s\",\"conexoes\":%d,\"alvos\":%zu,\"requisicoes\":%llu,\"respostas\":%llu,\"erros\":%llu,"
+           "\"req_s\":%.0f,\"p50_us\":%.1f,\"p99_us\":%.1f,\"max_us\":%.1f}\n",
+           intervalo ? "taxa" : "fechada", n_conexoes, requisicoes.size(), (unsigned long long)enviadas,
+           (unsigned long long)latencia.total(), (unsigned long long)erros, latencia.total() / duracao,
+           latencia.percentil(0.5) / 1e3, latencia.percentil(0.99) / 1e3, latencia.maximo() / 1e3);
+    printf("{\"servidor\":%s}\n", buscar(porta, "/metricas").c_str());
+    return erros ? 1 : 0;
+}
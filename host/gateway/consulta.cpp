@@ -0,0 +1,736 @@
+#include "consulta.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+
+const char *const NOMES[CANAIS_SAUDE] = {"temp", "umid", "peso", "luz", "voc", "vibra", "saude"};
+const char *const CAMPOS[NUM_CANAIS] = {"\"temp\":", "\"umid\":", "\"peso\":", "\"luz\":", "\"voc\":", "\"vibra\":"};
+
+constexpr int64_t MS_MINUTO = 60000;
+constexpr int64_t MS_HORA = 3600000;
+constexpr size_t REQUISICAO_MAX = 8192; // cabeçalho sem fim além disso fecha a conexão
+constexpr int64_t PONTOS_MAX = 2000;    // pontos de uma série (passo)
+constexpr int64_t HORAS_CONSULTA_MAX = HORAS + 24; // horas= de /agregado: os 7 dias e uma folga
+
+bool numero(const char *s, size_t n, const char *campo, float &valor)
+{
+    size_t tam = strlen(campo);
+    const char *p = (const char *)memmem(s, n, campo, tam);
+    if (!p)
+        return false;
+    char *fim;
+    valor = strtof(p + tam, &fim);
+    return fim != p + tam;
+}
+
+// "anom": [0, 1, ...] (um estado por canal) ou uma máscara, como nos nós do
+// barramento de campo
+uint8_t anomalias(const char *s, size_t n)
+{
+    const char *p = (const char *)memmem(s, n, "\"anom\":", 7);
+    if (!p)
+        return 0;
+    const char *fim = s + n;
+    p += 7;
+    while (p < fim && *p == ' ')
+        p++;
+    if (p == fim)
+        return 0;
+    if (*p != '[')
+        return (uint8_t)strtoul(p, nullptr, 10);
+    uint8_t bits = 0;
+    p++;
+    for (int i = 0; i < NUM_CANAIS && p < fim && *p != ']'; i++)
+    {
+        char *depois;
+        unsigned long estado = strtoul(p, &depois, 10);
+        if (depois == p)
+            break;
+        bits |= (estado != 0) << i;
+        p = depois;
+        while (p < fim && (*p == ',' || *p == ' '))
+            p++;
+    }
+    return bits;
+}
+
+// Balde do período no anel; nullptr se o período já saiu do anel
+Balde *balde(Balde *anel, int n, int64_t periodo)
+{
+    Balde &b = anel[periodo % n];
+    if (b.periodo > periodo)
+        return nullptr;
+    if (b.periodo != periodo)
+    {
+        b = Balde();
+        b.periodo = periodo;
+    }
+    return &b;
+}
+
+void anexar(std::string &s, const char *formato, ...) __attribute__((format(printf, 2, 3)));
+
+void anexar(std::string &s, const char *formato, ...)
+{
+    char buf[256];
+    va_list args;
+    va_start(args, formato);
+    int n = vsnprintf(buf, sizeof buf, formato, args);
+    va_end(args);
+    s.append(buf, n < (int)sizeof buf ? n : sizeof buf - 1);
+}
+
+void anexar_valor(std::string &s, double v)
+{
+    if (std::isfinite(v))
+        anexar(s, "%.2f", v);
+    else
+        s += "null";
+}
+
+// "amostras":n,"alarmes":n,"temp":{"media":..,"min":..,"max":..},...
+void anexar_balde(std::string &s, const Balde &b)
+{
+    anexar(s, "\"amostras\":%u,\"alarmes\":%u", b.amostras, b.alarmes);
+    for (int i = 0; i < CANAIS_SAUDE; i++)
+    {
+        anexar(s, ",\"%s\":", NOMES[i]);
+        if (!b.amostras)
+        {
+            s += "null";
+            continue;
+        }
+        s += "{\"media\":";
+        anexar_valor(s, b.soma[i] / b.amostras);
+        s += ",\"min\":";
+        anexar_valor(s, b.min[i]);
+        s += ",\"max\":";
+        anexar_valor(s, b.max[i]);
+        s += '}';
+    }
+}
+
+std::string resposta(int status, const std::string &corpo)
+{
+    const char *texto = status == 200   ? "OK"
+                        : status == 400 ? "Bad Request"
+                        : status == 404 ? "Not Found"
+                                        : "Method Not Allowed";
+    std::string r;
+    r.reserve(corpo.size() + 96);
+    anexar(r, "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %zu\r\n\r\n", status, texto,
+           corpo.size() + 1);
+    r += corpo;
+    r += '\n';
+    return r;
+}
+
+int hex(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    c |= 0x20;
+    return c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+}
+
+// Valor de um parâmetro da query string, já decodificado (%2F, +)
+bool parametro(const std::string &consulta, const char *nome, std::string &valor)
+{
+    size_t tam = strlen(nome);
+    for (size_t i = 0; i < consulta.size();)
+    {
+        size_t fim = consulta.find('&', i);
+        if (fim == std::string::npos)
+            fim = consulta.size();
+        if (fim - i > tam && consulta.compare(i, tam, nome) == 0 && consulta[i + tam] == '=')
+        {
+            valor.clear();
+            for (size_t k = i + tam + 1; k < fim; k++)
+            {
+                if (consulta[k] == '%' && k + 2 < fim && hex(consulta[k + 1]) >= 0 && hex(consulta[k + 2]) >= 0)
+                {
+                    valor += (char)(hex(consulta[k + 1]) * 16 + hex(consulta[k + 2]));
+                    k += 2;
+                }
+                else
+                    valor += consulta[k] == '+' ? ' ' : consulta[k];
+            }
+            return true;
+        }
+        i = fim + 1;
+    }
+    return false;
+}
+
+bool parametro_inteiro(const std::string &consulta, const char *nome, int64_t &valor)
+{
+    std::string s;
+    if (!parametro(consulta, nome, s))
+        return false;
+    char *fim;
+    valor = strtoll(s.c_str(), &fim, 10);
+    return !s.empty() && !*fim;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Agregados
+
+void Balde::somar(const float *v, bool alarme)
+{
+    for (int i = 0; i < CANAIS_SAUDE; i++)
+    {
+        soma[i] += v[i];
+        min[i] = amostras && min[i] < v[i] ? min[i] : v[i];
+        max[i] = amostras && max[i] > v[i] ? max[i] : v[i];
+    }
+    amostras++;
+    alarmes += alarme;
+}
+
+void Balde::juntar(const Balde &b)
+{
+    if (!b.amostras)
+        return;
+    for (int i = 0; i < CANAIS_SAUDE; i++)
+    {
+        soma[i] += b.soma[i];
+        min[i] = amostras && min[i] < b.min[i] ? min[i] : b.min[i];
+        max[i] = amostras && max[i] > b.max[i] ? max[i] : b.max[i];
+    }
+    amostras += b.amostras;
+    alarmes += b.alarmes;
+}
+
+Agregados::Agregados(const std::vector<std::string> &caminhos, const Beeespecies *especie) : especie(especie)
+{
+    for (auto &c : caminhos)
+    {
+        colmeias.emplace_back(new AgregadosColmeia);
+        colmeias.back()->caminho = c;
+    }
+}
+
+int Agregados::buscar(const std::string &caminho) const
+{
+    for (size_t i = 0; i < colmeias.size(); i++)
+        if (colmeias[i]->caminho == caminho)
+            return (int)i;
+    return -1;
+}
+
+void Agregados::registrar(size_t colmeia, int64_t t_ms, const char *linha, size_t n)
+{
+    // Só linhas de telemetria: respostas de comandos e anúncios não têm os canais
+    float v[CANAIS_SAUDE];
+    for (int i = 0; i < NUM_CANAIS; i++)
+        if (!numero(linha, n, CAMPOS[i], v[i]))
+            return;
+    v[NUM_CANAIS] = pontuacao_saude(especie, v[CANAL_TEMP], v[CANAL_UMID]);
+    uint8_t anom = anomalias(linha, n);
+    bool alarme = v[NUM_CANAIS] < LIMIAR_ALARME;
+
+    AgregadosColmeia &c = *colmeias[colmeia];
+    std::lock_guard<std::mutex> trava(c.trava);
+    if (!c.minutos)
+    {
+        c.minutos.reset(new Balde[MINUTOS]);
+        c.horas.reset(new Balde[HORAS]);
+    }
+    if (Balde *b = balde(c.minutos.get(), MINUTOS, t_ms / MS_MINUTO))
+        b->somar(v, alarme);
+    if (Balde *b = balde(c.horas.get(), HORAS, t_ms / MS_HORA))
+        b->somar(v, alarme);
+
+    memcpy(c.ultimo, v, sizeof v);
+    c.t_ultimo = t_ms;
+    c.amostras++;
+
+    // Evento: entrada em alarme ou um detector a mais disparado
+    bool ativo = alarme || anom;
+    if ((ativo && !c.em_alarme) || (anom & ~c.anomalias))
+        c.alarmes[c.n_alarmes++ % ALARMES_RECENTES] = Alarme{t_ms, v[NUM_CANAIS], anom};
+    c.em_alarme = ativo;
+    c.anomalias = anom;
+}
+
+void Agregados::publicar(size_t colmeia)
+{
+    colmeias[colmeia]->geracao.fetch_add(1, std::memory_order_release);
+    geracao_global.fetch_add(1, std::memory_order_release);
+}
+
+// As horas entram até a primeira hora cheia dentro do anel de minutos; dali em
+// diante, os minutos. Os extremos são arredondados para o balde que os contém.
+Balde Agregados::intervalo(const AgregadosColmeia &c, int64_t de, int64_t ate)
+{
+    Balde r;
+    if (!c.minutos || de > ate || de < 0)
+        return r;
+    int64_t m_fim = c.t_ultimo / MS_MINUTO;
+    int64_t h_corte = (m_fim - MINUTOS + 1 + 59) / 60;
+
+    int64_t h0 = std::max(de / MS_HORA, h_corte - HORAS), h1 = std::min(ate / MS_HORA, h_corte - 1);
+    for (int64_t h = std::max<int64_t>(h0, 0); h <= h1; h++)
+        if (c.horas[h % HORAS].periodo == h)
+            r.juntar(c.horas[h % HORAS]);
+
+    int64_t m0 = std::max(de / MS_MINUTO, h_corte * 60), m1 = std::min(ate / MS_MINUTO, m_fim);
+    for (int64_t m = std::max<int64_t>(m0, 0); m <= m1; m++)
+        if (c.minutos[m % MINUTOS].periodo == m)
+            r.juntar(c.minutos[m % MINUTOS]);
+    return r;
+}
+
+// ---------------------------------------------------------------------------
+// Cache
+
+const std::string *CacheRespostas::buscar(const std::string &chave, int colmeia, uint64_t geracao, int64_t minuto)
+{
+    auto it = indice.find(chave);
+    if (it == indice.end())
+    {
+        faltas++;
+        return nullptr;
+    }
+    Entrada &e = *it->second;
+    if (e.colmeia != colmeia || e.geracao != geracao || e.minuto != minuto)
+    {
+        // Dado novo na colmeia (ou o minuto virou): a resposta é refeita
+        lru.erase(it->second);
+        indice.erase(it);
+        invalidadas++;
+        faltas++;
+        return nullptr;
+    }
+    lru.splice(lru.begin(), lru, it->second);
+    acertos++;
+    return &e.resposta;
+}
+
+const std::string &CacheRespostas::guardar(const std::string &chave, int colmeia, uint64_t geracao, int64_t minuto,
+                                           std::string resposta)
+{
+    auto it = indice.find(chave);
+    if (it != indice.end())
+    {
+        lru.erase(it->second);
+        indice.erase(it);
+    }
+    lru.push_front(Entrada{chave, colmeia, geracao, minuto, std::move(resposta)});
+    indice[chave] = lru.begin();
+    if (lru.size() > capacidade)
+    {
+        indice.erase(lru.back().chave);
+        lru.pop_back();
+    }
+    return lru.front().resposta;
+}
+
+// ---------------------------------------------------------------------------
+// Servidor
+
+ServidorConsulta::ServidorConsulta(Agregados &agregados, int porta, size_t cache)
+    : agregados(agregados), cache(cache ? cache : 1)
+{
+    ep = epoll_create1(EPOLL_CLOEXEC);
+    acordar = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    escuta = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int um = 1;
+    setsockopt(escuta, SOL_SOCKET, SO_REUSEADDR, &um, sizeof um);
+    // Só local: os painéis ficam na mesma máquina ou atrás de um proxy
+    sockaddr_in endereco{};
+    endereco.sin_family = AF_INET;
+    endereco.sin_port = htons(porta);
+    endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(escuta, (sockaddr *)&endereco, sizeof endereco) < 0 || listen(escuta, SOMAXCONN) < 0)
+    {
+        perror("--http");
+        close(escuta);
+        escuta = -1;
+        return;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = escuta;
+    epoll_ctl(ep, EPOLL_CTL_ADD, escuta, &ev);
+    ev.data.fd = acordar;
+    epoll_ctl(ep, EPOLL_CTL_ADD, acordar, &ev);
+}
+
+ServidorConsulta::~ServidorConsulta()
+{
+    for (auto &c : conexoes)
+        close(c.first);
+    if (escuta >= 0)
+        close(escuta);
+    close(acordar);
+    close(ep);
+}
+
+void ServidorConsulta::parar()
+{
+    uint64_t um = 1;
+    (void)!write(acordar, &um, sizeof um);
+}
+
+void ServidorConsulta::aceitar()
+{
+    for (;;)
+    {
+        int fd = accept4(escuta, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+            return; // EAGAIN, ou falta de descritores: tenta no próximo evento
+        int um = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &um, sizeof um);
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev);
+        conexoes[fd].reset(new Conexao{fd, {}, {}});
+    }
+}
+
+void ServidorConsulta::encerrar(Conexao &c)
+{
+    epoll_ctl(ep, EPOLL_CTL_DEL, c.fd, nullptr);
+    close(c.fd);
+    conexoes.erase(c.fd);
+}
+
+// false quando a conexão deve ser fechada
+bool ServidorConsulta::ler(Conexao &c)
+{
+    char buf[4096];
+    for (;;)
+    {
+        ssize_t n = read(c.fd, buf, sizeof buf);
+        if (n > 0)
+        {
+            c.entrada.append(buf, n);
+            if (c.entrada.size() > REQUISICAO_MAX && c.entrada.find("\r\n\r\n") == std::string::npos)
+                return false;
+            continue;
+        }
+        if (n == 0)
+            return false;
+        if (errno == EAGAIN)
+            break;
+        if (errno != EINTR)
+            return false;
+    }
+    // Várias requisições de uma vez (pipelining) saem na ordem
+    size_t usado = 0, fim;
+    while (!c.fechar && (fim = c.entrada.find("\r\n\r\n", usado)) != std::string::npos)
+    {
+        atender(c, c.entrada.data() + usado, fim - usado);
+        usado = fim + 4;
+    }
+    c.entrada.erase(0, usado);
+    return escrever(c);
+}
+
+// Envia o que couber; o resto espera EPOLLOUT. false quando a conexão deve
+// ser fechada.
+bool ServidorConsulta::escrever(Conexao &c)
+{
+    while (c.enviado < c.saida.size())
+    {
+        ssize_t n = send(c.fd, c.saida.data() + c.enviado, c.saida.size() - c.enviado, MSG_NOSIGNAL);
+        if (n > 0)
+        {
+            c.enviado += n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && errno == EAGAIN)
+        {
+            if (!c.esperando_saida)
+            {
+                epoll_event ev{};
+                ev.events = EPOLLIN | EPOLLOUT;
+                ev.data.fd = c.fd;
+                epoll_ctl(ep, EPOLL_CTL_MOD, c.fd, &ev);
+                c.esperando_saida = true;
+            }
+            return true;
+        }
+        return false;
+    }
+    c.saida.clear();
+    c.enviado = 0;
+    if (c.esperando_saida)
+    {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = c.fd;
+        epoll_ctl(ep, EPOLL_CTL_MOD, c.fd, &ev);
+        c.esperando_saida = false;
+    }
+    return !c.fechar;
+}
+
+void ServidorConsulta::atender(Conexao &c, const char *requisicao, size_t n)
+{
+    int64_t inicio = agora_ns();
+    const char *fim_linha = (const char *)memmem(requisicao, n, "\r\n", 2);
+    if (!fim_linha)
+        fim_linha = requisicao + n;
+    std::string linha(requisicao, fim_linha);
+    std::string cabecalhos(fim_linha, requisicao + n);
+
+    size_t espaco = linha.find(' ', 4);
+    if (linha.compare(0, 4, "GET ") != 0 || espaco == std::string::npos)
+    {
+        c.saida += resposta(405, "{\"erro\":\"apenas GET\"}");
+        c.fechar = true;
+        return;
+    }
+    if (linha.compare(espaco + 1, std::string::npos, "HTTP/1.0") == 0 ||
+        strcasestr(cabecalhos.c_str(), "connection: close"))
+        c.fechar = true;
+
+    c.saida += responder(linha.substr(4, espaco - 4));
+    requisicoes++;
+    servico.registrar(agora_ns() - inicio);
+}
+
+const std::string &ServidorConsulta::responder(const std::string &alvo)
+{
+    size_t q = alvo.find('?');
+    std::string caminho = alvo.substr(0, q);
+    std::string consulta = q == std::string::npos ? "" : alvo.substr(q + 1);
+    int64_t agora_ms = relogio_unix_ns() / 1000000;
+
+    if (caminho == "/metricas")
+    {
+        std::string b;
+        anexar(b,
+               "{\"requisicoes\":%llu,\"acertos\":%llu,\"faltas\":%llu,\"invalidadas\":%llu,\"conexoes\":%zu,"
+               "\"servico_p50_us\":%.1f,\"servico_p99_us\":%.1f}",
+               (unsigned long long)requisicoes, (unsigned long long)cache.acertos, (unsigned long long)cache.faltas,
+               (unsigned long long)cache.invalidadas, conexoes.size(), servico.percentil(0.5) / 1e3,
+               servico.percentil(0.99) / 1e3);
+        return erro = resposta(200, b);
+    }
+
+    int colmeia = -1;
+    std::string nome;
+    if (parametro(consulta, "colmeia", nome) && (colmeia = agregados.buscar(nome)) < 0)
+        return erro = resposta(404, "{\"erro\":\"colmeia desconhecida\"}");
+
+    // A geração é lida antes de montar a resposta: dado que chegue no meio
+    // já deixa a entrada velha
+    uint64_t geracao = colmeia >= 0 ? agregados[colmeia].geracao.load(std::memory_order_acquire) : agregados.geracao();
+    int64_t minuto = agora_ms / MS_MINUTO;
+    if (const std::string *r = cache.buscar(alvo, colmeia, geracao, minuto))
+        return *r;
+
+    int status = 200;
+    std::string b = corpo(caminho, consulta, colmeia, agora_ms, status);
+    if (status != 200)
+        return erro = resposta(status, b);
+    return cache.guardar(alvo, colmeia, geracao, minuto, resposta(200, b));
+}
+
+std::string ServidorConsulta::corpo(const std::string &caminho, const std::string &consulta, int colmeia,
+                                    int64_t agora_ms, int &status)
+{
+    std::string b;
+    size_t i0 = colmeia >= 0 ? colmeia : 0, i1 = colmeia >= 0 ? colmeia + 1 : agregados.tamanho();
+
+    if (caminho == "/colmeias")
+    {
+        b += "{\"colmeias\":[";
+        for (size_t i = i0; i < i1; i++)
+        {
+            AgregadosColmeia &c = agregados[i];
+            std::lock_guard<std::mutex> trava(c.trava);
+            anexar(b, "%s{\"colmeia\":\"%s\",\"t\":%lld,\"amostras\":%llu,\"alarme\":%s}", i > i0 ? "," : "",
+                   c.caminho.c_str(), (long long)c.t_ultimo, (unsigned long long)c.amostras,
+                   c.em_alarme ? "true" : "false");
+        }
+        b += "]}";
+    }
+    else if (caminho == "/ultimo")
+    {
+        if (colmeia < 0)
+        {
+            status = 400;
+            return "{\"erro\":\"falta colmeia\"}";
+        }
+        AgregadosColmeia &c = agregados[colmeia];
+        std::lock_guard<std::mutex> trava(c.trava);
+        anexar(b, "{\"colmeia\":\"%s\",\"t\":%lld,\"amostras\":%llu", c.caminho.c_str(), (long long)c.t_ultimo,
+               (unsigned long long)c.amostras);
+        for (int i = 0; i < CANAIS_SAUDE; i++)
+        {
+            anexar(b, ",\"%s\":", NOMES[i]);
+            anexar_valor(b, c.amostras ? c.ultimo[i] : NAN);
+        }
+        b += ",\"anom\":[";
+        for (int i = 0; i < NUM_CANAIS; i++)
+            anexar(b, i ? ",%d" : "%d", (c.anomalias >> i) & 1);
+        anexar(b, "],\"alarme\":%s}", c.em_alarme ? "true" : "false");
+    }
+    else if (caminho == "/agregado")
+    {
+        if (colmeia < 0)
+        {
+            status = 400;
+            return "{\"erro\":\"falta colmeia\"}";
+        }
+        // Os parâmetros vêm direto do strtoll: limitados antes de qualquer
+        // multiplicação ou soma, que estourariam o int64_t
+        int64_t de = agora_ms - 24 * MS_HORA, ate = agora_ms, horas, passo = 0;
+        if (parametro_inteiro(consulta, "horas", horas))
+        {
+            if (horas < 0 || horas > HORAS_CONSULTA_MAX)
+            {
+                status = 400;
+                return "{\"erro\":\"horas fora de 0 a " + std::to_string(HORAS_CONSULTA_MAX) + "\"}";
+            }
+            de = agora_ms - horas * MS_HORA;
+        }
+        parametro_inteiro(consulta, "de", de);
+        parametro_inteiro(consulta, "ate", ate);
+        parametro_inteiro(consulta, "passo", passo);
+        if (passo < 0 || passo > HORAS_CONSULTA_MAX * 60 || de < 0 || de > ate ||
+            (passo && ate > INT64_MAX - passo * MS_MINUTO) ||
+            (passo && (ate - de) / (passo * MS_MINUTO) >= PONTOS_MAX))
+        {
+            status = 400;
+            return "{\"erro\":\"intervalo ou passo inválido\"}";
+        }
+        passo *= MS_MINUTO;
+
+        AgregadosColmeia &c = agregados[colmeia];
+        std::lock_guard<std::mutex> trava(c.trava);
+        anexar(b, "{\"colmeia\":\"%s\",\"de\":%lld,\"ate\":%lld,", c.caminho.c_str(), (long long)de, (long long)ate);
+        anexar_balde(b, Agregados::intervalo(c, de, ate));
+        if (passo)
+        {
+            b += ",\"serie\":[";
+            for (int64_t t = de; t <= ate; t += passo)
+            {
+                anexar(b, "%s{\"de\":%lld,", t > de ? "," : "", (long long)t);
+                anexar_balde(b, Agregados::intervalo(c, t, std::min(t + passo - 1, ate)));
+                b += '}';
+            }
+            b += ']';
+        }
+        b += '}';
+    }
+    else if (caminho == "/alarmes")
+    {
+        b += "{\"alarmes\":[";
+        bool primeira = true;
+        for (size_t i = i0; i < i1; i++)
+        {
+            AgregadosColmeia &c = agregados[i];
+            std::lock_guard<std::mutex> trava(c.trava);
+            if (colmeia < 0 && !c.n_alarmes)
+                continue;
+            anexar(b, "%s{\"colmeia\":\"%s\",\"ativo\":%s,\"eventos\":%llu,\"recentes\":[", primeira ? "" : ",",
+                   c.caminho.c_str(), c.em_alarme ? "true" : "false", (unsigned long long)c.n_alarmes);
+            primeira = false;
+            uint64_t n = std::min<uint64_t>(c.n_alarmes, ALARMES_RECENTES);
+            for (uint64_t k = 0; k < n; k++)
+            {
+                const Alarme &a = c.alarmes[(c.n_alarmes - 1 - k) % ALARMES_RECENTES];
+                anexar(b, "%s{\"t\":%lld,\"saude\":%.3f,\"anom\":%u}", k ? "," : "", (long long)a.t, a.saude,
+                       a.anomalias);
+            }
+            b += "]}";
+        }
+        b += "]}";
+    }
+    else if (caminho == "/saude")
+    {
+        anexar(b, "{\"especie\":\"%s\",\"limiar\":%.2f,\"colmeias\":[", agregados.especie_avaliada()->nome,
+               LIMIAR_ALARME);
+        for (size_t i = i0; i < i1; i++)
+        {
+            AgregadosColmeia &c = agregados[i];
+            std::lock_guard<std::mutex> trava(c.trava);
+            Balde dia = Agregados::intervalo(c, agora_ms - 24 * MS_HORA, agora_ms);
+            anexar(b, "%s{\"colmeia\":\"%s\",\"saude\":", i > i0 ? "," : "", c.caminho.c_str());
+            anexar_valor(b, c.amostras ? c.ultimo[NUM_CANAIS] : NAN);
+            b += ",\"media_24h\":";
+            anexar_valor(b, dia.amostras ? dia.soma[NUM_CANAIS] / dia.amostras : NAN);
+            b += ",\"min_24h\":";
+            anexar_valor(b, dia.amostras ? dia.min[NUM_CANAIS] : NAN);
+            b += ",\"em_alarme_24h\":";
+            anexar_valor(b, dia.amostras ? (double)dia.alarmes / dia.amostras : NAN);
+            b += '}';
+        }
+        b += "]}";
+    }
+    else
+    {
+        status = 404;
+        b = "{\"erro\":\"consultas: /colmeias /ultimo /agregado /alarmes /saude /metricas\"}";
+    }
+    return b;
+}
+
+void ServidorConsulta::executar()
+{
+    epoll_event eventos[256];
+    for (;;)
+    {
+        int n = epoll_wait(ep, eventos, 256, -1);
+        if (n < 0 && errno != EINTR)
+            break;
+        for (int k = 0; k < n; k++)
+        {
+            int fd = eventos[k].data.fd;
+            if (fd == acordar)
+            {
+                fprintf(stderr,
+                        "{\"consultas\":\"final\",\"requisicoes\":%llu,\"acertos\":%llu,\"faltas\":%llu,"
+                        "\"invalidadas\":%llu,\"servico_p50_us\":%.1f,\"servico_p99_us\":%.1f}\n",
+                        (unsigned long long)requisicoes, (unsigned long long)cache.acertos,
+                        (unsigned long long)cache.faltas, (unsigned long long)cache.invalidadas,
+                        servico.percentil(0.5) / 1e3, servico.percentil(0.99) / 1e3);
+                return;
+            }
+            if (fd == escuta)
+            {
+                aceitar();
+                continue;
+            }
+            auto it = conexoes.find(fd);
+            if (it == conexoes.end())
+                continue;
+            Conexao &c = *it->second;
+            bool segue;
+            if (eventos[k].events & EPOLLIN)
+                segue = ler(c);
+            else if (eventos[k].events & EPOLLOUT)
+                segue = escrever(c);
+            else
+                segue = false; // EPOLLERR/EPOLLHUP sem dados
+            if (!segue)
+                encerrar(c);
+        }
+    }
+}
@@ -0,0 +1,197 @@
+#ifndef CONSULTA_HPP
+#define CONSULTA_HPP
+
+// Consultas locais do gateway: agregados mantidos a cada linha gravada e um
+// servidor HTTP/JSON para os painéis do apiário.
+//
+// Agregados: por colmeia, o último valor de cada canal e dois anéis de baldes
+// (por minuto nas últimas 24 h, por hora nos últimos 7 dias) com contagem,
+// soma, mínimo e máximo dos canais e do índice de saúde do firmware
+// (pontuacao_saude). Uma consulta de intervalo junta no máximo algumas
+// centenas de baldes, sem reler nada do log. A thread de escrita atualiza sob
+// o mutex da colmeia e, a cada lote, avança a geração dela.
+//
+// Servidor: uma thread com epoll, sockets não bloqueantes e keep-alive. As
+// respostas prontas (cabeçalho + corpo) ficam num cache LRU com a geração da
+// colmeia de que dependem: dado novo numa colmeia invalida só as respostas
+// dela; as consultas de todas as colmeias dependem da geração global.
+//
+//   GET /colmeias
+//   GET /ultimo?colmeia=/dev/ttyACM0
+//   GET /agregado?colmeia=..&horas=24[&passo=60]   ou  &de=ms&ate=ms
+//   GET /alarmes[?colmeia=..]
+//   GET /saude[?colmeia=..]
+//   GET /metricas
+
+#include "metricas.hpp"
+
+extern "C"
+{
+#include "especies.h"
+#include "pontuacao.h"
+}
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+constexpr int CANAIS_SAUDE = NUM_CANAIS + 1; // canais e, por último, a saúde
+constexpr int MINUTOS = 24 * 60;
+constexpr int HORAS = 7 * 24;
+constexpr int ALARMES_RECENTES = 32;
+
+struct Balde
+{
+    int64_t periodo = -1; // minuto ou hora Unix do balde; -1 vazio
+    uint32_t amostras = 0;
+    uint32_t alarmes = 0; // amostras com saúde abaixo de LIMIAR_ALARME
+    double soma[CANAIS_SAUDE] = {};
+    float min[CANAIS_SAUDE] = {};
+    float max[CANAIS_SAUDE] = {};
+
+    void somar(const float *v, bool alarme);
+    void juntar(const Balde &b);
+};
+
+struct Alarme
+{
+    int64_t t;      // ms Unix
+    float saude;
+    uint8_t anomalias; // bit por canal (CANAL_TEMP ...)
+};
+
+struct AgregadosColmeia
+{
+    std::string caminho;
+    std::mutex trava;
+    std::atomic<uint64_t> geracao{0};
+
+    // Tudo abaixo sob a trava
+    int64_t t_ultimo = -1; // ms Unix
+    float ultimo[CANAIS_SAUDE] = {};
+    uint8_t anomalias = 0;
+    uint64_t amostras = 0;
+    std::unique_ptr<Balde[]> minutos; // alocados na primeira amostra
+    std::unique_ptr<Balde[]> horas;
+    Alarme alarmes[ALARMES_RECENTES];
+    uint64_t n_alarmes = 0; // eventos desde o início; o anel guarda os últimos
+    bool em_alarme = false;
+};
+
+class Agregados
+{
+public:
+    Agregados(const std::vector<std::string> &caminhos, const Beeespecies *especie);
+
+    // Thread de escrita: uma linha de telemetria (JSON do firmware)
+    void registrar(size_t colmeia, int64_t t_ms, const char *linha, size_t n);
+    // Fim do lote: as respostas em cache desta colmeia ficam velhas
+    void publicar(size_t colmeia);
+
+    size_t tamanho() const
+    {
+        return colmeias.size();
+    }
+    AgregadosColmeia &operator[](size_t i)
+    {
+        return *colmeias[i];
+    }
+    // Índice pelo caminho; -1 se não existir
+    int buscar(const std::string &caminho) const;
+    uint64_t geracao() const
+    {
+        return geracao_global.load(std::memory_order_acquire);
+    }
+    const Beeespecies *especie_avaliada() const
+    {
+        return especie;
+    }
+
+    // Junta os baldes de [de, ate] (ms Unix): minutos onde o anel cobre,
+    // horas antes disso. Chamar com a trava da colmeia.
+    static Balde intervalo(const AgregadosColmeia &c, int64_t de, int64_t ate);
+
+private:
+    std::vector<std::unique_ptr<AgregadosColmeia>> colmeias;
+    std::atomic<uint64_t> geracao_global{0};
+    const Beeespecies *especie;
+};
+
+// LRU de respostas HTTP prontas
+class CacheRespostas
+{
+public:
+    explicit CacheRespostas(size_t capacidade) : capacidade(capacidade) {}
+
+    // colmeia -1: depende de todas (geração global)
+    const std::string *buscar(const std::string &chave, int colmeia, uint64_t geracao, int64_t minuto);
+    const std::string &guardar(const std::string &chave, int colmeia, uint64_t geracao, int64_t minuto,
+                               std::string resposta);
+
+    uint64_t acertos = 0, faltas = 0, invalidadas = 0;
+
+private:
+    struct Entrada
+    {
+        std::string chave;
+        int colmeia;
+        uint64_t geracao;
+        int64_t minuto; // consultas relativas ao "agora" andam com o relógio
+        std::string resposta;
+    };
+    size_t capacidade;
+    std::list<Entrada> lru; // mais recente na frente
+    std::unordered_map<std::string, std::list<Entrada>::iterator> indice;
+};
+
+class ServidorConsulta
+{
+public:
+    ServidorConsulta(Agregados &agregados, int porta, size_t cache);
+    ~ServidorConsulta();
+
+    bool ok() const
+    {
+        return escuta >= 0;
+    }
+    // Laço da thread do servidor, até parar()
+    void executar();
+    void parar();
+
+private:
+    struct Conexao
+    {
+        int fd;
+        std::string entrada;
+        std::string saida;
+        size_t enviado = 0;
+        bool fechar = false;         // depois de enviar o que falta
+        bool esperando_saida = false; // EPOLLOUT ligado
+    };
+
+    void aceitar();
+    bool ler(Conexao &c);
+    bool escrever(Conexao &c);
+    void encerrar(Conexao &c);
+    void atender(Conexao &c, const char *requisicao, size_t n);
+    const std::string &responder(const std::string &alvo);
+    std::string corpo(const std::string &caminho, const std::string &consulta, int colmeia, int64_t agora_ms,
+                      int &status);
+
+    Agregados &agregados;
+    CacheRespostas cache;
+    int escuta = -1;
+    int ep = -1;
+    int acordar = -1;
+    std::unordered_map<int, std::unique_ptr<Conexao>> conexoes;
+    std::string erro; // resposta fora do cache
+    uint64_t requisicoes = 0;
+    Histograma servico; // da requisição completa à resposta na fila do socket
+};
+
+#endif
@@ -0,0 +1,838 @@
+// Gateway de campo: lê a telemetria de muitas BeeSense (USB/UART ou ptys nos
+// testes) e grava um fluxo único de linhas JSON.
+//
+// Thread de leitura: um laço epoll sobre todas as portas. Cada colmeia tem um
+// AnelBytes; o readv escreve direto no espaço livre do anel e a varredura de
+// fim de linha (memchr) só publica descritores {início, tamanho, t_rx} numa
+// FilaSpsc. Thread de escrita: acordada por eventfd, junta um lote de todas as
+// colmeias e grava com writev apontando para os bytes dentro dos anéis, depois
+// os devolve. A memória é fixa: colmeias × (anel + fila).
+//
+// Capturas brutas: uma linha {"captura": {"bytes": n, "baud": b, ...}} anuncia
+// um quadro binário (inc/quadro.h). Se os bytes seguintes começam pela mágica,
+// a leitura troca o baud da porta, junta o quadro fora do anel, confere o CRC e
+// o grava em --capturas; senão (anúncio vindo pela USB, sem o quadro) o texto
+// continua normalmente.
+//
+// Consultas (--http porta): a escrita também alimenta os agregados por
+// colmeia, e uma terceira thread responde HTTP/JSON em 127.0.0.1 (consulta.hpp).
+
+#include "anel.hpp"
+#include "consulta.hpp"
+#include "metricas.hpp"
+#include "serial.hpp"
+
+extern "C"
+{
+#include "quadro.h"
+}
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t LINHA_MAX = 2048;  // linhas maiores são tratadas como lixo
+constexpr size_t BYTES_POR_LINHA = 32; // dimensiona a fila de descritores pelo anel
+constexpr int IOV_LOTE = 1020;      // abaixo de IOV_MAX; de 3 a 4 iovecs por linha
+constexpr size_t PREFIXO_MAX = 128;
+
+struct Linha
+{
+    uint64_t inicio;
+    uint32_t tamanho; // sem o '\n' (nem '\r')
+    int64_t t_rx;     // CLOCK_MONOTONIC da chegada do fim de linha
+};
+
+struct Colmeia
+{
+    Colmeia(std::string caminho, size_t anel_bytes)
+        : caminho(std::move(caminho)), anel(anel_bytes), linhas(anel_bytes / BYTES_POR_LINHA)
+    {
+    }
+
+    std::string caminho;
+    int fd = -1;
+    std::atomic<bool> conectada{false};
+    AnelBytes anel;
+    FilaSpsc<Linha> linhas;
+
+    // Só a thread de leitura
+    uint64_t inicio_linha = 0; // começo da linha em montagem
+    uint64_t varrido = 0;      // até onde já se procurou '\n'
+    bool descartando = false;  // linha atual corrompida: ignora até o próximo '\n'
+
+    // Quadro binário anunciado e, depois de conferida a mágica, em montagem
+    size_t quadro_anunciado = 0;
+    size_t quadro_faltam = 0;
+    std::vector<uint8_t> quadro;
+    int64_t quadro_prazo = 0;
+    bool baud_trocado = false;
+
+    // Fim da última linha fechada (publicada ou descartada): a escrita pode
+    // devolver até aqui quando a fila esvaziar
+    std::atomic<uint64_t> fechado{0};
+
+    // Só a thread de escrita
+    uint64_t liberar = 0; // posição a devolver ao anel depois do writev
+    bool tocada = false;  // já está na lista do lote
+
+    // Contadores (leitura escreve, escrita lê para as métricas)
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> perdidos{0};   // bytes que não couberam no anel
+    std::atomic<uint64_t> invalidas{0};  // linhas longas, cortadas ou que não são JSON
+    std::atomic<uint64_t> sem_fila{0};   // linhas descartadas com a fila cheia
+    std::atomic<uint64_t> reconexoes{0};
+    std::atomic<uint64_t> capturas{0};
+    std::atomic<uint64_t> capturas_invalidas{0}; // CRC errado, cortadas ou fora do prazo
+};
+
+struct Opcoes
+{
+    std::string saida = "-";
+    std::string capturas = ".";
+    int baud = 115200;
+    size_t anel_kb = 16;
+    int lote_ms = 20;
+    int metricas_s = 5;
+    int http = 0;
+    size_t cache = 4096;
+    std::string especie = "Jataí";
+    std::vector<std::string> dispositivos;
+};
+
+std::atomic<bool> parar{false};
+
+void uso(const char *programa)
+{
+    fprintf(stderr,
+            "uso: %s [--saida arquivo] [--capturas dir] [--baud n] [--anel KB] [--lote ms] [--metricas s]\n"
+            "          [--http porta] [--cache n] [--especie nome] dispositivo...\n"
+            "  --capturas dir  onde gravar os quadros de captura bruta .bsq (padrão .)\n"
+            "  --anel KB     anel por colmeia, potência de 2 (padrão 16)\n"
+            "  --lote ms     janela de acúmulo da escrita (padrão 20)\n"
+            "  --metricas s  intervalo do relatório em stderr, 0 desliga (padrão 5)\n"
+            "  --http porta  servidor de consultas em 127.0.0.1 (padrão desligado)\n"
+            "  --cache n     respostas guardadas pelo servidor de consultas (padrão 4096)\n"
+            "  --especie nome  espécie do índice de saúde das consultas (padrão Jataí)\n",
+            programa);
+}
+
+bool ler_opcoes(int argc, char **argv, Opcoes &op)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string a = argv[i];
+        bool tem_valor = i + 1 < argc;
+        if (a == "--saida" && tem_valor)
+            op.saida = argv[++i];
+        else if (a == "--capturas" && tem_valor)
+            op.capturas = argv[++i];
+        else if (a == "--baud" && tem_valor)
+            op.baud = atoi(argv[++i]);
+        else if (a == "--anel" && tem_valor)
+            op.anel_kb = strtoul(argv[++i], nullptr, 10);
+        else if (a == "--lote" && tem_valor)
+            op.lote_ms = atoi(argv[++i]);
+        else if (a == "--metricas" && tem_valor)
+            op.metricas_s = atoi(argv[++i]);
+        else if (a == "--http" && tem_valor)
+            op.http = atoi(argv[++i]);
+        else if (a == "--cache" && tem_valor)
+            op.cache = strtoul(argv[++i], nullptr, 10);
+        else if (a == "--especie" && tem_valor)
+            op.especie = argv[++i];
+        else if (a.size() > 1 && a[0] == '-')
+            return false;
+        else
+            op.dispositivos.push_back(a);
+    }
+    size_t anel = op.anel_kb * 1024;
+    if (anel < 2 * LINHA_MAX || (anel & (anel - 1)))
+    {
+        fprintf(stderr, "--anel precisa ser potência de 2 e ao menos %zu KB\n", 2 * LINHA_MAX / 1024);
+        return false;
+    }
+    if (especies_buscar(op.especie.c_str()) < 0)
+    {
+        fprintf(stderr, "espécie desconhecida: %s\n", op.especie.c_str());
+        return false;
+    }
+    return !op.dispositivos.empty() && op.lote_ms >= 0 && op.http >= 0 && op.http < 65536;
+}
+
+// Byte numa posição do anel
+uint8_t byte_em(const AnelBytes &anel, uint64_t pos)
+{
+    iovec iov[2];
+    anel.trechos(pos, 1, iov);
+    return *(const uint8_t *)iov[0].iov_base;
+}
+
+// A linha inteira num trecho contíguo: direto no anel ou, se ela dá a volta
+// (raro), copiada para o buffer de LINHA_MAX + 1 bytes
+const char *linha_contigua(const AnelBytes &anel, const Linha &l, char *copia)
+{
+    iovec iov[2];
+    anel.trechos(l.inicio, l.tamanho, iov);
+    if (!iov[1].iov_len)
+        return (const char *)iov[0].iov_base;
+    memcpy(copia, iov[0].iov_base, iov[0].iov_len);
+    memcpy(copia + iov[0].iov_len, iov[1].iov_base, iov[1].iov_len);
+    return copia;
+}
+
+// Valor inteiro de um campo ("\"t_env\":"); -1 se a linha não o tiver
+int64_t campo_inteiro(const char *s, size_t n, const char *campo)
+{
+    size_t tam = strlen(campo);
+    const char *p = (const char *)memmem(s, n, campo, tam);
+    if (!p)
+        return -1;
+    return strtoll(p + tam, nullptr, 10);
+}
+
+// ---------------------------------------------------------------------------
+// Leitura
+
+class Leitor
+{
+public:
+    Leitor(std::vector<std::unique_ptr<Colmeia>> &colmeias, int baud, const std::string &capturas, int acordar)
+        : colmeias(colmeias), baud(baud), capturas(capturas), acordar(acordar)
+    {
+    }
+
+    int executar();
+
+private:
+    void conectar(size_t i);
+    void desconectar(Colmeia &c);
+    bool ler(Colmeia &c);
+    bool fechar_linhas(Colmeia &c, int64_t t_rx);
+    void publicar(Colmeia &c, uint64_t fim, int64_t t_rx, bool &publicou);
+    void anunciar_quadro(Colmeia &c, const Linha &l);
+    void encerrar_quadro(Colmeia &c, bool valido);
+
+    std::vector<std::unique_ptr<Colmeia>> &colmeias;
+    int baud;
+    std::string capturas;
+    int acordar;
+    int ep = -1;
+    uint8_t lixo[4096];
+};
+
+void Leitor::conectar(size_t i)
+{
+    Colmeia &c = *colmeias[i];
+    c.fd = serial_abrir(c.caminho, baud);
+    if (c.fd < 0)
+        return;
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = i;
+    epoll_ctl(ep, EPOLL_CTL_ADD, c.fd, &ev);
+    c.conectada = true;
+    // Resto de linha da conexão anterior não se junta ao que vier agora; o
+    // primeiro pedaço da nova, se vier cortado, falha na checagem de JSON
+    uint64_t pos = c.anel.posicao_escrita();
+    c.inicio_linha = c.varrido = pos;
+    c.descartando = false;
+    c.fechado.store(pos, std::memory_order_release);
+    c.reconexoes.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Leitor::desconectar(Colmeia &c)
+{
+    if (c.quadro_anunciado || c.quadro_faltam)
+        encerrar_quadro(c, false);
+    epoll_ctl(ep, EPOLL_CTL_DEL, c.fd, nullptr);
+    close(c.fd);
+    c.fd = -1;
+    c.conectada = false;
+}
+
+void Leitor::publicar(Colmeia &c, uint64_t fim, int64_t t_rx, bool &publicou)
+{
+    uint64_t inicio = c.inicio_linha;
+    uint64_t n = fim - inicio; // sem o '\n'
+    if (n && byte_em(c.anel, fim - 1) == '\r')
+        n--;
+
+    if (c.descartando)
+        c.descartando = false;
+    else if (n == 0)
+        ; // linha vazia
+    else if (n > LINHA_MAX || byte_em(c.anel, inicio) != '{' || byte_em(c.anel, inicio + n - 1) != '}')
+        c.invalidas.fetch_add(1, std::memory_order_relaxed);
+    else if (!c.linhas.colocar(Linha{inicio, (uint32_t)n, t_rx}))
+        c.sem_fila.fetch_add(1, std::memory_order_relaxed);
+    else
+    {
+        publicou = true;
+        anunciar_quadro(c, Linha{inicio, (uint32_t)n, t_rx});
+    }
+
+    c.inicio_linha = fim + 1;
+    c.fechado.store(fim + 1, std::memory_order_release);
+}
+
+// Linha de anúncio de captura: espera o quadro binário logo depois dela
+void Leitor::anunciar_quadro(Colmeia &c, const Linha &l)
+{
+    static const char anuncio[] = "\"captura\": {";
+    char copia[LINHA_MAX + 1];
+    const char *s = linha_contigua(c.anel, l, copia);
+    // O anúncio começa pelo campo: as linhas de telemetria saem no primeiro teste
+    if (!memmem(s, l.tamanho < 16 ? l.tamanho : 16, anuncio, 9) || !memmem(s, l.tamanho, anuncio, sizeof anuncio - 1))
+        return;
+    int64_t bytes = campo_inteiro(s, l.tamanho, "\"bytes\":");
+    int64_t baud_quadro = campo_inteiro(s, l.tamanho, "\"baud\":");
+    if (bytes < (int64_t)quadro_tamanho(0) || bytes > (1 << 24))
+        return;
+
+    c.quadro_anunciado = (size_t)bytes;
+    // Pausa do firmware, o quadro a 10 bits por byte e folga
+    int taxa = baud_quadro > 0 ? (int)baud_quadro : baud;
+    c.quadro_prazo = l.t_rx + 2000000000LL + (int64_t)(bytes * 10 * 1e9 / taxa);
+    if (baud_quadro > 0 && baud_quadro != baud && serial_definir_baud(c.fd, (int)baud_quadro))
+        c.baud_trocado = true;
+}
+
+void Leitor::encerrar_quadro(Colmeia &c, bool valido)
+{
+    if (c.baud_trocado && c.fd >= 0)
+        serial_definir_baud(c.fd, baud);
+    c.baud_trocado = false;
+
+    const quadro_cabecalho_t *cab;
+    const uint8_t *carga;
+    if (valido && quadro_validar(c.quadro.data(), c.quadro.size(), &cab, &carga))
+    {
+        std::string nome = c.caminho;
+        for (char &ch : nome)
+            if (ch == '/')
+                ch = '_';
+        nome = capturas + "/" + (nome[0] == '_' ? nome.substr(1) : nome) + "_" + std::to_string(cab->sequencia) + ".bsq";
+        FILE *f = fopen(nome.c_str(), "wb");
+        bool gravou = f && fwrite(c.quadro.data(), 1, c.quadro.size(), f) == c.quadro.size();
+        if (f)
+            gravou &= fclose(f) == 0;
+        if (gravou)
+        {
+            c.capturas.fetch_add(1, std::memory_order_relaxed);
+            fprintf(stderr, "{\"captura\":\"%s\",\"colmeia\":\"%s\",\"bytes\":%zu}\n", nome.c_str(),
+                    c.caminho.c_str(), c.quadro.size());
+        }
+        else
+        {
+            c.capturas_invalidas.fetch_add(1, std::memory_order_relaxed);
+            perror(nome.c_str());
+        }
+    }
+    else
+    {
+        c.capturas_invalidas.fetch_add(1, std::memory_order_relaxed);
+        fprintf(stderr, "%s: captura invalida\n", c.caminho.c_str());
+    }
+    c.quadro_anunciado = c.quadro_faltam = 0;
+    c.quadro.clear();
+    c.quadro.shrink_to_fit();
+}
+
+// Procura '\n' nos bytes novos; true se alguma linha foi para a fila (ou se
+// bytes de um quadro saíram do anel e a escrita precisa devolvê-los)
+bool Leitor::fechar_linhas(Colmeia &c, int64_t t_rx)
+{
+    bool publicou = false;
+    uint64_t fim = c.anel.posicao_escrita();
+    while (c.varrido < fim)
+    {
+        if (c.quadro_anunciado && !c.quadro_faltam)
+        {
+            // Mágica no começo: é o quadro; senão o anúncio veio sem ele
+            uint32_t magica = QUADRO_MAGICA;
+            size_t n = fim - c.varrido < 4 ? fim - c.varrido : 4;
+            size_t i = 0;
+            while (i < n && byte_em(c.anel, c.varrido + i) == ((const uint8_t *)&magica)[i])
+                i++;
+            if (i < n)
+            {
+                if (c.baud_trocado)
+                    serial_definir_baud(c.fd, baud);
+                c.baud_trocado = false;
+                c.quadro_anunciado = 0;
+                continue;
+            }
+            if (n < 4)
+                break; // espera o resto da mágica
+            c.quadro_faltam = c.quadro_anunciado;
+            c.quadro.reserve(c.quadro_anunciado);
+        }
+        if (c.quadro_faltam)
+        {
+            size_t n = fim - c.varrido < c.quadro_faltam ? fim - c.varrido : c.quadro_faltam;
+            iovec iov[2];
+            c.anel.trechos(c.varrido, n, iov);
+            for (auto &v : iov)
+                c.quadro.insert(c.quadro.end(), (uint8_t *)v.iov_base, (uint8_t *)v.iov_base + v.iov_len);
+            c.varrido += n;
+            c.quadro_faltam -= n;
+            c.inicio_linha = c.varrido;
+            c.fechado.store(c.varrido, std::memory_order_release);
+            publicou = true;
+            if (!c.quadro_faltam)
+                encerrar_quadro(c, true);
+            continue;
+        }
+
+        iovec iov[2];
+        c.anel.trechos(c.varrido, fim - c.varrido, iov);
+        const uint8_t *p = (const uint8_t *)iov[0].iov_base;
+        const uint8_t *nl = (const uint8_t *)memchr(p, '\n', iov[0].iov_len);
+        if (!nl)
+        {
+            c.varrido += iov[0].iov_len;
+            continue;
+        }
+        uint64_t pos = c.varrido + (uint64_t)(nl - p);
+        publicar(c, pos, t_rx, publicou);
+        c.varrido = pos + 1;
+    }
+
+    // Linha sem fim e já longa demais: solta os bytes e ignora o resto dela
+    if (fim - c.inicio_linha > LINHA_MAX)
+    {
+        if (!c.descartando)
+            c.invalidas.fetch_add(1, std::memory_order_relaxed);
+        c.descartando = true;
+        c.inicio_linha = fim;
+        c.fechado.store(fim, std::memory_order_release);
+    }
+    return publicou;
+}
+
+// false quando a porta caiu
+bool Leitor::ler(Colmeia &c)
+{
+    bool publicou = false;
+    for (;;)
+    {
+        iovec iov[2];
+        ssize_t n;
+        if (c.anel.livre(iov) == 0)
+        {
+            // Escrita atrasada: mantém a porta drenada e conta a perda. A
+            // linha em montagem fica incompleta, então é descartada também.
+            n = read(c.fd, lixo, sizeof lixo);
+            if (n > 0)
+            {
+                c.perdidos.fetch_add(n, std::memory_order_relaxed);
+                c.descartando = true;
+                continue;
+            }
+        }
+        else
+        {
+            n = readv(c.fd, iov, iov[1].iov_len ? 2 : 1);
+            if (n > 0)
+            {
+                c.anel.confirmar_escrita(n);
+                c.bytes.fetch_add(n, std::memory_order_relaxed);
+                publicou |= fechar_linhas(c, agora_ns());
+                continue;
+            }
+        }
+        if (publicou)
+        {
+            uint64_t um = 1;
+            (void)!write(acordar, &um, sizeof um);
+        }
+        if (n == 0)
+            return false;
+        return errno == EAGAIN || errno == EINTR;
+    }
+}
+
+int Leitor::executar()
+{
+    ep = epoll_create1(EPOLL_CLOEXEC);
+
+    sigset_t sinais;
+    sigemptyset(&sinais);
+    sigaddset(&sinais, SIGINT);
+    sigaddset(&sinais, SIGTERM);
+    int sfd = signalfd(-1, &sinais, SFD_CLOEXEC);
+
+    // Reconexão das portas ausentes a cada segundo
+    int tfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    itimerspec periodo{{1, 0}, {1, 0}};
+    timerfd_settime(tfd, 0, &periodo, nullptr);
+
+    const uint64_t SINAL = UINT64_MAX, TEMPO = UINT64_MAX - 1;
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = SINAL;
+    epoll_ctl(ep, EPOLL_CTL_ADD, sfd, &ev);
+    ev.data.u64 = TEMPO;
+    epoll_ctl(ep, EPOLL_CTL_ADD, tfd, &ev);
+
+    for (size_t i = 0; i < colmeias.size(); i++)
+    {
+        conectar(i);
+        if (colmeias[i]->fd < 0)
+            fprintf(stderr, "%s: %s (tentando de novo)\n", colmeias[i]->caminho.c_str(), strerror(errno));
+    }
+
+    epoll_event eventos[256];
+    while (!parar.load(std::memory_order_relaxed))
+    {
+        int n = epoll_wait(ep, eventos, 256, -1);
+        for (int k = 0; k < n; k++)
+        {
+            uint64_t id = eventos[k].data.u64;
+            if (id == SINAL)
+            {
+                parar = true;
+            }
+            else if (id == TEMPO)
+            {
+                uint64_t expiracoes;
+                (void)!read(tfd, &expiracoes, sizeof expiracoes);
+                int64_t agora = agora_ns();
+                for (size_t i = 0; i < colmeias.size(); i++)
+                {
+                    Colmeia &c = *colmeias[i];
+                    if (c.fd < 0)
+                        conectar(i);
+                    else if ((c.quadro_anunciado || c.quadro_faltam) && agora > c.quadro_prazo)
+                        encerrar_quadro(c, false);
+                }
+            }
+            else
+            {
+                Colmeia &c = *colmeias[id];
+                if (c.fd >= 0 && !ler(c))
+                {
+                    fprintf(stderr, "%s: desconectada\n", c.caminho.c_str());
+                    desconectar(c);
+                }
+            }
+        }
+    }
+
+    for (auto &c : colmeias)
+        if (c->fd >= 0)
+            desconectar(*c);
+    close(tfd);
+    close(sfd);
+    close(ep);
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Escrita
+
+class Escritor
+{
+public:
+    Escritor(std::vector<std::unique_ptr<Colmeia>> &colmeias, const Opcoes &op, int saida, int acordar,
+             Agregados *agregados)
+        : colmeias(colmeias), op(op), saida(saida), acordar(acordar), agregados(agregados)
+    {
+        prefixos.resize(IOV_LOTE / 3 * PREFIXO_MAX);
+    }
+
+    void executar();
+
+private:
+    size_t drenar(size_t i);
+    void gravar();
+    void relatar(double segundos, bool final);
+
+    std::vector<std::unique_ptr<Colmeia>> &colmeias;
+    const Opcoes &op;
+    int saida;
+    int acordar;
+    Agregados *agregados; // nullptr sem --http
+
+    // Lote em montagem: prefixo JSON + trechos do anel + sufixo, por linha
+    iovec iov[IOV_LOTE];
+    int n_iov = 0;
+    std::vector<char> prefixos;
+    size_t usado = 0;
+    std::vector<Colmeia *> tocadas;
+    std::vector<int64_t> t_rx;
+
+    // [0] no intervalo do relatório, [1] desde o início
+    Histograma lat_gateway[2]; // chegada -> gravado
+    Histograma lat_total[2];   // t_env do simulador -> gravado
+    uint64_t linhas = 0, linhas_total = 0, lotes = 0;
+    int64_t inicio = agora_ns();
+    // Somado ao CLOCK_MONOTONIC dá o horário Unix (campo "t", em ms)
+    int64_t desvio_unix = relogio_unix_ns() - agora_ns();
+    uint64_t bytes_gravados = 0;
+    bool falhou = false;
+};
+
+// Coloca as linhas da colmeia no lote; retorna quantas
+size_t Escritor::drenar(size_t i)
+{
+    Colmeia &c = *colmeias[i];
+    static const char sufixo[] = "}\n";
+    // Lido antes de esvaziar a fila: toda linha fechada até aqui já está nela
+    uint64_t fechado = c.fechado.load(std::memory_order_acquire);
+    size_t n = 0;
+    while (const Linha *l = c.linhas.frente())
+    {
+        if (n_iov + 4 > IOV_LOTE)
+            gravar();
+        char *p = &prefixos[usado];
+        int64_t t_ms = (l->t_rx + desvio_unix) / 1000000;
+        int tam = snprintf(p, PREFIXO_MAX, "{\"colmeia\":\"%s\",\"t\":%lld,\"t_rx\":%lld,\"dados\":",
+                           c.caminho.c_str(), (long long)t_ms, (long long)l->t_rx);
+        if (tam >= (int)PREFIXO_MAX)
+            tam = PREFIXO_MAX - 1;
+        usado += tam;
+        iov[n_iov++] = {p, (size_t)tam};
+
+        iovec trechos[2];
+        c.anel.trechos(l->inicio, l->tamanho, trechos);
+        iov[n_iov++] = trechos[0];
+        if (trechos[1].iov_len)
+            iov[n_iov++] = trechos[1];
+        iov[n_iov++] = {(void *)sufixo, sizeof sufixo - 1};
+
+        // "t_env": ns no relógio do gateway, nos testes com o simulador
+        char copia[LINHA_MAX + 1];
+        const char *s = linha_contigua(c.anel, *l, copia);
+        t_rx.push_back(l->t_rx);
+        t_rx.push_back(campo_inteiro(s, l->tamanho, "\"t_env\":"));
+        if (agregados)
+            agregados->registrar(i, t_ms, s, l->tamanho);
+
+        c.liberar = l->inicio + l->tamanho;
+        if (!c.tocada)
+        {
+            c.tocada = true;
+            tocadas.push_back(&c);
+        }
+        c.linhas.retirar();
+        n++;
+    }
+    if (n && agregados)
+        agregados->publicar(i);
+    // Linhas descartadas pela leitura depois da última publicada
+    if (fechado > c.liberar)
+    {
+        c.liberar = fechado;
+        if (!c.tocada)
+        {
+            c.tocada = true;
+            tocadas.push_back(&c);
+        }
+    }
+    return n;
+}
+
+// writev do lote e devolução dos trechos aos anéis
+void Escritor::gravar()
+{
+    iovec *v = iov;
+    int restantes = n_iov;
+    while (restantes > 0 && !falhou)
+    {
+        ssize_t n = writev(saida, v, restantes);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("saida");
+            falhou = true;
+            break;
+        }
+        bytes_gravados += n;
+        // Escrita parcial: avança pelos iovecs
+        while (restantes > 0 && (size_t)n >= v->iov_len)
+        {
+            n -= v->iov_len;
+            v++;
+            restantes--;
+        }
+        if (restantes > 0)
+        {
+            v->iov_base = (char *)v->iov_base + n;
+            v->iov_len -= n;
+        }
+    }
+
+    int64_t agora = agora_ns();
+    for (size_t i = 0; i < t_rx.size(); i += 2)
+        for (int k = 0; k < 2; k++)
+        {
+            lat_gateway[k].registrar(agora - t_rx[i]);
+            if (t_rx[i + 1] >= 0)
+                lat_total[k].registrar(agora - t_rx[i + 1]);
+        }
+    linhas += t_rx.size() / 2;
+    lotes += n_iov > 0;
+
+    for (Colmeia *c : tocadas)
+    {
+        c->anel.liberar_ate(c->liberar);
+        c->tocada = false;
+    }
+    tocadas.clear();
+    t_rx.clear();
+    n_iov = 0;
+    usado = 0;
+}
+
+void Escritor::relatar(double segundos, bool final)
+{
+    int k = final ? 1 : 0;
+    uint64_t bytes = 0, perdidos = 0, invalidas = 0, sem_fila = 0, reconexoes = 0, capturas = 0, capturas_invalidas = 0;
+    size_t conectadas = 0;
+    for (auto &c : colmeias)
+    {
+        bytes += c->bytes.load(std::memory_order_relaxed);
+        perdidos += c->perdidos.load(std::memory_order_relaxed);
+        invalidas += c->invalidas.load(std::memory_order_relaxed);
+        sem_fila += c->sem_fila.load(std::memory_order_relaxed);
+        reconexoes += c->reconexoes.load(std::memory_order_relaxed);
+        capturas += c->capturas.load(std::memory_order_relaxed);
+        capturas_invalidas += c->capturas_invalidas.load(std::memory_order_relaxed);
+        conectadas += c->conectada.load(std::memory_order_relaxed);
+    }
+    linhas_total += linhas;
+    if (final)
+        segundos = (agora_ns() - inicio) / 1e9;
+    fprintf(stderr,
+            "{\"metricas\":\"%s\",\"colmeias\":%zu,\"conectadas\":%zu,\"linhas_s\":%.0f,\"linhas\":%llu,"
+            "\"lotes\":%llu,\"bytes_rx\":%llu,\"perdidos\":%llu,\"invalidas\":%llu,\"sem_fila\":%llu,\"conexoes\":%llu,"
+            "\"capturas\":%llu,\"capturas_invalidas\":%llu,"
+            "\"gw_p50_us\":%.1f,\"gw_p99_us\":%.1f,\"gw_max_us\":%.1f,"
+            "\"total_p50_us\":%.1f,\"total_p99_us\":%.1f,\"total_max_us\":%.1f}\n",
+            final ? "final" : "parcial", colmeias.size(), conectadas, (final ? linhas_total : linhas) / segundos,
+            (unsigned long long)linhas_total, (unsigned long long)lotes, (unsigned long long)bytes,
+            (unsigned long long)perdidos, (unsigned long long)invalidas, (unsigned long long)sem_fila, (unsigned long long)reconexoes,
+            (unsigned long long)capturas, (unsigned long long)capturas_invalidas,
+            lat_gateway[k].percentil(0.5) / 1e3, lat_gateway[k].percentil(0.99) / 1e3, lat_gateway[k].maximo() / 1e3,
+            lat_total[k].percentil(0.5) / 1e3, lat_total[k].percentil(0.99) / 1e3, lat_total[k].maximo() / 1e3);
+    linhas = 0;
+    lat_gateway[0].zerar();
+    lat_total[0].zerar();
+}
+
+void Escritor::executar()
+{
+    int64_t relatorio = agora_ns();
+    for (;;)
+    {
+        uint64_t sinal;
+        // Bloqueia até a leitura publicar algo (eventfd soma os avisos)
+        (void)!read(acordar, &sinal, sizeof sinal);
+        bool fim = parar.load();
+
+        // Janela do lote: deixa as outras colmeias acumularem
+        if (op.lote_ms > 0 && !fim)
+            std::this_thread::sleep_for(std::chrono::milliseconds(op.lote_ms));
+
+        for (size_t i = 0; i < colmeias.size(); i++)
+            drenar(i);
+        gravar();
+
+        int64_t agora = agora_ns();
+        if (op.metricas_s > 0 && agora - relatorio >= (int64_t)op.metricas_s * 1000000000)
+        {
+            relatar((agora - relatorio) / 1e9, false);
+            relatorio = agora;
+        }
+        if (fim)
+        {
+            relatar(0, true);
+            return;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Opcoes op;
+    if (!ler_opcoes(argc, argv, op))
+    {
+        uso(argv[0]);
+        return 2;
+    }
+
+    // Sinais vão para o signalfd da thread de leitura
+    sigset_t sinais;
+    sigemptyset(&sinais);
+    sigaddset(&sinais, SIGINT);
+    sigaddset(&sinais, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &sinais, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    int saida = STDOUT_FILENO;
+    if (op.saida != "-")
+    {
+        saida = open(op.saida.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (saida < 0)
+        {
+            perror(op.saida.c_str());
+            return 1;
+        }
+    }
+
+    std::vector<std::unique_ptr<Colmeia>> colmeias;
+    for (auto &d : op.dispositivos)
+        colmeias.emplace_back(new Colmeia(d, op.anel_kb * 1024));
+
+    std::unique_ptr<Agregados> agregados;
+    std::unique_ptr<ServidorConsulta> servidor;
+    std::thread t_servidor;
+    if (op.http)
+    {
+        agregados.reset(new Agregados(op.dispositivos, &especies[especies_buscar(op.especie.c_str())]));
+        servidor.reset(new ServidorConsulta(*agregados, op.http, op.cache));
+        if (!servidor->ok())
+            return 1;
+        t_servidor = std::thread([&] { servidor->executar(); });
+    }
+
+    int acordar = eventfd(0, EFD_CLOEXEC);
+    Escritor escritor(colmeias, op, saida, acordar, agregados.get());
+    std::thread t([&] { escritor.executar(); });
+
+    Leitor leitor(colmeias, op.baud, op.capturas, acordar);
+    leitor.executar();
+
+    uint64_t um = 1;
+    (void)!write(acordar, &um, sizeof um);
+    t.join();
+    if (servidor)
+    {
+        servidor->parar();
+        t_servidor.join();
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "metricas.hpp"
+
+#include <time.h>
+
+// Expoente nos bits altos, os SUB bits seguintes ao mais significativo nos baixos
+static int balde(uint64_t v)
+{
+    int e = 63 - __builtin_clzll(v);
+    if (e < Histograma::SUB)
+        return (int)v;
+    return (e << Histograma::SUB) | (int)((v >> (e - Histograma::SUB)) & ((1 << Histograma::SUB) - 1));
+}
+
+// Menor valor que cai depois do balde b
+static uint64_t limite(int b)
+{
+    int e = b >> Histograma::SUB;
+    uint64_t m = (uint64_t)(b & ((1 << Histograma::SUB) - 1)) + 1;
+    if (e < Histograma::SUB)
+        return (uint64_t)b + 1;
+    return ((1ULL << Histograma::SUB) + m) << (e - Histograma::SUB);
+}
+
+void Histograma::registrar(int64_t ns)
+{
+    if (ns < 1)
+        ns = 1;
+    baldes[balde((uint64_t)ns)]++;
+    n++;
+    if (ns > max)
+        max = ns;
+}
+
+void Histograma::zerar()
+{
+    for (auto &b : baldes)
+        b = 0;
+    n = 0;
+    max = 0;
+}
+
+// Limite superior do balde onde cai o percentil p (0..1), sem passar do máximo
+int64_t Histograma::percentil(double p) const
+{
+    if (n == 0)
+        return 0;
+    uint64_t alvo = (uint64_t)(p * (double)n);
+    if (alvo >= n)
+        alvo = n - 1;
+    uint64_t acumulado = 0;
+    for (int i = 0; i < BALDES; i++)
+    {
+        acumulado += baldes[i];
+        if (acumulado > alvo)
+        {
+            uint64_t l = limite(i);
+            return l > (uint64_t)max ? max : (int64_t)l;
+        }
+    }
+    return max;
+}
+
+int64_t agora_ns()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+int64_t relogio_unix_ns()
+{
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
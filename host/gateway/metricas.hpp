@@ -0,0 +1,38 @@
+#ifndef METRICAS_HPP
+#define METRICAS_HPP
+
+#include <cstdint>
+#include <cstdio>
+
+// Histograma de latências (ns) em baldes logarítmicos: cada potência de 2 é
+// dividida em 4, então os percentis têm erro de no máximo 25%. Memória fixa e
+// registro O(1), sem alocar no caminho da escrita.
+class Histograma
+{
+public:
+    static constexpr int SUB = 2; // bits de subdivisão de cada potência de 2
+
+    void registrar(int64_t ns);
+    void zerar();
+    uint64_t total() const
+    {
+        return n;
+    }
+    int64_t percentil(double p) const;
+    int64_t maximo() const
+    {
+        return max;
+    }
+
+private:
+    static constexpr int BALDES = 64 << SUB;
+    uint64_t baldes[BALDES] = {};
+    uint64_t n = 0;
+    int64_t max = 0;
+};
+
+// CLOCK_MONOTONIC e CLOCK_REALTIME em ns
+int64_t agora_ns();
+int64_t relogio_unix_ns();
+
+#endif
@@ -0,0 +1,64 @@
+#include "serial.hpp"
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <cerrno>
+
+static speed_t velocidade(int baud)
+{
+    switch (baud)
+    {
+    case 9600:
+        return B9600;
+    case 19200:
+        return B19200;
+    case 38400:
+        return B38400;
+    case 57600:
+        return B57600;
+    case 230400:
+        return B230400;
+    case 460800:
+        return B460800;
+    case 921600:
+        return B921600;
+    default:
+        return B115200;
+    }
+}
+
+int serial_abrir(const std::string &caminho, int baud)
+{
+    int fd = open(caminho.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+        return -1;
+
+    termios tio;
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        // Cru: sem eco, sem edição de linha, sem tradução de CR/LF
+        cfmakeraw(&tio);
+        tio.c_cflag |= CLOCAL | CREAD;
+        cfsetispeed(&tio, velocidade(baud));
+        cfsetospeed(&tio, velocidade(baud));
+        if (tcsetattr(fd, TCSANOW, &tio) != 0)
+        {
+            int erro = errno;
+            close(fd);
+            errno = erro;
+            return -1;
+        }
+    }
+    return fd;
+}
+
+bool serial_definir_baud(int fd, int baud)
+{
+    termios tio;
+    if (tcgetattr(fd, &tio) != 0)
+        return false;
+    cfsetispeed(&tio, velocidade(baud));
+    cfsetospeed(&tio, velocidade(baud));
+    return tcsetattr(fd, TCSANOW, &tio) == 0;
+}
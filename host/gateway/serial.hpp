@@ -0,0 +1,13 @@
+#ifndef SERIAL_HPP
+#define SERIAL_HPP
+
+#include <string>
+
+// Abre uma porta serial (ou pty) em modo cru e não bloqueante.
+// Retorna o descritor ou -1 (errno preservado).
+int serial_abrir(const std::string &caminho, int baud);
+
+// Troca o baud de uma porta aberta (rajadas de captura em outro baud)
+bool serial_definir_baud(int fd, int baud);
+
+#endif
@@ -0,0 +1,227 @@
+// Simulador de colmeias para o teste de carga do gateway: abre N
+// pseudo-terminais e escreve em cada um linhas de telemetria no formato da
+// BeeSense, com o campo extra "t_env" (CLOCK_MONOTONIC em ns no envio) para o
+// gateway medir a latência de ponta a ponta. Os nomes dos escravos saem em
+// stdout, um por linha, antes do primeiro envio.
+//
+// Com o quarto argumento, cada colmeia manda também, a cada tantos segundos,
+// uma captura bruta como a do firmware: a linha de anúncio e o quadro binário
+// (inc/quadro.h) com dois canais senoidais.
+
+#include "metricas.hpp"
+
+extern "C"
+{
+#include "crc32.h"
+#include "quadro.h"
+}
+
+#include <fcntl.h>
+#include <signal.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct Pty
+{
+    int mestre;
+    int escravo; // mantido aberto para o pty não fechar entre reconexões do gateway
+    std::string nome;
+    int64_t proximo;
+    uint64_t enviados = 0;
+    int64_t proxima_captura;
+    uint32_t capturas = 0;
+    std::vector<uint8_t> pendente; // captura ainda saindo: a telemetria espera
+    size_t escrito = 0;
+};
+
+volatile sig_atomic_t parar = 0;
+
+void ao_sinal(int)
+{
+    parar = 1;
+}
+
+// Anúncio + quadro de uma captura de 2 canais × 1024 instantes a 8 kHz, com o
+// disparo no meio, como o firmware envia
+std::vector<uint8_t> montar_captura(uint32_t sequencia)
+{
+    const uint32_t quadros = 1024, n_canais = 2;
+    std::vector<uint16_t> amostras(quadros * n_canais);
+    for (uint32_t i = 0; i < quadros; i++)
+    {
+        amostras[i * n_canais] = (uint16_t)(2048 + 1500 * std::sin(2 * M_PI * 440 * i / 8000.0));
+        amostras[i * n_canais + 1] = (uint16_t)(2048 + (i >= quadros / 2 ? 1000 * std::sin(2 * M_PI * 120 * i / 8000.0) : 0));
+    }
+    captura_meta_t meta{};
+    meta.taxa_hz = 8000;
+    meta.quadros = quadros;
+    meta.disparo = quadros / 2;
+    meta.canais = (1u << 1) | (1u << 2);
+    meta.n_canais = n_canais;
+    meta.bits = 12;
+    meta.motivo = CAPTURA_COMANDO;
+    uint32_t bytes = sizeof meta + amostras.size() * sizeof(uint16_t);
+    quadro_cabecalho_t cab;
+    quadro_cabecalho(&cab, QUADRO_CAPTURA, sequencia, bytes);
+
+    char anuncio[256];
+    int tam = snprintf(anuncio, sizeof anuncio,
+                       "{ \"captura\": { \"seq\": %u, \"bytes\": %zu, \"baud\": 921600, \"canais\": %u, \"taxa\": 8000, "
+                       "\"quadros\": %u, \"disparo\": %u, \"motivo\": \"comando\" } }\r\n",
+                       sequencia, quadro_tamanho(bytes), meta.canais, quadros, meta.disparo);
+    std::vector<uint8_t> saida(anuncio, anuncio + tam);
+    auto colocar = [&saida](const void *p, size_t n) {
+        saida.insert(saida.end(), (const uint8_t *)p, (const uint8_t *)p + n);
+    };
+    size_t inicio = saida.size();
+    colocar(&cab, sizeof cab);
+    colocar(&meta, sizeof meta);
+    colocar(amostras.data(), amostras.size() * sizeof(uint16_t));
+    uint32_t crc = crc32_calcular(saida.data() + inicio, saida.size() - inicio);
+    colocar(&crc, sizeof crc);
+    return saida;
+}
+
+bool abrir_pty(Pty &p)
+{
+    p.mestre = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (p.mestre < 0 || grantpt(p.mestre) || unlockpt(p.mestre))
+        return false;
+    p.nome = ptsname(p.mestre);
+    p.escravo = open(p.nome.c_str(), O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (p.escravo < 0)
+        return false;
+
+    // Escravo cru, como o gateway deixa a porta: sem eco de volta ao mestre
+    termios tio;
+    tcgetattr(p.escravo, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(p.escravo, TCSANOW, &tio);
+
+    fcntl(p.mestre, F_SETFL, fcntl(p.mestre, F_GETFL) | O_NONBLOCK);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "uso: %s colmeias linhas_por_segundo [segundos] [captura a cada s]\n", argv[0]);
+        return 2;
+    }
+    int n = atoi(argv[1]);
+    double taxa = atof(argv[2]);
+    double duracao = argc > 3 ? atof(argv[3]) : 0;
+    double captura_s = argc > 4 ? atof(argv[4]) : 0;
+    if (n <= 0 || taxa <= 0)
+        return 2;
+
+    signal(SIGINT, ao_sinal);
+    signal(SIGTERM, ao_sinal);
+
+    std::vector<Pty> ptys(n);
+    int64_t periodo = (int64_t)(1e9 / taxa);
+    int64_t inicio = agora_ns();
+    std::mt19937 aleatorio(1234);
+    for (int i = 0; i < n; i++)
+    {
+        if (!abrir_pty(ptys[i]))
+        {
+            perror("pty");
+            return 1;
+        }
+        // Espalha as colmeias pelo período, como unidades independentes
+        ptys[i].proximo = inicio + (int64_t)(aleatorio() % (uint64_t)periodo);
+        ptys[i].proxima_captura = captura_s > 0 ? inicio + (int64_t)(captura_s * 1e9) : INT64_MAX;
+        printf("%s\n", ptys[i].nome.c_str());
+    }
+    fflush(stdout);
+
+    uint64_t cheios = 0;
+    int64_t fim = duracao > 0 ? inicio + (int64_t)(duracao * 1e9) : INT64_MAX;
+    std::uniform_real_distribution<double> ruido(-0.5, 0.5);
+    char linha[512];
+    while (!parar)
+    {
+        int64_t agora = agora_ns();
+        if (agora >= fim)
+            break;
+        int64_t mais_cedo = fim;
+        for (int i = 0; i < n; i++)
+        {
+            Pty &p = ptys[i];
+            if (p.pendente.empty() && agora >= p.proxima_captura)
+            {
+                p.pendente = montar_captura(++p.capturas);
+                p.escrito = 0;
+                p.proxima_captura += (int64_t)(captura_s * 1e9);
+            }
+            if (!p.pendente.empty())
+            {
+                // O quadro não cabe no buffer do pty: sai aos pedaços
+                ssize_t n = write(p.mestre, p.pendente.data() + p.escrito, p.pendente.size() - p.escrito);
+                if (n > 0)
+                    p.escrito += n;
+                if (p.escrito == p.pendente.size())
+                    p.pendente.clear();
+                else
+                    mais_cedo = agora + 1000000;
+            }
+            else if (agora >= p.proximo)
+            {
+                int tam = snprintf(linha, sizeof linha,
+                                   "{ \"temp\": %.1f, \"umid\": %.1f, \"peso\": %.1f, \"luz\": %.1f, \"voc\": %.1f, "
+                                   "\"vibra\": %.1f, \"z\": [0.1, 0.0, 0.2, 0.0], \"anom\": [0, 0, 0, 0], "
+                                   "\"perfil\": [34.50, 34.75, 35.00], \"tend\": 0.012, \"dias\": -1, "
+                                   "\"seq\": %llu, \"t_env\": %lld }\r\n",
+                                   34.0 + ruido(aleatorio), 60.0 + ruido(aleatorio), 42.0 + ruido(aleatorio),
+                                   400.0, 120.0, 0.3, (unsigned long long)p.enviados, (long long)agora_ns());
+                // O pty tem buffer pequeno: se o gateway não drenar, a linha se perde
+                if (write(p.mestre, linha, tam) == tam)
+                    p.enviados++;
+                else
+                    cheios++;
+                p.proximo += periodo;
+                if (p.proximo < agora)
+                    p.proximo = agora + periodo;
+            }
+            if (p.pendente.empty() && p.proximo < mais_cedo)
+                mais_cedo = p.proximo;
+            if (p.proxima_captura < mais_cedo)
+                mais_cedo = p.proxima_captura;
+        }
+        int64_t espera = mais_cedo - agora_ns();
+        if (espera > 0)
+            std::this_thread::sleep_for(std::chrono::nanoseconds(espera));
+    }
+
+    uint64_t total = 0;
+    for (auto &p : ptys)
+        total += p.enviados;
+    uint64_t capturas = 0;
+    for (auto &p : ptys)
+        capturas += p.capturas - !p.pendente.empty();
+    fprintf(stderr, "{\"simulador\":\"fim\",\"colmeias\":%d,\"enviadas\":%llu,\"recusadas\":%llu,\"capturas\":%llu}\n", n,
+            (unsigned long long)total, (unsigned long long)cheios, (unsigned long long)capturas);
+    for (auto &p : ptys)
+    {
+        close(p.escravo);
+        close(p.mestre);
+    }
+    return 0;
+}
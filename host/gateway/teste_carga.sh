@@ -0,0 +1,36 @@
+#!/bin/sh
+# Teste de carga do gateway com colmeias simuladas em pseudo-terminais.
+# uso: teste_carga.sh [colmeias] [linhas/s por colmeia] [segundos] [diretório do build]
+# Imprime as métricas do gateway, o pico de memória dele e quantas linhas
+# chegaram à saída contra as que o simulador enviou.
+
+COLMEIAS=${1:-200}
+TAXA=${2:-10}
+SEGUNDOS=${3:-10}
+BUILD=${4:-build-host}
+
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+"$BUILD/beesense_simulador" "$COLMEIAS" "$TAXA" "$SEGUNDOS" > "$TMP/ptys" 2> "$TMP/simulador" &
+SIM=$!
+
+# Espera o simulador publicar todos os nomes
+while [ "$(wc -l < "$TMP/ptys")" -lt "$COLMEIAS" ]; do
+    kill -0 $SIM 2>/dev/null || { echo "simulador falhou"; cat "$TMP/simulador"; exit 1; }
+    sleep 0.1
+done
+
+"$BUILD/beesense_gateway" --saida "$TMP/saida.jsonl" --metricas 2 $(cat "$TMP/ptys") 2> "$TMP/gateway" &
+GW=$!
+
+wait $SIM
+sleep 1
+PICO=$(grep VmHWM /proc/$GW/status)
+kill -TERM $GW
+wait $GW
+
+grep -v desconectada "$TMP/gateway"
+cat "$TMP/simulador"
+echo "linhas gravadas: $(wc -l < "$TMP/saida.jsonl")"
+echo "memória do gateway: $PICO"
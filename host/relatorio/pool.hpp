@@ -0,0 +1,96 @@
+#ifndef POOL_HPP
+#define POOL_HPP
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Executa um lote de tarefas independentes em n threads com roubo de
+// trabalho. Cada thread recebe uma faixa contígua das tarefas (fatias
+// vizinhas da mesma colmeia ficam juntas) e as consome pelo fim da sua fila;
+// quando ela esvazia, rouba do começo da fila de outra thread. As tarefas
+// não criam tarefas novas, então uma thread que não acha nada para roubar
+// pode terminar.
+class PoolRoubo
+{
+public:
+    explicit PoolRoubo(unsigned threads) : filas(threads ? threads : 1)
+    {
+    }
+
+    void executar(std::vector<std::function<void()>> &tarefas)
+    {
+        size_t n = filas.size();
+        for (size_t i = 0; i < tarefas.size(); i++)
+            filas[i * n / tarefas.size()].tarefas.push_back(&tarefas[i]);
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < n; i++)
+            threads.emplace_back([this, i] { trabalhar(i); });
+        trabalhar(0);
+        for (auto &t : threads)
+            t.join();
+    }
+
+    // Tarefas executadas por uma thread diferente da que as recebeu
+    uint64_t roubos() const
+    {
+        return total_roubos.load();
+    }
+
+private:
+    struct alignas(64) Fila
+    {
+        std::mutex trava;
+        std::deque<std::function<void()> *> tarefas;
+    };
+
+    std::function<void()> *pegar(size_t i)
+    {
+        Fila &f = filas[i];
+        std::lock_guard<std::mutex> g(f.trava);
+        if (f.tarefas.empty())
+            return nullptr;
+        auto *t = f.tarefas.back();
+        f.tarefas.pop_back();
+        return t;
+    }
+
+    std::function<void()> *roubar(size_t i)
+    {
+        for (size_t k = 1; k < filas.size(); k++)
+        {
+            Fila &f = filas[(i + k) % filas.size()];
+            std::lock_guard<std::mutex> g(f.trava);
+            if (!f.tarefas.empty())
+            {
+                auto *t = f.tarefas.front();
+                f.tarefas.pop_front();
+                total_roubos++;
+                return t;
+            }
+        }
+        return nullptr;
+    }
+
+    void trabalhar(size_t i)
+    {
+        for (;;)
+        {
+            auto *t = pegar(i);
+            if (!t)
+                t = roubar(i);
+            if (!t)
+                return;
+            (*t)();
+        }
+    }
+
+    std::vector<Fila> filas;
+    std::atomic<uint64_t> total_roubos{0};
+};
+
+#endif
@@ -0,0 +1,390 @@
+// Relatório de diagnóstico do apiário sobre o arquivo histórico (.bsc).
+//
+// Cada amostra passa pela mesma avaliação do firmware: índice de saúde da
+// espécie (pontuacao_saude), detectores de anomalia por canal e tendência do
+// peso com os dias até a reserva mínima. O trabalho é dividido em fatias de
+// tempo por colmeia e executado num pool com roubo de trabalho; cada fatia
+// começa com detectores e tendência novos (o aquecimento dos detectores cobre
+// a emenda). Saída: uma linha JSON por colmeia e uma com os rankings.
+//
+// uso: beesense_relatorio arquivo.bsc [--especie nome] [--especies mapa]
+//                         [--threads n] [--fatia dias] [--de ms] [--ate ms]
+
+#include "../arquivo/colunar.hpp"
+#include "pool.hpp"
+
+extern "C"
+{
+#include "anomalia.h"
+#include "especies.h"
+#include "pontuacao.h"
+#include "tendencia.h"
+}
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr int64_t MS_POR_DIA = 86400000;
+
+// Canais do arquivo na ordem dos detectores (CANAL_TEMP ... CANAL_VIBRA)
+const Coluna COLUNAS_CANAIS[NUM_CANAIS] = {COLUNA_TEMP, COLUNA_UMID, COLUNA_PESO,
+                                           COLUNA_LUZ,  COLUNA_VOC,  COLUNA_VIBRA};
+
+struct Metricas
+{
+    uint64_t amostras = 0;
+    double saude_soma = 0;
+    float saude_min = 1;
+    uint64_t em_alarme = 0;
+    double temp_soma = 0, umid_soma = 0;
+    uint64_t eventos[NUM_CANAIS] = {}; // entradas em estado anômalo
+    int64_t t_inicio = INT64_MAX, t_fim = INT64_MIN;
+    float peso_inicio = 0, peso_fim = 0;
+    bool tendencia_valida = false;
+    float kg_por_dia = 0;
+    int32_t dias_reserva = -1;
+};
+
+struct alignas(64) Fatia // cada thread escreve só nas suas fatias
+{
+    uint32_t colmeia;
+    std::vector<const Grupo *> grupos;
+    Metricas m;
+};
+
+struct Opcoes
+{
+    std::string arquivo;
+    std::string especie = "Jataí";
+    std::string mapa;
+    unsigned threads = std::thread::hardware_concurrency();
+    int64_t fatia_ms = 7 * MS_POR_DIA;
+    int64_t de = INT64_MIN, ate = INT64_MAX;
+};
+
+void avaliar(const Arquivo &a, const Beeespecies *especie, const Opcoes &op, Fatia &f)
+{
+    Metricas &m = f.m;
+    anomalia_canal_t detectores[NUM_CANAIS];
+    uint8_t anterior[NUM_CANAIS] = {};
+    for (int c = 0; c < NUM_CANAIS; c++)
+        anomalia_init(&detectores[c], &anomalia_config[c]);
+    tendencia_t tendencia;
+    tendencia_init(&tendencia, TENDENCIA_PERIODO_MS);
+    int64_t proxima_tendencia = INT64_MIN;
+
+    int64_t tempo[BLOCO_LINHAS];
+    int64_t colunas[NUM_CANAIS][BLOCO_LINHAS];
+    for (const Grupo *g : f.grupos)
+    {
+        uint32_t n = ler_coluna(a, *g, COLUNA_TEMPO, tempo);
+        for (int c = 0; c < NUM_CANAIS; c++)
+            ler_coluna(a, *g, COLUNAS_CANAIS[c], colunas[c]);
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            int64_t t = tempo[i];
+            if (t < op.de || t > op.ate)
+                continue;
+            float v[NUM_CANAIS];
+            for (int c = 0; c < NUM_CANAIS; c++)
+                v[c] = (float)colunas[c][i] / ESCALA;
+
+            float saude = pontuacao_saude(especie, v[CANAL_TEMP], v[CANAL_UMID]);
+            m.amostras++;
+            m.saude_soma += saude;
+            m.saude_min = std::min(m.saude_min, saude);
+            m.em_alarme += saude < LIMIAR_ALARME;
+            m.temp_soma += v[CANAL_TEMP];
+            m.umid_soma += v[CANAL_UMID];
+
+            for (int c = 0; c < NUM_CANAIS; c++)
+            {
+                uint8_t estado = anomalia_atualizar(&detectores[c], Q16(v[c]));
+                m.eventos[c] += estado && !anterior[c];
+                anterior[c] = estado;
+            }
+
+            if (t >= proxima_tendencia)
+            {
+                tendencia_adicionar(&tendencia, Q16(v[CANAL_PESO]));
+                proxima_tendencia = t + TENDENCIA_PERIODO_MS;
+            }
+
+            if (t < m.t_inicio)
+            {
+                m.t_inicio = t;
+                m.peso_inicio = v[CANAL_PESO];
+            }
+            if (t > m.t_fim)
+            {
+                m.t_fim = t;
+                m.peso_fim = v[CANAL_PESO];
+            }
+        }
+    }
+
+    if (tendencia_valida(&tendencia))
+    {
+        m.tendencia_valida = true;
+        m.kg_por_dia = q16_para_float(tendencia_por_dia(&tendencia));
+        m.dias_reserva = tendencia_dias_ate(&tendencia, Q16(especie->reserva_min));
+    }
+}
+
+// Junta as fatias de uma colmeia, em ordem de tempo
+Metricas juntar(const std::vector<const Fatia *> &fatias)
+{
+    Metricas r;
+    for (const Fatia *f : fatias)
+    {
+        const Metricas &m = f->m;
+        if (!m.amostras)
+            continue;
+        r.amostras += m.amostras;
+        r.saude_soma += m.saude_soma;
+        r.saude_min = std::min(r.saude_min, m.saude_min);
+        r.em_alarme += m.em_alarme;
+        r.temp_soma += m.temp_soma;
+        r.umid_soma += m.umid_soma;
+        for (int c = 0; c < NUM_CANAIS; c++)
+            r.eventos[c] += m.eventos[c];
+        if (m.t_inicio < r.t_inicio)
+        {
+            r.t_inicio = m.t_inicio;
+            r.peso_inicio = m.peso_inicio;
+        }
+        if (m.t_fim > r.t_fim)
+        {
+            r.t_fim = m.t_fim;
+            r.peso_fim = m.peso_fim;
+            // A tendência que vale é a da fatia mais recente
+            r.tendencia_valida = m.tendencia_valida;
+            r.kg_por_dia = m.kg_por_dia;
+            r.dias_reserva = m.dias_reserva;
+        }
+    }
+    return r;
+}
+
+struct Relatorio
+{
+    std::string colmeia;
+    const Beeespecies *especie;
+    Metricas m;
+    double dias;
+    double saude_media;
+    double alarme;       // fração do tempo com saúde abaixo do limiar
+    double anomalias_dia;
+    double indice;       // saúde média descontada do tempo em alarme
+};
+
+bool ler_opcoes(int argc, char **argv, Opcoes &op)
+{
+    if (argc < 2)
+        return false;
+    op.arquivo = argv[1];
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        std::string a = argv[i];
+        const char *v = argv[i + 1];
+        if (a == "--especie")
+            op.especie = v;
+        else if (a == "--especies")
+            op.mapa = v;
+        else if (a == "--threads")
+            op.threads = atoi(v);
+        else if (a == "--fatia")
+            op.fatia_ms = (int64_t)(atof(v) * MS_POR_DIA);
+        else if (a == "--de")
+            op.de = strtoll(v, nullptr, 10);
+        else if (a == "--ate")
+            op.ate = strtoll(v, nullptr, 10);
+        else
+            return false;
+    }
+    return op.threads > 0 && op.fatia_ms > 0;
+}
+
+// Mapa "colmeia espécie" por linha; linhas com '#' são comentários
+bool ler_mapa(const std::string &caminho, const Arquivo &a, std::vector<const Beeespecies *> &especie)
+{
+    std::ifstream f(caminho);
+    if (!f)
+        return false;
+    std::string linha;
+    while (std::getline(f, linha))
+    {
+        std::istringstream s(linha);
+        std::string colmeia, nome;
+        if (!(s >> colmeia >> nome) || colmeia[0] == '#')
+            continue;
+        int c = a.colmeia(colmeia), e = especies_buscar(nome.c_str());
+        if (e < 0)
+        {
+            fprintf(stderr, "%s: espécie desconhecida: %s\n", caminho.c_str(), nome.c_str());
+            return false;
+        }
+        if (c >= 0)
+            especie[c] = &especies[e];
+    }
+    return true;
+}
+
+void imprimir_lista(const char *nome, const std::vector<const Relatorio *> &lista, size_t max,
+                    double Relatorio::*campo, bool ultimo)
+{
+    printf("\"%s\":[", nome);
+    for (size_t i = 0; i < lista.size() && i < max; i++)
+        printf("%s{\"colmeia\":\"%s\",\"valor\":%.3f}", i ? "," : "", lista[i]->colmeia.c_str(),
+               lista[i]->*campo);
+    printf(ultimo ? "]" : "],");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Opcoes op;
+    if (!ler_opcoes(argc, argv, op))
+    {
+        fprintf(stderr,
+                "uso: %s arquivo.bsc [--especie nome] [--especies mapa] [--threads n] [--fatia dias] [--de ms] "
+                "[--ate ms]\n",
+                argv[0]);
+        return 2;
+    }
+    Arquivo a;
+    if (!a.abrir(op.arquivo))
+    {
+        fprintf(stderr, "%s: arquivo .bsc inválido\n", op.arquivo.c_str());
+        return 1;
+    }
+    int padrao = especies_buscar(op.especie.c_str());
+    if (padrao < 0)
+    {
+        fprintf(stderr, "espécie desconhecida: %s\n", op.especie.c_str());
+        return 2;
+    }
+    size_t n_colmeias = a.colmeias().size();
+    std::vector<const Beeespecies *> especie(n_colmeias, &especies[padrao]);
+    if (!op.mapa.empty() && !ler_mapa(op.mapa, a, especie))
+        return 1;
+
+    // Fatias: grupos de cada colmeia agrupados pela janela de tempo do início
+    std::vector<Fatia> fatias;
+    {
+        std::vector<std::vector<const Grupo *>> por_colmeia(n_colmeias);
+        for (size_t i = 0; i < a.num_grupos(); i++)
+        {
+            const Grupo &g = a.grupos()[i];
+            if (g.t_max >= op.de && g.t_min <= op.ate)
+                por_colmeia[g.colmeia].push_back(&g);
+        }
+        for (uint32_t c = 0; c < n_colmeias; c++)
+        {
+            auto &gs = por_colmeia[c];
+            std::sort(gs.begin(), gs.end(), [](const Grupo *x, const Grupo *y) { return x->t_min < y->t_min; });
+            int64_t janela = INT64_MIN;
+            for (const Grupo *g : gs)
+            {
+                int64_t j = g->t_min / op.fatia_ms;
+                if (fatias.empty() || fatias.back().colmeia != c || j != janela)
+                    fatias.push_back(Fatia{c, {}, {}});
+                fatias.back().grupos.push_back(g);
+                janela = j;
+            }
+        }
+    }
+
+    std::vector<std::function<void()>> tarefas;
+    for (auto &f : fatias)
+        tarefas.push_back([&a, &especie, &op, &f] { avaliar(a, especie[f.colmeia], op, f); });
+
+    auto inicio = std::chrono::steady_clock::now();
+    PoolRoubo pool(op.threads);
+    pool.executar(tarefas);
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    // Relatório por colmeia
+    std::vector<std::vector<const Fatia *>> por_colmeia(n_colmeias);
+    for (auto &f : fatias)
+        por_colmeia[f.colmeia].push_back(&f);
+    std::vector<Relatorio> relatorios;
+    uint64_t amostras = 0;
+    for (uint32_t c = 0; c < n_colmeias; c++)
+    {
+        Relatorio r{a.colmeias()[c], especie[c], juntar(por_colmeia[c]), 0, 0, 0, 0, 0};
+        const Metricas &m = r.m;
+        if (!m.amostras)
+            continue;
+        amostras += m.amostras;
+        r.dias = std::max((double)(m.t_fim - m.t_inicio) / MS_POR_DIA, 1.0 / 24);
+        r.saude_media = m.saude_soma / m.amostras;
+        r.alarme = (double)m.em_alarme / m.amostras;
+        uint64_t eventos = 0;
+        for (int k = 0; k < NUM_CANAIS; k++)
+            eventos += m.eventos[k];
+        r.anomalias_dia = eventos / r.dias;
+        r.indice = r.saude_media * (1 - r.alarme);
+        relatorios.push_back(r);
+
+        printf("{\"colmeia\":\"%s\",\"especie\":\"%s\",\"inicio\":%lld,\"fim\":%lld,\"dias\":%.1f,\"amostras\":%llu,"
+               "\"saude_media\":%.3f,\"saude_min\":%.3f,\"alarme_pct\":%.1f,\"temp_media\":%.2f,\"umid_media\":%.2f,"
+               "\"eventos\":{",
+               r.colmeia.c_str(), r.especie->nome, (long long)m.t_inicio, (long long)m.t_fim, r.dias,
+               (unsigned long long)m.amostras, r.saude_media, m.saude_min, r.alarme * 100,
+               m.temp_soma / m.amostras, m.umid_soma / m.amostras);
+        for (int k = 0; k < NUM_CANAIS; k++)
+            printf("%s\"%s\":%llu", k ? "," : "", NOMES_COLUNAS[COLUNAS_CANAIS[k]], (unsigned long long)m.eventos[k]);
+        printf("},\"anomalias_dia\":%.2f,\"peso_inicio\":%.2f,\"peso_fim\":%.2f,", r.anomalias_dia, m.peso_inicio,
+               m.peso_fim);
+        if (m.tendencia_valida)
+            printf("\"kg_dia\":%.3f,\"dias_reserva\":%ld,", m.kg_por_dia, (long)m.dias_reserva);
+        else
+            printf("\"kg_dia\":null,\"dias_reserva\":null,");
+        printf("\"indice\":%.3f}\n", r.indice);
+    }
+
+    // Rankings do apiário
+    std::vector<const Relatorio *> lista;
+    for (auto &r : relatorios)
+        lista.push_back(&r);
+    printf("{\"ranking\":{");
+    std::sort(lista.begin(), lista.end(), [](auto *x, auto *y) { return x->indice > y->indice; });
+    imprimir_lista("saude", lista, lista.size(), &Relatorio::indice, false);
+    std::sort(lista.begin(), lista.end(), [](auto *x, auto *y) { return x->anomalias_dia > y->anomalias_dia; });
+    imprimir_lista("mais_anomalias", lista, 10, &Relatorio::anomalias_dia, false);
+    std::sort(lista.begin(), lista.end(), [](auto *x, auto *y) { return x->alarme > y->alarme; });
+    imprimir_lista("mais_alarme", lista, 10, &Relatorio::alarme, false);
+
+    // Reserva de mel mais perto do mínimo (só colmeias com tendência de queda)
+    std::vector<const Relatorio *> reserva;
+    for (auto *r : lista)
+        if (r->m.tendencia_valida && r->m.dias_reserva >= 0)
+            reserva.push_back(r);
+    std::sort(reserva.begin(), reserva.end(),
+              [](auto *x, auto *y) { return x->m.dias_reserva < y->m.dias_reserva; });
+    printf("\"reserva\":[");
+    for (size_t i = 0; i < reserva.size() && i < 10; i++)
+        printf("%s{\"colmeia\":\"%s\",\"dias\":%ld}", i ? "," : "", reserva[i]->colmeia.c_str(),
+               (long)reserva[i]->m.dias_reserva);
+    printf("]}}\n");
+
+    fprintf(stderr, "{\"threads\":%u,\"fatias\":%zu,\"roubos\":%llu,\"amostras\":%llu,\"segundos\":%.3f,"
+                    "\"amostras_s\":%.0f}\n",
+            op.threads, fatias.size(), (unsigned long long)pool.roubos(), (unsigned long long)amostras, segundos,
+            amostras / segundos);
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "anomalia.h"
+
+void anomalia_init(anomalia_canal_t *canal, const anomalia_config_t *cfg)
+{
+    canal->cfg = *cfg;
+    canal->media = 0;
+    canal->variancia = 0;
+    canal->z = 0;
+    canal->cusum_pos = 0;
+    canal->cusum_neg = 0;
+    canal->amostras = 0;
+    canal->estado = 0;
+}
+
+q16_t anomalia_desvio(const anomalia_canal_t *canal)
+{
+    // sqrt(v / 2^16) * 2^16 = sqrt(v * 2^16)
+    q16_t desvio = (q16_t)raiz_inteira((uint64_t)canal->variancia << 16);
+    if (desvio < canal->cfg.desvio_min)
+        desvio = canal->cfg.desvio_min;
+    return desvio;
+}
+
+uint8_t anomalia_atualizar(anomalia_canal_t *canal, q16_t amostra)
+{
+    const anomalia_config_t *cfg = &canal->cfg;
+
+    if (canal->amostras == 0)
+    {
+        canal->media = amostra;
+        canal->amostras = 1;
+        return 0;
+    }
+
+    // z-score contra a estatística anterior à amostra
+    int32_t diff = amostra - canal->media;
+    q16_t desvio = anomalia_desvio(canal);
+    canal->z = q16_div(diff, desvio);
+
+    // EWMA da média e da variância (forma incremental de West)
+    int32_t incremento = diff >> cfg->alfa_shift;
+    canal->media += incremento;
+    uint64_t var = canal->variancia + (uint64_t)(((int64_t)diff * incremento) >> 16);
+    var -= var >> cfg->alfa_shift;
+    canal->variancia = var > UINT32_MAX ? UINT32_MAX : (uint32_t)var;
+
+    if (canal->amostras < cfg->aquecimento)
+    {
+        canal->amostras++;
+        canal->estado = 0;
+        return 0;
+    }
+
+    // CUSUM bilateral sobre o z-score normalizado. O z é limitado ao limiar
+    // para que um pico isolado (já sinalizado pelo z-score) não sature o CUSUM.
+    q16_t z = canal->z;
+    if (z > cfg->z_limiar)
+        z = cfg->z_limiar;
+    if (z < -cfg->z_limiar)
+        z = -cfg->z_limiar;
+    q16_t pos = canal->cusum_pos + z - cfg->cusum_k;
+    q16_t neg = canal->cusum_neg - z - cfg->cusum_k;
+    canal->cusum_pos = pos > 0 ? pos : 0;
+    canal->cusum_neg = neg > 0 ? neg : 0;
+
+    uint8_t estado = 0;
+    if (q16_abs(canal->z) > cfg->z_limiar)
+        estado |= ANOMALIA_Z;
+    if (canal->cusum_pos > cfg->cusum_h)
+        estado |= ANOMALIA_CUSUM_SUBIDA;
+    if (canal->cusum_neg > cfg->cusum_h)
+        estado |= ANOMALIA_CUSUM_DESCIDA;
+
+    canal->estado = estado;
+    return estado;
+}
+
+char anomalia_simbolo(uint8_t estado)
+{
+    if (estado & ANOMALIA_Z)
+        return '!';
+    if (estado & ANOMALIA_CUSUM_SUBIDA)
+        return '+';
+    if (estado & ANOMALIA_CUSUM_DESCIDA)
+        return '-';
+    return ' ';
+}
@@ -0,0 +1,47 @@
+#ifndef ANOMALIA_H
+#define ANOMALIA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ponto_fixo.h"
+
+// Detector de anomalias por canal, com memória e custo O(1) por amostra:
+// - média e variância por média móvel exponencial (EWMA, alfa = 2^-alfa_shift)
+// - z-score da amostra em relação à média/desvio antes da atualização
+// - CUSUM bilateral sobre o z-score, para detectar deriva lenta e degraus
+
+// Bits de estado retornados por anomalia_atualizar()
+#define ANOMALIA_Z (1u << 0)             // |z| acima do limiar
+#define ANOMALIA_CUSUM_SUBIDA (1u << 1)  // deriva/degrau para cima
+#define ANOMALIA_CUSUM_DESCIDA (1u << 2) // deriva/degrau para baixo
+
+typedef struct
+{
+    uint8_t alfa_shift;  // sensibilidade da EWMA (maior = mais lenta)
+    q16_t z_limiar;      // limiar do z-score (em desvios)
+    q16_t cusum_k;       // folga do CUSUM (em desvios)
+    q16_t cusum_h;       // limiar de decisão do CUSUM (em desvios)
+    q16_t desvio_min;    // piso do desvio padrão, na unidade do canal
+    uint16_t aquecimento; // amostras antes de sinalizar
+} anomalia_config_t;
+
+typedef struct
+{
+    anomalia_config_t cfg;
+    q16_t media;
+    uint32_t variancia; // Q16.16, sem sinal
+    q16_t z;
+    q16_t cusum_pos;
+    q16_t cusum_neg;
+    uint16_t amostras;
+    uint8_t estado;
+} anomalia_canal_t;
+
+void anomalia_init(anomalia_canal_t *canal, const anomalia_config_t *cfg);
+uint8_t anomalia_atualizar(anomalia_canal_t *canal, q16_t amostra);
+q16_t anomalia_desvio(const anomalia_canal_t *canal);
+
+// Caractere indicador para o display: '!' (z), '+' (subida), '-' (descida) ou ' '
+char anomalia_simbolo(uint8_t estado);
+
+#endif
@@ -0,0 +1,64 @@
+#include "balanca.h"
+
+// Diferença mínima (em contagens) entre a tara e a massa de referência
+#define BALANCA_DIFERENCA_MIN 1000
+
+int32_t balanca_decodificar(uint32_t palavra)
+{
+    // Estende o sinal do bit 23
+    return (int32_t)(palavra << 8) >> 8;
+}
+
+bool balanca_saturada(int32_t bruto)
+{
+    return bruto >= 0x7FFFFF || bruto <= -0x800000;
+}
+
+void balanca_media_somar(balanca_media_t *m, int32_t bruto)
+{
+    if (balanca_saturada(bruto))
+        return;
+    m->soma += bruto;
+    m->n++;
+}
+
+bool balanca_media(const balanca_media_t *m, int32_t *media)
+{
+    if (m->n == 0)
+        return false;
+    int64_t meio = m->soma >= 0 ? m->n / 2 : -(int64_t)(m->n / 2);
+    *media = (int32_t)((m->soma + meio) / (int64_t)m->n);
+    return true;
+}
+
+q16_t balanca_kg(const balanca_calibracao_t *cal, int32_t bruto)
+{
+    if (cal->contagens_por_kg == 0)
+        return 0;
+    int64_t liquido = (int64_t)bruto - cal->tara;
+    int64_t kg = (liquido * Q16_UM) / cal->contagens_por_kg;
+    if (kg > INT32_MAX)
+        return INT32_MAX;
+    if (kg < INT32_MIN)
+        return INT32_MIN;
+    return (q16_t)kg;
+}
+
+void balanca_tarar(balanca_calibracao_t *cal, int32_t media_vazia)
+{
+    cal->tara = media_vazia;
+}
+
+bool balanca_calibrar_escala(balanca_calibracao_t *cal, int32_t media_com_peso, q16_t kg_referencia)
+{
+    int64_t liquido = (int64_t)media_com_peso - cal->tara;
+    if (kg_referencia <= 0 || (liquido < BALANCA_DIFERENCA_MIN && liquido > -BALANCA_DIFERENCA_MIN))
+        return false;
+
+    // Arredonda para o inteiro mais próximo
+    int64_t escala = (liquido * Q16_UM + (liquido >= 0 ? kg_referencia / 2 : -kg_referencia / 2)) / kg_referencia;
+    if (escala == 0 || escala > INT32_MAX || escala < INT32_MIN)
+        return false;
+    cal->contagens_por_kg = (int32_t)escala;
+    return true;
+}
@@ -0,0 +1,47 @@
+#ifndef BALANCA_H
+#define BALANCA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ponto_fixo.h"
+
+// Conversão das leituras brutas da célula de carga (HX711) em kg. Só usa
+// inteiros e não depende do SDK, para poder ser verificado no host.
+//   peso = (bruto - tara) / contagens_por_kg
+
+typedef struct
+{
+    int32_t tara;             // leitura bruta com a balança vazia
+    int32_t contagens_por_kg; // inclinação; negativa se a célula estiver invertida
+} balanca_calibracao_t;
+
+#define BALANCA_CALIBRACAO_PADRAO {0, 21000} // célula de 50 kg típica, ganho 128
+
+// Palavra de 24 bits em complemento de dois, como sai do HX711
+int32_t balanca_decodificar(uint32_t palavra);
+
+// Leituras que saturam em 0x7FFFFF/0x800000 indicam célula desconectada ou fora da faixa
+bool balanca_saturada(int32_t bruto);
+
+// Média das leituras para a tara e a escala, sem as saturadas
+typedef struct
+{
+    int64_t soma;
+    uint32_t n;
+} balanca_media_t;
+
+void balanca_media_somar(balanca_media_t *m, int32_t bruto);
+
+// Média arredondada para o inteiro mais próximo; false sem leitura válida
+bool balanca_media(const balanca_media_t *m, int32_t *media);
+
+q16_t balanca_kg(const balanca_calibracao_t *cal, int32_t bruto);
+
+// Tara pela média com a balança vazia
+void balanca_tarar(balanca_calibracao_t *cal, int32_t media_vazia);
+
+// Escala pela média com uma massa conhecida sobre a balança (após a tara).
+// Retorna false se a diferença for pequena demais para uma escala confiável.
+bool balanca_calibrar_escala(balanca_calibracao_t *cal, int32_t media_com_peso, q16_t kg_referencia);
+
+#endif
@@ -0,0 +1,334 @@
+#include "barramento_i2c.h"
+#include "relogio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "perfil.h"
+#include "sram.h"
+
+#define I2C_COMANDOS_MAX (1 + I2C_BLOCO_MAX + I2C_LEITURA_MAX)
+
+typedef struct
+{
+    i2c_inst_t *i2c;
+    uint baudrate;
+    uint dma_tx, dma_rx;
+    bool pronto;
+    volatile bool pausado;
+
+    // Filas por prioridade (início e fim); a transação em andamento fica no início da sua
+    i2c_transacao_t *inicio[I2C_NUM_PRIORIDADES];
+    i2c_transacao_t *fim[I2C_NUM_PRIORIDADES];
+
+    // Bloco em execução
+    i2c_transacao_t *volatile atual;
+    uint16_t bloco_dados;
+    uint32_t bloco_inicio_us;
+    bool abortado;
+
+    // Palavras para IC_DATA_CMD: byte + bits de leitura/RESTART/STOP
+    uint32_t comandos[I2C_COMANDOS_MAX];
+
+    i2c_dispositivo_t dispositivos[I2C_DISPOSITIVOS_MAX];
+    uint num_dispositivos;
+} barramento_t;
+
+static barramento_t barramentos[2];
+
+static barramento_t *barramento(i2c_inst_t *i2c)
+{
+    return &barramentos[i2c_hw_index(i2c)];
+}
+
+static i2c_dispositivo_t *dispositivo(barramento_t *b, uint8_t endereco)
+{
+    for (uint i = 0; i < b->num_dispositivos; i++)
+        if (b->dispositivos[i].endereco == endereco)
+            return &b->dispositivos[i];
+    if (b->num_dispositivos >= I2C_DISPOSITIVOS_MAX)
+        return NULL;
+    i2c_dispositivo_t *d = &b->dispositivos[b->num_dispositivos++];
+    d->endereco = endereco;
+    return d;
+}
+
+// Transação mais prioritária esperando (a do início da fila mais alta)
+static i2c_transacao_t *proxima(barramento_t *b)
+{
+    for (uint p = 0; p < I2C_NUM_PRIORIDADES; p++)
+        if (b->inicio[p])
+            return b->inicio[p];
+    return NULL;
+}
+
+// Monta e dispara o próximo bloco; chamada com as IRQs desligadas ou na IRQ
+static void NA_RAM(iniciar_proximo)(barramento_t *b)
+{
+    if (b->atual || b->pausado)
+        return;
+    i2c_transacao_t *t = proxima(b);
+    if (!t)
+        return;
+
+    i2c_hw_t *hw = i2c_get_hw(b->i2c);
+    uint n = 0;
+
+    if (t->estado == I2C_NA_FILA && t->enviados == 0)
+    {
+        i2c_dispositivo_t *d = dispositivo(b, t->endereco);
+        uint32_t espera = time_us_32() - t->enfileirada_us;
+        if (d && espera > d->espera_max_us)
+            d->espera_max_us = espera;
+    }
+    t->estado = I2C_EXECUTANDO;
+
+    if (t->prefixo >= 0)
+    {
+        // Bloco de uma escrita fracionada: prefixo + até I2C_BLOCO_MAX bytes
+        uint restante = t->n_escrita - t->enviados;
+        b->bloco_dados = restante < I2C_BLOCO_MAX ? restante : I2C_BLOCO_MAX;
+        b->comandos[n++] = (uint8_t)t->prefixo;
+        for (uint i = 0; i < b->bloco_dados; i++)
+            b->comandos[n++] = t->escrita[t->enviados + i];
+        b->comandos[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    }
+    else
+    {
+        b->bloco_dados = t->n_escrita + t->n_leitura;
+        for (uint i = 0; i < t->n_escrita; i++)
+            b->comandos[n++] = t->escrita[i];
+        for (uint i = 0; i < t->n_leitura; i++)
+            b->comandos[n++] = I2C_IC_DATA_CMD_CMD_BITS | (i == 0 && t->n_escrita ? I2C_IC_DATA_CMD_RESTART_BITS : 0);
+        b->comandos[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    }
+
+    // O endereço de destino só muda com o controlador desabilitado
+    hw->enable = 0;
+    hw->tar = t->endereco;
+    hw->enable = 1;
+
+    b->atual = t;
+    b->abortado = false;
+    b->bloco_inicio_us = time_us_32();
+
+    if (t->prefixo < 0 && t->n_leitura)
+    {
+        dma_channel_config c = dma_channel_get_default_config(b->dma_rx);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+        channel_config_set_read_increment(&c, false);
+        channel_config_set_write_increment(&c, true);
+        channel_config_set_dreq(&c, i2c_get_dreq(b->i2c, false));
+        dma_channel_configure(b->dma_rx, &c, t->leitura, &hw->data_cmd, t->n_leitura, true);
+    }
+    dma_channel_set_read_addr(b->dma_tx, b->comandos, false);
+    dma_channel_set_trans_count(b->dma_tx, n, true);
+}
+
+static void NA_RAM(retirar)(barramento_t *b, i2c_transacao_t *t)
+{
+    b->inicio[t->prioridade] = t->proxima;
+    if (!t->proxima)
+        b->fim[t->prioridade] = NULL;
+    t->proxima = NULL;
+}
+
+// STOP no barramento: fecha o bloco e passa ao seguinte
+static void NA_RAM(concluir_bloco)(barramento_t *b)
+{
+    i2c_transacao_t *t = b->atual;
+    if (!t)
+        return;
+
+    if (!b->abortado && t->prefixo < 0 && t->n_leitura)
+        dma_channel_wait_for_finish_blocking(b->dma_rx);
+
+    i2c_dispositivo_t *d = dispositivo(b, t->endereco);
+    if (d)
+    {
+        d->ocupado_us += time_us_32() - b->bloco_inicio_us;
+        d->blocos++;
+        d->bytes += b->bloco_dados;
+    }
+
+    bool terminou = true;
+    if (b->abortado)
+    {
+        t->estado = I2C_ERRO;
+        if (d)
+            d->erros++;
+    }
+    else if (t->prefixo >= 0 && (t->enviados += b->bloco_dados) < t->n_escrita)
+    {
+        // Ainda há blocos: volta para a fila sem perder o lugar
+        t->estado = I2C_NA_FILA;
+        terminou = false;
+    }
+    else
+    {
+        t->estado = I2C_OK;
+    }
+
+    b->atual = NULL;
+    if (terminou)
+    {
+        retirar(b, t);
+        if (d)
+            d->transacoes++;
+        if (t->fim)
+            t->fim(t, t->contexto);
+    }
+    iniciar_proximo(b);
+}
+
+// Interrupção e tudo que ela chama ficam na SRAM (inc/sram.h)
+static void NA_RAM(barramento_irq)(barramento_t *b)
+{
+    PERFIL_INICIO(marca);
+    i2c_hw_t *hw = i2c_get_hw(b->i2c);
+    uint32_t estado = hw->intr_stat;
+
+    if (estado & I2C_IC_INTR_STAT_R_TX_ABRT_BITS)
+    {
+        // NAK: o controlador descarta o FIFO e gera STOP; para o DMA antes de liberar
+        dma_channel_abort(b->dma_tx);
+        dma_channel_abort(b->dma_rx);
+        b->abortado = true;
+        (void)hw->clr_tx_abrt;
+    }
+    if (estado & I2C_IC_INTR_STAT_R_STOP_DET_BITS)
+    {
+        (void)hw->clr_stop_det;
+        concluir_bloco(b);
+    }
+    PERFIL_FIM(PERFIL_ISR_I2C, marca);
+}
+
+static void NA_RAM(barramento_irq0)(void)
+{
+    barramento_irq(&barramentos[0]);
+}
+
+static void NA_RAM(barramento_irq1)(void)
+{
+    barramento_irq(&barramentos[1]);
+}
+
+// Troca de clock: termina o bloco em andamento e segura a fila até o novo baud
+static void retemporizar_barramento(relogio_fase_t fase, uint32_t sys_hz, void *contexto)
+{
+    barramento_t *b = contexto;
+    if (fase == RELOGIO_ANTES)
+    {
+        b->pausado = true;
+        while (b->atual)
+            tight_loop_contents();
+        return;
+    }
+    i2c_set_baudrate(b->i2c, b->baudrate);
+    b->pausado = false;
+    uint32_t irq = save_and_disable_interrupts();
+    iniciar_proximo(b);
+    restore_interrupts(irq);
+}
+
+bool barramento_i2c_init(i2c_inst_t *i2c, uint baudrate)
+{
+    barramento_t *b = barramento(i2c);
+    int tx = dma_claim_unused_channel(false);
+    if (tx < 0)
+        return false;
+    int rx = dma_claim_unused_channel(false);
+    if (rx < 0)
+    {
+        dma_channel_unclaim(tx);
+        return false;
+    }
+
+    b->i2c = i2c;
+    b->baudrate = baudrate;
+    b->dma_tx = tx;
+    b->dma_rx = rx;
+
+    // O canal de envio é sempre o mesmo: comandos -> IC_DATA_CMD
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    dma_channel_config c = dma_channel_get_default_config(tx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+    dma_channel_configure(tx, &c, &hw->data_cmd, b->comandos, 0, false);
+
+    hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS | I2C_IC_DMA_CR_RDMAE_BITS;
+    hw->dma_tdlr = 8; // meio FIFO: o DMA repõe antes de esvaziar
+    hw->dma_rdlr = 0;
+
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+    uint irq = i2c_hw_index(i2c) ? I2C1_IRQ : I2C0_IRQ;
+    irq_set_exclusive_handler(irq, i2c_hw_index(i2c) ? barramento_irq1 : barramento_irq0);
+    irq_set_enabled(irq, true);
+
+    b->pronto = true;
+    relogio_registrar(retemporizar_barramento, b);
+    return true;
+}
+
+// Só as escritas fracionáveis podem passar do tamanho de um bloco, e não leem
+static bool transacao_valida(const i2c_transacao_t *t)
+{
+    if (t->prefixo >= 0)
+        return t->n_leitura == 0 && t->n_escrita > 0;
+    return t->n_escrita + t->n_leitura > 0 && t->n_escrita <= I2C_BLOCO_MAX + 1 && t->n_leitura <= I2C_LEITURA_MAX;
+}
+
+bool barramento_i2c_enviar(i2c_inst_t *i2c, i2c_transacao_t *transacao)
+{
+    barramento_t *b = barramento(i2c);
+    if (!b->pronto || barramento_i2c_pendente(transacao))
+        return false;
+
+    if (!transacao_valida(transacao))
+        return false;
+
+    transacao->estado = I2C_NA_FILA;
+    transacao->enviados = 0;
+    transacao->enfileirada_us = time_us_32();
+    transacao->proxima = NULL;
+
+    uint32_t irq = save_and_disable_interrupts();
+    i2c_prioridade_t p = transacao->prioridade;
+    if (b->fim[p])
+        b->fim[p]->proxima = transacao;
+    else
+        b->inicio[p] = transacao;
+    b->fim[p] = transacao;
+    iniciar_proximo(b);
+    restore_interrupts(irq);
+    return true;
+}
+
+bool barramento_i2c_executar(i2c_inst_t *i2c, i2c_transacao_t *transacao)
+{
+    while (barramento_i2c_pendente(transacao))
+        tight_loop_contents();
+    if (!barramento_i2c_enviar(i2c, transacao))
+        return false;
+    while (barramento_i2c_pendente(transacao))
+        tight_loop_contents();
+    return transacao->estado == I2C_OK;
+}
+
+bool barramento_i2c_ocupado(i2c_inst_t *i2c)
+{
+    barramento_t *b = barramento(i2c);
+    for (uint p = 0; p < I2C_NUM_PRIORIDADES; p++)
+        if (b->inicio[p])
+            return true;
+    return false;
+}
+
+uint barramento_i2c_dispositivos(i2c_inst_t *i2c, const i2c_dispositivo_t **lista)
+{
+    barramento_t *b = barramento(i2c);
+    *lista = b->dispositivos;
+    return b->num_dispositivos;
+}
@@ -0,0 +1,93 @@
+#ifndef BARRAMENTO_I2C_H
+#define BARRAMENTO_I2C_H
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+// Gerenciador do barramento I2C. Os drivers descrevem cada operação num
+// i2c_transacao_t e a colocam na fila; a execução é por DMA e avança na IRQ
+// de STOP do controlador, sem a CPU esperar. A fila tem prioridades: leituras
+// de sensores passam à frente dos quadros do display. Escritas grandes com
+// prefixo (dados do SSD1306) são quebradas em blocos, e entre um bloco e outro
+// uma transação mais prioritária pode usar o barramento.
+
+#define I2C_BLOCO_MAX 32      // bytes de dados por bloco das transações fracionáveis
+#define I2C_LEITURA_MAX 32
+#define I2C_DISPOSITIVOS_MAX 8 // dispositivos com contabilidade própria
+
+typedef enum
+{
+    I2C_PRIORIDADE_ALTA,   // leituras de sensores
+    I2C_PRIORIDADE_NORMAL, // comandos e configuração
+    I2C_PRIORIDADE_BAIXA,  // quadros do display
+    I2C_NUM_PRIORIDADES
+} i2c_prioridade_t;
+
+typedef enum
+{
+    I2C_LIVRE,     // nunca enviada ou já concluída e recolhida
+    I2C_NA_FILA,
+    I2C_EXECUTANDO,
+    I2C_OK,
+    I2C_ERRO       // NAK ou perda de arbitragem
+} i2c_estado_t;
+
+typedef struct i2c_transacao i2c_transacao_t;
+typedef void (*i2c_fim_t)(i2c_transacao_t *transacao, void *contexto);
+
+struct i2c_transacao
+{
+    uint8_t endereco;
+    i2c_prioridade_t prioridade;
+
+    // Escrita, seguida (se n_leitura > 0) de repeated start e leitura
+    const uint8_t *escrita;
+    uint16_t n_escrita;
+    uint8_t *leitura;
+    uint16_t n_leitura;
+
+    // Transação fracionável: cada bloco vira uma escrita própria começando
+    // pelo byte de prefixo (ex.: 0x40, dados do SSD1306). -1 = não fracionar.
+    int16_t prefixo;
+
+    i2c_fim_t fim; // chamado na IRQ; pode ser NULL
+    void *contexto;
+
+    // Preenchidos pelo gerenciador
+    volatile i2c_estado_t estado;
+    uint16_t enviados;
+    uint32_t enfileirada_us;
+    i2c_transacao_t *proxima;
+};
+
+typedef struct
+{
+    uint8_t endereco;
+    uint32_t transacoes;
+    uint32_t blocos;
+    uint32_t bytes;
+    uint32_t erros;
+    uint64_t ocupado_us;    // tempo de barramento usado
+    uint32_t espera_max_us; // maior espera na fila até o primeiro bloco
+} i2c_dispositivo_t;
+
+// Assume o controlador já inicializado por i2c_init e seus pinos
+bool barramento_i2c_init(i2c_inst_t *i2c, uint baudrate);
+
+// Coloca na fila; false se a transação ainda estiver na fila ou executando
+bool barramento_i2c_enviar(i2c_inst_t *i2c, i2c_transacao_t *transacao);
+
+// Envia e espera a conclusão (só em contexto de tarefa, ex.: inicialização)
+bool barramento_i2c_executar(i2c_inst_t *i2c, i2c_transacao_t *transacao);
+
+static inline bool barramento_i2c_pendente(const i2c_transacao_t *transacao)
+{
+    return transacao->estado == I2C_NA_FILA || transacao->estado == I2C_EXECUTANDO;
+}
+
+bool barramento_i2c_ocupado(i2c_inst_t *i2c);
+
+// Contabilidade por endereço; retorna a quantidade de dispositivos
+uint barramento_i2c_dispositivos(i2c_inst_t *i2c, const i2c_dispositivo_t **lista);
+
+#endif
@@ -0,0 +1,174 @@
+#include <math.h>
+#include <string.h>
+#include "calibracao.h"
+
+#define CALIBRACAO_FUNDO_ESCALA ((float)((1 << CALIBRACAO_BITS) - 1))
+
+// Pontos a menos de meio trecho um do outro são a mesma leitura
+#define CALIBRACAO_DISTANCIA_MIN ((1 << CALIBRACAO_DESLOCAMENTO) / 2)
+
+// Correção de temperatura/umidade do MQ-135 (ajuste das curvas da folha de
+// dados): fator = A·T² - B·T + C - D·(H - 33), 1 perto de 20 °C e 33 %.
+// A, B e D em Q32 para não perder precisão nos coeficientes pequenos.
+#define Q32(x) ((int64_t)((x) * 4294967296.0))
+#define CORRECAO_A Q32(0.00035)
+#define CORRECAO_B Q32(0.02718)
+#define CORRECAO_C Q16(1.39538)
+#define CORRECAO_D Q32(0.0018)
+
+static q16_t para_q16(float y)
+{
+    if (!(y < CALIBRACAO_LIMITE)) // inclui NaN e infinito
+        return CALIBRACAO_LIMITE * Q16_UM;
+    if (y < -CALIBRACAO_LIMITE)
+        return -CALIBRACAO_LIMITE * Q16_UM;
+    return (q16_t)lroundf(y * Q16_UM);
+}
+
+// Resistência do sensor pela tensão no resistor de carga
+static float resistencia(const calibracao_curva_t *c, float x)
+{
+    float u = x / CALIBRACAO_FUNDO_ESCALA;
+    float borda = 0.5f / CALIBRACAO_FUNDO_ESCALA;
+    if (u < borda)
+        u = borda;
+    else if (u > 1.0f - borda)
+        u = 1.0f - borda;
+    return c->coef[2] * (1.0f - u) / u;
+}
+
+float calibracao_avaliar(const calibracao_curva_t *c, float x)
+{
+    float u = x / CALIBRACAO_FUNDO_ESCALA;
+    switch (c->tipo)
+    {
+    case CURVA_LINEAR:
+        return c->coef[0] + c->coef[1] * u;
+    case CURVA_POLINOMIO:
+        return c->coef[0] + u * (c->coef[1] + u * (c->coef[2] + u * c->coef[3]));
+    case CURVA_POTENCIA:
+        return c->coef[0] * powf(resistencia(c, x) / c->coef[3], c->coef[1]);
+    case CURVA_PONTOS:
+    {
+        // Trecho que contém x; as pontas estendem o primeiro e o último
+        int i = 0;
+        while (i + 2 < c->n_pontos && x > c->pontos[i + 1].x)
+            i++;
+        const calibracao_ponto_t *a = &c->pontos[i], *b = &c->pontos[i + 1];
+        return a->y + (b->y - a->y) * (x - a->x) / (b->x - a->x);
+    }
+    default:
+        return 0.0f;
+    }
+}
+
+static bool curva_valida(const calibracao_curva_t *c)
+{
+    switch (c->tipo)
+    {
+    case CURVA_LINEAR:
+    case CURVA_POLINOMIO:
+        for (int i = 0; i < 4; i++)
+            if (!isfinite(c->coef[i]))
+                return false;
+        return true;
+    case CURVA_POTENCIA:
+        return c->coef[0] > 0.0f && isfinite(c->coef[1]) && c->coef[1] != 0.0f && c->coef[2] > 0.0f &&
+               c->coef[3] > 0.0f && isfinite(c->coef[0] + c->coef[2] + c->coef[3]);
+    case CURVA_PONTOS:
+        if (c->n_pontos < 2 || c->n_pontos > CALIBRACAO_MAX_PONTOS)
+            return false;
+        for (int i = 0; i < c->n_pontos; i++)
+            if (!isfinite(c->pontos[i].x) || !isfinite(c->pontos[i].y) ||
+                (i > 0 && c->pontos[i].x - c->pontos[i - 1].x < CALIBRACAO_DISTANCIA_MIN))
+                return false;
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool calibracao_compilar(calibracao_tabela_t *t, const calibracao_curva_t *c)
+{
+    if (!curva_valida(c))
+        return false;
+
+    // Um ponto a mais no fim (x = 4096) fecha o último trecho
+    for (int i = 0; i <= CALIBRACAO_SEGMENTOS; i++)
+        t->lut[i] = para_q16(calibracao_avaliar(c, (float)(i << CALIBRACAO_DESLOCAMENTO)));
+
+    // y = c0·(Rs/(R0·fator))^c1 = y(sem correção)·fator^(-c1)
+    t->compensar = c->tipo == CURVA_POTENCIA && c->compensar;
+    for (int i = 0; i <= CALIBRACAO_FATOR_SEGMENTOS; i++)
+    {
+        float fator = (float)(CALIBRACAO_FATOR_MIN + (i << CALIBRACAO_FATOR_DESLOCAMENTO)) / Q16_UM;
+        t->fator_lut[i] = t->compensar ? para_q16(powf(fator, -c->coef[1])) : Q16_UM;
+    }
+    t->fator = Q16_UM;
+    t->correcao = Q16_UM;
+    return true;
+}
+
+void calibracao_ambiente(calibracao_tabela_t *t, q16_t temperatura, q16_t umidade)
+{
+    if (!t->compensar)
+        return;
+    int64_t temp = temperatura;
+    int64_t fator = CORRECAO_C + ((CORRECAO_A * ((temp * temp) >> 16)) >> 32) - ((CORRECAO_B * temp) >> 32) -
+                    ((CORRECAO_D * ((int64_t)umidade - 33 * Q16_UM)) >> 32);
+
+    int64_t maximo = CALIBRACAO_FATOR_MIN + ((int64_t)CALIBRACAO_FATOR_SEGMENTOS << CALIBRACAO_FATOR_DESLOCAMENTO) - 1;
+    if (fator < CALIBRACAO_FATOR_MIN)
+        fator = CALIBRACAO_FATOR_MIN;
+    else if (fator > maximo)
+        fator = maximo;
+
+    uint32_t desvio = (uint32_t)(fator - CALIBRACAO_FATOR_MIN);
+    uint32_t i = desvio >> CALIBRACAO_FATOR_DESLOCAMENTO;
+    int64_t f = desvio & ((1 << CALIBRACAO_FATOR_DESLOCAMENTO) - 1);
+    t->fator = (q16_t)fator;
+    t->correcao = t->fator_lut[i] +
+                  (q16_t)((((int64_t)t->fator_lut[i + 1] - t->fator_lut[i]) * f) >> CALIBRACAO_FATOR_DESLOCAMENTO);
+}
+
+bool calibracao_adicionar_ponto(calibracao_curva_t *c, float x, float y)
+{
+    if (!isfinite(x) || !isfinite(y))
+        return false;
+    if (c->tipo != CURVA_PONTOS)
+    {
+        memset(c, 0, sizeof(*c));
+        c->tipo = CURVA_PONTOS;
+    }
+
+    int i = 0;
+    while (i < c->n_pontos && c->pontos[i].x < x - CALIBRACAO_DISTANCIA_MIN)
+        i++;
+    if (i < c->n_pontos && c->pontos[i].x < x + CALIBRACAO_DISTANCIA_MIN)
+    {
+        c->pontos[i].x = x;
+        c->pontos[i].y = y;
+        return true;
+    }
+    if (c->n_pontos >= CALIBRACAO_MAX_PONTOS)
+        return false;
+    memmove(&c->pontos[i + 1], &c->pontos[i], (c->n_pontos - i) * sizeof(c->pontos[0]));
+    c->pontos[i].x = x;
+    c->pontos[i].y = y;
+    c->n_pontos++;
+    return true;
+}
+
+bool calibracao_ajustar_r0(calibracao_curva_t *c, const calibracao_tabela_t *t, uint16_t bruto, float referencia)
+{
+    if (c->tipo != CURVA_POTENCIA || referencia <= 0.0f || !curva_valida(c))
+        return false;
+    // Rs/(R0·fator) = (y/c0)^(1/c1)
+    float razao = powf(referencia / c->coef[0], 1.0f / c->coef[1]);
+    float fator = c->compensar ? q16_para_float(t->fator) : 1.0f;
+    float r0 = resistencia(c, bruto) / (razao * fator);
+    if (!isfinite(r0) || r0 <= 0.0f)
+        return false;
+    c->coef[3] = r0;
+    return true;
+}
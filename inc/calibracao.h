@@ -0,0 +1,107 @@
+#ifndef CALIBRACAO_H
+#define CALIBRACAO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ponto_fixo.h"
+
+// Calibração e linearização dos canais analógicos (ADC de 12 bits). Cada canal
+// tem uma curva, dada por coeficientes ou por pontos de calibração, que é
+// compilada numa tabela Q16 de trechos lineares uniformes só quando muda. Por
+// amostra, a conversão é uma consulta à tabela e uma interpolação, sem float
+// nem powf/logf; a compilação usa float e roda na configuração.
+// Não depende do SDK, para poder ser verificado no host.
+
+#define CALIBRACAO_BITS 12
+#define CALIBRACAO_DESLOCAMENTO 4 // 16 contagens por trecho
+#define CALIBRACAO_SEGMENTOS ((1 << CALIBRACAO_BITS) >> CALIBRACAO_DESLOCAMENTO)
+#define CALIBRACAO_MAX_PONTOS 6
+#define CALIBRACAO_LIMITE 30000 // saturação da saída, dentro da faixa do Q16
+
+// Correção de temperatura/umidade das curvas de potência: tabela do fator
+// entre CALIBRACAO_FATOR_MIN e CALIBRACAO_FATOR_MIN + 2, em passos de 1/32
+#define CALIBRACAO_FATOR_DESLOCAMENTO 11
+#define CALIBRACAO_FATOR_SEGMENTOS 64
+#define CALIBRACAO_FATOR_MIN (Q16_UM / 2)
+
+typedef enum
+{
+    CURVA_LINEAR,    // y = c0 + c1·u, com u = x/4095 (fração do fundo de escala)
+    CURVA_POLINOMIO, // y = c0 + c1·u + c2·u² + c3·u³
+    CURVA_POTENCIA,  // sensor resistivo (MQ-135) num divisor: y = c0·(Rs/R0)^c1,
+                     // Rs = c2·(1 - u)/u (c2 = resistor de carga), R0 = c3
+    CURVA_PONTOS,    // pontos (x em contagens, y) ligados por retas, extrapolando nas pontas
+    NUM_CURVAS
+} curva_tipo_t;
+
+typedef struct
+{
+    float x; // leitura bruta
+    float y; // valor de referência
+} calibracao_ponto_t;
+
+// Definição gravada na flash (52 bytes)
+typedef struct
+{
+    uint8_t tipo;      // curva_tipo_t
+    uint8_t n_pontos;  // CURVA_PONTOS
+    uint8_t compensar; // CURVA_POTENCIA: corrige por temperatura e umidade
+    uint8_t reservado;
+    union
+    {
+        float coef[4];
+        calibracao_ponto_t pontos[CALIBRACAO_MAX_PONTOS]; // x crescente
+    };
+} calibracao_curva_t;
+
+// Tabela compilada de um canal
+typedef struct
+{
+    q16_t lut[CALIBRACAO_SEGMENTOS + 1];
+    q16_t fator_lut[CALIBRACAO_FATOR_SEGMENTOS + 1]; // fator^(-c1), com compensação
+    q16_t fator;    // correção de T/H atual (1 = 20 °C e 33 %, ou sem compensação)
+    q16_t correcao; // multiplicador da saída pelo fator atual
+    bool compensar;
+} calibracao_tabela_t;
+
+static inline q16_t calibracao_saturar(int64_t v)
+{
+    if (v > (int64_t)CALIBRACAO_LIMITE * Q16_UM)
+        return CALIBRACAO_LIMITE * Q16_UM;
+    if (v < -(int64_t)CALIBRACAO_LIMITE * Q16_UM)
+        return -CALIBRACAO_LIMITE * Q16_UM;
+    return (q16_t)v;
+}
+
+// Leitura bruta (0 a 4095) na unidade do canal
+static inline q16_t calibracao_aplicar(const calibracao_tabela_t *t, uint16_t bruto)
+{
+    if (bruto >= (1 << CALIBRACAO_BITS))
+        bruto = (1 << CALIBRACAO_BITS) - 1;
+    uint32_t i = bruto >> CALIBRACAO_DESLOCAMENTO;
+    int64_t f = bruto & ((1 << CALIBRACAO_DESLOCAMENTO) - 1);
+    q16_t y = t->lut[i] + (q16_t)((((int64_t)t->lut[i + 1] - t->lut[i]) * f) >> CALIBRACAO_DESLOCAMENTO);
+    if (!t->compensar)
+        return y;
+    return calibracao_saturar(((int64_t)y * t->correcao) >> 16);
+}
+
+// Curva em float, para a compilação e para conferência; x em contagens
+float calibracao_avaliar(const calibracao_curva_t *c, float x);
+
+// Valida a curva e gera a tabela; false (tabela intacta) se a curva for inválida
+bool calibracao_compilar(calibracao_tabela_t *t, const calibracao_curva_t *c);
+
+// Temperatura (°C) e umidade (%) do ar para a correção; só consulta a tabela
+// do fator, então pode ser chamada a cada amostra
+void calibracao_ambiente(calibracao_tabela_t *t, q16_t temperatura, q16_t umidade);
+
+// Insere um ponto de calibração mantendo x crescente (substitui o que estiver
+// a menos de meio trecho); converte a curva em CURVA_PONTOS. false se cheia.
+bool calibracao_adicionar_ponto(calibracao_curva_t *c, float x, float y);
+
+// Ajusta R0 de uma curva de potência pela leitura atual num ambiente de
+// referência (ar limpo: ~400 ppm de CO2), com a correção de T/H da tabela
+bool calibracao_ajustar_r0(calibracao_curva_t *c, const calibracao_tabela_t *t, uint16_t bruto, float referencia);
+
+#endif
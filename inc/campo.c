@@ -0,0 +1,240 @@
+#include <string.h>
+#include "campo.h"
+#include "crc32.h"
+
+_Static_assert(sizeof(campo_amostra_t) == 20, "amostra no fio deve ter 20 bytes");
+
+bool campo_decodificar(campo_decodificador_t *d, uint8_t byte)
+{
+    if (d->pos == 0)
+    {
+        if (byte == CAMPO_SINC0)
+            d->quadro[d->pos++] = byte;
+        else
+            d->ruido++;
+        return false;
+    }
+    if (d->pos == 1)
+    {
+        if (byte == CAMPO_SINC1)
+            d->quadro[d->pos++] = byte;
+        else if (byte != CAMPO_SINC0)
+        {
+            d->pos = 0;
+            d->ruido += 2;
+        }
+        else
+            d->ruido++;
+        return false;
+    }
+
+    d->quadro[d->pos++] = byte;
+    if (d->pos == CAMPO_CABECALHO)
+    {
+        if (byte > CAMPO_CARGA_MAX)
+        {
+            d->pos = 0;
+            d->ruido += CAMPO_CABECALHO;
+            return false;
+        }
+        d->esperado = CAMPO_CABECALHO + byte + sizeof(uint32_t);
+    }
+    if (d->pos < CAMPO_CABECALHO || d->pos < d->esperado)
+        return false;
+
+    d->pos = 0;
+    uint32_t crc;
+    memcpy(&crc, &d->quadro[d->esperado - sizeof(crc)], sizeof(crc));
+    if (crc32_calcular(&d->quadro[2], d->esperado - 2 - sizeof(crc)) != crc)
+    {
+        d->erros_crc++;
+        return false;
+    }
+    d->quadros++;
+    return true;
+}
+
+size_t campo_montar(uint8_t *quadro, uint8_t endereco, campo_tipo_t tipo, uint8_t seq, size_t carga)
+{
+    quadro[0] = CAMPO_SINC0;
+    quadro[1] = CAMPO_SINC1;
+    quadro[2] = endereco;
+    quadro[3] = tipo;
+    quadro[4] = seq;
+    quadro[5] = (uint8_t)carga;
+    uint32_t crc = crc32_calcular(&quadro[2], CAMPO_CABECALHO - 2 + carga);
+    memcpy(&quadro[CAMPO_CABECALHO + carga], &crc, sizeof(crc));
+    return CAMPO_CABECALHO + carga + sizeof(crc);
+}
+
+uint32_t campo_janela_us(uint32_t baud, uint32_t folga_us)
+{
+    // 10 bits por byte (8N1)
+    uint64_t bytes = CAMPO_CABECALHO + sizeof(campo_consulta_t) + sizeof(uint32_t) + CAMPO_QUADRO_MAX;
+    return (uint32_t)(bytes * 10 * 1000000 / baud) + folga_us;
+}
+
+// ---------------------------------------------------------------------------
+// Nó
+
+void campo_no_init(campo_no_t *no, uint8_t endereco, uint8_t seq_inicial)
+{
+    memset(no, 0, sizeof(*no));
+    no->endereco = endereco;
+    no->seq = seq_inicial;
+}
+
+bool campo_no_guardar(campo_no_t *no, const campo_amostra_t *amostra)
+{
+    if (no->quantidade >= CAMPO_FILA)
+    {
+        no->est.descartadas++;
+        return false;
+    }
+    no->fila[(no->inicio + no->quantidade) % CAMPO_FILA] = *amostra;
+    no->quantidade++;
+    return true;
+}
+
+size_t campo_no_byte(campo_no_t *no, uint8_t byte, uint8_t *resposta)
+{
+    if (!campo_decodificar(&no->dec, byte))
+        return 0;
+    const uint8_t *q = no->dec.quadro;
+    if (campo_endereco(q) != no->endereco || campo_tipo(q) != CAMPO_CONSULTA || q[5] < sizeof(campo_consulta_t))
+        return 0;
+    no->est.consultas++;
+
+    // Confirmação do lote em trânsito: libera o início da fila; sem ela, o
+    // mesmo lote sai de novo
+    const campo_consulta_t *consulta = (const campo_consulta_t *)&q[CAMPO_CABECALHO];
+    if (no->n_pendente && consulta->confirmado && campo_seq(q) == no->seq)
+    {
+        no->inicio = (no->inicio + no->n_pendente) % CAMPO_FILA;
+        no->quantidade -= no->n_pendente;
+        no->est.amostras += no->n_pendente;
+        no->n_pendente = 0;
+    }
+    else if (no->n_pendente)
+        no->est.retransmissoes++;
+    if (!no->n_pendente)
+    {
+        no->n_pendente = no->quantidade < CAMPO_LOTE_MAX ? no->quantidade : CAMPO_LOTE_MAX;
+        if (no->n_pendente)
+            no->seq++;
+    }
+
+    campo_lote_t lote = {
+        .descartadas = no->est.descartadas > UINT16_MAX ? UINT16_MAX : (uint16_t)no->est.descartadas,
+        .na_fila = no->quantidade - no->n_pendente,
+    };
+    uint8_t *p = &resposta[CAMPO_CABECALHO];
+    memcpy(p, &lote, sizeof(lote));
+    p += sizeof(lote);
+    for (uint16_t i = 0; i < no->n_pendente; i++, p += sizeof(campo_amostra_t))
+        memcpy(p, &no->fila[(no->inicio + i) % CAMPO_FILA], sizeof(campo_amostra_t));
+    no->est.lotes++;
+    return campo_montar(resposta, no->endereco, CAMPO_LOTE, no->seq,
+                        sizeof(lote) + no->n_pendente * sizeof(campo_amostra_t));
+}
+
+// ---------------------------------------------------------------------------
+// Mestre
+
+bool campo_mestre_init(campo_mestre_t *m, const uint8_t *enderecos, uint8_t n, uint32_t janela_us,
+                       uint8_t tentativas_max, campo_entregar_t entregar, void *contexto)
+{
+    if (n == 0 || n > CAMPO_NOS_MAX)
+        return false;
+    memset(m, 0, sizeof(*m));
+    memcpy(m->enderecos, enderecos, n);
+    m->n_nos = n;
+    m->janela_us = janela_us;
+    m->tentativas_max = tentativas_max;
+    m->entregar = entregar;
+    m->contexto = contexto;
+    return true;
+}
+
+static void proximo_no(campo_mestre_t *m)
+{
+    m->tentativa = 0;
+    if (++m->atual >= m->n_nos)
+    {
+        m->atual = 0;
+        m->ciclos++;
+    }
+}
+
+size_t campo_mestre_consultar(campo_mestre_t *m, uint64_t agora_us, uint8_t *quadro)
+{
+    uint8_t i = m->atual;
+    campo_consulta_t consulta = {.confirmado = m->recebeu[i]};
+    memcpy(&quadro[CAMPO_CABECALHO], &consulta, sizeof(consulta));
+    m->remotos[i].consultas++;
+    m->esperando = true;
+    m->enviado_us = agora_us;
+    m->dec.pos = 0;
+    return campo_montar(quadro, m->enderecos[i], CAMPO_CONSULTA, m->ultimo_seq[i], sizeof(consulta));
+}
+
+bool campo_mestre_byte(campo_mestre_t *m, uint8_t byte, uint64_t agora_us)
+{
+    if (!campo_decodificar(&m->dec, byte) || !m->esperando)
+        return false;
+    const uint8_t *q = m->dec.quadro;
+    uint8_t i = m->atual;
+    if (campo_tipo(q) != CAMPO_LOTE || campo_endereco(q) != m->enderecos[i] || q[5] < sizeof(campo_lote_t))
+        return false; // eco da própria consulta ou resposta fora de hora
+
+    size_t bytes = q[5] - sizeof(campo_lote_t);
+    if (bytes % sizeof(campo_amostra_t))
+        return false;
+    campo_remoto_t *r = &m->remotos[i];
+    campo_lote_t lote;
+    memcpy(&lote, &q[CAMPO_CABECALHO], sizeof(lote));
+    size_t n = bytes / sizeof(campo_amostra_t);
+    uint8_t seq = campo_seq(q);
+    if (n > 0 && m->recebeu[i] && seq == m->ultimo_seq[i])
+        r->duplicados++; // a confirmação anterior se perdeu
+    else if (n > 0)
+    {
+        // A carga fica logo depois do cabeçalho do lote, sem garantia de alinhamento
+        campo_amostra_t amostras[CAMPO_LOTE_MAX];
+        memcpy(amostras, &q[CAMPO_CABECALHO + sizeof(lote)], bytes);
+        m->ultimo_seq[i] = seq;
+        m->recebeu[i] = true;
+        r->amostras += n;
+        if (m->entregar)
+            m->entregar(m->contexto, m->enderecos[i], amostras, n);
+    }
+    r->descartadas = lote.descartadas;
+    r->respostas++;
+    uint32_t latencia = (uint32_t)(agora_us - m->enviado_us);
+    r->latencia_soma_us += latencia;
+    if (latencia > r->latencia_max_us)
+        r->latencia_max_us = latencia;
+    m->esperando = false;
+    proximo_no(m);
+    return true;
+}
+
+bool campo_mestre_expirar(campo_mestre_t *m)
+{
+    if (!m->esperando)
+        return false;
+    m->esperando = false;
+    campo_remoto_t *r = &m->remotos[m->atual];
+    r->expiradas++;
+    if (m->tentativa < m->tentativas_max)
+    {
+        m->tentativa++;
+        r->retentativas++;
+    }
+    else
+    {
+        r->falhas++;
+        proximo_no(m);
+    }
+    return true;
+}
@@ -0,0 +1,195 @@
+#ifndef CAMPO_H
+#define CAMPO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Barramento de campo mestre/escravo (RS-485 half-duplex, ou UART direta)
+// para ler muitas BeeSense por um só cabo. O mestre consulta os nós um a um,
+// em rodízio; cada consulta abre uma janela fixa em que só o nó endereçado
+// transmite, respondendo com um lote das amostras guardadas desde a última
+// consulta. Quadros binários, little-endian:
+//
+//   0xBE 0xE5 | endereço | tipo | seq | tamanho | carga[tamanho] | crc32
+//
+// O CRC-32 (inc/crc32.h) cobre do endereço ao fim da carga. A consulta leva o
+// seq do último lote recebido daquele nó; sem essa confirmação o nó
+// retransmite o mesmo lote, então um lote perdido ou corrompido não perde
+// amostras. O núcleo não depende do SDK: recebe os bytes um a um e o tempo em
+// µs; o firmware (inc/campo_uart.h) e a simulação do host (host/campo) só
+// movem os bytes.
+
+#define CAMPO_SINC0 0xBE
+#define CAMPO_SINC1 0xE5
+#define CAMPO_CABECALHO 6
+#define CAMPO_CARGA_MAX 240
+#define CAMPO_QUADRO_MAX (CAMPO_CABECALHO + CAMPO_CARGA_MAX + sizeof(uint32_t))
+
+#define CAMPO_ENDERECO_MESTRE 0
+#define CAMPO_NOS_MAX 64
+#define CAMPO_FILA 64 // amostras guardadas por nó entre consultas
+
+typedef enum
+{
+    CAMPO_CONSULTA = 1, // mestre -> nó: carga = campo_consulta_t
+    CAMPO_LOTE = 2      // nó -> mestre: carga = campo_lote_t + amostras
+} campo_tipo_t;
+
+typedef struct
+{
+    uint8_t confirmado; // 1: o seq do quadro confirma o último lote recebido
+} campo_consulta_t;
+
+// Amostra no fio: inteiros com escala fixa (20 bytes)
+typedef struct
+{
+    uint32_t tempo_ms;
+    int32_t peso_g;
+    int16_t temp;    // centésimos de °C
+    uint16_t umid;   // centésimos de %
+    uint16_t luz;    // décimos de %
+    uint16_t voc;    // centésimos de ppm
+    uint16_t vibra;  // décimos de %
+    uint8_t anomalias; // bit por canal (inc/pontuacao.h)
+    uint8_t reservado;
+} campo_amostra_t;
+
+typedef struct
+{
+    uint16_t descartadas; // amostras perdidas com a fila cheia, desde o boot (satura)
+    uint16_t na_fila;     // amostras que ficaram para a próxima consulta
+} campo_lote_t;
+
+#define CAMPO_LOTE_MAX ((CAMPO_CARGA_MAX - sizeof(campo_lote_t)) / sizeof(campo_amostra_t))
+
+// Recepção byte a byte, com ressincronização pela sequência de início
+typedef struct
+{
+    uint8_t quadro[CAMPO_QUADRO_MAX];
+    uint16_t pos;
+    uint16_t esperado;
+    uint32_t quadros;
+    uint32_t erros_crc;
+    uint32_t ruido; // bytes fora de um quadro
+} campo_decodificador_t;
+
+// true quando d->quadro tem um quadro completo com CRC válido
+bool campo_decodificar(campo_decodificador_t *d, uint8_t byte);
+
+static inline uint8_t campo_endereco(const uint8_t *quadro)
+{
+    return quadro[2];
+}
+
+static inline uint8_t campo_tipo(const uint8_t *quadro)
+{
+    return quadro[3];
+}
+
+static inline uint8_t campo_seq(const uint8_t *quadro)
+{
+    return quadro[4];
+}
+
+// Monta um quadro com a carga já em quadro + CAMPO_CABECALHO; devolve o tamanho
+size_t campo_montar(uint8_t *quadro, uint8_t endereco, campo_tipo_t tipo, uint8_t seq, size_t carga);
+
+// Janela de uma consulta: a consulta e a maior resposta no baud dado, mais a
+// folga para o nó virar o transceptor
+uint32_t campo_janela_us(uint32_t baud, uint32_t folga_us);
+
+// ---------------------------------------------------------------------------
+// Nó
+
+typedef struct
+{
+    uint32_t consultas;
+    uint32_t lotes;
+    uint32_t retransmissoes;
+    uint32_t descartadas;
+    uint32_t amostras; // enviadas e confirmadas
+} campo_no_estatisticas_t;
+
+typedef struct
+{
+    uint8_t endereco;
+    uint8_t seq;        // do lote pendente (ou do último confirmado)
+    uint8_t n_pendente; // amostras do início da fila no lote em trânsito
+    uint16_t inicio;
+    uint16_t quantidade;
+    campo_amostra_t fila[CAMPO_FILA];
+    campo_decodificador_t dec;
+    campo_no_estatisticas_t est;
+} campo_no_t;
+
+// seq_inicial diferente a cada boot evita que uma confirmação antiga do
+// mestre descarte o primeiro lote depois de um reset
+void campo_no_init(campo_no_t *no, uint8_t endereco, uint8_t seq_inicial);
+
+// Fila cheia descarta a amostra nova: as antigas podem estar num lote em trânsito
+bool campo_no_guardar(campo_no_t *no, const campo_amostra_t *amostra);
+
+// Byte recebido; com uma consulta para este nó completa, monta a resposta
+// (até CAMPO_QUADRO_MAX bytes) e devolve o tamanho a transmitir, senão 0
+size_t campo_no_byte(campo_no_t *no, uint8_t byte, uint8_t *resposta);
+
+// ---------------------------------------------------------------------------
+// Mestre
+
+typedef struct
+{
+    uint32_t consultas;
+    uint32_t respostas;
+    uint32_t expiradas;
+    uint32_t retentativas;
+    uint32_t falhas;     // nó desistido no ciclo depois das retentativas
+    uint32_t duplicados; // lote retransmitido que já tinha chegado
+    uint32_t amostras;
+    uint32_t descartadas; // informadas pelo nó
+    uint32_t latencia_max_us;
+    uint64_t latencia_soma_us;
+} campo_remoto_t;
+
+typedef void (*campo_entregar_t)(void *contexto, uint8_t endereco, const campo_amostra_t *amostras, size_t n);
+
+typedef struct
+{
+    uint8_t enderecos[CAMPO_NOS_MAX];
+    campo_remoto_t remotos[CAMPO_NOS_MAX];
+    uint8_t ultimo_seq[CAMPO_NOS_MAX];
+    bool recebeu[CAMPO_NOS_MAX];
+    uint8_t n_nos;
+    uint8_t atual;
+    uint8_t tentativa;
+    uint8_t tentativas_max;
+    bool esperando;
+    uint32_t janela_us;
+    uint64_t enviado_us;
+    uint32_t ciclos;
+    campo_decodificador_t dec;
+    campo_entregar_t entregar;
+    void *contexto;
+} campo_mestre_t;
+
+bool campo_mestre_init(campo_mestre_t *m, const uint8_t *enderecos, uint8_t n, uint32_t janela_us,
+                       uint8_t tentativas_max, campo_entregar_t entregar, void *contexto);
+
+// Monta a consulta do nó da vez (ou a retentativa) e abre a janela; chame logo
+// antes de transmitir
+size_t campo_mestre_consultar(campo_mestre_t *m, uint64_t agora_us, uint8_t *quadro);
+
+// Byte recebido; true quando a resposta do nó consultado chegou inteira e a
+// próxima consulta pode sair
+bool campo_mestre_byte(campo_mestre_t *m, uint8_t byte, uint64_t agora_us);
+
+// Fim da janela sem resposta válida: conta e decide entre retentativa e o
+// próximo nó; false se não havia consulta aberta
+bool campo_mestre_expirar(campo_mestre_t *m);
+
+static inline uint64_t campo_mestre_prazo(const campo_mestre_t *m)
+{
+    return m->enviado_us + m->janela_us;
+}
+
+#endif
@@ -0,0 +1,297 @@
+#include <stdio.h>
+#include "campo_uart.h"
+#include "relogio.h"
+#include "sram.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "pico/stdio_uart.h"
+
+#define CAMPO_RECEBIDAS 128 // amostras do mestre à espera do laço principal
+#define CAMPO_ENDERECO_MAX 247
+
+static uart_inst_t *uart;
+static int pino_de = -1;
+static int dma_tx = -1;
+static campo_config_t config;
+static volatile campo_modo_t modo = CAMPO_DESLIGADO;
+static volatile bool transmitindo;
+static uint32_t byte_us; // tempo de um byte no fio
+static uint8_t saida[CAMPO_QUADRO_MAX];
+static uint32_t erros_uart;
+static uint64_t inicio_us;
+
+static campo_no_t no;
+static campo_mestre_t mestre;
+static alarm_id_t alarme_janela;
+
+// Amostras entregues ao mestre (na IRQ) até o laço principal consumir
+static struct
+{
+    uint8_t endereco;
+    campo_amostra_t amostra;
+} recebidas[CAMPO_RECEBIDAS];
+static uint16_t recebidas_inicio, recebidas_quantidade;
+static uint32_t recebidas_perdidas;
+
+static void NA_RAM(entregar)(void *contexto, uint8_t endereco, const campo_amostra_t *amostras, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        if (recebidas_quantidade >= CAMPO_RECEBIDAS)
+        {
+            recebidas_perdidas += n - i;
+            return;
+        }
+        uint16_t j = (recebidas_inicio + recebidas_quantidade++) % CAMPO_RECEBIDAS;
+        recebidas[j].endereco = endereco;
+        recebidas[j].amostra = amostras[i];
+    }
+}
+
+// O DMA esvazia no FIFO antes do fim: o DE só cai quando o último stop bit sai
+static int64_t NA_RAM(fim_transmissao)(alarm_id_t id, void *contexto)
+{
+    if (dma_channel_is_busy(dma_tx) || (uart_get_hw(uart)->fr & UART_UARTFR_BUSY_BITS))
+        return -(int64_t)byte_us;
+    if (pino_de >= 0)
+        gpio_put(pino_de, 0);
+    transmitindo = false;
+    return 0;
+}
+
+static void NA_RAM(transmitir)(size_t n)
+{
+    transmitindo = true;
+    if (pino_de >= 0)
+        gpio_put(pino_de, 1);
+    dma_channel_transfer_from_buffer_now(dma_tx, saida, n);
+    add_alarm_in_us(n * byte_us, fim_transmissao, NULL, true);
+}
+
+static int64_t proxima_consulta(alarm_id_t id, void *contexto);
+
+static int64_t NA_RAM(janela_expirada)(alarm_id_t id, void *contexto)
+{
+    if (id != alarme_janela || modo != CAMPO_MESTRE || !campo_mestre_expirar(&mestre))
+        return 0;
+    alarme_janela = add_alarm_in_us(CAMPO_SILENCIO_US, proxima_consulta, NULL, true);
+    return 0;
+}
+
+static int64_t NA_RAM(proxima_consulta)(alarm_id_t id, void *contexto)
+{
+    if (modo != CAMPO_MESTRE)
+        return 0;
+    transmitir(campo_mestre_consultar(&mestre, time_us_64(), saida));
+    alarme_janela = add_alarm_at(from_us_since_boot(campo_mestre_prazo(&mestre)), janela_expirada, NULL, true);
+    return 0;
+}
+
+static void NA_RAM(campo_irq_uart)(void)
+{
+    uint64_t agora = time_us_64();
+    while (uart_is_readable(uart))
+    {
+        uint32_t dr = uart_get_hw(uart)->dr;
+        if (dr & (UART_UARTDR_OE_BITS | UART_UARTDR_BE_BITS | UART_UARTDR_PE_BITS | UART_UARTDR_FE_BITS))
+        {
+            erros_uart++;
+            continue;
+        }
+        if (modo == CAMPO_NO)
+        {
+            // Com o receptor sempre ligado, o nó ouve o próprio lote
+            size_t n = transmitindo ? 0 : campo_no_byte(&no, (uint8_t)dr, saida);
+            if (n)
+                transmitir(n);
+        }
+        else if (modo == CAMPO_MESTRE && campo_mestre_byte(&mestre, (uint8_t)dr, agora))
+        {
+            cancel_alarm(alarme_janela);
+            alarme_janela = add_alarm_in_us(CAMPO_SILENCIO_US, proxima_consulta, NULL, true);
+        }
+    }
+}
+
+static uint uart_irq(void)
+{
+    return uart_get_index(uart) ? UART1_IRQ : UART0_IRQ;
+}
+
+bool campo_uart_iniciar(uart_inst_t *u, int de, const campo_config_t *cfg)
+{
+    if (modo != CAMPO_DESLIGADO)
+        campo_uart_parar();
+    if (cfg->modo == CAMPO_DESLIGADO)
+        return true;
+    if (cfg->baud < 9600 || cfg->baud > 1000000 ||
+        (cfg->modo == CAMPO_NO && (cfg->endereco == CAMPO_ENDERECO_MESTRE || cfg->endereco > CAMPO_ENDERECO_MAX)) ||
+        (cfg->modo == CAMPO_MESTRE && (cfg->n_nos == 0 || cfg->n_nos > CAMPO_NOS_MAX)))
+        return false;
+    if (dma_tx < 0 && (dma_tx = dma_claim_unused_channel(false)) < 0)
+        return false;
+
+    uart = u;
+    pino_de = de;
+    config = *cfg;
+    byte_us = (10 * 1000000 + cfg->baud - 1) / cfg->baud;
+    erros_uart = 0;
+    recebidas_inicio = recebidas_quantidade = 0;
+    recebidas_perdidas = 0;
+    inicio_us = time_us_64();
+
+    dma_channel_config c = dma_channel_get_default_config(dma_tx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, uart_get_dreq(uart, true));
+    dma_channel_configure(dma_tx, &c, &uart_get_hw(uart)->dr, NULL, 0, false);
+
+    if (pino_de >= 0)
+    {
+        gpio_init(pino_de);
+        gpio_set_dir(pino_de, GPIO_OUT);
+        gpio_put(pino_de, 0);
+    }
+
+    if (cfg->modo == CAMPO_NO)
+        campo_no_init(&no, cfg->endereco, (uint8_t)(time_us_32() ^ (time_us_32() >> 8)));
+    else
+    {
+        uint8_t enderecos[CAMPO_NOS_MAX];
+        for (uint i = 0; i < cfg->n_nos; i++)
+            enderecos[i] = i + 1;
+        campo_mestre_init(&mestre, enderecos, cfg->n_nos, campo_janela_us(cfg->baud, CAMPO_FOLGA_US),
+                          CAMPO_TENTATIVAS, entregar, NULL);
+    }
+
+    // Texto só pelo USB daqui em diante
+    stdio_flush();
+    uart_tx_wait_blocking(uart);
+    stdio_set_driver_enabled(&stdio_uart, false);
+    relogio_elevar();
+    uart_set_baudrate(uart, cfg->baud);
+    while (uart_is_readable(uart))
+        (void)uart_get_hw(uart)->dr;
+
+    transmitindo = false;
+    modo = cfg->modo;
+    irq_set_exclusive_handler(uart_irq(), campo_irq_uart);
+    irq_set_enabled(uart_irq(), true);
+    uart_set_irq_enables(uart, true, false);
+    if (modo == CAMPO_MESTRE)
+        alarme_janela = add_alarm_in_us(CAMPO_SILENCIO_US, proxima_consulta, NULL, true);
+    return true;
+}
+
+void campo_uart_parar(void)
+{
+    if (modo == CAMPO_DESLIGADO)
+        return;
+    uint32_t irq = save_and_disable_interrupts();
+    modo = CAMPO_DESLIGADO;
+    cancel_alarm(alarme_janela);
+    restore_interrupts(irq);
+
+    uart_set_irq_enables(uart, false, false);
+    irq_set_enabled(uart_irq(), false);
+    irq_remove_handler(uart_irq(), campo_irq_uart);
+    while (transmitindo)
+        tight_loop_contents();
+
+    uart_set_baudrate(uart, PICO_DEFAULT_UART_BAUD_RATE);
+    relogio_liberar();
+    stdio_set_driver_enabled(&stdio_uart, true);
+}
+
+campo_modo_t campo_uart_modo(void)
+{
+    return modo;
+}
+
+uint32_t campo_uart_baud(void)
+{
+    return config.baud;
+}
+
+bool campo_uart_guardar(const campo_amostra_t *amostra)
+{
+    if (modo != CAMPO_NO)
+        return false;
+    uint32_t irq = save_and_disable_interrupts();
+    bool ok = campo_no_guardar(&no, amostra);
+    restore_interrupts(irq);
+    return ok;
+}
+
+bool campo_uart_recebida(uint8_t *endereco, campo_amostra_t *amostra)
+{
+    uint32_t irq = save_and_disable_interrupts();
+    bool ok = recebidas_quantidade > 0;
+    if (ok)
+    {
+        *endereco = recebidas[recebidas_inicio].endereco;
+        *amostra = recebidas[recebidas_inicio].amostra;
+        recebidas_inicio = (recebidas_inicio + 1) % CAMPO_RECEBIDAS;
+        recebidas_quantidade--;
+    }
+    restore_interrupts(irq);
+    return ok;
+}
+
+void campo_uart_relatorio(void)
+{
+    if (modo == CAMPO_DESLIGADO)
+    {
+        printf("{ \"campo\": \"desligado\" }\n");
+        return;
+    }
+    if (modo == CAMPO_NO)
+    {
+        uint32_t irq = save_and_disable_interrupts();
+        campo_no_estatisticas_t est = no.est;
+        uint32_t erros_crc = no.dec.erros_crc, ruido = no.dec.ruido;
+        uint16_t fila = no.quantidade;
+        restore_interrupts(irq);
+        printf("{ \"campo\": \"no\", \"endereco\": %u, \"baud\": %lu, \"consultas\": %lu, \"lotes\": %lu, "
+               "\"retransmissoes\": %lu, \"amostras\": %lu, \"descartadas\": %lu, \"fila\": %u, \"erros_crc\": %lu, "
+               "\"ruido\": %lu, \"erros_uart\": %lu }\n",
+               config.endereco, (unsigned long)config.baud, (unsigned long)est.consultas, (unsigned long)est.lotes,
+               (unsigned long)est.retransmissoes, (unsigned long)est.amostras, (unsigned long)est.descartadas, fila,
+               (unsigned long)erros_crc, (unsigned long)ruido, (unsigned long)erros_uart);
+        return;
+    }
+
+    // Mestre: totais, taxa de consultas e uma entrada por nó
+    uint64_t decorrido_ms = (time_us_64() - inicio_us) / 1000;
+    campo_remoto_t total = {0};
+    printf("{ \"campo\": \"mestre\", \"baud\": %lu, \"janela_us\": %lu, \"nos\": [", (unsigned long)config.baud,
+           (unsigned long)mestre.janela_us);
+    for (uint i = 0; i < mestre.n_nos; i++)
+    {
+        uint32_t irq = save_and_disable_interrupts();
+        campo_remoto_t r = mestre.remotos[i];
+        restore_interrupts(irq);
+        total.consultas += r.consultas;
+        total.respostas += r.respostas;
+        total.expiradas += r.expiradas;
+        total.retentativas += r.retentativas;
+        total.amostras += r.amostras;
+        printf("%s{ \"end\": %u, \"resp\": %lu, \"exp\": %lu, \"ret\": %lu, \"falhas\": %lu, \"dup\": %lu, "
+               "\"amostras\": %lu, \"descartadas\": %lu, \"lat_med_us\": %lu, \"lat_max_us\": %lu }",
+               i ? ", " : "", mestre.enderecos[i], (unsigned long)r.respostas, (unsigned long)r.expiradas,
+               (unsigned long)r.retentativas, (unsigned long)r.falhas, (unsigned long)r.duplicados,
+               (unsigned long)r.amostras, (unsigned long)r.descartadas,
+               (unsigned long)(r.respostas ? r.latencia_soma_us / r.respostas : 0), (unsigned long)r.latencia_max_us);
+    }
+    printf("], \"ciclos\": %lu, \"consultas\": %lu, \"respostas\": %lu, \"expiradas\": %lu, \"retentativas\": %lu, "
+           "\"consultas_s\": %lu, \"amostras_s\": %lu, \"erros_crc\": %lu, \"ruido\": %lu, \"erros_uart\": %lu, "
+           "\"perdidas\": %lu }\n",
+           (unsigned long)mestre.ciclos, (unsigned long)total.consultas, (unsigned long)total.respostas,
+           (unsigned long)total.expiradas, (unsigned long)total.retentativas,
+           (unsigned long)(decorrido_ms ? total.consultas * 1000ull / decorrido_ms : 0),
+           (unsigned long)(decorrido_ms ? total.amostras * 1000ull / decorrido_ms : 0),
+           (unsigned long)mestre.dec.erros_crc, (unsigned long)mestre.dec.ruido, (unsigned long)erros_uart,
+           (unsigned long)recebidas_perdidas);
+}
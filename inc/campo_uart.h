@@ -0,0 +1,56 @@
+#ifndef CAMPO_UART_H
+#define CAMPO_UART_H
+
+#include "pico/stdlib.h"
+#include "hardware/uart.h"
+#include "campo.h"
+
+// Barramento de campo (inc/campo.h) na UART do stdio, com um transceptor
+// RS-485 cujo DE fica alto só enquanto o quadro sai. Com o barramento ligado o
+// texto do stdio segue só pelo USB. Tudo corre em interrupção: a recepção na
+// IRQ da UART, a transmissão por DMA e o fim da transmissão e as janelas do
+// mestre em alarmes; o laço principal só guarda amostras (nó) ou imprime os
+// lotes recebidos (mestre). Com o barramento ligado o clock fica no nível de
+// desempenho (relogio_elevar), para o baud não mudar no meio de um quadro.
+
+#define CAMPO_BAUD_PADRAO 460800 // 64 nós com lotes cheios em ~0,4 s por ciclo
+#define CAMPO_FOLGA_US 500      // nó vira o transceptor e monta o lote
+#define CAMPO_SILENCIO_US 100   // entre a resposta e a próxima consulta
+#define CAMPO_TENTATIVAS 1      // retentativas por nó em cada ciclo
+
+typedef enum
+{
+    CAMPO_DESLIGADO,
+    CAMPO_NO,
+    CAMPO_MESTRE
+} campo_modo_t;
+
+// Gravada na flash (inc/persistencia.h)
+typedef struct
+{
+    uint8_t modo;     // campo_modo_t
+    uint8_t endereco; // nó: 1 a 247
+    uint8_t n_nos;    // mestre: consulta os endereços 1 a n_nos
+    uint8_t reservado;
+    uint32_t baud;
+} campo_config_t;
+
+// pino_de: habilita o transmissor do RS-485 (-1 sem transceptor)
+bool campo_uart_iniciar(uart_inst_t *uart, int pino_de, const campo_config_t *cfg);
+
+// Volta a UART ao stdio
+void campo_uart_parar(void);
+
+campo_modo_t campo_uart_modo(void);
+uint32_t campo_uart_baud(void);
+
+// Nó: guarda a amostra para o próximo lote
+bool campo_uart_guardar(const campo_amostra_t *amostra);
+
+// Mestre: próxima amostra recebida (com o endereço do nó), no laço principal
+bool campo_uart_recebida(uint8_t *endereco, campo_amostra_t *amostra);
+
+// Estatísticas em JSON pelo stdio
+void campo_uart_relatorio(void);
+
+#endif
@@ -0,0 +1,400 @@
+#include <stdio.h>
+#include "captura.h"
+#include "crc32.h"
+#include "relogio.h"
+#include "sram.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "pico/stdio_uart.h"
+
+#define ADC_HZ 48000000u // clk_adc vem do PLL USB: não muda com o relogio
+#define ADC_PINO0 26
+
+// Rajada: fora do .bss, não é zerada no boot
+static uint16_t __uninitialized_ram(amostras)[CAPTURA_AMOSTRAS];
+static uint16_t *const inicio_anel = amostras; // lido pelo canal de controle
+
+static uart_inst_t *uart;
+static int dma_dados = -1, dma_controle = -1, dma_envio = -1;
+
+static volatile captura_estado_t estado = CAPTURA_LIVRE;
+static captura_config_t config;
+static captura_motivo_t motivo;
+static uint8_t n_canais;
+static uint32_t quadros, pre_quadros;
+static uint32_t anel;       // amostras no buffer em uso
+static bool em_anel;        // pré-disparo: DMA reiniciado pelo canal de controle
+static bool elevado;        // relogio_elevar() pendente de liberação
+static volatile uint32_t voltas;
+static volatile bool parada;
+static volatile uint64_t fim_us;
+static uint64_t disparo_amostra;
+static alarm_id_t alarme;
+
+// Envio: prefixo | trechos da rajada | CRC, um trecho por transferência
+static struct
+{
+    quadro_cabecalho_t cab;
+    captura_meta_t meta;
+} prefixo;
+static uint32_t crc;
+typedef struct
+{
+    const void *dados;
+    uint32_t bytes;
+} trecho_t;
+static trecho_t trechos[4];
+static uint n_trechos;
+static volatile uint trecho;
+static volatile bool enviado;
+static bool retornando;
+static absolute_time_t retorno;
+static uint32_t sequencia = 0;
+
+static void NA_RAM(parar)(void)
+{
+    adc_run(false);
+    fim_us = time_us_64();
+    parada = true;
+}
+
+static void NA_RAM(enviar_trecho)(uint i)
+{
+    dma_channel_transfer_from_buffer_now(dma_envio, trechos[i].dados, trechos[i].bytes);
+}
+
+static void NA_RAM(captura_irq_dma)(void)
+{
+    if (dma_channel_get_irq1_status(dma_dados))
+    {
+        dma_channel_acknowledge_irq1(dma_dados);
+        if (em_anel)
+            voltas++;
+        else
+            parar();
+    }
+    if (dma_channel_get_irq1_status(dma_envio))
+    {
+        dma_channel_acknowledge_irq1(dma_envio);
+        if (++trecho < n_trechos)
+            enviar_trecho(trecho);
+        else
+            enviado = true;
+    }
+}
+
+static int64_t fim_pos_disparo(alarm_id_t id, void *contexto)
+{
+    parar();
+    return 0;
+}
+
+static int64_t iniciar_envio(alarm_id_t id, void *contexto)
+{
+    uart_set_baudrate(uart, CAPTURA_BAUD);
+    trecho = 0;
+    enviar_trecho(0);
+    return 0;
+}
+
+bool captura_init(uart_inst_t *u)
+{
+    int dados = dma_claim_unused_channel(false);
+    int controle = dma_claim_unused_channel(false);
+    int envio = dma_claim_unused_channel(false);
+    if (dados < 0 || controle < 0 || envio < 0)
+    {
+        if (dados >= 0)
+            dma_channel_unclaim(dados);
+        if (controle >= 0)
+            dma_channel_unclaim(controle);
+        if (envio >= 0)
+            dma_channel_unclaim(envio);
+        return false;
+    }
+    uart = u;
+    dma_dados = dados;
+    dma_controle = controle;
+    dma_envio = envio;
+
+    // Controle: uma palavra (o início da região) no gatilho do endereço de
+    // escrita do canal de dados, que recomeça a volta
+    dma_channel_config c = dma_channel_get_default_config(dma_controle);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure(dma_controle, &c, &dma_hw->ch[dma_dados].al2_write_addr_trig, &inicio_anel, 1, false);
+
+    c = dma_channel_get_default_config(dma_envio);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, uart_get_dreq(uart, true));
+    dma_channel_configure(dma_envio, &c, &uart_get_hw(uart)->dr, NULL, 0, false);
+
+    dma_channel_set_irq1_enabled(dma_envio, true);
+    irq_add_shared_handler(DMA_IRQ_1, captura_irq_dma, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+    return true;
+}
+
+// Amostras gravadas desde o início, contando as voltas do anel. Uma volta
+// que terminou mas ainda não passou pela IRQ conta pelo bit pendente.
+static uint64_t posicao(void)
+{
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t bit = 1u << dma_dados;
+    bool pendente = dma_hw->intr & bit;
+    uint32_t pos = (dma_channel_hw_addr(dma_dados)->write_addr - (uintptr_t)amostras) / sizeof(uint16_t);
+    if (!pendente && (dma_hw->intr & bit))
+    {
+        pendente = true;
+        pos = (dma_channel_hw_addr(dma_dados)->write_addr - (uintptr_t)amostras) / sizeof(uint16_t);
+    }
+    if (pos >= anel)
+        pos = 0; // fim da volta, antes do canal de controle reiniciar
+    uint64_t total = (uint64_t)(voltas + pendente) * anel + pos;
+    restore_interrupts(irq);
+    return total;
+}
+
+static void iniciar_adc(void)
+{
+    for (uint i = 0; i < CAPTURA_CANAIS_MAX; i++)
+        if (config.canais & (1u << i))
+            adc_gpio_init(ADC_PINO0 + i);
+    voltas = 0;
+    parada = false;
+    relogio_elevar();
+    elevado = true;
+
+    dma_channel_config c = dma_channel_get_default_config(dma_dados);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    channel_config_set_chain_to(&c, em_anel ? dma_controle : dma_dados);
+    dma_channel_acknowledge_irq1(dma_dados);
+    dma_channel_set_irq1_enabled(dma_dados, true);
+    dma_channel_configure(dma_dados, &c, amostras, &adc_hw->fifo, anel, true);
+
+    // O round-robin segue em ordem crescente a partir do canal selecionado
+    adc_select_input(__builtin_ctz(config.canais));
+    adc_set_round_robin(config.canais);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_fifo_drain();
+    adc_set_clkdiv((float)ADC_HZ / (config.taxa_hz * n_canais) - 1.0f);
+    adc_run(true);
+}
+
+// Devolve o ADC ao modo de leitura única do laço principal
+static void liberar_adc(void)
+{
+    adc_run(false);
+    dma_channel_set_irq1_enabled(dma_dados, false);
+    dma_channel_abort(dma_controle);
+    dma_channel_abort(dma_dados);
+    dma_channel_acknowledge_irq1(dma_dados);
+    adc_set_round_robin(0);
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_fifo_drain();
+    adc_set_clkdiv(0);
+}
+
+static void liberar_relogio(void)
+{
+    if (elevado)
+        relogio_liberar();
+    elevado = false;
+}
+
+bool captura_armar(const captura_config_t *cfg)
+{
+    if (estado != CAPTURA_LIVRE || dma_dados < 0)
+        return false;
+    uint8_t canais = cfg->canais & ((1u << CAPTURA_CANAIS_MAX) - 1);
+    uint n = __builtin_popcount(canais);
+    if (n == 0 || cfg->taxa_hz == 0 || cfg->taxa_hz > CAPTURA_TAXA_MAX / n || cfg->pre_ms >= cfg->duracao_ms)
+        return false;
+
+    // Com anel, um instante a mais: o que está sendo sobrescrito quando o ADC para
+    uint32_t maximo = CAPTURA_AMOSTRAS / n - (cfg->pre_ms ? 1 : 0);
+    uint64_t pedidos = (uint64_t)cfg->taxa_hz * cfg->duracao_ms / 1000;
+    if (pedidos == 0)
+        return false;
+    config = *cfg;
+    config.canais = canais;
+    n_canais = n;
+    quadros = pedidos < maximo ? (uint32_t)pedidos : maximo;
+    pre_quadros = (uint32_t)((uint64_t)cfg->taxa_hz * cfg->pre_ms / 1000);
+    if (pre_quadros >= quadros)
+        pre_quadros = quadros - 1;
+    em_anel = cfg->pre_ms > 0;
+    anel = (em_anel ? quadros + 1 : quadros) * n;
+
+    if (em_anel)
+        iniciar_adc();
+    estado = CAPTURA_ARMADA;
+    return true;
+}
+
+bool captura_disparar(captura_motivo_t m)
+{
+    if (estado != CAPTURA_ARMADA)
+        return false;
+    motivo = m;
+    if (em_anel)
+    {
+        disparo_amostra = posicao();
+        uint64_t pos_disparo_us = (uint64_t)(quadros - pre_quadros) * 1000000 / config.taxa_hz;
+        alarme = add_alarm_in_us(pos_disparo_us, fim_pos_disparo, NULL, true);
+    }
+    else
+    {
+        disparo_amostra = 0;
+        iniciar_adc();
+    }
+    estado = CAPTURA_GRAVANDO;
+    return true;
+}
+
+bool captura_cancelar(void)
+{
+    if (estado != CAPTURA_ARMADA && estado != CAPTURA_GRAVANDO)
+        return false;
+    if (estado == CAPTURA_GRAVANDO && em_anel)
+        cancel_alarm(alarme);
+    if (em_anel || estado == CAPTURA_GRAVANDO)
+        liberar_adc();
+    liberar_relogio();
+    estado = CAPTURA_LIVRE;
+    return true;
+}
+
+// ADC parado: monta o quadro com os instantes completos mais recentes
+static void concluir_gravacao(void)
+{
+    // A conversão em curso termina e, no anel, o DMA ainda recolhe o FIFO
+    while (!(adc_hw->cs & ADC_CS_READY_BITS))
+        tight_loop_contents();
+    absolute_time_t limite = make_timeout_time_us(100);
+    while (em_anel && !adc_fifo_is_empty() && !time_reached(limite))
+        tight_loop_contents();
+    uint64_t fim = em_anel ? posicao() : anel;
+    liberar_adc();
+
+    uint32_t slots = anel / n_canais;
+    uint64_t fim_q = fim / n_canais;
+    uint32_t disponiveis = fim_q < quadros ? (uint32_t)fim_q : quadros;
+    uint64_t primeiro_q = fim_q - disponiveis;
+    uint64_t disparo_q = (disparo_amostra + n_canais - 1) / n_canais;
+
+    captura_meta_t *meta = &prefixo.meta;
+    meta->taxa_hz = config.taxa_hz;
+    meta->quadros = disponiveis;
+    meta->disparo = disparo_q <= primeiro_q ? 0 : (uint32_t)(disparo_q - primeiro_q);
+    if (meta->disparo > disponiveis)
+        meta->disparo = disponiveis;
+    meta->inicio_ms = (uint32_t)((fim_us - (uint64_t)disponiveis * 1000000 / config.taxa_hz) / 1000);
+    meta->canais = config.canais;
+    meta->n_canais = n_canais;
+    meta->bits = 12;
+    meta->motivo = motivo;
+    meta->reservado = 0;
+
+    // No anel o mais antigo pode estar no meio da região: dois trechos
+    uint32_t s = (uint32_t)(primeiro_q % slots);
+    uint32_t a = disponiveis < slots - s ? disponiveis : slots - s;
+    uint32_t bytes_a = a * n_canais * sizeof(uint16_t);
+    uint32_t bytes_b = (disponiveis - a) * n_canais * sizeof(uint16_t);
+    quadro_cabecalho(&prefixo.cab, QUADRO_CAPTURA, ++sequencia, sizeof(*meta) + bytes_a + bytes_b);
+
+    n_trechos = 0;
+    trechos[n_trechos++] = (trecho_t){&prefixo, sizeof(prefixo)};
+    trechos[n_trechos++] = (trecho_t){&amostras[s * n_canais], bytes_a};
+    if (bytes_b)
+        trechos[n_trechos++] = (trecho_t){amostras, bytes_b};
+    trechos[n_trechos++] = (trecho_t){&crc, sizeof(crc)};
+
+    // CRC na CPU com a mesma rotina do receptor: ~5 ms para 48 KB a 128 MHz
+    crc = 0;
+    for (uint i = 0; i + 1 < n_trechos; i++)
+        crc = crc32_continuar(crc, trechos[i].dados, trechos[i].bytes);
+}
+
+void captura_tarefa(void)
+{
+    if (estado == CAPTURA_GRAVANDO && parada)
+    {
+        concluir_gravacao();
+
+        // Anúncio pelo stdio (UART e USB); o quadro só sai pela UART, com o
+        // stdio dela desligado para o texto não se misturar aos bytes
+        const captura_meta_t *meta = &prefixo.meta;
+        printf("{ \"captura\": { \"seq\": %lu, \"bytes\": %lu, \"baud\": %u, \"canais\": %u, \"taxa\": %lu, "
+               "\"quadros\": %lu, \"disparo\": %lu, \"motivo\": \"%s\" } }\n",
+               (unsigned long)sequencia, (unsigned long)quadro_tamanho(prefixo.cab.bytes), CAPTURA_BAUD,
+               meta->canais, (unsigned long)meta->taxa_hz, (unsigned long)meta->quadros,
+               (unsigned long)meta->disparo, motivo == CAPTURA_ANOMALIA ? "anomalia" : "comando");
+        stdio_flush();
+        uart_tx_wait_blocking(uart);
+        stdio_set_driver_enabled(&stdio_uart, false);
+
+        enviado = false;
+        retornando = false;
+        estado = CAPTURA_ENVIANDO;
+        add_alarm_in_ms(CAPTURA_PAUSA_MS, iniciar_envio, NULL, true);
+    }
+    else if (estado == CAPTURA_ENVIANDO && enviado && !retornando)
+    {
+        uart_tx_wait_blocking(uart);
+        uart_set_baudrate(uart, PICO_DEFAULT_UART_BAUD_RATE);
+        retorno = make_timeout_time_ms(CAPTURA_PAUSA_MS);
+        retornando = true;
+    }
+    else if (estado == CAPTURA_ENVIANDO && retornando && time_reached(retorno))
+    {
+        stdio_set_driver_enabled(&stdio_uart, true);
+        liberar_relogio();
+        estado = CAPTURA_LIVRE;
+        printf("{ \"captura\": \"enviada\", \"seq\": %lu }\n", (unsigned long)sequencia);
+    }
+}
+
+captura_estado_t captura_estado(void)
+{
+    return estado;
+}
+
+uint32_t captura_quadros(void)
+{
+    return quadros;
+}
+
+bool captura_adc_ocupado(void)
+{
+    return (estado == CAPTURA_ARMADA && em_anel) || estado == CAPTURA_GRAVANDO;
+}
+
+bool captura_ativa(void)
+{
+    return captura_adc_ocupado() || estado == CAPTURA_ENVIANDO;
+}
+
+bool captura_ultima(uint canal, uint16_t *valor)
+{
+    if (!captura_adc_ocupado() || canal >= CAPTURA_CANAIS_MAX || !(config.canais & (1u << canal)))
+        return false;
+    uint32_t pos = (dma_channel_hw_addr(dma_dados)->write_addr - (uintptr_t)amostras) / sizeof(uint16_t);
+    uint32_t q = pos / n_canais; // instantes completos nesta volta
+    if (q == 0)
+    {
+        if (!em_anel || voltas == 0)
+            return false;
+        q = anel / n_canais;
+    }
+    *valor = amostras[(q - 1) * n_canais + __builtin_popcount(config.canais & ((1u << canal) - 1))];
+    return true;
+}
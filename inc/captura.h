@@ -0,0 +1,76 @@
+#ifndef CAPTURA_H
+#define CAPTURA_H
+
+#include "pico/stdlib.h"
+#include "hardware/uart.h"
+#include "quadro.h"
+
+// Captura bruta em rajada: formas de onda de vários canais do ADC a alguns kHz
+// (microfone, piezo), para pesquisa e para treinar o classificador. O ADC
+// roda em round-robin e um canal de DMA grava as conversões numa região
+// reservada da SRAM; com pré-disparo, um segundo canal de DMA reinicia o
+// primeiro no começo da região, formando um anel que roda enquanto a captura
+// está armada. Depois do disparo (comando ou anomalia) e da parte posterior,
+// a rajada sai pela UART como um quadro binário (inc/quadro.h) com CRC, em
+// DMA e no baud da rajada, sem passar pelo stdio.
+//
+// Só o ADC para o resto do firmware durante a captura: os canais que estão
+// na rajada continuam legíveis pelo último quadro gravado (captura_ultima).
+
+#define CAPTURA_BYTES (48 * 1024) // região reservada, fora do .bss
+#define CAPTURA_AMOSTRAS (CAPTURA_BYTES / sizeof(uint16_t))
+#define CAPTURA_CANAIS_MAX 4     // ADC0 a ADC3 (GPIO26 a GPIO29)
+#define CAPTURA_TAXA_MAX 500000  // conversões por segundo do ADC, somando os canais
+#define CAPTURA_PAUSA_MS 20      // entre o anúncio e o quadro, para o receptor trocar o baud
+
+// Baud da rajada: 921600 é o teto comum dos conversores USB-serial; com o
+// mesmo valor do stdio não há troca
+#ifndef CAPTURA_BAUD
+#define CAPTURA_BAUD 921600
+#endif
+
+typedef enum
+{
+    CAPTURA_LIVRE,
+    CAPTURA_ARMADA,   // esperando o disparo (anel rodando, se houver pré-disparo)
+    CAPTURA_GRAVANDO, // depois do disparo
+    CAPTURA_ENVIANDO  // quadro saindo pela UART
+} captura_estado_t;
+
+typedef struct
+{
+    uint8_t canais;      // máscara: bit n = ADCn
+    uint32_t taxa_hz;    // amostras por segundo em cada canal
+    uint32_t duracao_ms; // rajada inteira, antes e depois do disparo
+    uint32_t pre_ms;     // parte antes do disparo; 0 começa a gravar no disparo
+} captura_config_t;
+
+// Reserva os canais de DMA; uart é a do stdio
+bool captura_init(uart_inst_t *uart);
+
+// Valida a configuração e arma; a duração é limitada pela região reservada
+bool captura_armar(const captura_config_t *cfg);
+
+bool captura_disparar(captura_motivo_t motivo);
+
+// Desarma ou interrompe a gravação (o envio em curso não é interrompido)
+bool captura_cancelar(void);
+
+// Chamado no laço principal: fecha a gravação, anuncia e acompanha o envio
+void captura_tarefa(void);
+
+captura_estado_t captura_estado(void);
+
+// Instantes da rajada configurada (depois de captura_armar)
+uint32_t captura_quadros(void);
+
+// ADC em uso pela captura: adc_read() não pode ser chamado
+bool captura_adc_ocupado(void);
+
+// Clock, sono profundo e UART precisam ficar como estão
+bool captura_ativa(void);
+
+// Último valor gravado de um canal da rajada, com o ADC ocupado
+bool captura_ultima(uint canal, uint16_t *valor);
+
+#endif
@@ -0,0 +1,169 @@
+#include <string.h>
+#include "classificador.h"
+#include "crc32.h"
+
+const char *const classe_colonia_nomes[NUM_CLASSES_COLONIA] = {
+    "saudavel", "com rainha", "orfa", "enxameando", "pilhagem"};
+
+// Ativações em pingue-pongue: a camada lê de uma área e escreve na outra
+static int8_t ativacoes[2][CLASSIFICADOR_MAX_ATIVACOES];
+
+static inline int8_t saturar(int32_t v)
+{
+    return v > 127 ? 127 : v < -128 ? -128 : (int8_t)v;
+}
+
+static inline int8_t requantizar(int32_t acc, const classificador_camada_t *camada)
+{
+    int64_t v = (int64_t)acc * camada->multiplicador;
+    v = (v + ((int64_t)1 << (camada->deslocamento - 1))) >> camada->deslocamento;
+    int8_t y = v > 127 ? 127 : v < -128 ? -128 : (int8_t)v;
+    return camada->relu && y < 0 ? 0 : y;
+}
+
+static uint32_t comprimento_saida(const classificador_camada_t *camada)
+{
+    if (camada->tipo == CAMADA_DENSA)
+        return 1;
+    return (camada->comprimento - camada->kernel) / camada->passo + 1;
+}
+
+static uint32_t bytes_camada(const classificador_camada_t *camada)
+{
+    uint32_t pesos = camada->saidas * camada->entradas;
+    if (camada->tipo == CAMADA_CONV1D)
+        pesos *= camada->kernel;
+    uint32_t bytes = sizeof(*camada) + camada->saidas * sizeof(int32_t) + pesos;
+    return (bytes + 3) & ~3u;
+}
+
+bool classificador_carregar(classificador_t *c, const void *blob, size_t bytes)
+{
+    const uint8_t *base = blob;
+    const classificador_cabecalho_t *cab = blob;
+    memset(c, 0, sizeof(*c));
+
+    if (((uintptr_t)blob & 3) || bytes < sizeof(*cab) || cab->magica != CLASSIFICADOR_MAGICA ||
+        cab->versao != CLASSIFICADOR_VERSAO || cab->bytes != bytes || cab->n_camadas == 0 ||
+        cab->n_camadas > CLASSIFICADOR_MAX_CAMADAS || cab->n_entradas == 0 || cab->n_saidas == 0 ||
+        cab->reservado[0] || cab->reservado[1] || cab->reservado[2])
+        return false;
+    if (crc32_calcular(base + sizeof(*cab), bytes - sizeof(*cab)) != cab->crc)
+        return false;
+
+    uint32_t pos = sizeof(*cab) + 2 * cab->n_entradas * sizeof(q16_t);
+    if (pos > bytes)
+        return false;
+    // |ganho| < 2^30 mantém (v - centro) * ganho dentro de 64 bits
+    const q16_t *ganho = (const q16_t *)(base + sizeof(*cab)) + cab->n_entradas;
+    for (uint8_t i = 0; i < cab->n_entradas; i++)
+        if (ganho[i] >= (1 << 30) || ganho[i] <= -(1 << 30))
+            return false;
+    uint32_t anterior = cab->n_entradas; // valores na saída da camada anterior
+    for (uint8_t i = 0; i < cab->n_camadas; i++)
+    {
+        if (pos + sizeof(classificador_camada_t) > bytes)
+            return false;
+        const classificador_camada_t *camada = (const classificador_camada_t *)(base + pos);
+        uint32_t entrada, saida;
+        if (camada->tipo == CAMADA_DENSA)
+        {
+            entrada = camada->entradas;
+            saida = camada->saidas;
+        }
+        else if (camada->tipo == CAMADA_CONV1D)
+        {
+            if (camada->kernel == 0 || camada->passo == 0 || camada->kernel > camada->comprimento)
+                return false;
+            entrada = camada->comprimento * camada->entradas;
+            saida = comprimento_saida(camada) * camada->saidas;
+        }
+        else
+            return false;
+
+        if (entrada != anterior || saida == 0 || saida > CLASSIFICADOR_MAX_ATIVACOES ||
+            camada->deslocamento == 0 || camada->deslocamento > 62 || pos + bytes_camada(camada) > bytes)
+            return false;
+
+        c->macs += saida * (camada->tipo == CAMADA_DENSA ? camada->entradas : camada->kernel * camada->entradas);
+        c->camadas[i] = camada;
+        anterior = saida;
+        pos += bytes_camada(camada);
+    }
+    if (anterior != cab->n_saidas || pos != bytes || c->macs > CLASSIFICADOR_MAX_MACS)
+    {
+        memset(c, 0, sizeof(*c));
+        return false;
+    }
+
+    c->cabecalho = cab;
+    c->centro = (const q16_t *)(base + sizeof(*cab));
+    c->ganho = c->centro + cab->n_entradas;
+    return true;
+}
+
+static void densa(const classificador_camada_t *camada, const int8_t *x, int8_t *y)
+{
+    const int32_t *bias = (const int32_t *)(camada + 1);
+    const int8_t *w = (const int8_t *)(bias + camada->saidas);
+    for (uint32_t o = 0; o < camada->saidas; o++)
+    {
+        int32_t acc = bias[o];
+        for (uint32_t i = 0; i < camada->entradas; i++)
+            acc += (int32_t)w[i] * x[i];
+        w += camada->entradas;
+        y[o] = requantizar(acc, camada);
+    }
+}
+
+static void conv1d(const classificador_camada_t *camada, const int8_t *x, int8_t *y)
+{
+    const int32_t *bias = (const int32_t *)(camada + 1);
+    const int8_t *pesos = (const int8_t *)(bias + camada->saidas);
+    uint32_t janela = camada->kernel * camada->entradas; // entradas contíguas por posição de saída
+    uint32_t n = comprimento_saida(camada);
+    for (uint32_t p = 0; p < n; p++)
+    {
+        const int8_t *xp = x + p * camada->passo * camada->entradas;
+        const int8_t *w = pesos;
+        for (uint32_t o = 0; o < camada->saidas; o++)
+        {
+            int32_t acc = bias[o];
+            for (uint32_t i = 0; i < janela; i++)
+                acc += (int32_t)w[i] * xp[i];
+            w += janela;
+            *y++ = requantizar(acc, camada);
+        }
+    }
+}
+
+uint8_t classificador_executar(const classificador_t *c, const q16_t *entradas, int8_t *saidas)
+{
+    const classificador_cabecalho_t *cab = c->cabecalho;
+    int8_t *x = ativacoes[0];
+    for (uint8_t i = 0; i < cab->n_entradas; i++)
+    {
+        int64_t v = ((int64_t)entradas[i] - c->centro[i]) * c->ganho[i];
+        int64_t q = (v + ((int64_t)1 << 31)) >> 32;
+        x[i] = saturar(q > INT32_MAX ? INT32_MAX : q < INT32_MIN ? INT32_MIN : (int32_t)q);
+    }
+
+    for (uint8_t l = 0; l < cab->n_camadas; l++)
+    {
+        int8_t *y = ativacoes[(l + 1) & 1];
+        if (c->camadas[l]->tipo == CAMADA_DENSA)
+            densa(c->camadas[l], x, y);
+        else
+            conv1d(c->camadas[l], x, y);
+        x = y;
+    }
+
+    uint8_t melhor = 0;
+    for (uint8_t i = 0; i < cab->n_saidas; i++)
+    {
+        saidas[i] = x[i];
+        if (x[i] > x[melhor])
+            melhor = i;
+    }
+    return melhor;
+}
@@ -0,0 +1,117 @@
+#ifndef CLASSIFICADOR_H
+#define CLASSIFICADOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ponto_fixo.h"
+
+// Inferência int8 de redes pequenas (camadas densas e convoluções 1-D) para
+// o Cortex-M0+: pesos int8 lidos direto do blob na flash, acumuladores int32
+// e requantização por camada, sem alocação (duas áreas estáticas de
+// ativações). O blob é validado uma vez ao carregar, e o total de
+// multiplicações fica limitado a CLASSIFICADOR_MAX_MACS, então cada janela
+// tem um custo fixo e conhecido.
+//
+// Formato do blob (little-endian, gerado por host/classificador):
+//   classificador_cabecalho_t
+//   q16_t centro[n_entradas], q16_t ganho[n_entradas]
+//   por camada: classificador_camada_t, int32_t bias[saidas], int8_t pesos[],
+//               completando até múltiplo de 4 bytes
+// O CRC-32 cobre tudo depois do cabeçalho.
+//
+// Entrada: x = sat8(arred((v - centro) * ganho)), em Q16, com |ganho| < 2^14.
+// Camada: acc = bias + Σ w·x; y = sat8((acc * multiplicador + 2^(d-1)) >> d),
+// com d = deslocamento; relu zera os negativos depois da requantização.
+// Densa: pesos [saidas][entradas]. Conv1D: entrada [comprimento][entradas],
+// pesos [saidas][kernel][entradas], sem preenchimento, saída
+// [(comprimento - kernel) / passo + 1][saidas].
+
+#define CLASSIFICADOR_MAGICA 0x4C4D5342u // "BSML"
+#define CLASSIFICADOR_VERSAO 1
+#define CLASSIFICADOR_MAX_CAMADAS 8
+#define CLASSIFICADOR_MAX_ATIVACOES 256 // int8 por camada
+#define CLASSIFICADOR_MAX_MACS 20000    // ~1 ms a 125 MHz
+
+typedef enum
+{
+    CAMADA_DENSA,
+    CAMADA_CONV1D
+} classificador_tipo_t;
+
+typedef struct
+{
+    uint32_t magica;
+    uint16_t versao;
+    uint8_t n_entradas;
+    uint8_t n_saidas;
+    uint8_t n_camadas;
+    uint8_t reservado[3];
+    uint32_t bytes; // blob inteiro, cabeçalho incluído
+    uint32_t crc;
+} classificador_cabecalho_t;
+
+typedef struct
+{
+    uint8_t tipo;
+    uint8_t relu;
+    uint8_t kernel; // conv1d
+    uint8_t passo;  // conv1d
+    uint16_t entradas;    // densa: neurônios de entrada; conv1d: canais de entrada
+    uint16_t saidas;      // densa: neurônios; conv1d: canais de saída
+    uint16_t comprimento; // conv1d: posições da entrada; densa: 1
+    uint8_t deslocamento; // 1 a 62
+    uint8_t reservado;
+    int32_t multiplicador;
+} classificador_camada_t;
+
+typedef struct
+{
+    const classificador_cabecalho_t *cabecalho;
+    const q16_t *centro;
+    const q16_t *ganho;
+    const classificador_camada_t *camadas[CLASSIFICADOR_MAX_CAMADAS];
+    uint32_t macs;
+} classificador_t;
+
+// Valida o blob (tamanhos, encadeamento das camadas, limites e CRC) e aponta
+// para ele sem copiar: o blob precisa continuar acessível (const na flash)
+bool classificador_carregar(classificador_t *c, const void *blob, size_t bytes);
+
+// Executa a rede; saidas recebe os n_saidas logits int8. Retorna o índice
+// do maior (o primeiro em caso de empate). Não é reentrante.
+uint8_t classificador_executar(const classificador_t *c, const q16_t *entradas, int8_t *saidas);
+
+// Modelo da colônia: características de entrada e classes de saída, na ordem
+// usada pelo treino em host/classificador
+typedef enum
+{
+    CARAC_TEMP,        // °C no ninho
+    CARAC_UMID,        // %
+    CARAC_PESO_TEND,   // kg/dia
+    CARAC_VOC,         // ppm
+    CARAC_VIBRA,       // % da escala
+    CARAC_Z_TEMP,      // z-score do detector de temperatura
+    CARAC_Z_PESO,      // z-score do detector de peso
+    CARAC_Z_VIBRA,     // z-score do detector de vibração
+    NUM_CARACTERISTICAS
+} caracteristica_t;
+
+typedef enum
+{
+    COLONIA_SAUDAVEL,
+    COLONIA_COM_RAINHA,
+    COLONIA_ORFA,
+    COLONIA_ENXAMEANDO,
+    COLONIA_PILHAGEM,
+    NUM_CLASSES_COLONIA
+} classe_colonia_t;
+
+extern const char *const classe_colonia_nomes[NUM_CLASSES_COLONIA];
+
+// Blob do modelo treinado, const na flash (inc/modelo_dados.c, gerado por
+// beesense_modelo treinar)
+extern const uint8_t modelo_colonia[];
+extern const size_t modelo_colonia_bytes;
+
+#endif
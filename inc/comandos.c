@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "comandos.h"
+
+typedef struct
+{
+    const char *nome;
+    comando_funcao_t funcao;
+    const char *ajuda;
+} comando_t;
+
+static comando_t comandos[COMANDOS_MAX];
+static unsigned num_comandos = 0;
+
+static char linha[COMANDOS_LINHA_MAX];
+static unsigned tamanho = 0;
+static bool descartando = false;
+
+bool comandos_registrar(const char *nome, comando_funcao_t funcao, const char *ajuda)
+{
+    if (num_comandos >= COMANDOS_MAX)
+        return false;
+    comandos[num_comandos].nome = nome;
+    comandos[num_comandos].funcao = funcao;
+    comandos[num_comandos].ajuda = ajuda;
+    num_comandos++;
+    return true;
+}
+
+static void comandos_ajuda(void)
+{
+    for (unsigned i = 0; i < num_comandos; i++)
+        printf("%-10s %s\n", comandos[i].nome, comandos[i].ajuda);
+}
+
+static void comandos_executar(char *texto)
+{
+    // Separa o nome dos argumentos
+    while (*texto == ' ')
+        texto++;
+    if (*texto == '\0')
+        return;
+    char *argumentos = strchr(texto, ' ');
+    if (argumentos)
+    {
+        *argumentos++ = '\0';
+        while (*argumentos == ' ')
+            argumentos++;
+    }
+    else
+    {
+        argumentos = texto + strlen(texto);
+    }
+
+    if (strcmp(texto, "ajuda") == 0)
+    {
+        comandos_ajuda();
+        return;
+    }
+    for (unsigned i = 0; i < num_comandos; i++)
+    {
+        if (strcmp(texto, comandos[i].nome) == 0)
+        {
+            comandos[i].funcao(argumentos);
+            return;
+        }
+    }
+    printf("{ \"erro\": \"comando desconhecido\", \"cmd\": \"%s\" }\n", texto);
+}
+
+void comandos_processar(void)
+{
+    int c;
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT)
+    {
+        if (c == '\r' || c == '\n')
+        {
+            linha[tamanho] = '\0';
+            if (!descartando)
+                comandos_executar(linha);
+            tamanho = 0;
+            descartando = false;
+        }
+        else if (tamanho < COMANDOS_LINHA_MAX - 1)
+        {
+            linha[tamanho++] = (char)c;
+        }
+        else
+        {
+            // Linha longa demais: ignora até o fim dela
+            descartando = true;
+        }
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef COMANDOS_H
+#define COMANDOS_H
+
+#include <stdbool.h>
+
+// Comandos de texto recebidos pelo stdio (UART/USB), uma linha por comando:
+// "nome argumentos\n". A leitura não bloqueia: comandos_processar() consome o
+// que já chegou e executa as linhas completas.
+
+#define COMANDOS_MAX 16
+#define COMANDOS_LINHA_MAX 64
+
+typedef void (*comando_funcao_t)(const char *argumentos);
+
+bool comandos_registrar(const char *nome, comando_funcao_t funcao, const char *ajuda);
+
+// Chamado no laço principal
+void comandos_processar(void);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// CRC-32 IEEE 802.3 (refletido, polinômio 0xEDB88320), o mesmo do zlib.
+// crc32_continuar permite calcular em partes: comece com crc = 0.
+uint32_t crc32_continuar(uint32_t crc, const void *dados, size_t tamanho);
+
+static inline uint32_t crc32_calcular(const void *dados, size_t tamanho)
+{
+    return crc32_continuar(0, dados, tamanho);
+}
+
+#endif
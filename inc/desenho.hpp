@@ -0,0 +1,259 @@
+#ifndef DESENHO_HPP
+#define DESENHO_HPP
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+extern "C"
+{
+#include "fontes.h"
+}
+
+// Desenho no framebuffer do SSD1306 e mapa de LEDs da matriz WS2812, com a
+// geometria como parâmetro de template. Com GeometriaFixa as dimensões são
+// constantes: o índice do byte vira deslocamento e máscara imediatos, os
+// limites viram comparações com constantes e os laços de tamanho fixo são
+// desenrolados. GeometriaVariavel lê as dimensões em tempo de execução e
+// serve a displays de outro tamanho. Sem dependência do SDK: o host compara
+// as duas (host/desenho).
+//
+// O framebuffer segue o modo de endereçamento vertical do controlador: cada
+// coluna ocupa paginas() bytes seguidos, LSB em cima.
+//
+// Primitivas e geometrias são todas DESENHO_INLINE: as funções NA_RAM de
+// inc/ssd1306_desenho.cpp recebem o corpo inteiro na seção delas. Um membro de
+// template sem always_inline vira uma cópia COMDAT em .text, na flash.
+
+#define DESENHO_INLINE inline __attribute__((always_inline))
+
+template <uint8_t Largura, uint8_t Altura>
+struct GeometriaFixa
+{
+    static_assert(Largura > 0 && Altura % 8 == 0 && Altura >= 8 && Altura <= 64,
+                  "SSD1306: até 64 linhas em páginas de 8");
+
+    static constexpr unsigned largura() { return Largura; }
+    static constexpr unsigned altura() { return Altura; }
+    static constexpr unsigned paginas() { return Altura / 8; }
+    static constexpr size_t bytes() { return (size_t)Largura * (Altura / 8); }
+};
+
+struct GeometriaVariavel
+{
+    uint8_t l, a, p;
+
+    DESENHO_INLINE GeometriaVariavel(uint8_t largura, uint8_t altura) : l(largura), a(altura), p(altura / 8) {}
+
+    DESENHO_INLINE unsigned largura() const { return l; }
+    DESENHO_INLINE unsigned altura() const { return a; }
+    DESENHO_INLINE unsigned paginas() const { return p; }
+    DESENHO_INLINE size_t bytes() const { return (size_t)l * p; }
+};
+
+// Primitivas sobre as colunas do framebuffer (ram_buffer + 1 no ssd1306_t).
+// Coordenadas fora da tela são recortadas.
+template <class G>
+class Desenho
+{
+public:
+    explicit DESENHO_INLINE Desenho(uint8_t *colunas, G geometria = G()) : c(colunas), g(geometria) {}
+
+    DESENHO_INLINE void pixel(unsigned x, unsigned y, bool valor)
+    {
+        if (x >= g.largura() || y >= g.altura())
+            return;
+        aplicar(c[x * g.paginas() + (y >> 3)], 1u << (y & 7), valor);
+    }
+
+    DESENHO_INLINE void preencher(bool valor)
+    {
+        memset(c, valor ? 0xFF : 0x00, g.bytes());
+    }
+
+    // Uma máscara fixa e um byte por coluna
+    DESENHO_INLINE void hline(unsigned x0, unsigned x1, unsigned y, bool valor)
+    {
+        if (y >= g.altura() || x0 > x1 || x0 >= g.largura())
+            return;
+        if (x1 >= g.largura())
+            x1 = g.largura() - 1;
+        uint8_t mascara = 1u << (y & 7);
+        uint8_t *b = &c[x0 * g.paginas() + (y >> 3)];
+        for (unsigned x = x0; x <= x1; x++, b += g.paginas())
+            aplicar(*b, mascara, valor);
+    }
+
+    // A coluna é contígua: um byte por página tocada
+    DESENHO_INLINE void vline(unsigned x, unsigned y0, unsigned y1, bool valor)
+    {
+        if (x >= g.largura() || y0 > y1 || y0 >= g.altura())
+            return;
+        if (y1 >= g.altura())
+            y1 = g.altura() - 1;
+        uint8_t *coluna = &c[x * g.paginas()];
+        unsigned p0 = y0 >> 3, p1 = y1 >> 3;
+        for (unsigned p = p0; p <= p1; p++)
+        {
+            uint8_t mascara = 0xFF;
+            if (p == p0)
+                mascara &= 0xFF << (y0 & 7);
+            if (p == p1)
+                mascara &= 0xFF >> (7 - (y1 & 7));
+            aplicar(coluna[p], mascara, valor);
+        }
+    }
+
+    DESENHO_INLINE void retangulo(unsigned topo, unsigned esquerda, unsigned largura, unsigned altura, bool valor, bool cheio)
+    {
+        if (!largura || !altura)
+            return;
+        unsigned direita = esquerda + largura - 1, base = topo + altura - 1;
+        if (cheio)
+        {
+            for (unsigned x = esquerda; x <= direita && x < g.largura(); x++)
+                vline(x, topo, base, valor);
+            return;
+        }
+        hline(esquerda, direita, topo, valor);
+        hline(esquerda, direita, base, valor);
+        vline(esquerda, topo, base, valor);
+        vline(direita, topo, base, valor);
+    }
+
+    // Bresenham; horizontais e verticais vão pelas versões por byte
+    DESENHO_INLINE void linha(int x0, int y0, int x1, int y1, bool valor)
+    {
+        if (y0 == y1 && y0 >= 0)
+            return hline(x0 < x1 ? x0 : x1, x0 < x1 ? x1 : x0, y0, valor);
+        if (x0 == x1 && x0 >= 0)
+            return vline(x0, y0 < y1 ? y0 : y1, y0 < y1 ? y1 : y0, valor);
+
+        int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+        int dy = y1 > y0 ? y1 - y0 : y0 - y1;
+        int sx = x0 < x1 ? 1 : -1;
+        int sy = y0 < y1 ? 1 : -1;
+        int erro = dx - dy;
+        while (true)
+        {
+            pixel(x0, y0, valor);
+            if (x0 == x1 && y0 == y1)
+                break;
+            int e2 = erro * 2;
+            if (e2 > -dy)
+            {
+                erro -= dy;
+                x0 += sx;
+            }
+            if (e2 < dx)
+            {
+                erro += dx;
+                y0 += sy;
+            }
+        }
+    }
+
+    // Escreve "altura" linhas de uma coluna a partir de y, substituindo o que havia
+    DESENHO_INLINE void blit_coluna(unsigned x, unsigned y, uint32_t bits, unsigned altura)
+    {
+        if (x >= g.largura() || y >= g.altura())
+            return;
+        unsigned desloc = y & 7;
+        uint64_t mascara = ((((uint64_t)1) << altura) - 1) << desloc;
+        uint64_t dados = ((uint64_t)bits << desloc) & mascara;
+        uint8_t *coluna = &c[x * g.paginas()];
+        for (unsigned p = y >> 3; mascara && p < g.paginas(); ++p)
+        {
+            coluna[p] = (coluna[p] & ~(uint8_t)mascara) | (uint8_t)dados;
+            mascara >>= 8;
+            dados >>= 8;
+        }
+    }
+
+    // Desenha um glifo e devolve o avanço horizontal
+    DESENHO_INLINE unsigned glifo(const fonte_t *fonte, uint32_t codigo, unsigned x, unsigned y)
+    {
+        uint8_t largura;
+        const uint8_t *bitmap = fonte_glifo(fonte, codigo, &largura);
+        unsigned avanco = fonte_avanco(fonte, codigo);
+        for (unsigned i = 0; i < avanco; ++i)
+        {
+            uint32_t bits = 0;
+            if (i < largura)
+            {
+                const uint8_t *coluna = &bitmap[i * fonte->bytes_coluna];
+                for (unsigned b = 0; b < fonte->bytes_coluna; ++b)
+                    bits |= (uint32_t)coluna[b] << (8 * b);
+            }
+            blit_coluna(x + i, y, bits, fonte->altura);
+        }
+        return avanco;
+    }
+
+    // UTF-8 na fonte 8x8, quebrando a linha na borda direita
+    DESENHO_INLINE void texto(const char *str, unsigned x, unsigned y)
+    {
+        while (*str)
+        {
+            glifo(&fonte_8x8, utf8_proximo(&str), x, y);
+            x += 8;
+            if (x + 8 >= g.largura())
+            {
+                x = 0;
+                y += 8;
+            }
+            if (y + 8 >= g.altura())
+                break;
+        }
+    }
+
+    // UTF-8 numa fonte qualquer, sem quebra; devolve o x final
+    DESENHO_INLINE unsigned texto_fonte(const fonte_t *fonte, const char *str, unsigned x, unsigned y)
+    {
+        while (*str && x < g.largura())
+            x += glifo(fonte, utf8_proximo(&str), x, y);
+        return x;
+    }
+
+private:
+    // Sem desvio: padrões alternados (xadrez, pontilhado) não erram previsão
+    static DESENHO_INLINE void aplicar(uint8_t &byte, uint8_t mascara, bool valor)
+    {
+        byte = (byte & ~mascara) | (mascara & -(uint8_t)valor);
+    }
+
+    uint8_t *c;
+    G g;
+};
+
+// Ordem física dos LEDs de uma matriz: a primeira linha ligada é a de baixo.
+// Em serpentina ela vai da direita para a esquerda e as seguintes alternam
+// (como a 5x5 da BitDogLab e inc/fitas_leds.c); sem serpentina todas vão da
+// esquerda para a direita. A tabela sai inteira em tempo de compilação.
+template <unsigned Largura, unsigned Altura, bool Serpentina>
+struct MapaMatriz
+{
+    static_assert(Largura * Altura > 0 && Largura * Altura <= UINT16_MAX, "matriz vazia ou grande demais");
+
+    static constexpr unsigned leds = Largura * Altura;
+
+    static constexpr uint16_t indice(unsigned x, unsigned y)
+    {
+        unsigned linha = Altura - 1 - y;
+        unsigned coluna = (Serpentina && linha % 2 == 0) ? Largura - 1 - x : x;
+        return linha * Largura + coluna;
+    }
+
+    // Por (y * Largura + x)
+    static constexpr std::array<uint16_t, leds> tabela = []
+    {
+        std::array<uint16_t, leds> t{};
+        for (unsigned y = 0; y < Altura; y++)
+            for (unsigned x = 0; x < Largura; x++)
+                t[y * Largura + x] = indice(x, y);
+        return t;
+    }();
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "dht22.h"
+#include "relogio.h"
+#include "hardware/clocks.h"
+
+// Arquivo .pio do sensor
+#include "dht22.pio.h"
+
+#define DHT22_PULSO_INICIO_US 1100
+#define DHT22_BITS 40
+#define DHT22_TIMEOUT_US 20000 // a leitura completa leva ~5 ms
+
+static PIO pio_dht;
+static uint sm_dht;
+static uint offset_dht;
+static bool pendente = false;
+static absolute_time_t inicio_leitura;
+static absolute_time_t proxima_permitida;
+
+static void retemporizar_dht22(relogio_fase_t fase, uint32_t sys_hz, void *contexto)
+{
+    if (fase == RELOGIO_DEPOIS)
+        pio_sm_set_clkdiv(pio_dht, sm_dht, sys_hz / 1000000.0f);
+}
+
+bool dht22_init(PIO pio, uint pino)
+{
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0)
+        return false;
+    pio_dht = pio;
+    sm_dht = sm;
+    offset_dht = pio_add_program(pio, &dht22_program);
+    dht22_program_init(pio, sm, offset_dht, pino);
+
+    // O sensor precisa de 1 s após ligar
+    proxima_permitida = make_timeout_time_ms(1000);
+    relogio_registrar(retemporizar_dht22, NULL);
+    return true;
+}
+
+bool dht22_iniciar(void)
+{
+    if (pendente || !time_reached(proxima_permitida))
+        return false;
+
+    pio_sm_put(pio_dht, sm_dht, DHT22_PULSO_INICIO_US);
+    pio_sm_put(pio_dht, sm_dht, DHT22_BITS - 1);
+    pendente = true;
+    inicio_leitura = get_absolute_time();
+    proxima_permitida = make_timeout_time_ms(DHT22_INTERVALO_MIN_MS);
+    return true;
+}
+
+// Sensor ausente: a PIO ficou presa num wait; volta ao início do programa
+static void dht22_reiniciar(void)
+{
+    pio_sm_set_enabled(pio_dht, sm_dht, false);
+    pio_sm_clear_fifos(pio_dht, sm_dht);
+    pio_sm_restart(pio_dht, sm_dht);
+    pio_sm_exec(pio_dht, sm_dht, pio_encode_jmp(offset_dht));
+    pio_sm_exec(pio_dht, sm_dht, pio_encode_set(pio_pindirs, 0));
+    pio_sm_set_enabled(pio_dht, sm_dht, true);
+}
+
+dht22_estado_t dht22_resultado(dht22_leitura_t *leitura)
+{
+    if (!pendente)
+        return DHT22_OCIOSO;
+
+    if (pio_sm_get_rx_fifo_level(pio_dht, sm_dht) >= 2)
+    {
+        uint32_t dados = pio_sm_get(pio_dht, sm_dht);
+        uint8_t soma = pio_sm_get(pio_dht, sm_dht) & 0xFF;
+        pendente = false;
+        return dht22_decodificar(dados, soma, leitura);
+    }
+
+    if (absolute_time_diff_us(inicio_leitura, get_absolute_time()) > DHT22_TIMEOUT_US)
+    {
+        dht22_reiniciar();
+        pendente = false;
+        return DHT22_ERRO_TEMPO;
+    }
+    return DHT22_PENDENTE;
+}
+
+dht22_estado_t dht22_decodificar(uint32_t dados, uint8_t soma, dht22_leitura_t *leitura)
+{
+    uint8_t calculada = (dados >> 24) + (dados >> 16) + (dados >> 8) + dados;
+    if (calculada != soma)
+        return DHT22_ERRO_SOMA;
+
+    // Décimos de %; temperatura em sinal e magnitude
+    uint16_t umidade = dados >> 16;
+    uint16_t temperatura = dados & 0xFFFF;
+    int32_t decimos = temperatura & 0x7FFF;
+    if (temperatura & 0x8000)
+        decimos = -decimos;
+
+    leitura->umidade = (q16_t)((int32_t)umidade * Q16_UM / 10);
+    leitura->temperatura = (q16_t)(decimos * Q16_UM / 10);
+    return DHT22_OK;
+}
@@ -0,0 +1,41 @@
+#ifndef DHT22_H
+#define DHT22_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "ponto_fixo.h"
+
+// Sensor de temperatura e umidade DHT22 lido por uma máquina de estado da PIO.
+// dht22_iniciar() só coloca dois valores no FIFO: a PIO gera o pulso de início
+// e cronometra os 40 bits sozinha. dht22_resultado() recolhe a leitura quando
+// ela chega, sem esperar.
+
+#define DHT22_INTERVALO_MIN_MS 2000 // o sensor não aceita leituras mais próximas
+
+typedef enum
+{
+    DHT22_OCIOSO,     // nenhuma leitura em andamento
+    DHT22_PENDENTE,   // aguardando a PIO
+    DHT22_OK,
+    DHT22_ERRO_SOMA,  // soma de verificação não confere
+    DHT22_ERRO_TEMPO  // o sensor não respondeu
+} dht22_estado_t;
+
+typedef struct
+{
+    q16_t temperatura; // °C
+    q16_t umidade;     // %
+} dht22_leitura_t;
+
+bool dht22_init(PIO pio, uint pino);
+
+// Dispara uma leitura; false se houver uma em andamento ou se for cedo demais
+bool dht22_iniciar(void);
+
+// Estado da leitura disparada; DHT22_OK e os erros são devolvidos uma única vez
+dht22_estado_t dht22_resultado(dht22_leitura_t *leitura);
+
+// Converte os 32 bits de dados e a soma recebidos do sensor
+dht22_estado_t dht22_decodificar(uint32_t dados, uint8_t soma, dht22_leitura_t *leitura);
+
+#endif
@@ -0,0 +1,179 @@
+#include "ds18b20.h"
+#include "onewire.h"
+
+#define DS18B20_FAMILIA 0x28
+#define CMD_SKIP_ROM 0xCC
+#define CMD_MATCH_ROM 0x55
+#define CMD_CONVERTER 0x44
+#define CMD_LER_SCRATCHPAD 0xBE
+#define SCRATCHPAD 9
+
+typedef enum
+{
+    DS_BUSCANDO,     // enumerando os sensores
+    DS_SEM_SENSORES, // barramento vazio: nova busca após o período
+    DS_CONVERTENDO,  // Convert T em andamento no barramento
+    DS_AGUARDANDO,   // 750 ms de conversão
+    DS_LENDO,        // scratchpad do sensor "atual"
+    DS_PAUSA         // resto do período até o próximo ciclo
+} ds18b20_fase_t;
+
+static uint8_t roms[DS18B20_MAX][8];
+static volatile q16_t temperaturas[DS18B20_MAX];
+static volatile bool validas[DS18B20_MAX];
+static volatile uint quantidade = 0;
+static volatile uint32_t erros = 0;
+
+static volatile ds18b20_fase_t fase;
+static uint32_t periodo;
+static uint atual;
+static uint8_t rom_encontrada[8];
+static uint8_t tx[10 + SCRATCHPAD];
+static uint8_t rx[10 + SCRATCHPAD];
+static absolute_time_t inicio_ciclo;
+
+static void ds18b20_fim(onewire_status_t status, void *contexto);
+static int64_t ds18b20_alarme(alarm_id_t id, void *contexto);
+
+static void ds18b20_agendar(ds18b20_fase_t proxima, int64_t atraso_us)
+{
+    fase = proxima;
+    if (atraso_us < 1000)
+        atraso_us = 1000;
+    add_alarm_in_us(atraso_us, ds18b20_alarme, NULL, true);
+}
+
+static void ds18b20_buscar(void)
+{
+    fase = DS_BUSCANDO;
+    quantidade = 0;
+    onewire_buscar(true, rom_encontrada, ds18b20_fim, NULL);
+}
+
+static void ds18b20_converter(void)
+{
+    fase = DS_CONVERTENDO;
+    inicio_ciclo = get_absolute_time();
+    tx[0] = CMD_SKIP_ROM;
+    tx[1] = CMD_CONVERTER;
+    onewire_transacao(tx, NULL, 2, ds18b20_fim, NULL);
+}
+
+static void ds18b20_ler(uint i)
+{
+    fase = DS_LENDO;
+    atual = i;
+    tx[0] = CMD_MATCH_ROM;
+    for (uint b = 0; b < 8; b++)
+        tx[1 + b] = roms[i][b];
+    tx[9] = CMD_LER_SCRATCHPAD;
+    for (uint b = 0; b < SCRATCHPAD; b++)
+        tx[10 + b] = 0xFF;
+    onewire_transacao(tx, rx, sizeof(tx), ds18b20_fim, NULL);
+}
+
+static void ds18b20_guardar_leitura(bool ok)
+{
+    const uint8_t *scratchpad = &rx[10];
+    if (!ok || onewire_crc8(scratchpad, SCRATCHPAD) != 0)
+    {
+        erros++;
+        validas[atual] = false;
+        return;
+    }
+    // 1/16 °C com sinal: desloca para Q16
+    int16_t bruto = (int16_t)(scratchpad[0] | (scratchpad[1] << 8));
+    temperaturas[atual] = (q16_t)bruto << 12;
+    validas[atual] = true;
+}
+
+// Fim de uma espera (timer): começa o passo seguinte
+static int64_t ds18b20_alarme(alarm_id_t id, void *contexto)
+{
+    if (fase == DS_SEM_SENSORES)
+        ds18b20_buscar();
+    else if (fase == DS_AGUARDANDO)
+        ds18b20_ler(0);
+    else if (fase == DS_PAUSA)
+        ds18b20_converter();
+    return 0;
+}
+
+// Fim de uma operação do barramento (IRQ da PIO): começa o passo seguinte
+static void ds18b20_fim(onewire_status_t status, void *contexto)
+{
+    switch (fase)
+    {
+    case DS_BUSCANDO:
+        if (status == ONEWIRE_OK)
+        {
+            if (rom_encontrada[0] == DS18B20_FAMILIA && quantidade < DS18B20_MAX)
+            {
+                for (uint b = 0; b < 8; b++)
+                    roms[quantidade][b] = rom_encontrada[b];
+                quantidade++;
+            }
+            onewire_buscar(false, rom_encontrada, ds18b20_fim, NULL);
+            break;
+        }
+        if (status == ONEWIRE_ERRO_CRC)
+            erros++;
+        if (quantidade == 0)
+            ds18b20_agendar(DS_SEM_SENSORES, (int64_t)periodo * 1000);
+        else
+            ds18b20_converter();
+        break;
+
+    case DS_CONVERTENDO:
+        if (status == ONEWIRE_OK)
+        {
+            ds18b20_agendar(DS_AGUARDANDO, DS18B20_CONVERSAO_MS * 1000);
+        }
+        else
+        {
+            erros++;
+            ds18b20_agendar(DS_PAUSA, (int64_t)periodo * 1000);
+        }
+        break;
+
+    case DS_LENDO:
+        ds18b20_guardar_leitura(status == ONEWIRE_OK);
+        if (atual + 1 < quantidade)
+            ds18b20_ler(atual + 1);
+        else
+            ds18b20_agendar(DS_PAUSA, (int64_t)periodo * 1000 - absolute_time_diff_us(inicio_ciclo, get_absolute_time()));
+        break;
+
+    default:
+        break;
+    }
+}
+
+void ds18b20_iniciar(uint32_t periodo_ms)
+{
+    periodo = periodo_ms;
+    ds18b20_buscar();
+}
+
+uint ds18b20_quantidade(void)
+{
+    return quantidade;
+}
+
+bool ds18b20_temperatura(uint i, q16_t *temperatura)
+{
+    if (i >= quantidade || !validas[i])
+        return false;
+    *temperatura = temperaturas[i];
+    return true;
+}
+
+const uint8_t *ds18b20_rom(uint i)
+{
+    return roms[i];
+}
+
+uint32_t ds18b20_erros(void)
+{
+    return erros;
+}
@@ -0,0 +1,30 @@
+#ifndef DS18B20_H
+#define DS18B20_H
+
+#include "pico/stdlib.h"
+#include "ponto_fixo.h"
+
+// Perfil de temperatura com vários DS18B20 no mesmo barramento 1-Wire. Na
+// partida a busca de ROM enumera os sensores; depois o ciclo se repete
+// sozinho: conversão simultânea de todos (Skip ROM + Convert T), 750 ms de
+// espera num alarme do timer e leitura do scratchpad de cada um (Match ROM),
+// com CRC. Tudo corre em callbacks de IRQ: a tarefa só lê os resultados.
+
+#define DS18B20_MAX 8
+#define DS18B20_CONVERSAO_MS 750 // 12 bits
+
+// Inicia a enumeração e o ciclo de leituras (onewire_init já chamado)
+void ds18b20_iniciar(uint32_t periodo_ms);
+
+uint ds18b20_quantidade(void);
+
+// Última temperatura válida do sensor i (°C); false se ainda não houver
+bool ds18b20_temperatura(uint i, q16_t *temperatura);
+
+// Código ROM do sensor i, para identificar a posição no ninho
+const uint8_t *ds18b20_rom(uint i);
+
+// Leituras descartadas por CRC ou falta de resposta
+uint32_t ds18b20_erros(void);
+
+#endif
@@ -0,0 +1,184 @@
+#include "energia.h"
+#include "hardware/sync.h"
+#include "sram.h"
+
+#ifdef BEESENSE_SONO_PROFUNDO
+#include "hardware/clocks.h"
+#include "hardware/pll.h"
+#include "hardware/rtc.h"
+#include "pico/sleep.h"
+#endif
+
+static energia_config_t config;
+static uint32_t periodo_ms;
+static uint32_t estaveis = 0;
+static absolute_time_t ultima_atividade;
+static bool display_ligado = true;
+static volatile bool despertar = false;
+static void (*callback_acordar)(void) = NULL;
+static bool sono_profundo = true;
+
+static energia_estatisticas_t estatisticas;
+static absolute_time_t inicio_acordado;
+
+void energia_init(const energia_config_t *cfg)
+{
+    config = *cfg;
+    periodo_ms = cfg->periodo_min_ms;
+    ultima_atividade = get_absolute_time();
+    inicio_acordado = ultima_atividade;
+
+#ifdef BEESENSE_SONO_PROFUNDO
+    // O RTC gera o despertar do sono profundo; a data em si é irrelevante
+    datetime_t inicio = {.year = 2025, .month = 1, .day = 1, .dotw = 3, .hour = 0, .min = 0, .sec = 0};
+    rtc_init();
+    rtc_set_datetime(&inicio);
+#endif
+}
+
+void energia_amostra(bool estavel)
+{
+    if (!estavel)
+    {
+        estaveis = 0;
+        periodo_ms = config.periodo_min_ms;
+    }
+    else if (++estaveis >= config.estaveis_para_reduzir)
+    {
+        estaveis = 0;
+        periodo_ms *= 2;
+        if (periodo_ms > config.periodo_max_ms)
+            periodo_ms = config.periodo_max_ms;
+    }
+
+    if (display_ligado && absolute_time_diff_us(ultima_atividade, get_absolute_time()) >= (int64_t)config.apagar_display_ms * 1000)
+        display_ligado = false;
+}
+
+void energia_atividade(void)
+{
+    ultima_atividade = get_absolute_time();
+    display_ligado = true;
+    estaveis = 0;
+    periodo_ms = config.periodo_min_ms;
+}
+
+void NA_RAM(energia_acordar)(void)
+{
+    despertar = true;
+    __sev();
+}
+
+void energia_consumir_despertar(void)
+{
+    despertar = false;
+}
+
+uint32_t energia_periodo_ms(void)
+{
+    return periodo_ms;
+}
+
+bool energia_display_ligado(void)
+{
+    return display_ligado;
+}
+
+void energia_permitir_sono_profundo(bool permitir)
+{
+    sono_profundo = permitir;
+}
+
+void energia_ao_acordar(void (*callback)(void))
+{
+    callback_acordar = callback;
+}
+
+#ifdef BEESENSE_SONO_PROFUNDO
+static volatile bool alarme_rtc = false;
+
+static void rtc_despertou(void)
+{
+    alarme_rtc = true;
+}
+
+// sleep_run_from_xosc() desliga o pll_usb, para clk_usb e clk_adc e deixa
+// clk_rtc no XOSC; sleep_power_up() não os religa. Refaz essa parte da árvore
+// como clocks_init(): a captura conta com clk_adc a 48 MHz e o primeiro
+// adc_read() sem clock não termina. clk_sys e clk_peri ficam para o gerenciador
+// de clock (callback de energia_ao_acordar), que reaplica o nível atual.
+static void restaurar_clocks_usb(void)
+{
+    pll_init(pll_usb, 1, 480 * MHZ, 5, 2);
+    clock_configure(clk_usb, 0, CLOCKS_CLK_USB_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB, 48 * MHZ, 48 * MHZ);
+    clock_configure(clk_adc, 0, CLOCKS_CLK_ADC_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB, 48 * MHZ, 48 * MHZ);
+    clock_configure(clk_rtc, 0, CLOCKS_CLK_RTC_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB, 48 * MHZ, 46875);
+}
+
+// Sono profundo: clk_sys passa para o XOSC e só o RTC fica ativo até o alarme.
+// Usado apenas para períodos de pelo menos 1 s (resolução do RTC).
+static bool dormir_profundo(uint32_t duracao_ms)
+{
+    if (duracao_ms < 1000)
+        return false;
+
+    datetime_t agora;
+    rtc_get_datetime(&agora);
+
+    // Alarme casando só os segundos: dispara na próxima ocorrência (< 60 s)
+    uint32_t segundos = duracao_ms / 1000;
+    datetime_t alvo = {.year = -1, .month = -1, .day = -1, .dotw = -1, .hour = -1, .min = -1,
+                       .sec = (int8_t)((agora.sec + segundos) % 60)};
+
+    alarme_rtc = false;
+    sleep_run_from_xosc();
+    sleep_goto_sleep_until(&alvo, &rtc_despertou);
+    sleep_power_up();
+    restaurar_clocks_usb();
+
+    if (callback_acordar)
+        callback_acordar();
+
+    // O timer de microssegundos para durante o sono: contabiliza o período programado
+    estatisticas.dormindo_us += (uint64_t)segundos * 1000000;
+    return true;
+}
+#endif
+
+void energia_dormir_ate(absolute_time_t alvo)
+{
+    absolute_time_t agora = get_absolute_time();
+    int64_t restante_us = absolute_time_diff_us(agora, alvo);
+    estatisticas.acordado_us += absolute_time_diff_us(inicio_acordado, agora);
+    estatisticas.despertares++;
+
+#ifdef BEESENSE_SONO_PROFUNDO
+    if (restante_us > 0 && !despertar && !display_ligado && sono_profundo && dormir_profundo((uint32_t)(restante_us / 1000)))
+    {
+        inicio_acordado = get_absolute_time();
+        return;
+    }
+#endif
+
+    // Sono leve: WFE até o prazo; IRQs (botões) acordam o núcleo. O pedido não
+    // é apagado aqui: uma borda entre o fim de eventos_processar() e este ponto
+    // já deixou despertar ligado e não pode esperar o período inteiro
+    while (restante_us > 0 && !despertar && !best_effort_wfe_or_timeout(alvo))
+        ;
+
+    inicio_acordado = get_absolute_time();
+    estatisticas.dormindo_us += absolute_time_diff_us(agora, inicio_acordado);
+}
+
+void energia_estatisticas(energia_estatisticas_t *saida)
+{
+    *saida = estatisticas;
+}
+
+uint32_t energia_acordado_permil(void)
+{
+    uint64_t total = estatisticas.acordado_us + estatisticas.dormindo_us;
+    if (total == 0)
+        return 1000;
+    return (uint32_t)(estatisticas.acordado_us * 1000 / total);
+}
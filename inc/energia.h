@@ -0,0 +1,61 @@
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include "pico/stdlib.h"
+
+// Modo de energia adaptativo: o período entre amostras dobra a cada sequência
+// de leituras estáveis (até periodo_max_ms) e volta à taxa cheia assim que a
+// detecção de anomalia, o alarme ou uma entrada do usuário disparam.
+// Entre amostras o núcleo dorme; o tempo acordado/dormindo é contabilizado.
+
+typedef struct
+{
+    uint32_t periodo_min_ms;       // taxa cheia
+    uint32_t periodo_max_ms;       // taxa mínima em regime estável
+    uint32_t estaveis_para_reduzir; // amostras estáveis antes de dobrar o período
+    uint32_t apagar_display_ms;    // inatividade até apagar display e matriz
+} energia_config_t;
+
+typedef struct
+{
+    uint64_t acordado_us;
+    uint64_t dormindo_us;
+    uint32_t despertares;
+} energia_estatisticas_t;
+
+void energia_init(const energia_config_t *cfg);
+
+// Informa o resultado da amostra atual (estável ou não)
+void energia_amostra(bool estavel);
+
+// Entrada do usuário: volta à taxa cheia e religa o display
+void energia_atividade(void);
+
+// Pode ser chamado de IRQ para encerrar o sono atual antes do prazo. O pedido
+// fica guardado até energia_consumir_despertar(): se chegar antes do sono, o
+// próximo energia_dormir_ate() retorna na hora
+void energia_acordar(void);
+
+// Chamado pela tarefa antes de esvaziar as filas de entrada; o que chegar
+// depois disso encerra o próximo sono
+void energia_consumir_despertar(void);
+
+uint32_t energia_periodo_ms(void);
+bool energia_display_ligado(void);
+
+// Dorme até o instante indicado (ou até energia_acordar())
+void energia_dormir_ate(absolute_time_t alvo);
+
+// Sono profundo (BEESENSE_SONO_PROFUNDO) para a UART: um nó do barramento de
+// campo precisa ouvir as consultas entre as amostras
+void energia_permitir_sono_profundo(bool permitir);
+
+// Função chamada após o sono profundo para reconfigurar clocks e periféricos
+void energia_ao_acordar(void (*callback)(void));
+
+void energia_estatisticas(energia_estatisticas_t *estatisticas);
+
+// Fração do tempo acordado, em milésimos
+uint32_t energia_acordado_permil(void);
+
+#endif
@@ -0,0 +1,24 @@
+#include "especies.h"
+#include <string.h>
+
+const Beeespecies especies[NUM_especies] = {
+    {"Africana", 30.0, 36.0, 65, 50.0, 15.0, 5.0, "Apis Mellifera"},
+    {"Iraí", 26.0, 34.0, 70, 3.5, 1.0, 2.8, "Frieseomelitta"},
+    {"Limão", 26.0, 34.0, 70, 0.7, 0.2, 1.4, "Lestrimelitta"},
+    {"Tiúba", 26.0, 34.0, 70, 2.8, 0.8, 2.8, "Melipona"},
+    {"Mandacaia", 22.0, 32.0, 70, 3.5, 1.0, 4.2, "Melipona"},
+    {"Urucu", 26.0, 34.0, 70, 7.0, 2.0, 4.2, "Melipona"},
+    {"Tataíra", 22.0, 32.0, 70, 1.4, 0.4, 2.8, "Oxytrigona"},
+    {"Mirim", 22.0, 32.0, 70, 0.7, 0.2, 1.4, "Plebeia"},
+    {"Jandaíra", 26.0, 34.0, 70, 2.8, 0.8, 4.2, "Scaptotrigona"},
+    {"Borá", 26.0, 34.0, 70, 4.2, 1.2, 4.2, "Tetragona"},
+    {"Jataí", 22.0, 32.0, 70, 1.4, 0.4, 2.8, "Tetragonisca"},
+    {"Mandaguari", 22.0, 32.0, 70, 1.4, 0.4, 2.8, "Trigona"}};
+
+int especies_buscar(const char *nome)
+{
+    for (int i = 0; i < NUM_especies; i++)
+        if (strcmp(especies[i].nome, nome) == 0)
+            return i;
+    return -1;
+}
@@ -0,0 +1,27 @@
+#ifndef ESPECIES_H
+#define ESPECIES_H
+
+// Parâmetros ideais das espécies de abelhas. Sem dependência do SDK: o
+// gerador de relatórios do computador usa a mesma tabela do firmware.
+
+#define NUM_especies 12
+
+// Especies de Abelhas
+typedef struct
+{
+    const char *nome;
+    float min_temp;
+    float max_temp;
+    int unidade_ideal;
+    float peso_mel_anual;
+    float reserva_min; // reserva mínima de mel (kg) antes de alimentar a colônia
+    float max_luz;
+    const char *genero;
+} Beeespecies;
+
+extern const Beeespecies especies[NUM_especies];
+
+// Índice da espécie pelo nome (como na tabela, UTF-8), ou -1
+int especies_buscar(const char *nome);
+
+#endif
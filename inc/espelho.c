@@ -0,0 +1,305 @@
+#include <string.h>
+#include "espelho.h"
+#include "crc32.h"
+
+#define PAGINA_MAX (LCD_WIDTH > ESPELHO_MATRIZ_BYTES ? LCD_WIDTH : ESPELHO_MATRIZ_BYTES)
+#define BIT_MATRIZ (1u << ESPELHO_PAGINAS)
+
+// Balde cheio: uma chave inteira pode sair de uma vez
+#define SALDO_MAX ((int32_t)espelho_linha_bytes(ESPELHO_CARGA_MAX) * 1000)
+
+// PackBits: controle c < 128 traz c + 1 bytes literais; c > 128, o byte
+// seguinte repetido 257 - c vezes (2 a 128). As diferenças são quase só
+// zeros, e cada 128 deles custam 2 bytes.
+static size_t packbits(const uint8_t *s, size_t n, uint8_t *d)
+{
+    size_t i = 0, o = 0;
+    while (i < n)
+    {
+        size_t repeticao = 1;
+        while (i + repeticao < n && repeticao < 128 && s[i + repeticao] == s[i])
+            repeticao++;
+        if (repeticao >= 2)
+        {
+            d[o++] = (uint8_t)(257 - repeticao);
+            d[o++] = s[i];
+            i += repeticao;
+            continue;
+        }
+        // Literais até uma repetição de 3, que vale mais como corrida
+        size_t inicio = i;
+        while (i < n && i - inicio < 128 && !(i + 2 < n && s[i] == s[i + 1] && s[i] == s[i + 2]))
+            i++;
+        d[o++] = (uint8_t)(i - inicio - 1);
+        memcpy(&d[o], &s[inicio], i - inicio);
+        o += i - inicio;
+    }
+    return o;
+}
+
+// Exatamente n bytes; false se a carga acabar antes ou passar do tamanho
+static bool despackbits(const uint8_t **p, const uint8_t *fim, uint8_t *d, size_t n)
+{
+    size_t o = 0;
+    const uint8_t *s = *p;
+    while (o < n)
+    {
+        if (s >= fim)
+            return false;
+        uint8_t c = *s++;
+        if (c < 128)
+        {
+            size_t k = (size_t)c + 1;
+            if (o + k > n || s + k > fim)
+                return false;
+            memcpy(&d[o], s, k);
+            s += k;
+            o += k;
+        }
+        else if (c > 128)
+        {
+            size_t k = 257 - (size_t)c;
+            if (o + k > n || s >= fim)
+                return false;
+            memset(&d[o], *s++, k);
+            o += k;
+        }
+    }
+    *p = s;
+    return true;
+}
+
+size_t espelho_linha_bytes(size_t carga)
+{
+    // + '\r' do stdio
+    return sizeof(ESPELHO_PREFIXO) - 1 + 4 * ((carga + 2) / 3) + sizeof(ESPELHO_SUFIXO) - 1 + 1;
+}
+
+void espelho_init(espelho_t *e, uint32_t baud, uint8_t parte, uint32_t agora_ms)
+{
+    memset(e, 0, sizeof(*e));
+    if (parte < 1)
+        parte = 1;
+    if (parte > 100)
+        parte = 100;
+    e->parte = parte;
+    e->bytes_s = baud / 10 * parte / 100;
+    e->saldo = SALDO_MAX;
+    e->ultimo_ms = agora_ms;
+    e->chave_pendente = true;
+    e->proxima_chave_ms = agora_ms;
+}
+
+void espelho_pedir_chave(espelho_t *e)
+{
+    e->chave_pendente = true;
+}
+
+size_t espelho_codificar(espelho_t *e, const uint8_t *tela, const uint8_t *matriz_rgb, uint32_t agora_ms,
+                         uint8_t *saida)
+{
+    int64_t saldo = e->saldo + (int64_t)(agora_ms - e->ultimo_ms) * e->bytes_s;
+    e->saldo = saldo > SALDO_MAX ? SALDO_MAX : (int32_t)saldo;
+    e->ultimo_ms = agora_ms;
+    if ((int32_t)(agora_ms - e->proxima_chave_ms) >= 0)
+        e->chave_pendente = true;
+
+    uint8_t *ref = e->referencia;
+    bool chave = e->chave_pendente;
+    if (!chave && memcmp(tela, ref, ESPELHO_TELA_BYTES) == 0 &&
+        memcmp(matriz_rgb, ref + ESPELHO_TELA_BYTES, ESPELHO_MATRIZ_BYTES) == 0)
+        return 0;
+    if (e->saldo < 0)
+    {
+        e->adiados++;
+        return 0;
+    }
+
+    // A chave é a diferença contra um quadro apagado
+    if (chave)
+        memset(ref, 0, ESPELHO_QUADRO_BYTES);
+    uint8_t xor[PAGINA_MAX];
+    uint8_t *p = saida + ESPELHO_CABECALHO;
+    uint16_t paginas = 0;
+    for (unsigned pg = 0; pg < ESPELHO_PAGINAS; pg++)
+    {
+        // Página pg: um byte de cada coluna, no passo do modo vertical
+        uint8_t mudou = chave;
+        for (unsigned x = 0; x < LCD_WIDTH; x++)
+        {
+            unsigned i = x * ESPELHO_PAGINAS + pg;
+            xor[x] = tela[i] ^ ref[i];
+            mudou |= xor[x];
+            ref[i] = tela[i];
+        }
+        if (mudou)
+        {
+            paginas |= 1u << pg;
+            p += packbits(xor, LCD_WIDTH, p);
+        }
+    }
+    uint8_t mudou = chave;
+    for (unsigned i = 0; i < ESPELHO_MATRIZ_BYTES; i++)
+    {
+        xor[i] = matriz_rgb[i] ^ ref[ESPELHO_TELA_BYTES + i];
+        mudou |= xor[i];
+        ref[ESPELHO_TELA_BYTES + i] = matriz_rgb[i];
+    }
+    if (mudou)
+    {
+        paginas |= BIT_MATRIZ;
+        p += packbits(xor, ESPELHO_MATRIZ_BYTES, p);
+    }
+
+    uint32_t crc = crc32_calcular(ref, ESPELHO_QUADRO_BYTES);
+    saida[0] = chave ? 'K' : 'D';
+    saida[1] = ++e->seq;
+    saida[2] = (uint8_t)paginas;
+    saida[3] = (uint8_t)(paginas >> 8);
+    for (int i = 0; i < 4; i++)
+        saida[4 + i] = (uint8_t)(crc >> (8 * i));
+
+    size_t n = p - saida;
+    e->saldo -= (int32_t)espelho_linha_bytes(n) * 1000;
+    e->quadros++;
+    e->carga_bytes += n;
+    e->linha_bytes += espelho_linha_bytes(n);
+    if (chave)
+    {
+        e->chaves++;
+        e->chave_pendente = false;
+        e->proxima_chave_ms = agora_ms + ESPELHO_CHAVE_MS;
+    }
+    return n;
+}
+
+static const char BASE64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+size_t espelho_base64(const uint8_t *dados, size_t n, char *texto)
+{
+    size_t o = 0;
+    for (size_t i = 0; i < n; i += 3)
+    {
+        uint32_t v = (uint32_t)dados[i] << 16;
+        if (i + 1 < n)
+            v |= (uint32_t)dados[i + 1] << 8;
+        if (i + 2 < n)
+            v |= dados[i + 2];
+        texto[o++] = BASE64[v >> 18];
+        texto[o++] = BASE64[(v >> 12) & 63];
+        texto[o++] = i + 1 < n ? BASE64[(v >> 6) & 63] : '=';
+        texto[o++] = i + 2 < n ? BASE64[v & 63] : '=';
+    }
+    texto[o] = '\0';
+    return o;
+}
+
+static int valor_base64(char c)
+{
+    if (c >= 'A' && c <= 'Z')
+        return c - 'A';
+    if (c >= 'a' && c <= 'z')
+        return c - 'a' + 26;
+    if (c >= '0' && c <= '9')
+        return c - '0' + 52;
+    if (c == '+')
+        return 62;
+    if (c == '/')
+        return 63;
+    return -1;
+}
+
+size_t espelho_base64_decodificar(const char *texto, size_t n, uint8_t *dados, size_t max)
+{
+    if (n % 4)
+        return 0;
+    size_t o = 0;
+    for (size_t i = 0; i < n; i += 4)
+    {
+        int v[4];
+        int validos = 4;
+        for (int k = 0; k < 4; k++)
+        {
+            v[k] = valor_base64(texto[i + k]);
+            // '=' só no fim, nas duas últimas posições
+            if (v[k] < 0 && (texto[i + k] != '=' || i + 4 != n || k < 2))
+                return 0;
+            if (v[k] < 0 && validos == 4)
+                validos = k;
+        }
+        if (validos < 4 && v[3] >= 0)
+            return 0;
+        uint32_t b = ((uint32_t)v[0] << 18) | ((uint32_t)v[1] << 12) | ((uint32_t)(validos > 2 ? v[2] : 0) << 6) |
+                     (uint32_t)(validos > 3 ? v[3] : 0);
+        if (o + validos - 1 > max)
+            return 0;
+        dados[o++] = (uint8_t)(b >> 16);
+        if (validos > 2)
+            dados[o++] = (uint8_t)(b >> 8);
+        if (validos > 3)
+            dados[o++] = (uint8_t)b;
+    }
+    return o;
+}
+
+void espelho_receptor_init(espelho_receptor_t *r)
+{
+    memset(r, 0, sizeof(*r));
+}
+
+bool espelho_aplicar(espelho_receptor_t *r, const uint8_t *carga, size_t n)
+{
+    if (n < ESPELHO_CABECALHO || (carga[0] != 'K' && carga[0] != 'D'))
+    {
+        r->falhas++;
+        r->sincronizado = false;
+        return false;
+    }
+    bool chave = carga[0] == 'K';
+    uint8_t seq = carga[1];
+    uint16_t paginas = carga[2] | (uint16_t)(carga[3] << 8);
+    uint32_t crc = carga[4] | ((uint32_t)carga[5] << 8) | ((uint32_t)carga[6] << 16) | ((uint32_t)carga[7] << 24);
+
+    if (!chave && !r->sincronizado)
+    {
+        r->ignorados++;
+        return false;
+    }
+    // Diferença fora de ordem: faltou uma no meio
+    if (!chave && seq != (uint8_t)(r->seq + 1))
+    {
+        r->falhas++;
+        r->sincronizado = false;
+        return false;
+    }
+
+    if (chave)
+        memset(r->quadro, 0, sizeof(r->quadro));
+    const uint8_t *p = carga + ESPELHO_CABECALHO, *fim = carga + n;
+    uint8_t xor[PAGINA_MAX];
+    bool ok = (paginas & ~((BIT_MATRIZ << 1) - 1)) == 0;
+    for (unsigned pg = 0; ok && pg < ESPELHO_PAGINAS; pg++)
+    {
+        if (!(paginas & (1u << pg)))
+            continue;
+        ok = despackbits(&p, fim, xor, LCD_WIDTH);
+        for (unsigned x = 0; ok && x < LCD_WIDTH; x++)
+            r->quadro[x * ESPELHO_PAGINAS + pg] ^= xor[x];
+    }
+    if (ok && (paginas & BIT_MATRIZ))
+    {
+        ok = despackbits(&p, fim, xor, ESPELHO_MATRIZ_BYTES);
+        for (unsigned i = 0; ok && i < ESPELHO_MATRIZ_BYTES; i++)
+            r->quadro[ESPELHO_TELA_BYTES + i] ^= xor[i];
+    }
+    if (!ok || p != fim || crc32_calcular(r->quadro, ESPELHO_QUADRO_BYTES) != crc)
+    {
+        r->falhas++;
+        r->sincronizado = false;
+        return false;
+    }
+    r->seq = seq;
+    r->sincronizado = true;
+    r->aplicados++;
+    return true;
+}
@@ -0,0 +1,101 @@
+#ifndef ESPELHO_H
+#define ESPELHO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "placa.h"
+
+// Espelho remoto do display e da matriz de LEDs pela UART da telemetria. O
+// quadro é o framebuffer do SSD1306 (ssd1306_t.ram_buffer + 1, modo vertical)
+// seguido da matriz em RGB, linha a linha de cima para baixo. Cada envio é o
+// XOR contra o último quadro enviado, por página do display (128 bytes: uma
+// faixa de 8 linhas) e a matriz como uma página a mais; só as páginas que
+// mudaram vão, cada uma comprimida em PackBits. A chave é o mesmo XOR contra
+// um quadro apagado, com todas as páginas, e sai a cada ESPELHO_CHAVE_MS para
+// quem conectar no meio. Carga, little-endian:
+//
+//   tipo ('K' chave, 'D' diferença) | seq | páginas (uint16, bit por página,
+//   bit ESPELHO_PAGINAS = matriz) | crc32 do quadro inteiro depois de
+//   aplicada | PackBits de cada página marcada, em ordem
+//
+// O CRC do quadro resultante pega bytes trocados e envios perdidos: o
+// receptor para de aplicar diferenças até a próxima chave. No fio, uma linha
+// JSON com a carga em base64: { "espelho": "..." }.
+//
+// O orçamento é um balde de bytes: "parte" por cento do link, contando a
+// linha inteira. Quadro sem orçamento não é codificado: a diferença seguinte
+// é contra o último enviado, então nada se perde, só a taxa de quadros cai.
+// Sem dependência do SDK: o visor do host (host/espelho) usa o mesmo código.
+
+#define ESPELHO_PAGINAS (LCD_HEIGHT / 8)
+#define ESPELHO_TELA_BYTES (LCD_WIDTH * ESPELHO_PAGINAS)
+#define ESPELHO_MATRIZ_BYTES (MATRIX_WIDTH * MATRIX_HEIGHT * 3)
+#define ESPELHO_QUADRO_BYTES (ESPELHO_TELA_BYTES + ESPELHO_MATRIZ_BYTES)
+#define ESPELHO_CABECALHO 8
+// Pior caso do PackBits: um byte de controle a cada 128 literais
+#define ESPELHO_PACKBITS_MAX(n) ((n) + ((n) + 127) / 128)
+#define ESPELHO_CARGA_MAX \
+    (ESPELHO_CABECALHO + ESPELHO_PAGINAS * ESPELHO_PACKBITS_MAX(LCD_WIDTH) + ESPELHO_PACKBITS_MAX(ESPELHO_MATRIZ_BYTES))
+#define ESPELHO_BASE64_MAX (4 * ((ESPELHO_CARGA_MAX + 2) / 3) + 1)
+
+// Linha no fio: prefixo, carga em base64 e sufixo (o stdio põe o '\r')
+#define ESPELHO_PREFIXO "{ \"espelho\": \""
+#define ESPELHO_SUFIXO "\" }\n"
+
+#define ESPELHO_CHAVE_MS 10000
+#define ESPELHO_PARTE_PADRAO 10 // % do link
+
+typedef struct
+{
+    uint8_t referencia[ESPELHO_QUADRO_BYTES]; // o que o receptor tem
+    uint8_t seq;
+    bool chave_pendente;
+    uint8_t parte;     // % do link
+    uint32_t bytes_s;  // orçamento em bytes por segundo
+    int32_t saldo;     // milésimos de byte disponíveis; negativo depois de um quadro grande
+    uint32_t ultimo_ms;
+    uint32_t proxima_chave_ms;
+
+    // Estatísticas desde espelho_init
+    uint32_t quadros, chaves;
+    uint32_t carga_bytes, linha_bytes; // somas
+    uint32_t adiados; // quadros que mudaram mas ficaram sem orçamento
+} espelho_t;
+
+// baud do link (10 bits por byte) e parte dele, de 1 a 100 %
+void espelho_init(espelho_t *e, uint32_t baud, uint8_t parte, uint32_t agora_ms);
+
+// Próximo envio sai como chave
+void espelho_pedir_chave(espelho_t *e);
+
+// Compara o quadro atual com o último enviado e, se mudou (ou a chave venceu)
+// e há orçamento, escreve a carga em saida (ESPELHO_CARGA_MAX) e devolve o
+// tamanho; 0 sem nada a enviar
+size_t espelho_codificar(espelho_t *e, const uint8_t *tela, const uint8_t *matriz_rgb, uint32_t agora_ms,
+                         uint8_t *saida);
+
+// Bytes da linha no fio para uma carga de n bytes
+size_t espelho_linha_bytes(size_t carga);
+
+// Base64 padrão, com '=' no fim; devolve o tamanho sem o '\0'
+size_t espelho_base64(const uint8_t *dados, size_t n, char *texto);
+// Devolve os bytes decodificados, ou 0 se o texto não for base64 válido
+size_t espelho_base64_decodificar(const char *texto, size_t n, uint8_t *dados, size_t max);
+
+// Receptor: reconstrói o quadro a partir das cargas
+typedef struct
+{
+    uint8_t quadro[ESPELHO_QUADRO_BYTES];
+    bool sincronizado; // desde a última chave, sem falha
+    uint8_t seq;
+    uint32_t aplicados, falhas, ignorados;
+} espelho_receptor_t;
+
+void espelho_receptor_init(espelho_receptor_t *r);
+
+// true se o quadro foi atualizado (false: carga inválida, CRC diferente ou
+// diferença sem chave antes)
+bool espelho_aplicar(espelho_receptor_t *r, const uint8_t *carga, size_t n);
+
+#endif
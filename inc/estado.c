@@ -0,0 +1,88 @@
+#include <stdatomic.h>
+#include <string.h>
+#include "estado.h"
+
+// Os dados de cada grupo ficam em palavras atômicas (acesso relaxado): a
+// cópia concorrente com a escrita não é uma corrida de dados em C11, só
+// devolve lixo que a verificação da versão descarta.
+#define PALAVRAS(tipo) ((sizeof(tipo) + sizeof(uint32_t) - 1) / sizeof(uint32_t))
+
+typedef struct
+{
+    _Atomic uint32_t versao;
+    _Atomic uint32_t dados[PALAVRAS(estado_interface_t)];
+} grupo_interface_t;
+
+typedef struct
+{
+    _Atomic uint32_t versao;
+    _Atomic uint32_t dados[PALAVRAS(estado_medidas_t)];
+} grupo_medidas_t;
+
+static grupo_interface_t interface;
+static grupo_medidas_t medidas;
+
+static void gravar(_Atomic uint32_t *versao, _Atomic uint32_t *dados, const void *origem, size_t bytes)
+{
+    uint32_t palavras[PALAVRAS(estado_medidas_t)] = {0};
+    memcpy(palavras, origem, bytes);
+
+    uint32_t v = atomic_load_explicit(versao, memory_order_relaxed);
+    atomic_store_explicit(versao, v + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    for (size_t i = 0; i < (bytes + 3) / 4; i++)
+        atomic_store_explicit(&dados[i], palavras[i], memory_order_relaxed);
+    atomic_store_explicit(versao, v + 2, memory_order_release);
+}
+
+static void copiar(_Atomic uint32_t *dados, void *destino, size_t bytes)
+{
+    uint32_t palavras[PALAVRAS(estado_medidas_t)];
+    for (size_t i = 0; i < (bytes + 3) / 4; i++)
+        palavras[i] = atomic_load_explicit(&dados[i], memory_order_relaxed);
+    memcpy(destino, palavras, bytes);
+}
+
+_Static_assert(sizeof(estado_interface_t) <= sizeof(estado_medidas_t), "buffer de cópia");
+
+void estado_publicar_interface(const estado_interface_t *novo)
+{
+    gravar(&interface.versao, interface.dados, novo, sizeof(*novo));
+}
+
+void estado_publicar_medidas(const estado_medidas_t *novo)
+{
+    gravar(&medidas.versao, medidas.dados, novo, sizeof(*novo));
+}
+
+bool estado_tentar_ler(estado_t *estado)
+{
+    uint32_t vi = atomic_load_explicit(&interface.versao, memory_order_acquire);
+    uint32_t vm = atomic_load_explicit(&medidas.versao, memory_order_acquire);
+    if ((vi | vm) & 1)
+        return false;
+
+    copiar(interface.dados, &estado->interface, sizeof(estado->interface));
+    copiar(medidas.dados, &estado->medidas, sizeof(estado->medidas));
+
+    // As cópias precisam terminar antes de reler as versões
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&interface.versao, memory_order_relaxed) != vi ||
+        atomic_load_explicit(&medidas.versao, memory_order_relaxed) != vm)
+        return false;
+
+    estado->versao = (vi >> 1) + (vm >> 1);
+    return true;
+}
+
+void estado_ler(estado_t *estado)
+{
+    while (!estado_tentar_ler(estado))
+        ;
+}
+
+uint32_t estado_versao(void)
+{
+    return (atomic_load_explicit(&interface.versao, memory_order_acquire) >> 1) +
+           (atomic_load_explicit(&medidas.versao, memory_order_acquire) >> 1);
+}
@@ -0,0 +1,78 @@
+#ifndef ESTADO_H
+#define ESTADO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ponto_fixo.h"
+
+// Estado do sistema compartilhado entre a tarefa, interrupções e o outro
+// núcleo, sem locks e sem desligar interrupções.
+//
+// Os campos são divididos em grupos, cada um com um único escritor, e cada
+// grupo é protegido por um seqlock: o escritor torna a versão ímpar, grava e
+// a torna par de novo; o leitor copia o grupo e repete se a versão mudou ou
+// era ímpar. Uma leitura devolve os dois grupos de uma mesma volta do laço,
+// nunca metade de um antes e metade depois de um botão.
+//
+// Só carga e armazenamento atômicos são usados (nada de read-modify-write),
+// então funciona no Cortex-M0+, que não tem LDREX/STREX.
+
+#define ESTADO_SENSORES 4
+#define ESTADO_CANAIS 6      // detectores de anomalia (NUM_CANAIS em pontuacao.h)
+#define ESTADO_GRAFICOS 3
+#define ESTADO_INDICADORES 5 // colunas da matriz no alarme
+
+// Escritor: a tarefa, depois de tratar os eventos de entrada
+typedef struct
+{
+    uint8_t tela;
+    uint8_t especie;
+    uint8_t sensor;
+    uint8_t grafico;
+    uint8_t modo; // 0: monitoramento, 1: ficha da espécie
+    bool alarme;
+    bool display; // display e matriz acesos
+    const char *sensor_nome;
+} estado_interface_t;
+
+// Escritor: o laço de amostragem, depois dos detectores
+typedef struct
+{
+    uint32_t amostra; // número da volta do laço
+    float temp;
+    float umid;
+    float sensores[ESTADO_SENSORES];
+    float valor_sensor; // valor em ajuste na tela de configuração
+    uint8_t anomalias[ESTADO_CANAIS]; // bits de anomalia_canal_t.estado
+    float saude;                      // índice de saúde da espécie, 0 a 1 (com o alarme ligado)
+    uint8_t indicadores[ESTADO_INDICADORES]; // linha acesa (0 = topo) de cada coluna da matriz
+    float peso_por_dia;
+    int32_t dias_reserva; // -1 sem previsão
+
+    // Última coluna dos gráficos; grafico_amostras conta as colunas publicadas
+    // e quem desenha acrescenta a nova ao seu próprio histórico
+    q16_t grafico[ESTADO_GRAFICOS];
+    uint32_t grafico_amostras;
+} estado_medidas_t;
+
+typedef struct
+{
+    uint32_t versao; // muda a cada publicação de qualquer grupo
+    estado_interface_t interface;
+    estado_medidas_t medidas;
+} estado_t;
+
+void estado_publicar_interface(const estado_interface_t *interface);
+void estado_publicar_medidas(const estado_medidas_t *medidas);
+
+// Cópia coerente dos dois grupos; repete enquanto houver escrita no meio
+void estado_ler(estado_t *estado);
+
+// Uma tentativa só: false se um escritor estava no meio. Use em interrupções
+// que podem ter interrompido o escritor no mesmo núcleo (lá, esperar trava).
+bool estado_tentar_ler(estado_t *estado);
+
+// Versão atual, para saber se algo mudou sem copiar
+uint32_t estado_versao(void);
+
+#endif
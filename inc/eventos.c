@@ -0,0 +1,205 @@
+#include "eventos.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "sram.h"
+
+// Fila de bordas: tamanho potência de 2; cabeca só é escrita pelo IRQ e cauda
+// só pela tarefa, então não há necessidade de travas nem de desligar IRQs.
+#define FILA_BORDAS_TAM 32
+#define FILA_EVENTOS_TAM 8
+
+// Limiares do joystick (ADC de 12 bits) com histerese
+#define JOY_LIMIAR_ALTO 3500
+#define JOY_RETORNO_ALTO 3000
+#define JOY_LIMIAR_BAIXO 600
+#define JOY_RETORNO_BAIXO 1100
+
+typedef struct
+{
+    uint32_t instante_us;
+    uint8_t gpio;
+    uint8_t nivel;
+} borda_t;
+
+typedef struct
+{
+    uint gpio;
+    bool candidato;          // pressionado segundo a última borda
+    uint32_t instante_borda; // instante da última borda
+    bool pressionado;        // nível estável (após debounce)
+    uint32_t instante_pressao;
+    bool longo;
+    uint32_t proxima_repeticao;
+} botao_t;
+
+static borda_t fila_bordas[FILA_BORDAS_TAM];
+static volatile uint32_t bordas_cabeca = 0;
+static volatile uint32_t bordas_cauda = 0;
+static volatile uint32_t bordas_perdidas = 0;
+
+static evento_t fila_eventos[FILA_EVENTOS_TAM];
+static uint32_t eventos_cabeca = 0;
+static uint32_t eventos_cauda = 0;
+
+static botao_t botoes[EVENTOS_MAX_BOTOES];
+static uint num_botoes = 0;
+
+static int8_t joy_estado_x = 0;
+static int8_t joy_estado_y = 0;
+
+void eventos_registrar_botao(uint gpio)
+{
+    if (num_botoes >= EVENTOS_MAX_BOTOES)
+        return;
+
+    gpio_init(gpio);
+    gpio_set_dir(gpio, GPIO_IN);
+    gpio_pull_up(gpio);
+
+    botao_t *b = &botoes[num_botoes++];
+    b->gpio = gpio;
+    b->candidato = !gpio_get(gpio);
+    b->instante_borda = time_us_32();
+    b->pressionado = b->candidato;
+    b->longo = false;
+}
+
+void NA_RAM(eventos_isr_borda)(uint gpio, uint32_t events)
+{
+    uint32_t cabeca = bordas_cabeca;
+    if (cabeca - bordas_cauda >= FILA_BORDAS_TAM)
+    {
+        bordas_perdidas++;
+        return;
+    }
+
+    borda_t *borda = &fila_bordas[cabeca & (FILA_BORDAS_TAM - 1)];
+    borda->instante_us = time_us_32();
+    borda->gpio = gpio;
+    // Com subida e descida no mesmo IRQ, vale o nível do pino agora
+    bool subida = events & GPIO_IRQ_EDGE_RISE, descida = events & GPIO_IRQ_EDGE_FALL;
+    borda->nivel = subida && descida ? gpio_get(gpio) : subida;
+
+    // Publica a entrada só depois de escrita
+    __dmb();
+    bordas_cabeca = cabeca + 1;
+}
+
+uint32_t eventos_perdidos(void)
+{
+    return bordas_perdidas;
+}
+
+static void emitir(evento_tipo_t tipo, uint origem, uint32_t instante)
+{
+    if (eventos_cabeca - eventos_cauda >= FILA_EVENTOS_TAM)
+        return;
+    evento_t *e = &fila_eventos[eventos_cabeca++ & (FILA_EVENTOS_TAM - 1)];
+    e->tipo = tipo;
+    e->origem = origem;
+    e->instante_us = instante;
+}
+
+static botao_t *buscar_botao(uint gpio)
+{
+    for (uint i = 0; i < num_botoes; i++)
+        if (botoes[i].gpio == gpio)
+            return &botoes[i];
+    return NULL;
+}
+
+// Clique longo e repetição de um botão pressionado, no instante t
+static void verificar_longo(botao_t *b, uint32_t t)
+{
+    if (!b->longo && t - b->instante_pressao >= EVENTOS_LONGO_US)
+    {
+        b->longo = true;
+        b->proxima_repeticao = t + EVENTOS_REPETICAO_US;
+        emitir(EVENTO_LONGO, b->gpio, t);
+    }
+    else if (b->longo && (int32_t)(t - b->proxima_repeticao) >= 0)
+    {
+        b->proxima_repeticao += EVENTOS_REPETICAO_US;
+        emitir(EVENTO_REPETICAO, b->gpio, t);
+    }
+}
+
+// Máquina de estados de debounce levada até o instante t. O nível candidato é
+// o da última borda; se ficou estável por EVENTOS_DEBOUNCE_US até t, vira o
+// nível do botão. Tudo pelos instantes das bordas: um toque inteiro entre
+// duas passadas do laço ainda gera o seu clique.
+static void avancar_botao(botao_t *b, uint32_t t)
+{
+    if (b->candidato != b->pressionado && t - b->instante_borda >= EVENTOS_DEBOUNCE_US)
+    {
+        if (b->candidato)
+        {
+            b->pressionado = true;
+            b->instante_pressao = b->instante_borda;
+            b->longo = false;
+        }
+        else
+        {
+            // Segurado até a soltura: pode ter sido longo sem ninguém ver
+            verificar_longo(b, b->instante_borda);
+            b->pressionado = false;
+            if (!b->longo)
+                emitir(EVENTO_CLIQUE, b->gpio, b->instante_pressao);
+        }
+    }
+
+    if (b->pressionado)
+        verificar_longo(b, t);
+}
+
+static int8_t cruzamento(int8_t estado, uint16_t valor, uint origem, evento_tipo_t alto, evento_tipo_t baixo)
+{
+    if (estado == 0 && valor > JOY_LIMIAR_ALTO)
+    {
+        emitir(alto, origem, time_us_32());
+        return 1;
+    }
+    if (estado == 0 && valor < JOY_LIMIAR_BAIXO)
+    {
+        emitir(baixo, origem, time_us_32());
+        return -1;
+    }
+    if ((estado == 1 && valor < JOY_RETORNO_ALTO) || (estado == -1 && valor > JOY_RETORNO_BAIXO))
+        return 0;
+    return estado;
+}
+
+void eventos_joystick(uint joy_x, uint16_t x, uint joy_y, uint16_t y)
+{
+    joy_estado_x = cruzamento(joy_estado_x, x, joy_x, EVENTO_JOY_DIREITA, EVENTO_JOY_ESQUERDA);
+    joy_estado_y = cruzamento(joy_estado_y, y, joy_y, EVENTO_JOY_CIMA, EVENTO_JOY_BAIXO);
+}
+
+bool eventos_processar(evento_t *evento)
+{
+    // Consome as bordas registradas pelo IRQ
+    uint32_t cabeca = bordas_cabeca;
+    __dmb();
+    while (bordas_cauda != cabeca)
+    {
+        const borda_t *borda = &fila_bordas[bordas_cauda & (FILA_BORDAS_TAM - 1)];
+        botao_t *b = buscar_botao(borda->gpio);
+        if (b)
+        {
+            // Fecha o intervalo anterior antes de trocar o candidato
+            avancar_botao(b, borda->instante_us);
+            b->candidato = !borda->nivel; // ativo em nível baixo
+            b->instante_borda = borda->instante_us;
+        }
+        bordas_cauda++;
+    }
+
+    uint32_t agora = time_us_32();
+    for (uint i = 0; i < num_botoes; i++)
+        avancar_botao(&botoes[i], agora);
+
+    if (eventos_cauda == eventos_cabeca)
+        return false;
+    *evento = fila_eventos[eventos_cauda++ & (FILA_EVENTOS_TAM - 1)];
+    return true;
+}
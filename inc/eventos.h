@@ -0,0 +1,50 @@
+#ifndef EVENTOS_H
+#define EVENTOS_H
+
+#include "pico/stdlib.h"
+
+// Entrada de eventos: o IRQ de GPIO só registra a borda (pino, nível e instante
+// do timer de hardware) numa fila circular sem travas (um produtor, um
+// consumidor). O debounce, o clique longo e a repetição rodam em contexto de
+// tarefa em eventos_processar(), a partir dos instantes registrados.
+
+#define EVENTOS_DEBOUNCE_US 20000   // nível estável por 20 ms
+#define EVENTOS_LONGO_US 800000     // segurar por 800 ms gera EVENTO_LONGO
+#define EVENTOS_REPETICAO_US 200000 // depois disso, EVENTO_REPETICAO a cada 200 ms
+
+#define EVENTOS_MAX_BOTOES 4
+
+typedef enum
+{
+    EVENTO_CLIQUE,     // botão solto antes do tempo de clique longo
+    EVENTO_LONGO,      // botão segurado por EVENTOS_LONGO_US
+    EVENTO_REPETICAO,  // botão continua segurado após o clique longo
+    EVENTO_JOY_CIMA,   // eixo Y cruzou o limiar superior
+    EVENTO_JOY_BAIXO,  // eixo Y cruzou o limiar inferior
+    EVENTO_JOY_DIREITA, // eixo X cruzou o limiar superior
+    EVENTO_JOY_ESQUERDA // eixo X cruzou o limiar inferior
+} evento_tipo_t;
+
+typedef struct
+{
+    evento_tipo_t tipo;
+    uint origem; // GPIO do botão ou do eixo do joystick
+    uint32_t instante_us;
+} evento_t;
+
+// Configura o pino do botão (pull-up, ativo em nível baixo) e o IRQ de bordas
+void eventos_registrar_botao(uint gpio);
+
+// Chamado pelo callback de GPIO; custo de poucos microssegundos
+void eventos_isr_borda(uint gpio, uint32_t events);
+
+// Gera eventos de cruzamento de limiar (com histerese) a partir das leituras do ADC
+void eventos_joystick(uint joy_x, uint16_t x, uint joy_y, uint16_t y);
+
+// Consome as bordas pendentes e devolve o próximo evento pronto (contexto de tarefa)
+bool eventos_processar(evento_t *evento);
+
+// Bordas descartadas por fila cheia
+uint32_t eventos_perdidos(void);
+
+#endif
@@ -0,0 +1,178 @@
+#include "fitas_leds.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+#include "relogio.h"
+
+// Arquivo .pio para controle da matriz
+#include "pio_matrix.pio.h"
+
+// 24 bits a 800 kHz por LED, mais o reset (>= 280 us nos WS2812B atuais)
+#define FITAS_US_POR_LED 30
+#define FITAS_RESET_US 300
+
+typedef struct
+{
+    PIO pio;
+    uint sm;
+    uint dma;
+    uint largura, altura;
+    uint32_t *buffer;
+} fita_info_t;
+
+static fita_info_t fitas[FITAS_MAX];
+static uint num_fitas = 0;
+
+// Framebuffers de todas as fitas saem de um único bloco estático
+static uint32_t memoria[FITAS_LEDS_MAX];
+static uint leds_usados = 0;
+
+// Programa carregado uma vez por PIO e compartilhado pelas máquinas de estado
+static int offset_programa[2] = {-1, -1};
+
+static uint32_t mascara_dma = 0;
+static uint maior_fita = 0;
+static absolute_time_t livre_em;
+
+// Recalcula o divisor da PIO (8 MHz, 10 ciclos por bit) de todas as fitas
+static void retemporizar_fitas(relogio_fase_t fase, uint32_t sys_hz, void *contexto)
+{
+    if (fase == RELOGIO_ANTES)
+    {
+        // Não troca o clock no meio de um quadro
+        while (fitas_ocupadas())
+            tight_loop_contents();
+        return;
+    }
+    for (uint i = 0; i < num_fitas; i++)
+        pio_sm_set_clkdiv(fitas[i].pio, fitas[i].sm, sys_hz / 8000000.0f);
+}
+
+fita_t fitas_adicionar(PIO pio, uint pino, uint largura, uint altura)
+{
+    uint num_leds = largura * altura;
+    if (num_fitas >= FITAS_MAX || num_leds == 0 || leds_usados + num_leds > FITAS_LEDS_MAX)
+        return FITA_INVALIDA;
+
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0)
+        return FITA_INVALIDA;
+    int dma = dma_claim_unused_channel(false);
+    if (dma < 0)
+    {
+        pio_sm_unclaim(pio, sm);
+        return FITA_INVALIDA;
+    }
+
+    uint indice_pio = pio_get_index(pio);
+    if (offset_programa[indice_pio] < 0)
+        offset_programa[indice_pio] = pio_add_program(pio, &pio_matrix_program);
+    pio_matrix_program_init(pio, sm, offset_programa[indice_pio], pino);
+
+    fita_info_t *f = &fitas[num_fitas];
+    f->pio = pio;
+    f->sm = sm;
+    f->dma = dma;
+    f->largura = largura;
+    f->altura = altura;
+    f->buffer = &memoria[leds_usados];
+    leds_usados += num_leds;
+
+    // Canal pré-configurado: a cada quadro basta reiniciá-lo pela máscara
+    dma_channel_config c = dma_channel_get_default_config(dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(dma, &c, &pio->txf[sm], f->buffer, num_leds, false);
+
+    mascara_dma |= 1u << dma;
+    if (num_leds > maior_fita)
+        maior_fita = num_leds;
+
+    if (num_fitas == 0)
+    {
+        livre_em = get_absolute_time();
+        relogio_registrar(retemporizar_fitas, NULL);
+    }
+
+    fitas_preencher(num_fitas, 0);
+    return num_fitas++;
+}
+
+fita_t fitas_buscar(PIO pio, uint sm)
+{
+    for (uint i = 0; i < num_fitas; i++)
+        if (fitas[i].pio == pio && fitas[i].sm == sm)
+            return i;
+    return FITA_INVALIDA;
+}
+
+uint fitas_sm(fita_t fita)
+{
+    return fitas[fita].sm;
+}
+
+uint fitas_quantidade(void)
+{
+    return num_fitas;
+}
+
+// Índice físico do LED (x, y) numa ligação em serpentina. A primeira linha
+// física é a de baixo (y = altura - 1) e é percorrida da direita para a
+// esquerda, como em imprimir_desenho.
+static uint fitas_indice(const fita_info_t *f, uint x, uint y)
+{
+    uint linha = f->altura - 1 - y;
+    uint coluna = (linha % 2) ? x : f->largura - 1 - x;
+    return linha * f->largura + coluna;
+}
+
+void fitas_pixel(fita_t fita, uint x, uint y, uint32_t grb)
+{
+    fita_info_t *f = &fitas[fita];
+    if (x >= f->largura || y >= f->altura)
+        return;
+    f->buffer[fitas_indice(f, x, y)] = grb;
+}
+
+void fitas_pixel_rgb(fita_t fita, uint x, uint y, uint8_t r, uint8_t g, uint8_t b)
+{
+    fitas_pixel(fita, x, y, ((uint32_t)g << 24) | ((uint32_t)r << 16) | ((uint32_t)b << 8));
+}
+
+void fitas_preencher(fita_t fita, uint32_t grb)
+{
+    fita_info_t *f = &fitas[fita];
+    uint n = f->largura * f->altura;
+    for (uint i = 0; i < n; i++)
+        f->buffer[i] = grb;
+}
+
+uint32_t *fitas_buffer(fita_t fita, uint *num_leds)
+{
+    if (num_leds)
+        *num_leds = fitas[fita].largura * fitas[fita].altura;
+    return fitas[fita].buffer;
+}
+
+bool fitas_ocupadas(void)
+{
+    return num_fitas && absolute_time_diff_us(get_absolute_time(), livre_em) > 0;
+}
+
+void fitas_atualizar(void)
+{
+    if (num_fitas == 0)
+        return;
+
+    // O DMA termina antes do último LED sair do FIFO: o prazo cobre a
+    // transmissão da fita mais longa e o reset que trava o quadro
+    while (fitas_ocupadas())
+        tight_loop_contents();
+
+    for (uint i = 0; i < num_fitas; i++)
+        dma_channel_set_read_addr(fitas[i].dma, fitas[i].buffer, false);
+    dma_start_channel_mask(mascara_dma);
+
+    livre_em = make_timeout_time_us(maior_fita * FITAS_US_POR_LED + FITAS_RESET_US);
+}
@@ -0,0 +1,47 @@
+#ifndef FITAS_LEDS_H
+#define FITAS_LEDS_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Fitas/matrizes de LEDs WS2812, uma por máquina de estado (pio0 e pio1, até 8).
+// Cada fita tem seu próprio framebuffer (uma palavra GRB por LED, no formato de
+// gerar_binario_cor) e um canal de DMA ligado ao FIFO da sua máquina de estado.
+// fitas_atualizar() dispara todos os canais de uma vez com dma_start_channel_mask:
+// as fitas são transmitidas em paralelo e o custo de CPU por quadro não depende
+// do comprimento delas (só um endereço de leitura rearmado por fita).
+
+#define FITAS_MAX 8
+#define FITAS_LEDS_MAX 1024 // soma dos LEDs de todas as fitas
+
+typedef int fita_t;
+
+#define FITA_INVALIDA (-1)
+
+// Registra uma fita de largura x altura LEDs no pino indicado, ligada em
+// serpentina como a matriz 5x5 da BitDogLab (fitas lineares usam altura 1).
+// Retorna FITA_INVALIDA se faltarem máquinas de estado, canais de DMA ou memória.
+fita_t fitas_adicionar(PIO pio, uint pino, uint largura, uint altura);
+
+// Busca a fita pela máquina de estado (usado pela API antiga da matriz)
+fita_t fitas_buscar(PIO pio, uint sm);
+
+uint fitas_sm(fita_t fita);
+uint fitas_quantidade(void);
+
+// Escrita no framebuffer; só vai para os LEDs em fitas_atualizar()
+void fitas_pixel(fita_t fita, uint x, uint y, uint32_t grb);
+void fitas_pixel_rgb(fita_t fita, uint x, uint y, uint8_t r, uint8_t g, uint8_t b);
+void fitas_preencher(fita_t fita, uint32_t grb);
+
+// Acesso direto ao framebuffer, na ordem física dos LEDs
+uint32_t *fitas_buffer(fita_t fita, uint *num_leds);
+
+// Dispara a transmissão de todas as fitas em paralelo. Se o quadro anterior
+// ainda estiver saindo (ou no intervalo de reset), espera por ele antes.
+void fitas_atualizar(void);
+
+// Verdadeiro enquanto um quadro ainda está sendo transmitido
+bool fitas_ocupadas(void);
+
+#endif
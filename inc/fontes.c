@@ -0,0 +1,60 @@
+#include "fontes.h"
+#include "sram.h"
+
+const uint8_t *NA_RAM(fonte_glifo)(const fonte_t *fonte, uint32_t codigo, uint8_t *largura)
+{
+    if (codigo < fonte->primeiro || codigo > fonte->ultimo)
+        codigo = '?';
+    uint32_t i = codigo - fonte->primeiro;
+    *largura = fonte->larguras[i];
+    return &fonte->bitmaps[fonte->offsets[i]];
+}
+
+uint8_t NA_RAM(fonte_avanco)(const fonte_t *fonte, uint32_t codigo)
+{
+    if (fonte->largura_fixa)
+        return fonte->largura_fixa;
+    uint8_t largura;
+    fonte_glifo(fonte, codigo, &largura);
+    return largura + fonte->espaco;
+}
+
+uint32_t NA_RAM(utf8_proximo)(const char **str)
+{
+    const uint8_t *s = (const uint8_t *)*str;
+    uint32_t codigo = s[0];
+
+    if (codigo < 0x80)
+    {
+        *str += 1;
+        return codigo;
+    }
+
+    // Latin-1 cabe em duas unidades (0xC2/0xC3 + continuação)
+    if ((codigo & 0xE0) == 0xC0 && (s[1] & 0xC0) == 0x80)
+    {
+        *str += 2;
+        codigo = ((codigo & 0x1F) << 6) | (s[1] & 0x3F);
+        return codigo <= 0xFF ? codigo : '?';
+    }
+
+    // Sequências mais longas: consome a sequência inteira
+    uint32_t n = 1;
+    if ((codigo & 0xF0) == 0xE0)
+        n = 3;
+    else if ((codigo & 0xF8) == 0xF0)
+        n = 4;
+    uint32_t i = 1;
+    while (i < n && (s[i] & 0xC0) == 0x80)
+        i++;
+    *str += i;
+    return '?';
+}
+
+uint16_t fonte_largura_texto(const fonte_t *fonte, const char *str)
+{
+    uint16_t largura = 0;
+    while (*str)
+        largura += fonte_avanco(fonte, utf8_proximo(&str));
+    return largura;
+}
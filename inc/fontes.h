@@ -0,0 +1,40 @@
+#ifndef FONTES_H
+#define FONTES_H
+
+#include <stdint.h>
+
+// Fontes do display, todas const em flash (inc/fontes_dados.c, gerado por
+// tools/gerar_fontes.py). Cada glifo é uma sequência de colunas com
+// bytes_coluna bytes (LSB em cima) e largura própria; o acesso é O(1) pela
+// tabela de offsets indexada pelo ponto de código Latin-1.
+
+typedef struct
+{
+    uint8_t altura;       // linhas por glifo
+    uint8_t bytes_coluna; // ceil(altura / 8)
+    uint8_t largura_fixa; // avanço fixo em pixels, ou 0 para proporcional
+    uint8_t espaco;       // colunas em branco entre glifos proporcionais
+    uint8_t primeiro, ultimo;
+    const uint16_t *offsets;
+    const uint8_t *larguras;
+    const uint8_t *bitmaps;
+} fonte_t;
+
+extern const fonte_t fonte_8x8;  // monoespaçada, a fonte original do projeto
+extern const fonte_t fonte_5x7;  // pequena, para telas com muitos dados
+extern const fonte_t fonte_8x16; // grande, para o valor em destaque
+
+// Bitmap e largura do glifo (pontos fora da fonte viram '?')
+const uint8_t *fonte_glifo(const fonte_t *fonte, uint32_t codigo, uint8_t *largura);
+
+// Avanço horizontal do glifo, incluindo o espaçamento
+uint8_t fonte_avanco(const fonte_t *fonte, uint32_t codigo);
+
+// Decodifica o próximo ponto de código UTF-8 e avança o ponteiro.
+// Sequências inválidas ou fora do Latin-1 viram '?'.
+uint32_t utf8_proximo(const char **str);
+
+// Largura em pixels de uma string UTF-8
+uint16_t fonte_largura_texto(const fonte_t *fonte, const char *str);
+
+#endif
@@ -0,0 +1,398 @@
+// Gerado por tools/gerar_fontes.py -- não edite à mão.
+
+#include "fontes.h"
+#include "sram.h"
+
+static const uint8_t fonte_8x8_bitmaps[] TABELA_NA_RAM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5F, 0x5F, 0x00, 0x00, 0x00,
+    0x00, 0x07, 0x07, 0x00, 0x07, 0x07, 0x00, 0x00, 0x14, 0x7F, 0x7F, 0x14, 0x7F, 0x7F, 0x14, 0x00,
+    0x24, 0x2E, 0x2A, 0x6B, 0x6B, 0x3A, 0x12, 0x00, 0x46, 0x66, 0x30, 0x18, 0x0C, 0x66, 0x62, 0x00,
+    0x30, 0x7A, 0x4F, 0x5D, 0x37, 0x7A, 0x48, 0x00, 0x00, 0x04, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x1C, 0x3E, 0x63, 0x41, 0x00, 0x00, 0x00, 0x00, 0x41, 0x63, 0x3E, 0x1C, 0x00, 0x00,
+    0x08, 0x2A, 0x3E, 0x1C, 0x1C, 0x3E, 0x2A, 0x08, 0x00, 0x08, 0x08, 0x3E, 0x3E, 0x08, 0x08, 0x00,
+    0x00, 0x00, 0x80, 0xE0, 0x60, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00,
+    0x00, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00,
+    0x3E, 0x7F, 0x59, 0x4D, 0x47, 0x7F, 0x3E, 0x00, 0x00, 0x40, 0x42, 0x7F, 0x7F, 0x40, 0x40, 0x00,
+    0x72, 0x7B, 0x49, 0x49, 0x49, 0x4F, 0x46, 0x00, 0x41, 0x41, 0x49, 0x49, 0x49, 0x7F, 0x36, 0x00,
+    0x1E, 0x1E, 0x10, 0x10, 0x7F, 0x7F, 0x10, 0x00, 0x27, 0x67, 0x45, 0x45, 0x45, 0x7D, 0x39, 0x00,
+    0x3E, 0x7F, 0x49, 0x49, 0x49, 0x79, 0x30, 0x00, 0x01, 0x01, 0x61, 0x71, 0x19, 0x0F, 0x07, 0x00,
+    0x36, 0x7F, 0x49, 0x49, 0x49, 0x7F, 0x36, 0x00, 0x06, 0x4F, 0x49, 0x49, 0x49, 0x7F, 0x3E, 0x00,
+    0x00, 0x00, 0x00, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xE6, 0x66, 0x00, 0x00, 0x00,
+    0x00, 0x08, 0x1C, 0x36, 0x63, 0x41, 0x00, 0x00, 0x00, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x00,
+    0x00, 0x00, 0x41, 0x63, 0x36, 0x1C, 0x08, 0x00, 0x00, 0x02, 0x03, 0x59, 0x5D, 0x07, 0x02, 0x00,
+    0x3E, 0x7F, 0x41, 0x5D, 0x5D, 0x5F, 0x5E, 0x00, 0x7C, 0x7E, 0x13, 0x11, 0x13, 0x7E, 0x7C, 0x00,
+    0x7F, 0x7F, 0x49, 0x49, 0x49, 0x7F, 0x36, 0x00, 0x3E, 0x7F, 0x41, 0x41, 0x41, 0x63, 0x22, 0x00,
+    0x7F, 0x7F, 0x41, 0x41, 0x63, 0x3E, 0x1C, 0x00, 0x7F, 0x7F, 0x49, 0x49, 0x49, 0x41, 0x41, 0x00,
+    0x7F, 0x7F, 0x09, 0x09, 0x09, 0x01, 0x01, 0x00, 0x3E, 0x7F, 0x41, 0x41, 0x51, 0x73, 0x32, 0x00,
+    0x7F, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x7F, 0x00, 0x00, 0x41, 0x41, 0x7F, 0x7F, 0x41, 0x41, 0x00,
+    0x20, 0x60, 0x40, 0x40, 0x40, 0x7F, 0x3F, 0x00, 0x7F, 0x7F, 0x08, 0x1C, 0x36, 0x63, 0x41, 0x00,
+    0x7F, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x7F, 0x7F, 0x0E, 0x1C, 0x0E, 0x7F, 0x7F, 0x00,
+    0x7F, 0x7F, 0x06, 0x0C, 0x18, 0x7F, 0x7F, 0x00, 0x3E, 0x7F, 0x41, 0x41, 0x41, 0x7F, 0x3E, 0x00,
+    0x7F, 0x7F, 0x09, 0x09, 0x09, 0x0F, 0x06, 0x00, 0x3E, 0x7F, 0x41, 0x71, 0x61, 0xFF, 0xBE, 0x00,
+    0x7F, 0x7F, 0x09, 0x19, 0x39, 0x6F, 0x46, 0x00, 0x26, 0x6F, 0x49, 0x49, 0x49, 0x7B, 0x32, 0x00,
+    0x01, 0x01, 0x01, 0x7F, 0x7F, 0x01, 0x01, 0x01, 0x7F, 0x7F, 0x40, 0x40, 0x40, 0x7F, 0x7F, 0x00,
+    0x1F, 0x3F, 0x60, 0x60, 0x60, 0x3F, 0x1F, 0x00, 0x3F, 0x7F, 0x60, 0x30, 0x60, 0x7F, 0x3F, 0x00,
+    0x63, 0x77, 0x1C, 0x08, 0x1C, 0x77, 0x63, 0x00, 0x47, 0x4F, 0x68, 0x38, 0x18, 0x0F, 0x07, 0x00,
+    0x41, 0x61, 0x71, 0x59, 0x4D, 0x47, 0x43, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x41, 0x41, 0x00, 0x00,
+    0x01, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x00, 0x00, 0x00, 0x41, 0x41, 0x7F, 0x7F, 0x00, 0x00,
+    0x04, 0xF1, 0xFA, 0x88, 0xFB, 0xF8, 0xF2, 0x01, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x00, 0xF0, 0xF8, 0xB8, 0xF8, 0xF8, 0xF0, 0x00, 0x20, 0x74, 0x54, 0x54, 0x54, 0x7C, 0x78, 0x00,
+    0x7F, 0x7F, 0x48, 0x48, 0x48, 0x78, 0x30, 0x00, 0x38, 0x7C, 0x44, 0x44, 0x44, 0x6C, 0x28, 0x00,
+    0x30, 0x78, 0x48, 0x48, 0x48, 0x7F, 0x7F, 0x00, 0x38, 0x7C, 0x54, 0x54, 0x54, 0x5C, 0x18, 0x00,
+    0x00, 0x48, 0x7E, 0x7F, 0x49, 0x03, 0x02, 0x00, 0x98, 0xBC, 0xA4, 0xA4, 0xA4, 0xFC, 0x7C, 0x00,
+    0x7F, 0x7F, 0x04, 0x04, 0x04, 0x7C, 0x78, 0x00, 0x00, 0x00, 0x44, 0x7D, 0x7D, 0x40, 0x00, 0x00,
+    0x40, 0xC0, 0x80, 0x80, 0x80, 0xFD, 0x7D, 0x00, 0x7F, 0x7F, 0x10, 0x18, 0x3C, 0x64, 0x40, 0x00,
+    0x00, 0x00, 0x41, 0x7F, 0x7F, 0x40, 0x00, 0x00, 0x7C, 0x7C, 0x18, 0x78, 0x1C, 0x7C, 0x78, 0x00,
+    0x7C, 0x7C, 0x04, 0x04, 0x04, 0x7C, 0x78, 0x00, 0x38, 0x7C, 0x44, 0x44, 0x44, 0x7C, 0x38, 0x00,
+    0xFC, 0xFC, 0x24, 0x24, 0x24, 0x3C, 0x18, 0x00, 0x18, 0x3C, 0x24, 0x24, 0x24, 0xFC, 0xFC, 0x00,
+    0x7C, 0x7C, 0x04, 0x04, 0x04, 0x0C, 0x08, 0x00, 0x48, 0x5C, 0x54, 0x54, 0x54, 0x74, 0x24, 0x00,
+    0x00, 0x04, 0x04, 0x3F, 0x7F, 0x44, 0x44, 0x00, 0x3C, 0x7C, 0x40, 0x40, 0x40, 0x7C, 0x7C, 0x00,
+    0x1C, 0x3C, 0x60, 0x60, 0x60, 0x3C, 0x1C, 0x00, 0x3C, 0x7C, 0x60, 0x30, 0x60, 0x7C, 0x3C, 0x00,
+    0x44, 0x6C, 0x38, 0x10, 0x38, 0x6C, 0x44, 0x00, 0x9C, 0xBC, 0xA0, 0xA0, 0xA0, 0xFC, 0x7C, 0x00,
+    0x44, 0x64, 0x74, 0x54, 0x5C, 0x4C, 0x44, 0x00, 0x00, 0x08, 0x08, 0x3E, 0x77, 0x41, 0x41, 0x00,
+    0x00, 0x00, 0x00, 0x77, 0x77, 0x00, 0x00, 0x00, 0x00, 0x41, 0x41, 0x77, 0x3E, 0x08, 0x08, 0x00,
+    0x02, 0x03, 0x01, 0x03, 0x02, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x7D, 0x7D, 0x00, 0x00, 0x00,
+    0x48, 0x7E, 0x7F, 0x49, 0x43, 0x62, 0x20, 0x00, 0x00, 0x26, 0x2F, 0x29, 0x2F, 0x2F, 0x28, 0x00,
+    0x08, 0x1C, 0x36, 0x22, 0x08, 0x1C, 0x36, 0x22, 0x08, 0x08, 0x08, 0x08, 0x38, 0x38, 0x00, 0x00,
+    0x38, 0x38, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x06, 0x0F, 0x09, 0x0F, 0x06, 0x00, 0x00,
+    0x00, 0x44, 0x44, 0x5F, 0x5F, 0x44, 0x44, 0x00, 0x00, 0x1D, 0x1D, 0x15, 0x17, 0x17, 0x00, 0x00,
+    0x80, 0xFE, 0x7E, 0x20, 0x20, 0x3E, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x00, 0x00, 0x00,
+    0x00, 0x26, 0x2F, 0x29, 0x29, 0x2F, 0x26, 0x00, 0x22, 0x36, 0x1C, 0x08, 0x22, 0x36, 0x1C, 0x08,
+    0x4F, 0x6F, 0x30, 0x18, 0x6C, 0x76, 0xDB, 0xF9, 0x67, 0x37, 0x18, 0x0C, 0xEE, 0xEB, 0xB9, 0xB8,
+    0x00, 0x20, 0x70, 0x5D, 0x4D, 0x60, 0x20, 0x00, 0xF8, 0xFD, 0x27, 0x23, 0x26, 0xFC, 0xF8, 0x00,
+    0xF8, 0xFC, 0x26, 0x23, 0x27, 0xFD, 0xF8, 0x00, 0xF8, 0xFC, 0x27, 0x23, 0x27, 0xFD, 0xF8, 0x00,
+    0xF8, 0xFD, 0x27, 0x23, 0x27, 0xFD, 0xF9, 0x00, 0x79, 0x7D, 0x14, 0x16, 0x14, 0x7D, 0x79, 0x00,
+    0x70, 0x78, 0x2B, 0x2B, 0x2B, 0x78, 0x70, 0x00, 0x7C, 0x7E, 0x0B, 0x09, 0x7F, 0x7F, 0x49, 0x49,
+    0x3E, 0x7F, 0xC1, 0xE1, 0x41, 0x63, 0x22, 0x00, 0x7C, 0x7C, 0x54, 0x54, 0x55, 0x45, 0x45, 0x00,
+    0xFE, 0xFE, 0x93, 0x93, 0x93, 0x83, 0x82, 0x00, 0x00, 0x82, 0x82, 0xFF, 0xFF, 0x83, 0x82, 0x00,
+    0x7D, 0x7D, 0x19, 0x31, 0x61, 0x7D, 0x7D, 0x00, 0x7C, 0xFE, 0x82, 0x83, 0x83, 0xFF, 0x7C, 0x00,
+    0x7C, 0xFE, 0x83, 0x83, 0x83, 0xFF, 0x7C, 0x00, 0x7C, 0xFF, 0x83, 0x83, 0x83, 0xFF, 0x7D, 0x00,
+    0x3D, 0x7F, 0x42, 0x42, 0x42, 0x7F, 0x3D, 0x00, 0xFF, 0xFF, 0x09, 0x09, 0x2F, 0x76, 0xF8, 0xA0,
+    0x00, 0x53, 0x57, 0xFC, 0xFC, 0x57, 0x53, 0x00, 0xFE, 0xFE, 0x80, 0x81, 0x81, 0xFF, 0xFE, 0x00,
+    0x7D, 0x7D, 0x40, 0x40, 0x40, 0x7D, 0x7D, 0x00, 0x00, 0xFE, 0xFF, 0x09, 0x5F, 0x76, 0x20, 0x00,
+    0x21, 0x75, 0x55, 0x54, 0x54, 0x7C, 0x78, 0x00, 0x20, 0x74, 0x54, 0x54, 0x55, 0x7D, 0x79, 0x00,
+    0x22, 0x71, 0x55, 0x55, 0x55, 0x7D, 0x79, 0x02, 0x20, 0x76, 0x55, 0x55, 0x56, 0x7E, 0x79, 0x00,
+    0x20, 0x75, 0x55, 0x54, 0x54, 0x7D, 0x79, 0x00, 0x20, 0x74, 0x54, 0x57, 0x57, 0x7C, 0x78, 0x00,
+    0x20, 0x74, 0x54, 0x54, 0x7C, 0x7C, 0x54, 0x54, 0x38, 0x7C, 0xC4, 0xE4, 0x44, 0x6C, 0x28, 0x00,
+    0x39, 0x7D, 0x55, 0x54, 0x54, 0x5C, 0x18, 0x00, 0x38, 0x7C, 0x54, 0x54, 0x55, 0x5D, 0x19, 0x00,
+    0x3A, 0x7D, 0x55, 0x55, 0x55, 0x5D, 0x19, 0x02, 0x38, 0x7D, 0x55, 0x54, 0x54, 0x5D, 0x19, 0x00,
+    0x00, 0x01, 0x45, 0x7D, 0x7C, 0x40, 0x00, 0x00, 0x00, 0x00, 0x44, 0x7D, 0x7D, 0x41, 0x00, 0x00,
+    0x02, 0x01, 0x45, 0x7D, 0x7D, 0x41, 0x02, 0x00, 0x00, 0x01, 0x45, 0x7C, 0x7C, 0x41, 0x01, 0x00,
+    0x7A, 0x7A, 0x0A, 0x0A, 0x0A, 0x7A, 0x72, 0x00, 0x39, 0x7D, 0x45, 0x44, 0x44, 0x7C, 0x38, 0x00,
+    0x38, 0x7C, 0x44, 0x44, 0x45, 0x7D, 0x39, 0x00, 0x3A, 0x7D, 0x45, 0x45, 0x45, 0x7D, 0x3A, 0x00,
+    0x38, 0x7E, 0x45, 0x45, 0x46, 0x7E, 0x39, 0x00, 0x38, 0x7D, 0x45, 0x44, 0x44, 0x7D, 0x39, 0x00,
+    0x00, 0x08, 0x08, 0x6B, 0x6B, 0x08, 0x08, 0x00, 0x38, 0x7C, 0x44, 0xFF, 0xFF, 0x44, 0x44, 0x00,
+    0x3D, 0x7D, 0x41, 0x40, 0x40, 0x7C, 0x7C, 0x00, 0x3C, 0x7C, 0x40, 0x40, 0x41, 0x7D, 0x7D, 0x00,
+    0x3A, 0x79, 0x41, 0x41, 0x41, 0x79, 0x7A, 0x00, 0x3D, 0x7D, 0x40, 0x40, 0x40, 0x7D, 0x7D, 0x00,
+    0x00, 0x9D, 0xBD, 0xA0, 0xA0, 0xFD, 0x7D, 0x00,
+};
+
+static const uint16_t fonte_8x8_offsets[] TABELA_NA_RAM = {
+    0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120,
+    128, 136, 144, 152, 160, 168, 176, 184, 192, 200, 208, 216, 224, 232, 240, 248,
+    256, 264, 272, 280, 288, 296, 304, 312, 320, 328, 336, 344, 352, 360, 368, 376,
+    384, 392, 400, 408, 416, 424, 432, 440, 448, 456, 464, 472, 480, 488, 496, 504,
+    512, 520, 528, 536, 544, 552, 560, 568, 576, 584, 592, 600, 608, 616, 624, 632,
+    640, 648, 656, 664, 672, 680, 688, 696, 704, 712, 720, 728, 736, 744, 752, 248,
+    248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248,
+    248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248, 248,
+    248, 760, 248, 768, 248, 248, 248, 248, 248, 248, 776, 784, 792, 248, 800, 248,
+    808, 816, 824, 248, 248, 832, 248, 840, 248, 248, 848, 856, 864, 872, 248, 880,
+    888, 896, 904, 912, 920, 928, 936, 944, 248, 952, 960, 248, 248, 968, 248, 248,
+    248, 976, 248, 984, 992, 1000, 1008, 1016, 1024, 248, 1032, 248, 1040, 248, 248, 1048,
+    1056, 1064, 1072, 1080, 1088, 1096, 1104, 1112, 1120, 1128, 1136, 1144, 1152, 1160, 1168, 1176,
+    248, 1184, 1192, 1200, 1208, 1216, 1224, 1232, 1240, 1248, 1256, 1264, 1272, 248, 248, 1280,
+};
+
+static const uint8_t fonte_8x8_larguras[] TABELA_NA_RAM = {
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+};
+
+const fonte_t fonte_8x8 TABELA_NA_RAM = {
+    .altura = 8,
+    .bytes_coluna = 1,
+    .largura_fixa = 8,
+    .espaco = 0,
+    .primeiro = 32,
+    .ultimo = 255,
+    .offsets = fonte_8x8_offsets,
+    .larguras = fonte_8x8_larguras,
+    .bitmaps = fonte_8x8_bitmaps,
+};
+
+static const uint8_t fonte_5x7_bitmaps[] TABELA_NA_RAM = {
+    0x00, 0x00, 0x00, 0x5F, 0x07, 0x00, 0x07, 0x14, 0x7F, 0x14, 0x7F, 0x14, 0x24, 0x2A, 0x7F, 0x2A,
+    0x12, 0x23, 0x13, 0x08, 0x64, 0x62, 0x36, 0x49, 0x55, 0x22, 0x50, 0x05, 0x03, 0x1C, 0x22, 0x41,
+    0x41, 0x22, 0x1C, 0x14, 0x08, 0x3E, 0x08, 0x14, 0x08, 0x08, 0x3E, 0x08, 0x08, 0x50, 0x30, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x60, 0x60, 0x20, 0x10, 0x08, 0x04, 0x02, 0x3E, 0x51, 0x49, 0x45, 0x3E,
+    0x42, 0x7F, 0x40, 0x42, 0x61, 0x51, 0x49, 0x46, 0x21, 0x41, 0x45, 0x4B, 0x31, 0x18, 0x14, 0x12,
+    0x7F, 0x10, 0x27, 0x45, 0x45, 0x45, 0x39, 0x3C, 0x4A, 0x49, 0x49, 0x30, 0x01, 0x71, 0x09, 0x05,
+    0x03, 0x36, 0x49, 0x49, 0x49, 0x36, 0x06, 0x49, 0x49, 0x29, 0x1E, 0x36, 0x36, 0x56, 0x36, 0x08,
+    0x14, 0x22, 0x41, 0x14, 0x14, 0x14, 0x14, 0x14, 0x41, 0x22, 0x14, 0x08, 0x02, 0x01, 0x51, 0x09,
+    0x06, 0x32, 0x49, 0x79, 0x41, 0x3E, 0x7E, 0x11, 0x11, 0x11, 0x7E, 0x7F, 0x49, 0x49, 0x49, 0x36,
+    0x3E, 0x41, 0x41, 0x41, 0x22, 0x7F, 0x41, 0x41, 0x22, 0x1C, 0x7F, 0x49, 0x49, 0x49, 0x41, 0x7F,
+    0x09, 0x09, 0x09, 0x01, 0x3E, 0x41, 0x49, 0x49, 0x7A, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x41, 0x7F,
+    0x41, 0x20, 0x40, 0x41, 0x3F, 0x01, 0x7F, 0x08, 0x14, 0x22, 0x41, 0x7F, 0x40, 0x40, 0x40, 0x40,
+    0x7F, 0x02, 0x0C, 0x02, 0x7F, 0x7F, 0x04, 0x08, 0x10, 0x7F, 0x3E, 0x41, 0x41, 0x41, 0x3E, 0x7F,
+    0x09, 0x09, 0x09, 0x06, 0x3E, 0x41, 0x51, 0x21, 0x5E, 0x7F, 0x09, 0x19, 0x29, 0x46, 0x46, 0x49,
+    0x49, 0x49, 0x31, 0x01, 0x01, 0x7F, 0x01, 0x01, 0x3F, 0x40, 0x40, 0x40, 0x3F, 0x1F, 0x20, 0x40,
+    0x20, 0x1F, 0x3F, 0x40, 0x38, 0x40, 0x3F, 0x63, 0x14, 0x08, 0x14, 0x63, 0x07, 0x08, 0x70, 0x08,
+    0x07, 0x61, 0x51, 0x49, 0x45, 0x43, 0x7F, 0x41, 0x41, 0x02, 0x04, 0x08, 0x10, 0x20, 0x41, 0x41,
+    0x7F, 0x04, 0x02, 0x01, 0x02, 0x04, 0x40, 0x40, 0x40, 0x40, 0x40, 0x01, 0x02, 0x04, 0x20, 0x54,
+    0x54, 0x54, 0x78, 0x7F, 0x48, 0x44, 0x44, 0x38, 0x38, 0x44, 0x44, 0x44, 0x20, 0x38, 0x44, 0x44,
+    0x48, 0x7F, 0x38, 0x54, 0x54, 0x54, 0x18, 0x08, 0x7E, 0x09, 0x01, 0x02, 0x0C, 0x52, 0x52, 0x52,
+    0x3E, 0x7F, 0x08, 0x04, 0x04, 0x78, 0x44, 0x7D, 0x40, 0x20, 0x40, 0x44, 0x3D, 0x7F, 0x10, 0x28,
+    0x44, 0x41, 0x7F, 0x40, 0x7C, 0x04, 0x18, 0x04, 0x78, 0x7C, 0x08, 0x04, 0x04, 0x78, 0x38, 0x44,
+    0x44, 0x44, 0x38, 0x7C, 0x14, 0x14, 0x14, 0x08, 0x08, 0x14, 0x14, 0x18, 0x7C, 0x7C, 0x08, 0x04,
+    0x04, 0x08, 0x48, 0x54, 0x54, 0x54, 0x20, 0x04, 0x3F, 0x44, 0x40, 0x20, 0x3C, 0x40, 0x40, 0x20,
+    0x7C, 0x1C, 0x20, 0x40, 0x20, 0x1C, 0x3C, 0x40, 0x30, 0x40, 0x3C, 0x44, 0x28, 0x10, 0x28, 0x44,
+    0x0C, 0x50, 0x50, 0x50, 0x3C, 0x44, 0x64, 0x54, 0x4C, 0x44, 0x08, 0x36, 0x41, 0x7F, 0x41, 0x36,
+    0x08, 0x02, 0x01, 0x02, 0x04, 0x02, 0x0A, 0x0D, 0x0E, 0x06, 0x09, 0x09, 0x06, 0x06, 0x09, 0x06,
+    0xFC, 0x23, 0x23, 0x22, 0xFC, 0xFC, 0x22, 0x23, 0x23, 0xFC, 0xFC, 0x23, 0x23, 0x23, 0xFC, 0xFD,
+    0x23, 0x23, 0x23, 0xFC, 0x1E, 0xA1, 0x61, 0x21, 0x12, 0xFE, 0x92, 0x93, 0x93, 0x82, 0xFE, 0x93,
+    0x93, 0x93, 0x82, 0x82, 0xFF, 0x83, 0x7C, 0x82, 0x83, 0x83, 0x7C, 0x7C, 0x83, 0x83, 0x83, 0x7C,
+    0x7D, 0x83, 0x83, 0x83, 0x7C, 0x7E, 0x80, 0x81, 0x81, 0x7E, 0x7E, 0x81, 0x80, 0x81, 0x7E, 0x20,
+    0x55, 0x56, 0x54, 0x78, 0x20, 0x54, 0x56, 0x55, 0x78, 0x20, 0x56, 0x55, 0x56, 0x78, 0x22, 0x55,
+    0x56, 0x55, 0x78, 0x18, 0xA4, 0x64, 0x24, 0x38, 0x54, 0x56, 0x55, 0x18, 0x38, 0x56, 0x55, 0x56,
+    0x18, 0x44, 0x7E, 0x41, 0x38, 0x44, 0x46, 0x45, 0x38, 0x38, 0x46, 0x45, 0x46, 0x38, 0x3A, 0x45,
+    0x46, 0x45, 0x38, 0x3C, 0x40, 0x42, 0x21, 0x7C, 0x3C, 0x41, 0x40, 0x21, 0x7C,
+};
+
+static const uint16_t fonte_5x7_offsets[] TABELA_NA_RAM = {
+    0, 3, 4, 7, 12, 17, 22, 27, 29, 32, 35, 40, 45, 47, 52, 54,
+    59, 64, 67, 72, 77, 82, 87, 92, 97, 102, 107, 109, 111, 115, 120, 124,
+    129, 134, 139, 144, 149, 154, 159, 164, 169, 174, 177, 182, 187, 192, 197, 202,
+    207, 212, 217, 222, 227, 232, 237, 242, 247, 252, 257, 262, 265, 270, 273, 278,
+    283, 286, 291, 296, 301, 306, 311, 316, 321, 326, 329, 333, 337, 340, 345, 350,
+    355, 360, 365, 370, 375, 380, 385, 390, 395, 400, 405, 410, 413, 414, 417, 124,
+    124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124,
+    124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 124,
+    124, 124, 124, 124, 124, 124, 124, 124, 124, 124, 422, 124, 124, 124, 124, 124,
+    425, 124, 124, 124, 124, 124, 124, 124, 124, 124, 429, 124, 124, 124, 124, 124,
+    432, 437, 442, 447, 124, 124, 124, 452, 124, 457, 462, 124, 124, 467, 124, 124,
+    124, 124, 124, 470, 475, 480, 124, 124, 124, 124, 485, 124, 490, 124, 124, 124,
+    495, 500, 505, 510, 124, 124, 124, 515, 124, 519, 524, 124, 124, 529, 124, 124,
+    124, 124, 124, 532, 537, 542, 124, 124, 124, 124, 547, 124, 552, 124, 124, 124,
+};
+
+static const uint8_t fonte_5x7_larguras[] TABELA_NA_RAM = {
+    3, 1, 3, 5, 5, 5, 5, 2, 3, 3, 5, 5, 2, 5, 2, 5,
+    5, 3, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 4, 5, 4, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 3, 5, 5,
+    3, 5, 5, 5, 5, 5, 5, 5, 5, 3, 4, 4, 3, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 1, 3, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5,
+    4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 4, 5, 5, 5, 5, 5, 3, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+};
+
+const fonte_t fonte_5x7 TABELA_NA_RAM = {
+    .altura = 8,
+    .bytes_coluna = 1,
+    .largura_fixa = 0,
+    .espaco = 1,
+    .primeiro = 32,
+    .ultimo = 255,
+    .offsets = fonte_5x7_offsets,
+    .larguras = fonte_5x7_larguras,
+    .bitmaps = fonte_5x7_bitmaps,
+};
+
+static const uint8_t fonte_8x16_bitmaps[] TABELA_NA_RAM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x33, 0xFF, 0x33, 0x3F, 0x00,
+    0x3F, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x3F, 0x00, 0x30, 0x03, 0xFF, 0x3F, 0xFF, 0x3F, 0x30, 0x03,
+    0xFF, 0x3F, 0xFF, 0x3F, 0x30, 0x03, 0x30, 0x0C, 0xFC, 0x0C, 0xCC, 0x0C, 0xCF, 0x3C, 0xCF, 0x3C,
+    0xCC, 0x0F, 0x0C, 0x03, 0x3C, 0x30, 0x3C, 0x3C, 0x00, 0x0F, 0xC0, 0x03, 0xF0, 0x00, 0x3C, 0x3C,
+    0x0C, 0x3C, 0x00, 0x0F, 0xCC, 0x3F, 0xFF, 0x30, 0xF3, 0x33, 0x3F, 0x0F, 0xCC, 0x3F, 0xC0, 0x30,
+    0x30, 0x00, 0x3F, 0x00, 0x0F, 0x00, 0xF0, 0x03, 0xFC, 0x0F, 0x0F, 0x3C, 0x03, 0x30, 0x03, 0x30,
+    0x0F, 0x3C, 0xFC, 0x0F, 0xF0, 0x03, 0xC0, 0x00, 0xCC, 0x0C, 0xFC, 0x0F, 0xF0, 0x03, 0xF0, 0x03,
+    0xFC, 0x0F, 0xCC, 0x0C, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xFC, 0x0F, 0xFC, 0x0F, 0xC0, 0x00,
+    0xC0, 0x00, 0x00, 0xC0, 0x00, 0xFC, 0x00, 0x3C, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0x00, 0x3C, 0x00, 0x3C, 0x00, 0x3C, 0x00, 0x0F, 0xC0, 0x03, 0xF0, 0x00,
+    0x3C, 0x00, 0x0F, 0x00, 0x03, 0x00, 0xFC, 0x0F, 0xFF, 0x3F, 0xC3, 0x33, 0xF3, 0x30, 0x3F, 0x30,
+    0xFF, 0x3F, 0xFC, 0x0F, 0x00, 0x30, 0x0C, 0x30, 0xFF, 0x3F, 0xFF, 0x3F, 0x00, 0x30, 0x00, 0x30,
+    0x0C, 0x3F, 0xCF, 0x3F, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xFF, 0x30, 0x3C, 0x30, 0x03, 0x30,
+    0x03, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xFF, 0x3F, 0x3C, 0x0F, 0xFC, 0x03, 0xFC, 0x03,
+    0x00, 0x03, 0x00, 0x03, 0xFF, 0x3F, 0xFF, 0x3F, 0x00, 0x03, 0x3F, 0x0C, 0x3F, 0x3C, 0x33, 0x30,
+    0x33, 0x30, 0x33, 0x30, 0xF3, 0x3F, 0xC3, 0x0F, 0xFC, 0x0F, 0xFF, 0x3F, 0xC3, 0x30, 0xC3, 0x30,
+    0xC3, 0x30, 0xC3, 0x3F, 0x00, 0x0F, 0x03, 0x00, 0x03, 0x00, 0x03, 0x3C, 0x03, 0x3F, 0xC3, 0x03,
+    0xFF, 0x00, 0x3F, 0x00, 0x3C, 0x0F, 0xFF, 0x3F, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xFF, 0x3F,
+    0x3C, 0x0F, 0x3C, 0x00, 0xFF, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xFF, 0x3F, 0xFC, 0x0F,
+    0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0xC0, 0x3C, 0xFC, 0x3C, 0x3C, 0xC0, 0x00, 0xF0, 0x03, 0x3C, 0x0F,
+    0x0F, 0x3C, 0x03, 0x30, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x03,
+    0x03, 0x30, 0x0F, 0x3C, 0x3C, 0x0F, 0xF0, 0x03, 0xC0, 0x00, 0x0C, 0x00, 0x0F, 0x00, 0xC3, 0x33,
+    0xF3, 0x33, 0x3F, 0x00, 0x0C, 0x00, 0xFC, 0x0F, 0xFF, 0x3F, 0x03, 0x30, 0xF3, 0x33, 0xF3, 0x33,
+    0xFF, 0x33, 0xFC, 0x33, 0xF0, 0x3F, 0xFC, 0x3F, 0x0F, 0x03, 0x03, 0x03, 0x0F, 0x03, 0xFC, 0x3F,
+    0xF0, 0x3F, 0xFF, 0x3F, 0xFF, 0x3F, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xFF, 0x3F, 0x3C, 0x0F,
+    0xFC, 0x0F, 0xFF, 0x3F, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30, 0x0F, 0x3C, 0x0C, 0x0C, 0xFF, 0x3F,
+    0xFF, 0x3F, 0x03, 0x30, 0x03, 0x30, 0x0F, 0x3C, 0xFC, 0x0F, 0xF0, 0x03, 0xFF, 0x3F, 0xFF, 0x3F,
+    0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0x03, 0x30, 0x03, 0x30, 0xFF, 0x3F, 0xFF, 0x3F, 0xC3, 0x00,
+    0xC3, 0x00, 0xC3, 0x00, 0x03, 0x00, 0x03, 0x00, 0xFC, 0x0F, 0xFF, 0x3F, 0x03, 0x30, 0x03, 0x30,
+    0x03, 0x33, 0x0F, 0x3F, 0x0C, 0x0F, 0xFF, 0x3F, 0xFF, 0x3F, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00,
+    0xFF, 0x3F, 0xFF, 0x3F, 0x03, 0x30, 0x03, 0x30, 0xFF, 0x3F, 0xFF, 0x3F, 0x03, 0x30, 0x03, 0x30,
+    0x00, 0x0C, 0x00, 0x3C, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0xFF, 0x3F, 0xFF, 0x0F, 0xFF, 0x3F,
+    0xFF, 0x3F, 0xC0, 0x00, 0xF0, 0x03, 0x3C, 0x0F, 0x0F, 0x3C, 0x03, 0x30, 0xFF, 0x3F, 0xFF, 0x3F,
+    0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0xFF, 0x3F, 0xFF, 0x3F, 0xFC, 0x00,
+    0xF0, 0x03, 0xFC, 0x00, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x3F, 0x3C, 0x00, 0xF0, 0x00,
+    0xC0, 0x03, 0xFF, 0x3F, 0xFF, 0x3F, 0xFC, 0x0F, 0xFF, 0x3F, 0x03, 0x30, 0x03, 0x30, 0x03, 0x30,
+    0xFF, 0x3F, 0xFC, 0x0F, 0xFF, 0x3F, 0xFF, 0x3F, 0xC3, 0x00, 0xC3, 0x00, 0xC3, 0x00, 0xFF, 0x00,
+    0x3C, 0x00, 0xFC, 0x0F, 0xFF, 0x3F, 0x03, 0x30, 0x03, 0x3F, 0x03, 0x3C, 0xFF, 0xFF, 0xFC, 0xCF,
+    0xFF, 0x3F, 0xFF, 0x3F, 0xC3, 0x00, 0xC3, 0x03, 0xC3, 0x0F, 0xFF, 0x3C, 0x3C, 0x30, 0x3C, 0x0C,
+    0xFF, 0x3C, 0xC3, 0x30, 0xC3, 0x30, 0xC3, 0x30, 0xCF, 0x3F, 0x0C, 0x0F, 0x03, 0x00, 0x03, 0x00,
+    0x03, 0x00, 0xFF, 0x3F, 0xFF, 0x3F, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0xFF, 0x3F, 0xFF, 0x3F,
+    0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0xFF, 0x3F, 0xFF, 0x3F, 0xFF, 0x03, 0xFF, 0x0F, 0x00, 0x3C,
+    0x00, 0x3C, 0x00, 0x3C, 0xFF, 0x0F, 0xFF, 0x03, 0xFF, 0x0F, 0xFF, 0x3F, 0x00, 0x3C, 0x00, 0x0F,
+    0x00, 0x3C, 0xFF, 0x3F, 0xFF, 0x0F, 0x0F, 0x3C, 0x3F, 0x3F, 0xF0, 0x03, 0xC0, 0x00, 0xF0, 0x03,
+    0x3F, 0x3F, 0x0F, 0x3C, 0x3F, 0x30, 0xFF, 0x30, 0xC0, 0x3C, 0xC0, 0x0F, 0xC0, 0x03, 0xFF, 0x00,
+    0x3F, 0x00, 0x03, 0x30, 0x03, 0x3C, 0x03, 0x3F, 0xC3, 0x33, 0xF3, 0x30, 0x3F, 0x30, 0x0F, 0x30,
+    0xFF, 0x3F, 0xFF, 0x3F, 0x03, 0x30, 0x03, 0x30, 0x03, 0x00, 0x0F, 0x00, 0x3C, 0x00, 0xF0, 0x00,
+    0xC0, 0x03, 0x00, 0x0F, 0x00, 0x3C, 0x03, 0x30, 0x03, 0x30, 0xFF, 0x3F, 0xFF, 0x3F, 0x30, 0x00,
+    0x03, 0xFF, 0xCC, 0xFF, 0xC0, 0xC0, 0xCF, 0xFF, 0xC0, 0xFF, 0x0C, 0xFF, 0x03, 0x00, 0x00, 0xC0,
+    0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xFF,
+    0xC0, 0xFF, 0xC0, 0xCF, 0xC0, 0xFF, 0xC0, 0xFF, 0x00, 0xFF, 0x00, 0x0C, 0x30, 0x3F, 0x30, 0x33,
+    0x30, 0x33, 0x30, 0x33, 0xF0, 0x3F, 0xC0, 0x3F, 0xFF, 0x3F, 0xFF, 0x3F, 0xC0, 0x30, 0xC0, 0x30,
+    0xC0, 0x30, 0xC0, 0x3F, 0x00, 0x0F, 0xC0, 0x0F, 0xF0, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0xF0, 0x3C, 0xC0, 0x0C, 0x00, 0x0F, 0xC0, 0x3F, 0xC0, 0x30, 0xC0, 0x30, 0xC0, 0x30, 0xFF, 0x3F,
+    0xFF, 0x3F, 0xC0, 0x0F, 0xF0, 0x3F, 0x30, 0x33, 0x30, 0x33, 0x30, 0x33, 0xF0, 0x33, 0xC0, 0x03,
+    0xC0, 0x30, 0xFC, 0x3F, 0xFF, 0x3F, 0xC3, 0x30, 0x0F, 0x00, 0x0C, 0x00, 0xC0, 0xC3, 0xF0, 0xCF,
+    0x30, 0xCC, 0x30, 0xCC, 0x30, 0xCC, 0xF0, 0xFF, 0xF0, 0x3F, 0xFF, 0x3F, 0xFF, 0x3F, 0x30, 0x00,
+    0x30, 0x00, 0x30, 0x00, 0xF0, 0x3F, 0xC0, 0x3F, 0x30, 0x30, 0xF3, 0x3F, 0xF3, 0x3F, 0x00, 0x30,
+    0x00, 0x30, 0x00, 0xF0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0xF3, 0xFF, 0xF3, 0x3F, 0xFF, 0x3F,
+    0xFF, 0x3F, 0x00, 0x03, 0xC0, 0x03, 0xF0, 0x0F, 0x30, 0x3C, 0x00, 0x30, 0x03, 0x30, 0xFF, 0x3F,
+    0xFF, 0x3F, 0x00, 0x30, 0xF0, 0x3F, 0xF0, 0x3F, 0xC0, 0x03, 0xC0, 0x3F, 0xF0, 0x03, 0xF0, 0x3F,
+    0xC0, 0x3F, 0xF0, 0x3F, 0xF0, 0x3F, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0xF0, 0x3F, 0xC0, 0x3F,
+    0xC0, 0x0F, 0xF0, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xF0, 0x3F, 0xC0, 0x0F, 0xF0, 0xFF,
+    0xF0, 0xFF, 0x30, 0x0C, 0x30, 0x0C, 0x30, 0x0C, 0xF0, 0x0F, 0xC0, 0x03, 0xC0, 0x03, 0xF0, 0x0F,
+    0x30, 0x0C, 0x30, 0x0C, 0x30, 0x0C, 0xF0, 0xFF, 0xF0, 0xFF, 0xF0, 0x3F, 0xF0, 0x3F, 0x30, 0x00,
+    0x30, 0x00, 0x30, 0x00, 0xF0, 0x00, 0xC0, 0x00, 0xC0, 0x30, 0xF0, 0x33, 0x30, 0x33, 0x30, 0x33,
+    0x30, 0x33, 0x30, 0x3F, 0x30, 0x0C, 0x30, 0x00, 0x30, 0x00, 0xFF, 0x0F, 0xFF, 0x3F, 0x30, 0x30,
+    0x30, 0x30, 0xF0, 0x0F, 0xF0, 0x3F, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0xF0, 0x3F, 0xF0, 0x3F,
+    0xF0, 0x03, 0xF0, 0x0F, 0x00, 0x3C, 0x00, 0x3C, 0x00, 0x3C, 0xF0, 0x0F, 0xF0, 0x03, 0xF0, 0x0F,
+    0xF0, 0x3F, 0x00, 0x3C, 0x00, 0x0F, 0x00, 0x3C, 0xF0, 0x3F, 0xF0, 0x0F, 0x30, 0x30, 0xF0, 0x3C,
+    0xC0, 0x0F, 0x00, 0x03, 0xC0, 0x0F, 0xF0, 0x3C, 0x30, 0x30, 0xF0, 0xC3, 0xF0, 0xCF, 0x00, 0xCC,
+    0x00, 0xCC, 0x00, 0xCC, 0xF0, 0xFF, 0xF0, 0x3F, 0x30, 0x30, 0x30, 0x3C, 0x30, 0x3F, 0x30, 0x33,
+    0xF0, 0x33, 0xF0, 0x30, 0x30, 0x30, 0xC0, 0x00, 0xC0, 0x00, 0xFC, 0x0F, 0x3F, 0x3F, 0x03, 0x30,
+    0x03, 0x30, 0x3F, 0x3F, 0x3F, 0x3F, 0x03, 0x30, 0x03, 0x30, 0x3F, 0x3F, 0xFC, 0x0F, 0xC0, 0x00,
+    0xC0, 0x00, 0x0C, 0x00, 0x0F, 0x00, 0x03, 0x00, 0x0F, 0x00, 0x0C, 0x00, 0x0F, 0x00, 0x03, 0x00,
+    0xF3, 0x3F, 0xF3, 0x3F, 0xC0, 0x30, 0xFC, 0x3F, 0xFF, 0x3F, 0xC3, 0x30, 0x0F, 0x30, 0x0C, 0x3C,
+    0x00, 0x0C, 0x3C, 0x0C, 0xFF, 0x0C, 0xC3, 0x0C, 0xFF, 0x0C, 0xFF, 0x0C, 0xC0, 0x0C, 0xC0, 0x00,
+    0xF0, 0x03, 0x3C, 0x0F, 0x0C, 0x0C, 0xC0, 0x00, 0xF0, 0x03, 0x3C, 0x0F, 0x0C, 0x0C, 0xC0, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x0F, 0xC0, 0x0F, 0xC0, 0x0F, 0xC0, 0x0F, 0xC0, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x3C, 0x00, 0xFF, 0x00, 0xC3, 0x00, 0xFF, 0x00, 0x3C, 0x00,
+    0x30, 0x30, 0x30, 0x30, 0xFF, 0x33, 0xFF, 0x33, 0x30, 0x30, 0x30, 0x30, 0xF3, 0x03, 0xF3, 0x03,
+    0x33, 0x03, 0x3F, 0x03, 0x3F, 0x03, 0x00, 0xC0, 0xFC, 0xFF, 0xFC, 0x3F, 0x00, 0x0C, 0x00, 0x0C,
+    0xFC, 0x0F, 0xFC, 0x03, 0x00, 0x03, 0x00, 0x03, 0x3C, 0x0C, 0xFF, 0x0C, 0xC3, 0x0C, 0xC3, 0x0C,
+    0xFF, 0x0C, 0x3C, 0x0C, 0x0C, 0x0C, 0x3C, 0x0F, 0xF0, 0x03, 0xC0, 0x00, 0x0C, 0x0C, 0x3C, 0x0F,
+    0xF0, 0x03, 0xC0, 0x00, 0xFF, 0x30, 0xFF, 0x3C, 0x00, 0x0F, 0xC0, 0x03, 0xF0, 0x3C, 0x3C, 0x3F,
+    0xCF, 0xF3, 0xC3, 0xFF, 0x3F, 0x3C, 0x3F, 0x0F, 0xC0, 0x03, 0xF0, 0x00, 0xFC, 0xFC, 0xCF, 0xFC,
+    0xC3, 0xCF, 0xC0, 0xCF, 0x00, 0x0C, 0x00, 0x3F, 0xF3, 0x33, 0xF3, 0x30, 0x00, 0x3C, 0x00, 0x0C,
+    0xC0, 0xFF, 0xF3, 0xFF, 0x3F, 0x0C, 0x0F, 0x0C, 0x3C, 0x0C, 0xF0, 0xFF, 0xC0, 0xFF, 0xC0, 0xFF,
+    0xF0, 0xFF, 0x3C, 0x0C, 0x0F, 0x0C, 0x3F, 0x0C, 0xF3, 0xFF, 0xC0, 0xFF, 0xC0, 0xFF, 0xF0, 0xFF,
+    0x3F, 0x0C, 0x0F, 0x0C, 0x3F, 0x0C, 0xF3, 0xFF, 0xC0, 0xFF, 0xC0, 0xFF, 0xF3, 0xFF, 0x3F, 0x0C,
+    0x0F, 0x0C, 0x3F, 0x0C, 0xF3, 0xFF, 0xC3, 0xFF, 0xC3, 0x3F, 0xF3, 0x3F, 0x30, 0x03, 0x3C, 0x03,
+    0x30, 0x03, 0xF3, 0x3F, 0xC3, 0x3F, 0x00, 0x3F, 0xC0, 0x3F, 0xCF, 0x0C, 0xCF, 0x0C, 0xCF, 0x0C,
+    0xC0, 0x3F, 0x00, 0x3F, 0xF0, 0x3F, 0xFC, 0x3F, 0xCF, 0x00, 0xC3, 0x00, 0xFF, 0x3F, 0xFF, 0x3F,
+    0xC3, 0x30, 0xC3, 0x30, 0xFC, 0x0F, 0xFF, 0x3F, 0x03, 0xF0, 0x03, 0xFC, 0x03, 0x30, 0x0F, 0x3C,
+    0x0C, 0x0C, 0xF0, 0x3F, 0xF0, 0x3F, 0x30, 0x33, 0x30, 0x33, 0x33, 0x33, 0x33, 0x30, 0x33, 0x30,
+    0xFC, 0xFF, 0xFC, 0xFF, 0x0F, 0xC3, 0x0F, 0xC3, 0x0F, 0xC3, 0x0F, 0xC0, 0x0C, 0xC0, 0x0C, 0xC0,
+    0x0C, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0xC0, 0x0C, 0xC0, 0xF3, 0x3F, 0xF3, 0x3F, 0xC3, 0x03,
+    0x03, 0x0F, 0x03, 0x3C, 0xF3, 0x3F, 0xF3, 0x3F, 0xF0, 0x3F, 0xFC, 0xFF, 0x0C, 0xC0, 0x0F, 0xC0,
+    0x0F, 0xC0, 0xFF, 0xFF, 0xF0, 0x3F, 0xF0, 0x3F, 0xFC, 0xFF, 0x0F, 0xC0, 0x0F, 0xC0, 0x0F, 0xC0,
+    0xFF, 0xFF, 0xF0, 0x3F, 0xF0, 0x3F, 0xFF, 0xFF, 0x0F, 0xC0, 0x0F, 0xC0, 0x0F, 0xC0, 0xFF, 0xFF,
+    0xF3, 0x3F, 0xF3, 0x0F, 0xFF, 0x3F, 0x0C, 0x30, 0x0C, 0x30, 0x0C, 0x30, 0xFF, 0x3F, 0xF3, 0x0F,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xC3, 0x00, 0xC3, 0x00, 0xFF, 0x0C, 0x3C, 0x3F, 0xC0, 0xFF, 0x00, 0xCC,
+    0x0F, 0x33, 0x3F, 0x33, 0xF0, 0xFF, 0xF0, 0xFF, 0x3F, 0x33, 0x0F, 0x33, 0xFC, 0xFF, 0xFC, 0xFF,
+    0x00, 0xC0, 0x03, 0xC0, 0x03, 0xC0, 0xFF, 0xFF, 0xFC, 0xFF, 0xF3, 0x3F, 0xF3, 0x3F, 0x00, 0x30,
+    0x00, 0x30, 0x00, 0x30, 0xF3, 0x3F, 0xF3, 0x3F, 0xFC, 0xFF, 0xFF, 0xFF, 0xC3, 0x00, 0xFF, 0x33,
+    0x3C, 0x3F, 0x00, 0x0C, 0x03, 0x0C, 0x33, 0x3F, 0x33, 0x33, 0x30, 0x33, 0x30, 0x33, 0xF0, 0x3F,
+    0xC0, 0x3F, 0x00, 0x0C, 0x30, 0x3F, 0x30, 0x33, 0x30, 0x33, 0x33, 0x33, 0xF3, 0x3F, 0xC3, 0x3F,
+    0x0C, 0x0C, 0x03, 0x3F, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xF3, 0x3F, 0xC3, 0x3F, 0x0C, 0x00,
+    0x00, 0x0C, 0x3C, 0x3F, 0x33, 0x33, 0x33, 0x33, 0x3C, 0x33, 0xFC, 0x3F, 0xC3, 0x3F, 0x00, 0x0C,
+    0x33, 0x3F, 0x33, 0x33, 0x30, 0x33, 0x30, 0x33, 0xF3, 0x3F, 0xC3, 0x3F, 0x00, 0x0C, 0x30, 0x3F,
+    0x30, 0x33, 0x3F, 0x33, 0x3F, 0x33, 0xF0, 0x3F, 0xC0, 0x3F, 0x00, 0x0C, 0x30, 0x3F, 0x30, 0x33,
+    0x30, 0x33, 0xF0, 0x3F, 0xF0, 0x3F, 0x30, 0x33, 0x30, 0x33, 0xC0, 0x0F, 0xF0, 0x3F, 0x30, 0xF0,
+    0x30, 0xFC, 0x30, 0x30, 0xF0, 0x3C, 0xC0, 0x0C, 0xC3, 0x0F, 0xF3, 0x3F, 0x33, 0x33, 0x30, 0x33,
+    0x30, 0x33, 0xF0, 0x33, 0xC0, 0x03, 0xC0, 0x0F, 0xF0, 0x3F, 0x30, 0x33, 0x30, 0x33, 0x33, 0x33,
+    0xF3, 0x33, 0xC3, 0x03, 0xCC, 0x0F, 0xF3, 0x3F, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0xF3, 0x33,
+    0xC3, 0x03, 0x0C, 0x00, 0xC0, 0x0F, 0xF3, 0x3F, 0x33, 0x33, 0x30, 0x33, 0x30, 0x33, 0xF3, 0x33,
+    0xC3, 0x03, 0x03, 0x00, 0x33, 0x30, 0xF3, 0x3F, 0xF0, 0x3F, 0x00, 0x30, 0x30, 0x30, 0xF3, 0x3F,
+    0xF3, 0x3F, 0x03, 0x30, 0x0C, 0x00, 0x03, 0x00, 0x33, 0x30, 0xF3, 0x3F, 0xF3, 0x3F, 0x03, 0x30,
+    0x0C, 0x00, 0x03, 0x00, 0x33, 0x30, 0xF0, 0x3F, 0xF0, 0x3F, 0x03, 0x30, 0x03, 0x00, 0xCC, 0x3F,
+    0xCC, 0x3F, 0xCC, 0x00, 0xCC, 0x00, 0xCC, 0x00, 0xCC, 0x3F, 0x0C, 0x3F, 0xC3, 0x0F, 0xF3, 0x3F,
+    0x33, 0x30, 0x30, 0x30, 0x30, 0x30, 0xF0, 0x3F, 0xC0, 0x0F, 0xC0, 0x0F, 0xF0, 0x3F, 0x30, 0x30,
+    0x30, 0x30, 0x33, 0x30, 0xF3, 0x3F, 0xC3, 0x0F, 0xCC, 0x0F, 0xF3, 0x3F, 0x33, 0x30, 0x33, 0x30,
+    0x33, 0x30, 0xF3, 0x3F, 0xCC, 0x0F, 0xC0, 0x0F, 0xFC, 0x3F, 0x33, 0x30, 0x33, 0x30, 0x3C, 0x30,
+    0xFC, 0x3F, 0xC3, 0x0F, 0xC0, 0x0F, 0xF3, 0x3F, 0x33, 0x30, 0x30, 0x30, 0x30, 0x30, 0xF3, 0x3F,
+    0xC3, 0x0F, 0xC0, 0x00, 0xC0, 0x00, 0xCF, 0x3C, 0xCF, 0x3C, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x0F,
+    0xF0, 0x3F, 0x30, 0x30, 0xFF, 0xFF, 0xFF, 0xFF, 0x30, 0x30, 0x30, 0x30, 0xF3, 0x0F, 0xF3, 0x3F,
+    0x03, 0x30, 0x00, 0x30, 0x00, 0x30, 0xF0, 0x3F, 0xF0, 0x3F, 0xF0, 0x0F, 0xF0, 0x3F, 0x00, 0x30,
+    0x00, 0x30, 0x03, 0x30, 0xF3, 0x3F, 0xF3, 0x3F, 0xCC, 0x0F, 0xC3, 0x3F, 0x03, 0x30, 0x03, 0x30,
+    0x03, 0x30, 0xC3, 0x3F, 0xCC, 0x3F, 0xF3, 0x0F, 0xF3, 0x3F, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30,
+    0xF3, 0x3F, 0xF3, 0x3F, 0xF3, 0xC3, 0xF3, 0xCF, 0x00, 0xCC, 0x00, 0xCC, 0xF3, 0xFF, 0xF3, 0x3F,
+};
+
+static const uint16_t fonte_8x16_offsets[] TABELA_NA_RAM = {
+    0, 10, 14, 24, 38, 52, 66, 80, 86, 94, 102, 118, 130, 136, 148, 152,
+    166, 180, 192, 206, 220, 234, 248, 262, 276, 290, 304, 308, 314, 324, 336, 346,
+    358, 372, 386, 400, 414, 428, 442, 456, 470, 484, 496, 510, 524, 538, 552, 566,
+    580, 594, 608, 622, 636, 652, 666, 680, 694, 708, 722, 736, 744, 758, 766, 782,
+    798, 810, 824, 838, 852, 866, 880, 892, 906, 920, 928, 942, 956, 964, 978, 992,
+    1006, 1020, 1034, 1048, 1062, 1074, 1088, 1102, 1116, 1130, 1144, 1158, 1170, 1174, 1186, 346,
+    346, 346, 346, 346, 346, 346, 346, 346, 346, 346, 346, 346, 346, 346, 346, 346,
+    346, 346, 346, 346, 346, 346, 346, 346, 346, 346, 346, 346, 346, 346, 346, 346,
+    346, 1200, 346, 1204, 346, 346, 346, 346, 346, 346, 1218, 1230, 1246, 346, 1258, 346,
+    1270, 1280, 1292, 346, 346, 1302, 346, 1316, 346, 346, 1320, 1332, 1348, 1364, 346, 1380,
+    1392, 1406, 1420, 1434, 1448, 1462, 1476, 1492, 346, 1506, 1520, 346, 346, 1534, 346, 346,
+    346, 1546, 346, 1560, 1574, 1588, 1602, 1616, 1632, 346, 1644, 346, 1658, 346, 346, 1672,
+    1684, 1698, 1712, 1728, 1742, 1756, 1770, 1786, 1800, 1814, 1828, 1844, 1858, 1868, 1876, 1890,
+    346, 1902, 1916, 1930, 1944, 1958, 1972, 1986, 1998, 2012, 2026, 2040, 2054, 346, 346, 2068,
+};
+
+static const uint8_t fonte_8x16_larguras[] TABELA_NA_RAM = {
+    5, 2, 5, 7, 7, 7, 7, 3, 4, 4, 8, 6, 3, 6, 2, 7,
+    7, 6, 7, 7, 7, 7, 7, 7, 7, 7, 2, 3, 5, 6, 5, 6,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 6, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 8, 7, 7, 7, 7, 7, 7, 4, 7, 4, 8, 8,
+    6, 7, 7, 7, 7, 7, 6, 7, 7, 4, 7, 7, 4, 7, 7, 7,
+    7, 7, 7, 7, 6, 7, 7, 7, 7, 7, 7, 6, 2, 6, 7, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 2, 6, 7, 6, 6, 6, 6, 6, 6, 6, 8, 6, 6, 6, 6,
+    5, 6, 5, 6, 6, 7, 6, 2, 6, 6, 6, 8, 8, 8, 6, 6,
+    7, 7, 7, 7, 7, 7, 8, 7, 6, 7, 7, 6, 6, 6, 6, 6,
+    6, 7, 6, 7, 7, 7, 7, 8, 6, 6, 7, 6, 7, 6, 6, 6,
+    7, 7, 8, 7, 7, 7, 8, 7, 7, 7, 8, 7, 5, 4, 7, 6,
+    6, 7, 7, 7, 7, 7, 7, 6, 7, 7, 7, 7, 7, 6, 6, 6,
+};
+
+const fonte_t fonte_8x16 TABELA_NA_RAM = {
+    .altura = 16,
+    .bytes_coluna = 2,
+    .largura_fixa = 0,
+    .espaco = 2,
+    .primeiro = 32,
+    .ultimo = 255,
+    .offsets = fonte_8x16_offsets,
+    .larguras = fonte_8x16_larguras,
+    .bitmaps = fonte_8x16_bitmaps,
+};
+
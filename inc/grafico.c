@@ -0,0 +1,123 @@
+#include "grafico.h"
+
+// Margem acrescentada à faixa ao reescalar, para não redesenhar a cada amostra
+#define GRAFICO_MARGEM_SHIFT 3 // 1/8 da faixa
+
+// Faixa mínima, evitando divisão por zero em sinais constantes
+#define GRAFICO_FAIXA_MIN (Q16_UM / 4)
+
+void grafico_init(grafico_t *g, uint8_t x0, uint8_t largura, uint8_t pagina0, uint8_t paginas)
+{
+    g->x0 = x0;
+    g->largura = largura > GRAFICO_LARGURA_MAX ? GRAFICO_LARGURA_MAX : largura;
+    g->pagina0 = pagina0;
+    g->paginas = paginas;
+    g->total = 0;
+    g->escala_valida = false;
+}
+
+static uint32_t grafico_n(const grafico_t *g)
+{
+    return g->total < g->largura ? g->total : g->largura;
+}
+
+// Recalcula a escala pela faixa das amostras visíveis (O(largura), só ocasionalmente)
+static void reescalar(grafico_t *g)
+{
+    uint32_t n = grafico_n(g);
+    q16_t min = g->amostras[0], max = g->amostras[0];
+    for (uint32_t i = 1; i < n; i++)
+    {
+        if (g->amostras[i] < min)
+            min = g->amostras[i];
+        if (g->amostras[i] > max)
+            max = g->amostras[i];
+    }
+
+    q16_t faixa = max - min;
+    if (faixa < GRAFICO_FAIXA_MIN)
+        faixa = GRAFICO_FAIXA_MIN;
+    g->escala_min = min - (faixa >> GRAFICO_MARGEM_SHIFT);
+    g->escala_max = max + (faixa >> GRAFICO_MARGEM_SHIFT);
+    g->escala_valida = true;
+}
+
+bool grafico_adicionar(grafico_t *g, q16_t valor)
+{
+    g->amostras[g->total % g->largura] = valor;
+    g->total++;
+
+    // Amostra fora da faixa: expande imediatamente
+    if (!g->escala_valida || valor < g->escala_min || valor > g->escala_max)
+    {
+        reescalar(g);
+        return true;
+    }
+
+    // A cada volta completa, encolhe a escala se a faixa visível caiu pela metade
+    if (g->total % g->largura == 0)
+    {
+        q16_t min = g->escala_min, max = g->escala_max;
+        reescalar(g);
+        if ((g->escala_max - g->escala_min) * 2 < max - min)
+            return true;
+        g->escala_min = min;
+        g->escala_max = max;
+    }
+    return false;
+}
+
+// Linha (em pixels, 0 = topo da região) correspondente a um valor
+static int grafico_y(const grafico_t *g, q16_t valor)
+{
+    int altura = g->paginas * 8;
+    int64_t rel = (int64_t)(valor - g->escala_min) * (altura - 1) / (g->escala_max - g->escala_min);
+    int y = (altura - 1) - (int)rel;
+    if (y < 0)
+        y = 0;
+    if (y >= altura)
+        y = altura - 1;
+    return y;
+}
+
+// Desenha a coluna da amostra k: segmento vertical ligando a amostra k-1 à k
+static void grafico_coluna(const grafico_t *g, ssd1306_t *ssd, uint32_t k)
+{
+    uint8_t x = g->x0 + k % g->largura;
+    uint64_t bits = 0;
+
+    if (k < g->total && k + g->largura >= g->total)
+    {
+        int y1 = grafico_y(g, g->amostras[k % g->largura]);
+        int y0 = y1;
+        if (k > 0 && k + g->largura > g->total)
+            y0 = grafico_y(g, g->amostras[(k - 1) % g->largura]);
+        if (y0 > y1)
+        {
+            int t = y0;
+            y0 = y1;
+            y1 = t;
+        }
+        bits = ((~0ULL) >> (63 - (y1 - y0))) << y0;
+    }
+
+    // No modo vertical a coluna é contígua no framebuffer: um byte por página
+    uint8_t *coluna = &ssd->ram_buffer[(x << 3) + g->pagina0 + 1];
+    for (uint8_t p = 0; p < g->paginas; p++)
+        coluna[p] = (uint8_t)(bits >> (p * 8));
+}
+
+void grafico_desenhar(const grafico_t *g, ssd1306_t *ssd)
+{
+    // Amostras visíveis: as últimas "largura" recebidas
+    uint32_t inicio = g->total > g->largura ? g->total - g->largura : 0;
+    for (uint32_t k = inicio; k < inicio + g->largura; k++)
+        grafico_coluna(g, ssd, k);
+}
+
+uint8_t grafico_desenhar_coluna(const grafico_t *g, ssd1306_t *ssd)
+{
+    uint32_t k = g->total ? g->total - 1 : 0;
+    grafico_coluna(g, ssd, k);
+    return g->x0 + k % g->largura;
+}
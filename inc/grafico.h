@@ -0,0 +1,38 @@
+#ifndef GRAFICO_H
+#define GRAFICO_H
+
+#include "ssd1306.h"
+#include "ponto_fixo.h"
+
+// Gráfico de linha (sparkline) numa região do display. A região funciona como
+// um buffer circular de colunas: a amostra k ocupa a coluna x0 + (k % largura),
+// sobrescrevendo a mais antiga. Cada nova amostra altera uma única coluna do
+// framebuffer (uma página por byte, no modo de endereçamento vertical), que
+// pode ser enviada sozinha com ssd1306_send_region(). A escala só é recalculada
+// (e a região redesenhada) quando a faixa de valores muda.
+
+#define GRAFICO_LARGURA_MAX 128
+
+typedef struct
+{
+    uint8_t x0, largura;
+    uint8_t pagina0, paginas;
+    q16_t amostras[GRAFICO_LARGURA_MAX];
+    uint32_t total; // amostras recebidas desde o início
+    q16_t escala_min, escala_max;
+    bool escala_valida;
+} grafico_t;
+
+void grafico_init(grafico_t *g, uint8_t x0, uint8_t largura, uint8_t pagina0, uint8_t paginas);
+
+// Acrescenta uma amostra. Retorna true se a escala mudou e a região inteira
+// precisa ser redesenhada; caso contrário basta desenhar a coluna nova.
+bool grafico_adicionar(grafico_t *g, q16_t valor);
+
+// Redesenha toda a região no framebuffer
+void grafico_desenhar(const grafico_t *g, ssd1306_t *ssd);
+
+// Desenha só a coluna da amostra mais recente e devolve seu x
+uint8_t grafico_desenhar_coluna(const grafico_t *g, ssd1306_t *ssd);
+
+#endif
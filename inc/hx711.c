@@ -0,0 +1,152 @@
+#include "hx711.h"
+#include "balanca.h"
+#include "relogio.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+
+// Arquivo .pio do conversor
+#include "hx711.pio.h"
+
+#define HX711_PIO_HZ 10000000
+#define HX711_AUSENTE_US 1000000
+
+// O DMA escreve em anel: o buffer precisa estar alinhado ao seu tamanho
+static uint32_t anel[HX711_ANEL] __attribute__((aligned(HX711_ANEL * sizeof(uint32_t))));
+
+static hx711_config_t config;
+static uint sm;
+static uint canal_dma;
+
+// Contadores de amostras: produzidas sai do transfer_count do DMA
+static uint64_t base_produzidas = 0;
+static uint64_t lidas = 0;
+static uint64_t ultima_produzidas = 0;
+static absolute_time_t ultima_amostra;
+static bool recebeu = false;
+static uint32_t perdidas = 0;
+
+static void retemporizar_hx711(relogio_fase_t fase, uint32_t sys_hz, void *contexto)
+{
+    if (fase == RELOGIO_DEPOIS)
+        pio_sm_set_clkdiv(config.pio, sm, (float)sys_hz / HX711_PIO_HZ);
+}
+
+static uint32_t log2_u32(uint32_t v)
+{
+    uint32_t n = 0;
+    while (v >>= 1)
+        n++;
+    return n;
+}
+
+bool hx711_init(const hx711_config_t *cfg)
+{
+    config = *cfg;
+
+    if (cfg->pino_taxa >= 0)
+    {
+        gpio_init(cfg->pino_taxa);
+        gpio_set_dir(cfg->pino_taxa, GPIO_OUT);
+        gpio_put(cfg->pino_taxa, cfg->taxa_80sps);
+    }
+
+    int s = pio_claim_unused_sm(cfg->pio, false);
+    if (s < 0)
+        return false;
+    int c = dma_claim_unused_channel(false);
+    if (c < 0)
+    {
+        pio_sm_unclaim(cfg->pio, s);
+        return false;
+    }
+    sm = s;
+    canal_dma = c;
+
+    // Sem HX711 o pull-up mantém DOUT alto e a PIO fica esperando
+    gpio_init(cfg->pino_dout);
+    gpio_pull_up(cfg->pino_dout);
+
+    uint offset = pio_add_program(cfg->pio, &hx711_program);
+    hx711_program_init(cfg->pio, sm, offset, cfg->pino_dout, cfg->pino_sck, cfg->ganho);
+
+    // FIFO RX -> anel: escrita incrementa e dá a volta no tamanho do anel
+    dma_channel_config dc = dma_channel_get_default_config(canal_dma);
+    channel_config_set_transfer_data_size(&dc, DMA_SIZE_32);
+    channel_config_set_read_increment(&dc, false);
+    channel_config_set_write_increment(&dc, true);
+    channel_config_set_ring(&dc, true, log2_u32(sizeof(anel)));
+    channel_config_set_dreq(&dc, pio_get_dreq(cfg->pio, sm, false));
+    dma_channel_configure(canal_dma, &dc, anel, &cfg->pio->rxf[sm], UINT32_MAX, true);
+
+    relogio_registrar(retemporizar_hx711, NULL);
+    return true;
+}
+
+void hx711_definir_ganho(hx711_ganho_t ganho)
+{
+    config.ganho = ganho;
+    hx711_program_set_gain(config.pio, sm, ganho);
+}
+
+// Total de amostras que o DMA já copiou desde o início
+static uint64_t produzidas(void)
+{
+    uint32_t restante = dma_channel_hw_addr(canal_dma)->transfer_count;
+
+    // 2^32 amostras levam mais de um ano a 80 SPS; se acabar, rearma o canal
+    if (!dma_channel_is_busy(canal_dma))
+    {
+        base_produzidas += UINT32_MAX - restante;
+        dma_channel_set_trans_count(canal_dma, UINT32_MAX, true);
+        restante = UINT32_MAX;
+    }
+    return base_produzidas + (UINT32_MAX - restante);
+}
+
+uint hx711_disponiveis(void)
+{
+    uint64_t p = produzidas();
+    if (p != ultima_produzidas)
+    {
+        ultima_produzidas = p;
+        ultima_amostra = get_absolute_time();
+        recebeu = true;
+    }
+
+    // Consumidor atrasado: as mais antigas já foram sobrescritas
+    if (p - lidas > HX711_ANEL)
+    {
+        perdidas += (uint32_t)(p - lidas - HX711_ANEL);
+        lidas = p - HX711_ANEL;
+    }
+    return (uint)(p - lidas);
+}
+
+bool hx711_ler(int32_t *bruto)
+{
+    if (hx711_disponiveis() == 0)
+        return false;
+    *bruto = balanca_decodificar(anel[lidas % HX711_ANEL]);
+    lidas++;
+    return true;
+}
+
+bool hx711_media(int32_t *media)
+{
+    balanca_media_t m = {0};
+    int32_t bruto;
+    while (hx711_ler(&bruto))
+        balanca_media_somar(&m, bruto);
+    return balanca_media(&m, media);
+}
+
+uint32_t hx711_perdidas(void)
+{
+    return perdidas;
+}
+
+bool hx711_presente(void)
+{
+    hx711_disponiveis();
+    return recebeu && absolute_time_diff_us(ultima_amostra, get_absolute_time()) < HX711_AUSENTE_US;
+}
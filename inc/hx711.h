@@ -0,0 +1,51 @@
+#ifndef HX711_H
+#define HX711_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Conversor HX711 da célula de carga lido por uma máquina de estado da PIO.
+// A PIO espera DOUT baixar, gera os 24 pulsos de PD_SCK mais os de ganho e
+// empurra a amostra no FIFO RX; um canal de DMA copia o FIFO para um anel em
+// RAM sem intervenção da CPU. hx711_ler() só consome o anel.
+
+#define HX711_ANEL 32 // amostras no anel (potência de 2): 3,2 s a 10 SPS
+
+typedef enum
+{
+    HX711_A_128 = 1, // pulsos extras após os 24 bits
+    HX711_B_32 = 2,
+    HX711_A_64 = 3
+} hx711_ganho_t;
+
+typedef struct
+{
+    PIO pio;
+    uint pino_dout;
+    uint pino_sck;
+    int pino_taxa; // RATE do HX711 (alto = 80 SPS); -1 se fixo na placa
+    hx711_ganho_t ganho;
+    bool taxa_80sps;
+} hx711_config_t;
+
+bool hx711_init(const hx711_config_t *cfg);
+
+// Troca canal/ganho; vale a partir da conversão seguinte à próxima
+void hx711_definir_ganho(hx711_ganho_t ganho);
+
+// Amostras esperando no anel
+uint hx711_disponiveis(void);
+
+// Retira a amostra mais antiga (24 bits com sinal estendido)
+bool hx711_ler(int32_t *bruto);
+
+// Média das amostras disponíveis (descarta as saturadas); false se não houver
+bool hx711_media(int32_t *media);
+
+// Amostras sobrescritas antes de serem lidas
+uint32_t hx711_perdidas(void);
+
+// Verdadeiro se chegaram amostras no último segundo (balança conectada)
+bool hx711_presente(void);
+
+#endif
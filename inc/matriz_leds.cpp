@@ -2,14 +2,27 @@
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/pio.h"
-#include "hardware/clocks.h"
+#include "ws2812.hpp"
+
+extern "C"
+{
 #include "matriz_leds.h"
+#include "placa.h"
+}
 
-// Arquivo .pio para controle da matriz
-#include "pio_matrix.pio.h"
+// A matriz da placa, com o mapa dos LEDs em tempo de compilação; a API em C
+// abaixo escreve por ela. As cores de cada desenho continuam em double na
+// API, mas o índice de cada LED não custa mais nada.
+using Matriz = Ws2812Matrix<MATRIX_PIN, MATRIX_WIDTH, MATRIX_HEIGHT, MATRIX_SERPENTINA>;
+static_assert(Matriz::largura == 5 && Matriz::altura == 5, "a API em C desenha em Matriz_leds_config (5x5)");
 
-// Pino que realizará a comunicação do microcontrolador com a matriz
-#define OUT_PIN 7
+static Matriz matriz;
+
+// A API recebe a PIO e a máquina de estado; só a matriz da placa é desenhada
+static bool e_a_matriz(PIO pio, uint sm)
+{
+    return matriz.id() != FITA_INVALIDA && fitas_buscar(pio, sm) == matriz.id();
+}
 
 // Gera o binário que controla a cor de cada célula do LED
 // rotina para definição da intensidade de cores do led
@@ -24,55 +37,26 @@ uint32_t gerar_binario_cor(double red, double green, double blue)
 
 uint configurar_matriz(PIO pio)
 {
-    bool ok;
-
-    // Define o clock para 128 MHz, facilitando a divisão pelo clock
-    ok = set_sys_clock_khz(128000, false);
+    // O driver de fitas cuida da PIO, do DMA e do divisor de clock
+    if (!matriz.iniciar(pio))
+        panic("matriz: sem maquina de estado ou canal de DMA livre");
 
-    // Inicializa todos os códigos stdio padrão que estão ligados ao binário.
-    stdio_init_all();
-
-    printf("iniciando a transmissão PIO");
-    if (ok)
-        printf("clock set to %ld\n", clock_get_hz(clk_sys));
-
-    // configurações da PIO
-    uint offset = pio_add_program(pio, &pio_matrix_program);
-    uint sm = pio_claim_unused_sm(pio, true);
-    pio_matrix_program_init(pio, sm, offset, OUT_PIN);
-
-    return sm;
+    return matriz.sm();
 }
 
-void imprimir_desenho(Matriz_leds_config configuracao, PIO pio, uint sm)
+void imprimir_desenho(const Matriz_leds_config configuracao, PIO pio, uint sm)
 {
-    for (int contadorLinha = 4; contadorLinha >= 0; contadorLinha--)
-    {
-        if (contadorLinha % 2)
-        {
-            for (int contadorColuna = 0; contadorColuna < 5; contadorColuna++)
-            {
-                uint32_t valor_cor_binario = gerar_binario_cor(
-                    configuracao[contadorLinha][contadorColuna].red,
-                    configuracao[contadorLinha][contadorColuna].green,
-                    configuracao[contadorLinha][contadorColuna].blue);
-
-                pio_sm_put_blocking(pio, sm, valor_cor_binario);
-            }
-        }
-        else
-        {
-            for (int contadorColuna = 4; contadorColuna >= 0; contadorColuna--)
-            {
-                uint32_t valor_cor_binario = gerar_binario_cor(
-                    configuracao[contadorLinha][contadorColuna].red,
-                    configuracao[contadorLinha][contadorColuna].green,
-                    configuracao[contadorLinha][contadorColuna].blue);
-
-                pio_sm_put_blocking(pio, sm, valor_cor_binario);
-            }
-        }
-    }
+    if (!e_a_matriz(pio, sm))
+        return;
+
+    uint32_t quadro[Matriz::altura][Matriz::largura];
+    for (uint linha = 0; linha < Matriz::altura; linha++)
+        for (uint coluna = 0; coluna < Matriz::largura; coluna++)
+            quadro[linha][coluna] = gerar_binario_cor(configuracao[linha][coluna].red,
+                                                      configuracao[linha][coluna].green,
+                                                      configuracao[linha][coluna].blue);
+    matriz.desenhar(quadro);
+    matriz.atualizar();
 }
 
 RGB_cod obter_cor_por_parametro_RGB(int red, int green, int blue)
@@ -82,13 +66,15 @@ RGB_cod obter_cor_por_parametro_RGB(int red, int green, int blue)
     return cor_customizada;
 }
 
+// Os desenhos ficam em flash (static const): nada de 600 bytes na pilha por chamada
+#define red {20, 0, 0}
+#define blk {0, 0, 0}
+
 void actionMatriz(int key, PIO pio, uint sm)
 {
-    const RGB_cod red = {20, 0, 0};
-    const RGB_cod blk = {0, 0, 0};
     if (key == ' ')
     {
-        Matriz_leds_config frame = {
+        static const Matriz_leds_config frame = {
             {blk, blk, blk, blk, blk},
             {blk, blk, blk, blk, blk},
             {blk, blk, blk, blk, blk},
@@ -98,7 +84,7 @@ void actionMatriz(int key, PIO pio, uint sm)
     }
     else if (key == '1')
     {
-        Matriz_leds_config frame = {
+        static const Matriz_leds_config frame = {
             {blk, blk, red, blk, blk},
             {blk, red, red, blk, blk},
             {blk, blk, red, blk, blk},
@@ -108,7 +94,7 @@ void actionMatriz(int key, PIO pio, uint sm)
     }
     else if (key == '2')
     {
-        Matriz_leds_config frame = {
+        static const Matriz_leds_config frame = {
             {blk, red, red, red, blk},
             {blk, blk, blk, red, blk},
             {blk, red, red, blk, blk},
@@ -118,7 +104,7 @@ void actionMatriz(int key, PIO pio, uint sm)
     }
     else if (key == '3')
     {
-        Matriz_leds_config frame = {
+        static const Matriz_leds_config frame = {
             {blk, red, red, red, blk},
             {blk, blk, blk, red, blk},
             {blk, blk, red, red, blk},
@@ -128,7 +114,7 @@ void actionMatriz(int key, PIO pio, uint sm)
     }
     else if (key == '4')
     {
-        Matriz_leds_config frame = {
+        static const Matriz_leds_config frame = {
             {blk, red, blk, red, blk},
             {blk, red, blk, red, blk},
             {blk, red, red, red, blk},
@@ -138,7 +124,7 @@ void actionMatriz(int key, PIO pio, uint sm)
     }
     else if (key == '5')
     {
-        Matriz_leds_config frame = {
+        static const Matriz_leds_config frame = {
             {blk, red, red, red, blk},
             {blk, red, blk, blk, blk},
             {blk, red, red, red, blk},
@@ -148,7 +134,7 @@ void actionMatriz(int key, PIO pio, uint sm)
     }
     else if (key == '6')
     {
-        Matriz_leds_config frame = {
+        static const Matriz_leds_config frame = {
             {blk, red, red, red, blk},
             {blk, red, blk, blk, blk},
             {blk, red, red, red, blk},
@@ -158,7 +144,7 @@ void actionMatriz(int key, PIO pio, uint sm)
     }
     else if (key == '7')
     {
-        Matriz_leds_config frame = {
+        static const Matriz_leds_config frame = {
             {blk, red, red, red, blk},
             {blk, blk, blk, red, blk},
             {blk, blk, blk, red, blk},
@@ -168,7 +154,7 @@ void actionMatriz(int key, PIO pio, uint sm)
     }
     else if (key == '8')
     {
-        Matriz_leds_config frame = {
+        static const Matriz_leds_config frame = {
             {blk, red, red, red, blk},
             {blk, red, blk, red, blk},
             {blk, red, red, red, blk},
@@ -178,7 +164,7 @@ void actionMatriz(int key, PIO pio, uint sm)
     }
     else if (key == '9')
     {
-        Matriz_leds_config frame = {
+        static const Matriz_leds_config frame = {
             {blk, red, red, red, blk},
             {blk, red, blk, red, blk},
             {blk, red, red, red, blk},
@@ -188,7 +174,7 @@ void actionMatriz(int key, PIO pio, uint sm)
     }
     else if (key == '0')
     {
-        Matriz_leds_config frame = {
+        static const Matriz_leds_config frame = {
             {blk, red, red, red, blk},
             {blk, red, blk, red, blk},
             {blk, red, blk, red, blk},
@@ -198,32 +184,44 @@ void actionMatriz(int key, PIO pio, uint sm)
     }
 }
 
+#undef red
+#undef blk
+
 void clearMatriz(PIO pio, uint sm)
 {
-    Matriz_leds_config frame = {
-        {0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0},
-        {0, 0, 0, 0, 0}};
-    imprimir_desenho(frame, pio, sm);
+    if (!e_a_matriz(pio, sm))
+        return;
+
+    matriz.preencher(0);
+    matriz.atualizar();
 }
 
+// Cada linha acesa tem sua cor, do verde (topo) ao vermelho (base), nos
+// mesmos valores que gerar_binario_cor daria para {0, 0.4, 0} .. {0.1, 0, 0}
 void actionMatrizPattern(bool pattern[5][5], PIO pio, uint sm)
 {
-    const RGB_cod red = {0.1, 0, 0};
-    const RGB_cod orange = {0.2, 0.1, 0};
-    const RGB_cod yellow = {0.3, 0.2, 0};
-    const RGB_cod limon = {0.1, 0.3, 0};
-    const RGB_cod green = {0, 0.4, 0};
-    const RGB_cod blk = {0, 0, 0};
-
-    Matriz_leds_config frame = {
-        {pattern[0][0] ? green : blk, pattern[0][1] ? green : blk, pattern[0][2] ? green : blk, pattern[0][3] ? green : blk, pattern[0][4] ? green : blk},
-        {pattern[1][0] ? limon : blk, pattern[1][1] ? limon : blk, pattern[1][2] ? limon : blk, pattern[1][3] ? limon : blk, pattern[1][4] ? limon : blk},
-        {pattern[2][0] ? yellow : blk, pattern[2][1] ? yellow : blk, pattern[2][2] ? yellow : blk, pattern[2][3] ? yellow : blk, pattern[2][4] ? yellow : blk},
-        {pattern[3][0] ? orange : blk, pattern[3][1] ? orange : blk, pattern[3][2] ? orange : blk, pattern[3][3] ? orange : blk, pattern[3][4] ? orange : blk},
-        {pattern[4][0] ? red : blk, pattern[4][1] ? red : blk, pattern[4][2] ? red : blk, pattern[4][3] ? red : blk, pattern[4][4] ? red : blk}};
-
-    imprimir_desenho(frame, pio, sm);
-}
\ No newline at end of file
+    static constexpr uint32_t cores[Matriz::altura] = {
+        Matriz::grb(0, 102, 0),
+        Matriz::grb(25, 76, 0),
+        Matriz::grb(76, 51, 0),
+        Matriz::grb(51, 25, 0),
+        Matriz::grb(25, 0, 0)};
+
+    if (!e_a_matriz(pio, sm))
+        return;
+
+    matriz.padrao(pattern, cores);
+    matriz.atualizar();
+}
+
+void matriz_ler_rgb(uint8_t *rgb)
+{
+    for (uint y = 0; y < Matriz::altura; y++)
+        for (uint x = 0; x < Matriz::largura; x++, rgb += 3)
+        {
+            uint32_t grb = matriz.cor(x, y);
+            rgb[0] = grb >> 16;
+            rgb[1] = grb >> 24;
+            rgb[2] = grb >> 8;
+        }
+}
@@ -15,8 +15,12 @@ uint32_t gerar_binario_cor(double red, double green, double blue);
 
 uint configurar_matriz(PIO pio);
 
-void imprimir_desenho(Matriz_leds_config configuracao, PIO pio, uint sm);
+void imprimir_desenho(const Matriz_leds_config configuracao, PIO pio, uint sm);
 void clearMatriz(PIO pio, uint sm);
 void actionMatrizPattern(bool pattern[5][5], PIO pio, uint sm);
+void actionMatriz(int key, PIO pio, uint sm);
+
+// Quadro atual da matriz em RGB (3 bytes por LED), linha a linha de cima para baixo
+void matriz_ler_rgb(uint8_t *rgb);
 
 RGB_cod obter_cor_por_parametro_RGB(int red, int green, int blue);
\ No newline at end of file
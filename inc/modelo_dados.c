@@ -0,0 +1,49 @@
+// Gerado por host/classificador (beesense_modelo treinar) -- não edite à mão.
+
+#include "classificador.h"
+
+const uint8_t modelo_colonia[] __attribute__((aligned(4))) = {
+    0x42, 0x53, 0x4D, 0x4C, 0x01, 0x00, 0x08, 0x05, 0x03, 0x00, 0x00, 0x00, 0x84, 0x02, 0x00, 0x00,
+    0xB7, 0xF0, 0x6D, 0xC7, 0x84, 0xEC, 0x21, 0x00, 0xCF, 0x0C, 0x3D, 0x00, 0xF0, 0x87, 0xFF, 0xFF,
+    0x58, 0xFD, 0x02, 0x00, 0x2D, 0xD1, 0x2F, 0x00, 0xCE, 0x99, 0x00, 0x00, 0x13, 0x01, 0xFF, 0xFF,
+    0x6B, 0x1C, 0x01, 0x00, 0xCF, 0x18, 0x10, 0x00, 0xCF, 0xBB, 0x04, 0x00, 0xAE, 0x17, 0x30, 0x00,
+    0xB8, 0xDD, 0x10, 0x00, 0x2C, 0x71, 0x01, 0x00, 0x94, 0xD7, 0x1A, 0x00, 0xFB, 0x6E, 0x15, 0x00,
+    0xB0, 0xB2, 0x14, 0x00, 0x00, 0x01, 0x01, 0x01, 0x08, 0x00, 0x10, 0x00, 0x01, 0x00, 0x25, 0x00,
+    0xB5, 0xEB, 0x1E, 0x42, 0xBA, 0xFB, 0xFF, 0xFF, 0xD4, 0xFD, 0xFF, 0xFF, 0xBC, 0x00, 0x00, 0x00,
+    0xE2, 0xFE, 0xFF, 0xFF, 0x00, 0xF7, 0xFF, 0xFF, 0x05, 0xF9, 0xFF, 0xFF, 0x33, 0x01, 0x00, 0x00,
+    0xE0, 0x01, 0x00, 0x00, 0xC4, 0xFA, 0xFF, 0xFF, 0xC5, 0xFA, 0xFF, 0xFF, 0x28, 0xFA, 0xFF, 0xFF,
+    0x48, 0xFE, 0xFF, 0xFF, 0x5F, 0xFC, 0xFF, 0xFF, 0xCE, 0xFC, 0xFF, 0xFF, 0x6F, 0xFE, 0xFF, 0xFF,
+    0xF7, 0xF4, 0xFF, 0xFF, 0xF8, 0x0E, 0x00, 0xF0, 0xED, 0x2D, 0x0C, 0xF9, 0x11, 0xFA, 0xCC, 0xEC,
+    0xE1, 0xF5, 0xF9, 0xF1, 0xCA, 0xED, 0x10, 0x18, 0x1E, 0x08, 0xFC, 0x14, 0xAA, 0x09, 0xED, 0x00,
+    0xDD, 0xFE, 0xFF, 0x07, 0x08, 0x14, 0xD0, 0xF2, 0xC4, 0xE6, 0xFF, 0xE9, 0x0B, 0x04, 0xCE, 0xEF,
+    0x0A, 0x0F, 0xE7, 0x11, 0xEC, 0x0C, 0x25, 0x13, 0x23, 0x1E, 0x12, 0x26, 0xF6, 0xFA, 0xCF, 0x13,
+    0x29, 0x05, 0xDD, 0x09, 0x35, 0xF5, 0xE9, 0x00, 0x0A, 0x24, 0x0C, 0x07, 0xF8, 0xFF, 0x3E, 0xFB,
+    0xD6, 0xFB, 0x0A, 0xFA, 0x0C, 0x00, 0x7F, 0xF9, 0x29, 0x07, 0xFD, 0x06, 0xFD, 0x05, 0x0E, 0x1F,
+    0x23, 0x02, 0x06, 0xDD, 0x0C, 0x0A, 0x05, 0xF9, 0x0B, 0x14, 0xFF, 0xF1, 0xDB, 0xF3, 0xCD, 0xEA,
+    0xE7, 0x0A, 0xFC, 0xDD, 0x06, 0x09, 0x0D, 0x58, 0xE3, 0xED, 0x02, 0x00, 0x28, 0xFC, 0xD9, 0xF3,
+    0x3C, 0x02, 0xDD, 0x16, 0x00, 0x01, 0x01, 0x01, 0x10, 0x00, 0x0C, 0x00, 0x01, 0x00, 0x24, 0x00,
+    0xD8, 0xEC, 0xEF, 0x54, 0xE8, 0xFF, 0xFF, 0xFF, 0x21, 0xFF, 0xFF, 0xFF, 0x70, 0x00, 0x00, 0x00,
+    0x07, 0x00, 0x00, 0x00, 0x16, 0x02, 0x00, 0x00, 0xAC, 0x00, 0x00, 0x00, 0x72, 0x01, 0x00, 0x00,
+    0xA8, 0x00, 0x00, 0x00, 0x80, 0xFF, 0xFF, 0xFF, 0x24, 0x00, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x00,
+    0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x14, 0xE7, 0x01, 0xFB, 0xEE, 0xFD, 0xE5, 0x0A, 0xD6, 0x19, 0xF3,
+    0x0F, 0xFA, 0x09, 0xF5, 0xE0, 0xF7, 0xFD, 0xED, 0xE5, 0x41, 0xED, 0xEC, 0xF9, 0xF7, 0x43, 0xE8,
+    0xF6, 0xD0, 0x05, 0x24, 0xCF, 0xDB, 0xD9, 0xD5, 0xE8, 0xEA, 0x01, 0xCD, 0xEF, 0x12, 0x3A, 0x0C,
+    0xE5, 0xD3, 0x02, 0xF8, 0x26, 0xFF, 0xF1, 0xEB, 0xF1, 0x03, 0xF7, 0xE3, 0xF2, 0xF5, 0xF2, 0xF8,
+    0xFE, 0xF8, 0xE2, 0xEF, 0xF9, 0xF9, 0x06, 0xF4, 0xE8, 0xEF, 0x17, 0x81, 0x05, 0xEB, 0xEF, 0x16,
+    0x08, 0xF8, 0x1D, 0xF0, 0x1B, 0xFF, 0x21, 0x0A, 0xEC, 0xE9, 0x1F, 0xC0, 0x2C, 0xC5, 0x17, 0x2F,
+    0x0B, 0x06, 0xB6, 0xF7, 0xF7, 0x1B, 0xFE, 0x02, 0xE8, 0xD5, 0xF7, 0x14, 0xF3, 0xCB, 0x05, 0x0A,
+    0xFA, 0x0A, 0x26, 0xE3, 0xF6, 0xFE, 0xD2, 0xFC, 0xFD, 0xFA, 0xC0, 0xD8, 0xC8, 0x07, 0xFE, 0x19,
+    0xED, 0x06, 0x13, 0xE2, 0x1E, 0x13, 0xDD, 0x26, 0x05, 0xF0, 0xF3, 0xEE, 0x00, 0xFC, 0xC6, 0xFE,
+    0x22, 0x19, 0xFC, 0xE8, 0xF5, 0x05, 0x21, 0xEB, 0xF2, 0xE7, 0xCF, 0xF6, 0xF1, 0xD6, 0xF5, 0x21,
+    0x00, 0xFF, 0x17, 0xCB, 0xEE, 0xFE, 0xF3, 0x12, 0xE9, 0x16, 0x0B, 0x12, 0xC6, 0xAB, 0xF8, 0xFA,
+    0x09, 0xDA, 0x12, 0xC3, 0xF2, 0x13, 0xE6, 0x01, 0x00, 0x09, 0x21, 0x05, 0x14, 0xEA, 0x04, 0xE2,
+    0x06, 0xFB, 0xD4, 0x1C, 0x00, 0x00, 0x01, 0x01, 0x0C, 0x00, 0x05, 0x00, 0x01, 0x00, 0x25, 0x00,
+    0x74, 0x0F, 0x0D, 0x56, 0xA3, 0x00, 0x00, 0x00, 0x4C, 0x01, 0x00, 0x00, 0x32, 0xFF, 0xFF, 0xFF,
+    0x4B, 0xFF, 0xFF, 0xFF, 0x94, 0xFF, 0xFF, 0xFF, 0xE2, 0xFD, 0x2B, 0x1B, 0x1B, 0x07, 0xEE, 0x7F,
+    0x03, 0xE7, 0xB3, 0xC7, 0x0A, 0xBE, 0x0C, 0x02, 0xF6, 0xFF, 0xA3, 0x7A, 0x2C, 0x0B, 0xED, 0xD4,
+    0x1D, 0x0D, 0xFA, 0xDD, 0x32, 0x29, 0x0A, 0xA5, 0x13, 0xE7, 0x29, 0x0A, 0xF9, 0x1C, 0xFC, 0xF6,
+    0xD3, 0xF4, 0x43, 0xC7, 0xCD, 0xEB, 0x13, 0x52, 0xF2, 0x05, 0xE7, 0xEB, 0xEE, 0xCD, 0x43, 0xC5,
+    0xE3, 0x37, 0x38, 0x35,
+};
+
+const size_t modelo_colonia_bytes = sizeof(modelo_colonia);
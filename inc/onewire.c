@@ -0,0 +1,274 @@
+#include "onewire.h"
+#include "relogio.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+
+// Arquivo .pio do barramento
+#include "onewire.pio.h"
+
+#define ONEWIRE_CMD_BUSCA 0xF0
+#define ONEWIRE_FIFO 4
+
+typedef enum
+{
+    FASE_OCIOSA,
+    FASE_RESET,  // aguardando o bit de presença
+    FASE_BYTES,  // troca de bytes da transação
+    FASE_BUSCA_LER, // busca: dois slots de leitura (bit e complemento)
+    FASE_BUSCA_ESCREVER // busca: slot com a direção escolhida
+} onewire_fase_t;
+
+static PIO pio_ow;
+static uint sm_ow;
+static uint offset_ow;
+
+static volatile onewire_fase_t fase = FASE_OCIOSA;
+static onewire_fim_t callback_fim;
+static void *contexto_fim;
+
+// Transação em bytes
+static const uint8_t *tx_bytes;
+static uint8_t *rx_bytes;
+static uint total, enviados, recebidos;
+static bool busca;
+
+// Estado da busca (algoritmo da nota de aplicação 187 da Maxim)
+static uint8_t *rom_busca;
+static uint8_t rom_atual[8];
+static int ultimo_desvio = -1;
+static bool ultimo_dispositivo = false;
+static int desvio_zero;
+static uint bit_busca;
+static uint lidos_busca;
+static uint32_t bits_lidos;
+static const uint8_t cmd_busca = ONEWIRE_CMD_BUSCA;
+
+static void retemporizar_onewire(relogio_fase_t f, uint32_t sys_hz, void *contexto)
+{
+    if (f == RELOGIO_ANTES)
+    {
+        // Um slot esticado no meio da troca seria lido errado
+        while (onewire_ocupado())
+            tight_loop_contents();
+        return;
+    }
+    pio_sm_set_clkdiv(pio_ow, sm_ow, sys_hz / 1000000.0f);
+}
+
+// Reinicia a máquina de estado num ponto do programa com outro tamanho de palavra
+static void onewire_reiniciar(uint bits, uint destino)
+{
+    pio_sm_set_enabled(pio_ow, sm_ow, false);
+    onewire_program_set_bits(pio_ow, sm_ow, bits);
+    pio_sm_clear_fifos(pio_ow, sm_ow);
+    pio_sm_restart(pio_ow, sm_ow);
+    pio_sm_exec(pio_ow, sm_ow, pio_encode_jmp(offset_ow + destino));
+    pio_sm_set_enabled(pio_ow, sm_ow, true);
+}
+
+static void onewire_terminar(onewire_status_t status)
+{
+    fase = FASE_OCIOSA;
+    if (callback_fim)
+        callback_fim(status, contexto_fim);
+}
+
+static void onewire_enviar_bytes(void)
+{
+    while (enviados < total && enviados - recebidos < ONEWIRE_FIFO)
+        pio_sm_put(pio_ow, sm_ow, tx_bytes[enviados++]);
+}
+
+static void onewire_busca_proximo_bit(void)
+{
+    lidos_busca = 0;
+    bits_lidos = 0;
+    fase = FASE_BUSCA_LER;
+    pio_sm_put(pio_ow, sm_ow, 1);
+    pio_sm_put(pio_ow, sm_ow, 1);
+}
+
+static void onewire_busca_concluir(void)
+{
+    if (onewire_crc8(rom_atual, 8) != 0)
+    {
+        ultimo_desvio = -1;
+        onewire_terminar(ONEWIRE_ERRO_CRC);
+        return;
+    }
+    ultimo_desvio = desvio_zero;
+    ultimo_dispositivo = desvio_zero < 0;
+    for (uint i = 0; i < 8; i++)
+        rom_busca[i] = rom_atual[i];
+    onewire_terminar(ONEWIRE_OK);
+}
+
+// Um resultado da PIO (presença, byte ou bit) avança a operação
+static void onewire_resultado(uint32_t palavra)
+{
+    switch (fase)
+    {
+    case FASE_RESET:
+        if (palavra & 1)
+        {
+            onewire_terminar(ONEWIRE_SEM_PRESENCA);
+            break;
+        }
+        fase = FASE_BYTES;
+        onewire_enviar_bytes();
+        break;
+
+    case FASE_BYTES:
+        if (rx_bytes)
+            rx_bytes[recebidos] = palavra >> 24;
+        recebidos++;
+        if (recebidos < total)
+        {
+            onewire_enviar_bytes();
+        }
+        else if (busca)
+        {
+            // Comando de busca enviado: passa a trocar bits
+            onewire_reiniciar(1, onewire_offset_bit);
+            bit_busca = 0;
+            desvio_zero = -1;
+            onewire_busca_proximo_bit();
+        }
+        else
+        {
+            onewire_terminar(ONEWIRE_OK);
+        }
+        break;
+
+    case FASE_BUSCA_LER:
+        bits_lidos |= (palavra >> 31) << lidos_busca;
+        if (++lidos_busca < 2)
+            break;
+        {
+            uint bit = bits_lidos & 1, complemento = (bits_lidos >> 1) & 1;
+            uint direcao;
+            if (bit && complemento)
+            {
+                // Ninguém respondeu no meio da busca
+                ultimo_desvio = -1;
+                onewire_terminar(ONEWIRE_SEM_PRESENCA);
+                break;
+            }
+            if (bit != complemento)
+                direcao = bit;
+            else if ((int)bit_busca < ultimo_desvio)
+                direcao = (rom_atual[bit_busca / 8] >> (bit_busca % 8)) & 1;
+            else
+                direcao = (int)bit_busca == ultimo_desvio;
+            if (bit == complemento && direcao == 0)
+                desvio_zero = bit_busca;
+
+            if (direcao)
+                rom_atual[bit_busca / 8] |= 1u << (bit_busca % 8);
+            else
+                rom_atual[bit_busca / 8] &= ~(1u << (bit_busca % 8));
+            fase = FASE_BUSCA_ESCREVER;
+            pio_sm_put(pio_ow, sm_ow, direcao);
+        }
+        break;
+
+    case FASE_BUSCA_ESCREVER:
+        if (++bit_busca < 64)
+            onewire_busca_proximo_bit();
+        else
+            onewire_busca_concluir();
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void onewire_irq(void)
+{
+    while (!pio_sm_is_rx_fifo_empty(pio_ow, sm_ow))
+        onewire_resultado(pio_sm_get(pio_ow, sm_ow));
+}
+
+bool onewire_init(PIO pio, uint pino)
+{
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0)
+        return false;
+    pio_ow = pio;
+    sm_ow = sm;
+    offset_ow = pio_add_program(pio, &onewire_program);
+    onewire_program_init(pio, sm, offset_ow, pino, 8);
+
+    // IRQ 1 do bloco PIO, compartilhável com outros drivers
+    uint irq = pio_get_index(pio) ? PIO1_IRQ_1 : PIO0_IRQ_1;
+    pio_set_irqn_source_enabled(pio, 1, pis_sm0_rx_fifo_not_empty + sm, true);
+    irq_add_shared_handler(irq, onewire_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(irq, true);
+
+    relogio_registrar(retemporizar_onewire, NULL);
+    return true;
+}
+
+bool onewire_ocupado(void)
+{
+    return fase != FASE_OCIOSA;
+}
+
+static bool onewire_comecar(const uint8_t *tx, uint8_t *rx, uint n, bool eh_busca, onewire_fim_t fim, void *contexto)
+{
+    if (onewire_ocupado() || n > ONEWIRE_TRANSACAO_MAX)
+        return false;
+    tx_bytes = tx;
+    rx_bytes = rx;
+    total = n;
+    enviados = recebidos = 0;
+    busca = eh_busca;
+    callback_fim = fim;
+    contexto_fim = contexto;
+
+    fase = FASE_RESET;
+    onewire_reiniciar(8, onewire_offset_reset);
+    return true;
+}
+
+bool onewire_transacao(const uint8_t *tx, uint8_t *rx, uint n, onewire_fim_t fim, void *contexto)
+{
+    return onewire_comecar(tx, rx, n, false, fim, contexto);
+}
+
+bool onewire_buscar(bool reiniciar, uint8_t rom[8], onewire_fim_t fim, void *contexto)
+{
+    if (reiniciar)
+    {
+        ultimo_desvio = -1;
+        ultimo_dispositivo = false;
+    }
+    if (ultimo_dispositivo)
+    {
+        // Todos já foram encontrados: termina sem tocar no barramento
+        if (fim)
+            fim(ONEWIRE_FIM_BUSCA, contexto);
+        return true;
+    }
+    rom_busca = rom;
+    return onewire_comecar(&cmd_busca, NULL, 1, true, fim, contexto);
+}
+
+uint8_t onewire_crc8(const uint8_t *dados, uint n)
+{
+    uint8_t crc = 0;
+    while (n--)
+    {
+        uint8_t byte = *dados++;
+        for (int i = 0; i < 8; i++)
+        {
+            uint8_t misturado = (crc ^ byte) & 1;
+            crc >>= 1;
+            if (misturado)
+                crc ^= 0x8C;
+            byte >>= 1;
+        }
+    }
+    return crc;
+}
@@ -0,0 +1,39 @@
+#ifndef ONEWIRE_H
+#define ONEWIRE_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Barramento 1-Wire numa máquina de estado da PIO, dirigido por interrupção.
+// A PIO gera os slots de tempo; a IRQ de FIFO RX não vazio recolhe cada byte
+// (ou bit, na busca de ROM) e alimenta o próximo. Cada operação começa com um
+// reset e termina chamando o callback de fim, ainda no contexto da IRQ.
+
+#define ONEWIRE_TRANSACAO_MAX 24 // bytes por transação
+
+typedef enum
+{
+    ONEWIRE_OK,
+    ONEWIRE_SEM_PRESENCA, // nenhum dispositivo respondeu ao reset
+    ONEWIRE_FIM_BUSCA,    // a busca não tem mais dispositivos
+    ONEWIRE_ERRO_CRC
+} onewire_status_t;
+
+typedef void (*onewire_fim_t)(onewire_status_t status, void *contexto);
+
+bool onewire_init(PIO pio, uint pino);
+
+bool onewire_ocupado(void);
+
+// Reset seguido da troca de n bytes: tx é enviado e a resposta de cada slot
+// vai para rx (envie 0xFF nas posições a ler). Os buffers devem viver até o fim.
+bool onewire_transacao(const uint8_t *tx, uint8_t *rx, uint n, onewire_fim_t fim, void *contexto);
+
+// Busca de ROM (Search ROM 0xF0): cada chamada acha o próximo dispositivo e
+// grava seu código em rom[8]. reiniciar = true começa do primeiro.
+bool onewire_buscar(bool reiniciar, uint8_t rom[8], onewire_fim_t fim, void *contexto);
+
+// CRC-8 Dallas/Maxim (x^8 + x^5 + x^4 + 1) usado na ROM e no scratchpad
+uint8_t onewire_crc8(const uint8_t *dados, uint n);
+
+#endif
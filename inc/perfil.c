@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "hardware/sync.h"
+#include "perfil.h"
+#include "sram.h"
+
+#if BEESENSE_PERFIL
+
+// SysTick de 24 bits contando para baixo no clk_sys
+#define SYSTICK_MASCARA 0xFFFFFFu
+
+typedef struct
+{
+    uint32_t chamadas;
+    uint64_t ciclos;
+    uint32_t ciclos_max;
+    uint32_t us_max;
+    uint64_t acessos;
+    uint64_t acertos;
+} perfil_t;
+
+static perfil_t perfis[NUM_PERFIS];
+
+static const char *const nomes[NUM_PERFIS] = {"amostra", "render", "envio", "isr_gpio", "isr_i2c"};
+
+void perfil_init(void)
+{
+    systick_hw->csr = 0;
+    systick_hw->rvr = SYSTICK_MASCARA;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // habilitado, clock do processador, sem interrupção
+    perfil_zerar();
+}
+
+perfil_marca_t NA_RAM(perfil_inicio)(void)
+{
+    return (perfil_marca_t){
+        .us = time_us_32(),
+        .ciclos = systick_hw->cvr,
+        .acessos = xip_ctrl_hw->ctr_acc,
+        .acertos = xip_ctrl_hw->ctr_hit,
+    };
+}
+
+void NA_RAM(perfil_fim)(perfil_etapa_t etapa, perfil_marca_t inicio)
+{
+    uint32_t ciclos = (inicio.ciclos - systick_hw->cvr) & SYSTICK_MASCARA;
+    uint32_t us = time_us_32() - inicio.us;
+    // Etapa longa: o SysTick pode ter dado a volta sem aviso
+    if (us >= PERFIL_US_SYSTICK)
+        ciclos = us * (clock_get_hz(clk_sys) / 1000000);
+    uint32_t acessos = xip_ctrl_hw->ctr_acc - inicio.acessos;
+    uint32_t acertos = xip_ctrl_hw->ctr_hit - inicio.acertos;
+
+    // Etapas da tarefa e das interrupções são distintas; a seção crítica só
+    // protege o relatório lido no meio de uma atualização
+    uint32_t irq = save_and_disable_interrupts();
+    perfil_t *p = &perfis[etapa];
+    p->chamadas++;
+    p->ciclos += ciclos;
+    if (ciclos > p->ciclos_max)
+        p->ciclos_max = ciclos;
+    if (us > p->us_max)
+        p->us_max = us;
+    p->acessos += acessos;
+    p->acertos += acertos;
+    restore_interrupts(irq);
+}
+
+void perfil_zerar(void)
+{
+    uint32_t irq = save_and_disable_interrupts();
+    memset(perfis, 0, sizeof(perfis));
+    restore_interrupts(irq);
+}
+
+void perfil_relatorio(void)
+{
+    perfil_t copia[NUM_PERFIS];
+    uint32_t irq = save_and_disable_interrupts();
+    memcpy(copia, perfis, sizeof(copia));
+    restore_interrupts(irq);
+
+    printf("{ \"sram\": %s", BEESENSE_TUDO_NA_FLASH ? "false" : "true");
+    for (int i = 0; i < NUM_PERFIS; i++)
+    {
+        const perfil_t *p = &copia[i];
+        printf(", \"%s\": { \"n\": %lu, \"ciclos_med\": %lu, \"ciclos_max\": %lu, \"us_max\": %lu, \"xip_acessos\": %llu, \"xip_faltas\": %llu }",
+               nomes[i], (unsigned long)p->chamadas,
+               (unsigned long)(p->chamadas ? p->ciclos / p->chamadas : 0), (unsigned long)p->ciclos_max,
+               (unsigned long)p->us_max,
+               (unsigned long long)p->acessos, (unsigned long long)(p->acessos - p->acertos));
+    }
+    printf(" }\n");
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef PERFIL_H
+#define PERFIL_H
+
+#include <stdint.h>
+
+// Build de perfil (BEESENSE_PERFIL): por etapa, ciclos pelo SysTick e acessos
+// e acertos do cache XIP pelos contadores do RP2040. O SysTick tem 24 bits e
+// dá a volta em 131 ms a 128 MHz: etapas mais longas que PERFIL_US_SYSTICK
+// contam os ciclos pelo timer de microssegundos. Os contadores são
+// globais: uma interrupção no meio de uma etapa entra na conta dela. Fora do
+// build de perfil as marcas somem.
+
+typedef enum
+{
+    PERFIL_AMOSTRA,  // leitura dos sensores até os detectores
+    PERFIL_RENDER,   // desenho do quadro no framebuffer
+    PERFIL_ENVIO,    // enfileiramento do quadro no barramento
+    PERFIL_ISR_GPIO, // callback dos botões
+    PERFIL_ISR_I2C,  // interrupção do barramento I2C
+    NUM_PERFIS
+} perfil_etapa_t;
+
+#define PERFIL_US_SYSTICK 100000 // abaixo da volta do SysTick em qualquer clock até 133 MHz
+
+typedef struct
+{
+    uint32_t us;
+    uint32_t ciclos;
+    uint32_t acessos;
+    uint32_t acertos;
+} perfil_marca_t;
+
+#if BEESENSE_PERFIL
+
+void perfil_init(void);
+perfil_marca_t perfil_inicio(void);
+void perfil_fim(perfil_etapa_t etapa, perfil_marca_t inicio);
+
+// Uma linha JSON com as etapas; zerar recomeça a contagem
+void perfil_relatorio(void);
+void perfil_zerar(void);
+
+#define PERFIL_INICIO(marca) perfil_marca_t marca = perfil_inicio()
+#define PERFIL_FIM(etapa, marca) perfil_fim(etapa, marca)
+
+#else
+
+#define PERFIL_INICIO(marca)
+#define PERFIL_FIM(etapa, marca)
+
+#endif
+
+#endif
@@ -0,0 +1,147 @@
+#include <string.h>
+#include "persistencia.h"
+#include "crc32.h"
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+
+#define PERSISTENCIA_MAGICA 0x53454542 // "BEES"
+#define PERSISTENCIA_PAGINAS (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+#define PERSISTENCIA_TIMEOUT_MS 100
+
+typedef struct
+{
+    uint32_t magica;
+    uint32_t sequencia;
+    uint16_t tamanho;
+    uint16_t registro;
+    uint32_t crc; // dos dados
+    uint8_t dados[PERSISTENCIA_TAMANHO_MAX];
+} persistencia_pagina_t;
+
+_Static_assert(sizeof(persistencia_pagina_t) == FLASH_PAGE_SIZE, "registro deve ocupar uma pagina");
+
+// Dois setores por registro, usados em anel: o primeiro é o de sempre (fim da
+// flash, um por registro) e o segundo fica logo abaixo do bloco dos primeiros.
+// Só se apaga o setor para onde a gravação está passando; a cópia mais recente
+// continua no outro, então faltar energia no meio do apagamento não perde nada.
+static uint32_t persistencia_offset(persistencia_registro_t registro, uint setor)
+{
+    return PICO_FLASH_SIZE_BYTES - (setor * PERSISTENCIA_NUM_REGISTROS + registro + 1) * FLASH_SECTOR_SIZE;
+}
+
+// Página i de 0 a 2 * PERSISTENCIA_PAGINAS - 1, setor a setor
+static uint32_t persistencia_offset_pagina(persistencia_registro_t registro, uint i)
+{
+    return persistencia_offset(registro, i / PERSISTENCIA_PAGINAS) + (i % PERSISTENCIA_PAGINAS) * FLASH_PAGE_SIZE;
+}
+
+static const persistencia_pagina_t *persistencia_pagina(persistencia_registro_t registro, uint i)
+{
+    return (const persistencia_pagina_t *)(XIP_BASE + persistencia_offset_pagina(registro, i));
+}
+
+static bool pagina_valida(const persistencia_pagina_t *p, persistencia_registro_t registro)
+{
+    return p->magica == PERSISTENCIA_MAGICA && p->registro == registro &&
+           p->tamanho <= PERSISTENCIA_TAMANHO_MAX && crc32_calcular(p->dados, p->tamanho) == p->crc;
+}
+
+static bool pagina_apagada(persistencia_registro_t registro, uint i)
+{
+    return persistencia_pagina(registro, i)->magica == 0xFFFFFFFF;
+}
+
+// Página válida mais recente nos dois setores (-1 se nenhuma)
+static int persistencia_recente(persistencia_registro_t registro)
+{
+    uint32_t maior = 0;
+    int recente = -1;
+    for (uint i = 0; i < 2 * PERSISTENCIA_PAGINAS; i++)
+    {
+        const persistencia_pagina_t *p = persistencia_pagina(registro, i);
+        if (pagina_valida(p, registro) && (recente < 0 || p->sequencia > maior))
+        {
+            maior = p->sequencia;
+            recente = i;
+        }
+    }
+    return recente;
+}
+
+// Próxima página: a primeira apagada depois da mais recente, no mesmo setor.
+// Setor esgotado: a primeira página do outro, que precisa ser apagado antes
+static uint persistencia_destino(persistencia_registro_t registro, int recente, bool *apagar)
+{
+    uint setor = recente < 0 ? 0 : (uint)recente / PERSISTENCIA_PAGINAS;
+    uint primeira = recente < 0 ? 0 : (uint)recente + 1;
+    for (uint i = primeira; i < (setor + 1) * PERSISTENCIA_PAGINAS; i++)
+        if (pagina_apagada(registro, i))
+        {
+            *apagar = false;
+            return i;
+        }
+
+    uint outro = (1 - setor) * PERSISTENCIA_PAGINAS;
+    *apagar = !pagina_apagada(registro, outro);
+    return outro;
+}
+
+bool persistencia_ler(persistencia_registro_t registro, void *dados, size_t tamanho)
+{
+    int recente = persistencia_recente(registro);
+    if (recente < 0)
+        return false;
+
+    const persistencia_pagina_t *p = persistencia_pagina(registro, recente);
+    if (p->tamanho != tamanho)
+        return false;
+    memcpy(dados, p->dados, tamanho);
+    return true;
+}
+
+typedef struct
+{
+    uint32_t offset;
+    bool apagar;
+    const persistencia_pagina_t *pagina;
+} persistencia_operacao_t;
+
+// Roda com as IRQs desligadas e o XIP fora do ar (flash_safe_execute)
+static void persistencia_flash(void *parametro)
+{
+    const persistencia_operacao_t *op = parametro;
+    if (op->apagar)
+        flash_range_erase(op->offset & ~(FLASH_SECTOR_SIZE - 1), FLASH_SECTOR_SIZE);
+    flash_range_program(op->offset, (const uint8_t *)op->pagina, FLASH_PAGE_SIZE);
+}
+
+bool persistencia_gravar(persistencia_registro_t registro, const void *dados, size_t tamanho)
+{
+    if (tamanho > PERSISTENCIA_TAMANHO_MAX || registro >= PERSISTENCIA_NUM_REGISTROS)
+        return false;
+
+    int recente = persistencia_recente(registro);
+    bool apagar;
+    uint destino = persistencia_destino(registro, recente, &apagar);
+
+    static persistencia_pagina_t pagina;
+    memset(&pagina, 0xFF, sizeof(pagina));
+    pagina.magica = PERSISTENCIA_MAGICA;
+    pagina.sequencia = recente < 0 ? 0 : persistencia_pagina(registro, recente)->sequencia + 1;
+    pagina.tamanho = tamanho;
+    pagina.registro = registro;
+    memcpy(pagina.dados, dados, tamanho);
+    pagina.crc = crc32_calcular(pagina.dados, tamanho);
+
+    persistencia_operacao_t op = {
+        .offset = persistencia_offset_pagina(registro, destino),
+        .apagar = apagar,
+        .pagina = &pagina,
+    };
+    if (flash_safe_execute(persistencia_flash, &op, PERSISTENCIA_TIMEOUT_MS) != PICO_OK)
+        return false;
+
+    // Confere a gravação lendo de volta pelo XIP
+    return memcmp(persistencia_pagina(registro, destino), &pagina, FLASH_PAGE_SIZE) == 0;
+}
@@ -0,0 +1,32 @@
+#ifndef PERSISTENCIA_H
+#define PERSISTENCIA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Registros persistentes nos últimos setores da flash, dois setores por
+// registro. Cada gravação ocupa a próxima página livre (com número de sequência
+// e CRC-32); quando as 16 páginas de um setor se esgotam, a gravação passa
+// para o outro, que só então é apagado. A cópia mais recente nunca está no
+// setor que se apaga, então uma queda de energia não perde o registro. A
+// leitura devolve a página válida mais recente dos dois setores.
+
+typedef enum
+{
+    PERSISTENCIA_BALANCA,
+    PERSISTENCIA_CONFIGURACAO,
+    PERSISTENCIA_CALIBRACAO,
+    PERSISTENCIA_CAMPO,
+    PERSISTENCIA_NUM_REGISTROS
+} persistencia_registro_t;
+
+#define PERSISTENCIA_TAMANHO_MAX 240 // dados por registro (uma página menos o cabeçalho)
+
+// Copia o registro para dados; false se não houver gravação válida do mesmo tamanho
+bool persistencia_ler(persistencia_registro_t registro, void *dados, size_t tamanho);
+
+// Grava o registro (bloqueia por alguns ms quando precisa apagar o setor)
+bool persistencia_gravar(persistencia_registro_t registro, const void *dados, size_t tamanho);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef PLACA_H
+#define PLACA_H
+
+// Mapa da BitDogLab para o display e a matriz de LEDs, num lugar só: o
+// firmware em C usa as macros e os drivers em C++ (inc/ssd1306.hpp,
+// inc/ws2812.hpp) as recebem como parâmetros de template, então a geometria
+// vira constante de compilação.
+
+// Display SSD1306 no i2c1
+#define PLACA_I2C 1
+#define I2C_PORT I2C_INSTANCE(PLACA_I2C)
+#define SDA_PIN 14
+#define SCL_PIN 15
+#define SSD1306_ADDR 0x3C
+#define LCD_WIDTH 128
+#define LCD_HEIGHT 64
+
+// Matriz WS2812 5x5 em serpentina
+#define MATRIX_PIN 7
+#define MATRIX_WIDTH 5
+#define MATRIX_HEIGHT 5
+#define MATRIX_SERPENTINA 1
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef PONTO_FIXO_H
+#define PONTO_FIXO_H
+
+#include <stdint.h>
+
+// Ponto fixo Q16.16: 16 bits de parte inteira (com sinal) e 16 bits fracionários.
+// O RP2040 (Cortex-M0+) não tem FPU, então o processamento contínuo das amostras
+// é feito inteiramente em inteiros.
+typedef int32_t q16_t;
+
+#define Q16_UM (1 << 16)
+
+// Conversão de constantes e leituras em float (apenas na borda do sistema)
+#define Q16(x) ((q16_t)((x) * 65536.0f))
+
+static inline float q16_para_float(q16_t v)
+{
+    return v / 65536.0f;
+}
+
+static inline q16_t q16_mul(q16_t a, q16_t b)
+{
+    return (q16_t)(((int64_t)a * b) >> 16);
+}
+
+static inline q16_t q16_div(q16_t a, q16_t b)
+{
+    return (q16_t)(((int64_t)a * Q16_UM) / b);
+}
+
+static inline q16_t q16_abs(q16_t v)
+{
+    return v < 0 ? -v : v;
+}
+
+// Raiz quadrada inteira (método bit a bit, sem divisões)
+static inline uint32_t raiz_inteira(uint64_t v)
+{
+    uint64_t resultado = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > v)
+        bit >>= 2;
+
+    while (bit)
+    {
+        if (v >= resultado + bit)
+        {
+            v -= resultado + bit;
+            resultado = (resultado >> 1) + bit;
+        }
+        else
+        {
+            resultado >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)resultado;
+}
+
+#endif
@@ -0,0 +1,44 @@
+#include "pontuacao.h"
+#include <math.h>
+
+// Sensibilidade por canal: {alfa_shift, z, cusum_k, cusum_h, desvio_min, aquecimento}
+const anomalia_config_t anomalia_config[NUM_CANAIS] = {
+    {6, Q16(3.0f), Q16(0.5f), Q16(8.0f), Q16(0.2f), 50}, // Temperatura
+    {5, Q16(3.0f), Q16(0.5f), Q16(8.0f), Q16(1.0f), 50}, // Umidade
+    {7, Q16(4.0f), Q16(0.5f), Q16(6.0f), Q16(0.1f), 50}, // Peso
+    {4, Q16(3.0f), Q16(0.5f), Q16(8.0f), Q16(1.0f), 50}, // Luminosidade
+    {5, Q16(3.0f), Q16(0.5f), Q16(8.0f), Q16(0.1f), 50}, // Gas VOC
+    {3, Q16(3.5f), Q16(1.0f), Q16(8.0f), Q16(2.0f), 50}, // Vibracao
+};
+
+static float limitar(float x)
+{
+    if (x < 0)
+        return 0;
+    if (x > 1)
+        return 1;
+    return x;
+}
+
+// Índice de temperatura (assimétrico)
+// Se temp <= ideal: mapeia de ideal a (ideal -15) para índice de 1.0 a 0.0
+// Se temp > ideal:  mapeia de ideal a (ideal +3) para índice de 1.0 a 0.0
+float pontuacao_temperatura(const Beeespecies *especie, float temp)
+{
+    float ideal_temp = (especie->min_temp + especie->max_temp) / 2.0f;
+    if (temp <= ideal_temp)
+        return limitar(1.0f + (temp - ideal_temp) / 15.0f);
+    return limitar(1.0f - (temp - ideal_temp) / 3.0f);
+}
+
+// Índice de umidade (simétrico: 70 ±25)
+float pontuacao_umidade(float umid)
+{
+    return limitar(1.0f - (fabsf(umid - UMIDADE_IDEAL) / 25.0f));
+}
+
+// Combinação ponderada: temperatura tem mais peso
+float pontuacao_saude(const Beeespecies *especie, float temp, float umid)
+{
+    return (0.85f * pontuacao_temperatura(especie, temp) + 0.15f * pontuacao_umidade(umid)) / (0.85f + 0.15f);
+}
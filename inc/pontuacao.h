@@ -0,0 +1,37 @@
+#ifndef PONTUACAO_H
+#define PONTUACAO_H
+
+#include "especies.h"
+#include "anomalia.h"
+
+// Avaliação da colmeia, compartilhada entre o firmware e as ferramentas do
+// computador: índice de saúde pela espécie, canais e sensibilidade dos
+// detectores de anomalia e período da tendência de peso.
+
+#define LIMIAR_ALARME 0.5f   // índice de saúde abaixo disso instabiliza o alarme
+#define UMIDADE_IDEAL 70.0f
+
+// Canais monitorados pelos detectores de anomalia: temperatura, umidade e sensores[]
+enum
+{
+    CANAL_TEMP,
+    CANAL_UMID,
+    CANAL_SENSORES,
+    CANAL_PESO = CANAL_SENSORES,
+    CANAL_LUZ,
+    CANAL_VOC,
+    CANAL_VIBRA,
+    NUM_CANAIS
+};
+
+extern const anomalia_config_t anomalia_config[NUM_CANAIS];
+
+// Tendência do peso da colmeia: uma amostra a cada 15 min, janela de 24 h
+#define TENDENCIA_PERIODO_MS (15 * 60 * 1000)
+
+// Índices parciais de 0 a 1 e a combinação ponderada (1 = ideal)
+float pontuacao_temperatura(const Beeespecies *especie, float temp);
+float pontuacao_umidade(float umid);
+float pontuacao_saude(const Beeespecies *especie, float temp, float umid);
+
+#endif
@@ -0,0 +1,31 @@
+#include <string.h>
+#include "quadro.h"
+#include "crc32.h"
+
+void quadro_cabecalho(quadro_cabecalho_t *cab, quadro_tipo_t tipo, uint32_t sequencia, uint32_t bytes)
+{
+    memset(cab, 0, sizeof(*cab));
+    cab->magica = QUADRO_MAGICA;
+    cab->tipo = tipo;
+    cab->versao = QUADRO_VERSAO;
+    cab->cabecalho = sizeof(*cab);
+    cab->sequencia = sequencia;
+    cab->bytes = bytes;
+}
+
+bool quadro_validar(const void *quadro, size_t tamanho, const quadro_cabecalho_t **cab, const uint8_t **carga)
+{
+    const quadro_cabecalho_t *c = quadro;
+    const uint8_t *p = quadro;
+    if (tamanho < quadro_tamanho(0) || c->magica != QUADRO_MAGICA || c->versao != QUADRO_VERSAO ||
+        c->cabecalho != sizeof(*c) || quadro_tamanho(c->bytes) != tamanho)
+        return false;
+
+    uint32_t crc;
+    memcpy(&crc, p + sizeof(*c) + c->bytes, sizeof(crc));
+    if (crc32_calcular(p, sizeof(*c) + c->bytes) != crc)
+        return false;
+    *cab = c;
+    *carga = p + sizeof(*c);
+    return true;
+}
@@ -0,0 +1,70 @@
+#ifndef QUADRO_H
+#define QUADRO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Quadro binário para blocos grandes pela UART (capturas brutas), fora do
+// fluxo de linhas JSON. O firmware anuncia o quadro numa linha JSON com o
+// tamanho total e, se for o caso, o baud da rajada; em seguida vêm os bytes:
+//
+//   quadro_cabecalho_t | carga[bytes] | uint32_t crc
+//
+// Tudo em little-endian. O CRC-32 (inc/crc32.h) cobre cabeçalho e carga, então
+// o receptor valida o bloco inteiro sem conhecer o tipo da carga. Usado pelo
+// firmware e pelas ferramentas em host/.
+
+#define QUADRO_MAGICA 0x31515342u // "BSQ1"
+#define QUADRO_VERSAO 1
+
+typedef enum
+{
+    QUADRO_CAPTURA = 1 // captura_meta_t + amostras (inc/captura.h)
+} quadro_tipo_t;
+
+typedef struct
+{
+    uint32_t magica;
+    uint8_t tipo;
+    uint8_t versao;
+    uint16_t cabecalho; // sizeof(quadro_cabecalho_t), para estender sem quebrar leitores
+    uint32_t sequencia;
+    uint32_t bytes; // carga, sem cabeçalho nem CRC
+} quadro_cabecalho_t;
+
+// Carga do quadro QUADRO_CAPTURA (inc/captura.h): captura_meta_t seguido de
+// quadros × n_canais amostras uint16_t (12 bits), canais em ordem crescente
+// dentro de cada instante
+typedef enum
+{
+    CAPTURA_COMANDO,
+    CAPTURA_ANOMALIA
+} captura_motivo_t;
+
+typedef struct
+{
+    uint32_t taxa_hz;
+    uint32_t quadros;   // instantes na rajada
+    uint32_t disparo;   // índice do instante do disparo
+    uint32_t inicio_ms; // tempo desde o boot do primeiro instante
+    uint8_t canais;     // máscara: bit n = ADCn
+    uint8_t n_canais;
+    uint8_t bits;
+    uint8_t motivo; // captura_motivo_t
+    uint32_t reservado;
+} captura_meta_t;
+
+// Bytes do quadro inteiro para uma carga de n bytes
+static inline size_t quadro_tamanho(uint32_t bytes)
+{
+    return sizeof(quadro_cabecalho_t) + bytes + sizeof(uint32_t);
+}
+
+void quadro_cabecalho(quadro_cabecalho_t *cab, quadro_tipo_t tipo, uint32_t sequencia, uint32_t bytes);
+
+// Valida um quadro completo em memória (alinhado a 4); devolve o cabeçalho e
+// a carga, com cab->bytes bytes
+bool quadro_validar(const void *quadro, size_t tamanho, const quadro_cabecalho_t **cab, const uint8_t **carga);
+
+#endif
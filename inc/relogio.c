@@ -0,0 +1,95 @@
+#include "relogio.h"
+#include "hardware/clocks.h"
+
+typedef struct
+{
+    relogio_callback_t callback;
+    void *contexto;
+} relogio_registro_t;
+
+static relogio_registro_t registros[RELOGIO_MAX_CALLBACKS];
+static uint num_registros = 0;
+
+static relogio_nivel_t nivel_base = RELOGIO_DESEMPENHO;
+static relogio_nivel_t nivel_aplicado = RELOGIO_DESEMPENHO;
+static bool aplicado = false;
+static uint impulsos = 0;
+
+static const uint32_t khz_por_nivel[] = {
+    [RELOGIO_ECONOMIA] = RELOGIO_ECONOMIA_KHZ,
+    [RELOGIO_DESEMPENHO] = RELOGIO_DESEMPENHO_KHZ,
+};
+
+bool relogio_registrar(relogio_callback_t callback, void *contexto)
+{
+    if (num_registros >= RELOGIO_MAX_CALLBACKS)
+        return false;
+    registros[num_registros].callback = callback;
+    registros[num_registros].contexto = contexto;
+    num_registros++;
+
+    // O driver já nasce ajustado ao clock atual
+    callback(RELOGIO_DEPOIS, clock_get_hz(clk_sys), contexto);
+    return true;
+}
+
+static void notificar(relogio_fase_t fase, uint32_t hz)
+{
+    for (uint i = 0; i < num_registros; i++)
+        registros[i].callback(fase, hz, registros[i].contexto);
+}
+
+static bool aplicar(relogio_nivel_t nivel, bool forcar)
+{
+    if (aplicado && !forcar && nivel == nivel_aplicado)
+        return true;
+
+    notificar(RELOGIO_ANTES, clock_get_hz(clk_sys));
+    bool ok = set_sys_clock_khz(khz_por_nivel[nivel], false);
+    if (ok)
+    {
+        nivel_aplicado = nivel;
+        aplicado = true;
+    }
+    notificar(RELOGIO_DEPOIS, clock_get_hz(clk_sys));
+    return ok;
+}
+
+static relogio_nivel_t nivel_efetivo(void)
+{
+    return impulsos ? RELOGIO_DESEMPENHO : nivel_base;
+}
+
+bool relogio_definir_nivel(relogio_nivel_t nivel)
+{
+    nivel_base = nivel;
+    return aplicar(nivel_efetivo(), false);
+}
+
+relogio_nivel_t relogio_nivel(void)
+{
+    return nivel_aplicado;
+}
+
+void relogio_elevar(void)
+{
+    impulsos++;
+    aplicar(nivel_efetivo(), false);
+}
+
+void relogio_liberar(void)
+{
+    if (impulsos)
+        impulsos--;
+    aplicar(nivel_efetivo(), false);
+}
+
+void relogio_reaplicar(void)
+{
+    aplicar(nivel_efetivo(), true);
+}
+
+uint32_t relogio_hz(void)
+{
+    return clock_get_hz(clk_sys);
+}
@@ -0,0 +1,44 @@
+#ifndef RELOGIO_H
+#define RELOGIO_H
+
+#include "pico/stdlib.h"
+
+// Gerenciador do clock do sistema. Troca clk_sys entre os níveis de economia e
+// de desempenho em tempo de execução e avisa os drivers registrados, que
+// recalculam seus divisores (PIO, PWM, I2C, UART) para o novo clock.
+
+#define RELOGIO_ECONOMIA_KHZ 48000
+#define RELOGIO_DESEMPENHO_KHZ 128000 // múltiplo exato de 8 MHz para a PIO da matriz
+
+#define RELOGIO_MAX_CALLBACKS 8
+
+typedef enum
+{
+    RELOGIO_ECONOMIA,
+    RELOGIO_DESEMPENHO
+} relogio_nivel_t;
+
+typedef enum
+{
+    RELOGIO_ANTES,  // clk_sys ainda no valor antigo: termine transferências em andamento
+    RELOGIO_DEPOIS  // clk_sys já no novo valor: recalcule os divisores
+} relogio_fase_t;
+
+typedef void (*relogio_callback_t)(relogio_fase_t fase, uint32_t sys_hz, void *contexto);
+
+bool relogio_registrar(relogio_callback_t callback, void *contexto);
+
+// Nível base pedido (ex.: pelo modo de energia)
+bool relogio_definir_nivel(relogio_nivel_t nivel);
+relogio_nivel_t relogio_nivel(void);
+
+// Impulso temporário para rajadas (FFT, descarga de buffers): aninhável
+void relogio_elevar(void);
+void relogio_liberar(void);
+
+// Reaplica o nível atual (após o sono profundo, que deixa clk_sys no XOSC)
+void relogio_reaplicar(void);
+
+uint32_t relogio_hz(void);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef SRAM_H
+#define SRAM_H
+
+// Código e tabelas quentes copiados para a SRAM no boot, fora do XIP: o
+// desenho pixel a pixel, as fontes e os caminhos de interrupção não esperam
+// por faltas no cache da flash enquanto o display e os sensores disputam o
+// barramento. Candidatos saem do build de perfil (inc/perfil.h).
+//
+// BEESENSE_TUDO_NA_FLASH desfaz a colocação, para comparar os dois builds
+// (e deixa as fontes compilarem no host, sem o SDK).
+
+#ifndef BEESENSE_TUDO_NA_FLASH
+#define BEESENSE_TUDO_NA_FLASH 0
+#endif
+
+#if BEESENSE_TUDO_NA_FLASH
+#define NA_RAM(nome) nome
+#define TABELA_NA_RAM
+#else
+#include "pico/platform.h"
+#define NA_RAM(nome) __not_in_flash_func(nome)
+#define TABELA_NA_RAM __not_in_flash("tabelas")
+#endif
+
+#endif
@@ -1,5 +1,5 @@
+#include <string.h>
 #include "ssd1306.h"
-#include "font.h"
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c)
 {
@@ -9,198 +9,113 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
   ssd->address = address;
   ssd->i2c_port = i2c;
   ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  hard_assert(ssd->bufsize <= SSD1306_BUFSIZE);
+  memset(ssd->ram_buffer, 0, ssd->bufsize);
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+
+  // Comandos avulsos e janelas têm prioridade normal; os dados do quadro vão
+  // em blocos de baixa prioridade, atrás das leituras de sensores
+  ssd->t_comando = (i2c_transacao_t){.endereco = address, .prioridade = I2C_PRIORIDADE_NORMAL,
+                                     .escrita = ssd->port_buffer, .n_escrita = 2, .prefixo = -1};
+  ssd->t_janela = (i2c_transacao_t){.endereco = address, .prioridade = I2C_PRIORIDADE_BAIXA,
+                                    .escrita = ssd->janela, .n_escrita = sizeof(ssd->janela), .prefixo = -1};
+  ssd->t_dados = (i2c_transacao_t){.endereco = address, .prioridade = I2C_PRIORIDADE_BAIXA, .prefixo = 0x40};
 }
 
+// Toda a inicialização numa transação só: depois do byte de controle 0x00
+// (Co = 0, D/C = 0) o controlador trata os bytes seguintes como comandos.
+// Multiplex e pinos COM seguem a altura (32 linhas usam COM sequencial).
 void ssd1306_config(ssd1306_t *ssd)
 {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  const uint8_t comandos[] = {
+      0x00,
+      SET_DISP | 0x00,
+      SET_MEM_ADDR, 0x01,
+      SET_DISP_START_LINE | 0x00,
+      SET_SEG_REMAP | 0x01,
+      SET_MUX_RATIO, ssd->height - 1,
+      SET_COM_OUT_DIR | 0x08,
+      SET_DISP_OFFSET, 0x00,
+      SET_COM_PIN_CFG, ssd->height == 32 ? 0x02 : 0x12,
+      SET_DISP_CLK_DIV, 0x80,
+      SET_PRECHARGE, 0xF1,
+      SET_VCOM_DESEL, 0x30,
+      SET_CONTRAST, 0xFF,
+      SET_ENTIRE_ON,
+      SET_NORM_INV,
+      SET_CHARGE_PUMP, 0x14,
+      SET_DISP | 0x01};
+  i2c_transacao_t t = {.endereco = ssd->address, .prioridade = I2C_PRIORIDADE_NORMAL,
+                       .escrita = comandos, .n_escrita = sizeof(comandos), .prefixo = -1};
+  barramento_i2c_executar(ssd->i2c_port, &t);
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command)
 {
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-      ssd->i2c_port,
-      ssd->address,
-      ssd->port_buffer,
-      2,
-      false);
+  barramento_i2c_executar(ssd->i2c_port, &ssd->t_comando);
 }
 
-void ssd1306_send_data(ssd1306_t *ssd)
+bool ssd1306_busy(ssd1306_t *ssd)
 {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-      ssd->i2c_port,
-      ssd->address,
-      ssd->ram_buffer,
-      ssd->bufsize,
-      false);
+  return barramento_i2c_pendente(&ssd->t_janela) || barramento_i2c_pendente(&ssd->t_dados);
 }
 
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value)
+// Espera o quadro anterior sair antes de reutilizar as transações
+void ssd1306_wait(ssd1306_t *ssd)
 {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
-  uint8_t pixel = (y & 0b111);
-  if (value)
-    ssd->ram_buffer[index] |= (1 << pixel);
-  else
-    ssd->ram_buffer[index] &= ~(1 << pixel);
+  while (ssd1306_busy(ssd))
+    tight_loop_contents();
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
-
-void ssd1306_fill(ssd1306_t *ssd, bool value)
+// Janela de colunas x0..x1 e páginas p0..p1 (0x00: todos os bytes seguintes
+// são comandos) seguida dos dados, na mesma fila para manter a ordem
+static void ssd1306_send_window(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1,
+                                const uint8_t *data, size_t len)
 {
-  // Itera por todas as posições do display
-  for (uint8_t y = 0; y < ssd->height; ++y)
-  {
-    for (uint8_t x = 0; x < ssd->width; ++x)
-    {
-      ssd1306_pixel(ssd, x, y, value);
-    }
-  }
+  ssd->janela[0] = 0x00;
+  ssd->janela[1] = SET_COL_ADDR;
+  ssd->janela[2] = x0;
+  ssd->janela[3] = x1;
+  ssd->janela[4] = SET_PAGE_ADDR;
+  ssd->janela[5] = p0;
+  ssd->janela[6] = p1;
+  barramento_i2c_enviar(ssd->i2c_port, &ssd->t_janela);
+
+  ssd->t_dados.escrita = data;
+  ssd->t_dados.n_escrita = len;
+  barramento_i2c_enviar(ssd->i2c_port, &ssd->t_dados);
 }
 
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill)
+// O quadro é copiado antes de sair: o laço já pode desenhar o próximo
+// enquanto os blocos são enviados
+void ssd1306_send_data(ssd1306_t *ssd)
 {
-  for (uint8_t x = left; x < left + width; ++x)
-  {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
-  }
-  for (uint8_t y = top; y < top + height; ++y)
-  {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
-  }
-
-  if (fill)
-  {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x)
-    {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y)
-      {
-        ssd1306_pixel(ssd, x, y, value);
-      }
-    }
-  }
+  ssd1306_wait(ssd);
+  memcpy(ssd->regiao, &ssd->ram_buffer[1], ssd->bufsize - 1);
+  ssd1306_send_window(ssd, 0, ssd->width - 1, 0, ssd->pages - 1, ssd->regiao, ssd->bufsize - 1);
 }
 
-void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value)
+// Envia só a janela de colunas x0..x1 e páginas p0..p1. No modo de
+// endereçamento vertical o controlador percorre as páginas de cada coluna,
+// então cada coluna da janela é um trecho contíguo do framebuffer.
+void ssd1306_send_region(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1)
 {
-  int dx = abs(x1 - x0);
-  int dy = abs(y1 - y0);
-
-  int sx = (x0 < x1) ? 1 : -1;
-  int sy = (y0 < y1) ? 1 : -1;
+  ssd1306_wait(ssd);
 
-  int err = dx - dy;
-
-  while (true)
+  uint8_t paginas = p1 - p0 + 1;
+  size_t n = 0;
+  for (uint16_t x = x0; x <= x1; x++)
   {
-    ssd1306_pixel(ssd, x0, y0, value); // Desenha o pixel atual
-
-    if (x0 == x1 && y0 == y1)
-      break; // Termina quando alcança o ponto final
-
-    int e2 = err * 2;
-
-    if (e2 > -dy)
-    {
-      err -= dy;
-      x0 += sx;
-    }
-
-    if (e2 < dx)
-    {
-      err += dx;
-      y0 += sy;
-    }
+    memcpy(&ssd->regiao[n], &ssd->ram_buffer[x * ssd->pages + p0 + 1], paginas);
+    n += paginas;
   }
+  ssd1306_send_window(ssd, x0, x1, p0, p1, ssd->regiao, n);
 }
 
-void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value)
-{
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
-}
-
-void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value)
-{
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
-}
-
-// Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+// Liga ou desliga o painel (a RAM do controlador é preservada)
+void ssd1306_display(ssd1306_t *ssd, bool on)
 {
-  uint16_t index = 0;
-  char ver = c;
-  index = (ver - 32) * 8;
-
-  for (uint8_t i = 0; i < 8; ++i)
-  {
-    uint8_t line = font[index + i];
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
-    }
-  }
+  ssd1306_command(ssd, SET_DISP | (on ? 0x01 : 0x00));
 }
-
-// Função para desenhar uma string
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
-{
-  while (*str)
-  {
-    ssd1306_draw_char(ssd, *str++, x, y);
-    x += 8;
-    if (x + 8 >= ssd->width)
-    {
-      x = 0;
-      y += 8;
-    }
-    if (y + 8 >= ssd->height)
-    {
-      break;
-    }
-  }
-}
\ No newline at end of file
@@ -1,10 +1,18 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "barramento_i2c.h"
+#include "fontes.h"
 
 #define WIDTH 128
 #define HEIGHT 64
 
+// Quadro em memória estática: o maior display suportado define o tamanho
+#define SSD1306_BUFSIZE (WIDTH * HEIGHT / 8 + 1)
+
 typedef enum {
   SET_CONTRAST = 0x81,
   SET_ENTIRE_ON = 0xA4,
@@ -29,16 +37,27 @@ typedef struct {
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
   bool external_vcc;
-  uint8_t *ram_buffer;
+  uint8_t ram_buffer[SSD1306_BUFSIZE];
   size_t bufsize;
   uint8_t port_buffer[2];
+  // Envio pelo gerenciador do barramento: janela de endereços e dados em blocos
+  uint8_t janela[7];
+  uint8_t regiao[SSD1306_BUFSIZE - 1];
+  i2c_transacao_t t_comando, t_janela, t_dados;
 } ssd1306_t;
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_display(ssd1306_t *ssd, bool on);
+void ssd1306_send_region(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1);
+bool ssd1306_busy(ssd1306_t *ssd);
+void ssd1306_wait(ssd1306_t *ssd);
 
+// Desenho: inc/ssd1306_desenho.cpp, com a geometria do display da placa
+// (inc/placa.h) fixa em compilação; outros tamanhos usam a geometria lida do
+// ssd1306_t. O C++ tem os mesmos caminhos em inc/ssd1306.hpp.
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
@@ -46,4 +65,17 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+void ssd1306_blit_coluna(ssd1306_t *ssd, uint8_t x, uint8_t y, uint32_t bits, uint8_t altura);
+uint8_t ssd1306_draw_glyph(ssd1306_t *ssd, const fonte_t *fonte, uint32_t codigo, uint8_t x, uint8_t y);
+uint8_t ssd1306_draw_string_font(ssd1306_t *ssd, const fonte_t *fonte, const char *str, uint8_t x, uint8_t y);
+
+// O display da placa: um Ssd1306<LCD_WIDTH, LCD_HEIGHT, SSD1306_ADDR,
+// PLACA_I2C> (inc/ssd1306.hpp). Configura o controlador e devolve o estado
+// para a API acima; o barramento já tem de estar de pé.
+ssd1306_t *ssd1306_placa_iniciar(void);
+
+// Tempo das mesmas cenas nas duas geometrias, em JSON pelo stdio
+void ssd1306_bancada(void);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef SSD1306_HPP
+#define SSD1306_HPP
+
+extern "C"
+{
+#include "ssd1306.h"
+}
+#include "desenho.hpp"
+
+// Display SSD1306 com tamanho, endereço e porta I2C fixos em compilação. O
+// estado é o mesmo ssd1306_t da API em C: o envio (janelas, blocos no
+// barramento I2C) continua em inc/ssd1306.c, e c() entrega o ponteiro para
+// quem ainda desenha pela API em C (inc/grafico.h). Cada instância tem seu
+// framebuffer, então vários displays (0x3C e 0x3D, ou um em cada porta)
+// convivem no mesmo build.
+//
+//   static Ssd1306<128, 64, 0x3C, 1> tela;
+//   tela.iniciar();
+//   auto d = tela.desenho();
+//   d.texto("BeeSense", 0, 0);
+//   tela.enviar();
+
+template <uint8_t Largura, uint8_t Altura, uint8_t Endereco, unsigned PortaI2c>
+class Ssd1306
+{
+public:
+    using Geometria = GeometriaFixa<Largura, Altura>;
+
+    static_assert(Geometria::bytes() + 1 <= SSD1306_BUFSIZE, "framebuffer maior que o ssd1306_t");
+    static_assert(PortaI2c < 2, "RP2040: i2c0 ou i2c1");
+
+    // O barramento (barramento_i2c_init) já tem de estar de pé
+    void iniciar(bool vcc_externo = false)
+    {
+        ssd1306_init(&estado, Largura, Altura, vcc_externo, Endereco, I2C_INSTANCE(PortaI2c));
+        ssd1306_config(&estado);
+    }
+
+    Desenho<Geometria> desenho()
+    {
+        return Desenho<Geometria>(&estado.ram_buffer[1]);
+    }
+
+    void enviar()
+    {
+        ssd1306_send_data(&estado);
+    }
+
+    void enviar_regiao(uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1)
+    {
+        ssd1306_send_region(&estado, x0, x1, p0, p1);
+    }
+
+    void ligar(bool ligado)
+    {
+        ssd1306_display(&estado, ligado);
+    }
+
+    bool ocupado()
+    {
+        return ssd1306_busy(&estado);
+    }
+
+    ssd1306_t *c()
+    {
+        return &estado;
+    }
+
+private:
+    ssd1306_t estado;
+};
+
+#endif
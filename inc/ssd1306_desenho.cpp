@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <type_traits>
+#include "pico/stdlib.h"
+#include "ssd1306.hpp"
+
+extern "C"
+{
+#include "placa.h"
+#include "sram.h"
+}
+
+// API de desenho em C por cima de inc/desenho.hpp. O display da placa cai na
+// geometria fixa; um ssd1306_t de outro tamanho usa a variável. A escolha é
+// uma comparação por chamada, não por pixel: laços como o do texto e dos
+// retângulos rodam inteiros na versão especializada.
+
+using GeometriaPlaca = GeometriaFixa<LCD_WIDTH, LCD_HEIGHT>;
+
+// O display da placa. A instanciação explícita compila todos os membros do
+// driver no build do firmware, não só os que o C usa.
+using DisplayPlaca = Ssd1306<LCD_WIDTH, LCD_HEIGHT, SSD1306_ADDR, PLACA_I2C>;
+template class Ssd1306<LCD_WIDTH, LCD_HEIGHT, SSD1306_ADDR, PLACA_I2C>;
+static_assert(std::is_same<DisplayPlaca::Geometria, GeometriaPlaca>::value, "despachar() especializa o display da placa");
+
+static DisplayPlaca display;
+
+ssd1306_t *ssd1306_placa_iniciar(void)
+{
+    display.iniciar();
+    return display.c();
+}
+
+// Os lambdas passados a despachar() também precisam de always_inline: um
+// operator() de lambda genérico é uma função à parte, emitida em .text.
+#define DESPACHO __attribute__((always_inline))
+
+template <class F>
+static DESENHO_INLINE auto despachar(ssd1306_t *ssd, F &&f)
+{
+    if (ssd->width == LCD_WIDTH && ssd->height == LCD_HEIGHT)
+        return f(Desenho<GeometriaPlaca>(&ssd->ram_buffer[1]));
+    return f(Desenho<GeometriaVariavel>(&ssd->ram_buffer[1], GeometriaVariavel(ssd->width, ssd->height)));
+}
+
+// Caminhos quentes do desenho: na SRAM (inc/sram.h)
+void NA_RAM(ssd1306_pixel)(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value)
+{
+    despachar(ssd, [&](auto d) DESPACHO { d.pixel(x, y, value); });
+}
+
+void ssd1306_fill(ssd1306_t *ssd, bool value)
+{
+    despachar(ssd, [&](auto d) DESPACHO { d.preencher(value); });
+}
+
+void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill)
+{
+    despachar(ssd, [&](auto d) DESPACHO { d.retangulo(top, left, width, height, value, fill); });
+}
+
+void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value)
+{
+    despachar(ssd, [&](auto d) DESPACHO { d.linha(x0, y0, x1, y1, value); });
+}
+
+void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value)
+{
+    despachar(ssd, [&](auto d) DESPACHO { d.hline(x0, x1, y, value); });
+}
+
+void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value)
+{
+    despachar(ssd, [&](auto d) DESPACHO { d.vline(x, y0, y1, value); });
+}
+
+void NA_RAM(ssd1306_blit_coluna)(ssd1306_t *ssd, uint8_t x, uint8_t y, uint32_t bits, uint8_t altura)
+{
+    despachar(ssd, [&](auto d) DESPACHO { d.blit_coluna(x, y, bits, altura); });
+}
+
+uint8_t NA_RAM(ssd1306_draw_glyph)(ssd1306_t *ssd, const fonte_t *fonte, uint32_t codigo, uint8_t x, uint8_t y)
+{
+    return despachar(ssd, [&](auto d) DESPACHO { return (uint8_t)d.glifo(fonte, codigo, x, y); });
+}
+
+// Latin-1, fonte 8x8
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+    despachar(ssd, [&](auto d) DESPACHO { d.glifo(&fonte_8x8, (uint8_t)c, x, y); });
+}
+
+// UTF-8, fonte 8x8, com quebra de linha
+void NA_RAM(ssd1306_draw_string)(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+{
+    despachar(ssd, [&](auto d) DESPACHO { d.texto(str, x, y); });
+}
+
+// UTF-8 numa fonte qualquer, sem quebra de linha; devolve o x final
+uint8_t NA_RAM(ssd1306_draw_string_font)(ssd1306_t *ssd, const fonte_t *fonte, const char *str, uint8_t x, uint8_t y)
+{
+    return despachar(ssd, [&](auto d) DESPACHO { return (uint8_t)d.texto_fonte(fonte, str, x, y); });
+}
+
+// ---------------------------------------------------------------------------
+// Bancada: as mesmas cenas nas duas geometrias, num framebuffer à parte
+
+template <class Op>
+static uint32_t medir_ns(Op op, unsigned repeticoes)
+{
+    uint64_t inicio = time_us_64();
+    for (unsigned i = 0; i < repeticoes; i++)
+        op(i);
+    return (uint32_t)((time_us_64() - inicio) * 1000 / repeticoes);
+}
+
+template <class D>
+static void cena_pixels(D d, unsigned i)
+{
+    for (unsigned y = 0; y < LCD_HEIGHT; y++)
+        for (unsigned x = 0; x < LCD_WIDTH; x++)
+            d.pixel(x, y, (x ^ y ^ i) & 1);
+}
+
+template <class D>
+static void cena_retangulos(D d, unsigned i)
+{
+    d.retangulo(1 + (i & 1), 2, LCD_WIDTH - 4, LCD_HEIGHT - 3, true, true);
+    d.retangulo(4, 6, LCD_WIDTH - 12, LCD_HEIGHT - 8, false, false);
+}
+
+template <class D>
+static void cena_linhas(D d, unsigned i)
+{
+    for (unsigned k = 0; k < 16; k++)
+        d.linha(k * 8, 0, LCD_WIDTH - 1 - k * 8, LCD_HEIGHT - 1, (k ^ i) & 1);
+}
+
+template <class D>
+static void cena_texto(D d, unsigned i)
+{
+    d.texto("Temp: 34.5 °C   Umid: 61 %      Peso: 42.1 kg   VOC: 1.2 ppm", 0, i & 1);
+    d.texto_fonte(&fonte_5x7, "Apis mellifera ligustica", 0, 48);
+    d.texto_fonte(&fonte_8x16, "42.1", 80, 40);
+}
+
+void ssd1306_bancada(void)
+{
+    static uint8_t quadro[SSD1306_BUFSIZE];
+    // Dimensões que o compilador não enxerga, como as lidas de um ssd1306_t
+    volatile uint8_t largura = LCD_WIDTH, altura = LCD_HEIGHT;
+    GeometriaVariavel variavel(largura, altura);
+    Desenho<GeometriaPlaca> fixa_d(&quadro[1]);
+    Desenho<GeometriaVariavel> variavel_d(&quadro[1], variavel);
+
+    struct
+    {
+        const char *nome;
+        unsigned repeticoes;
+        uint32_t variavel_ns, fixa_ns;
+    } r[] = {{"pixels", 20}, {"retangulos", 200}, {"linhas", 100}, {"texto", 200}};
+
+    r[0].variavel_ns = medir_ns([&](unsigned i) { cena_pixels(variavel_d, i); }, r[0].repeticoes);
+    r[0].fixa_ns = medir_ns([&](unsigned i) { cena_pixels(fixa_d, i); }, r[0].repeticoes);
+    r[1].variavel_ns = medir_ns([&](unsigned i) { cena_retangulos(variavel_d, i); }, r[1].repeticoes);
+    r[1].fixa_ns = medir_ns([&](unsigned i) { cena_retangulos(fixa_d, i); }, r[1].repeticoes);
+    r[2].variavel_ns = medir_ns([&](unsigned i) { cena_linhas(variavel_d, i); }, r[2].repeticoes);
+    r[2].fixa_ns = medir_ns([&](unsigned i) { cena_linhas(fixa_d, i); }, r[2].repeticoes);
+    r[3].variavel_ns = medir_ns([&](unsigned i) { cena_texto(variavel_d, i); }, r[3].repeticoes);
+    r[3].fixa_ns = medir_ns([&](unsigned i) { cena_texto(fixa_d, i); }, r[3].repeticoes);
+
+    printf("{ \"desenho\": [");
+    for (unsigned i = 0; i < sizeof(r) / sizeof(r[0]); i++)
+        printf("%s{ \"cena\": \"%s\", \"variavel_ns\": %lu, \"fixa_ns\": %lu }", i ? ", " : "", r[i].nome,
+               (unsigned long)r[i].variavel_ns, (unsigned long)r[i].fixa_ns);
+    printf("] }\n");
+}
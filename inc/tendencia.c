@@ -0,0 +1,104 @@
+#include "tendencia.h"
+
+#define MS_POR_DIA 86400000LL
+#define DIAS_MAX 9999
+
+void tendencia_init(tendencia_t *t, uint32_t periodo_ms)
+{
+    t->inicio = 0;
+    t->n = 0;
+    t->soma_y = 0;
+    t->soma_iy = 0;
+    t->periodo_ms = periodo_ms;
+}
+
+void tendencia_adicionar(tendencia_t *t, q16_t y)
+{
+    if (t->n < TENDENCIA_JANELA)
+    {
+        // Janela ainda enchendo: a nova amostra entra na posição n
+        t->amostras[(t->inicio + t->n) % TENDENCIA_JANELA] = y;
+        t->soma_iy += (int64_t)t->n * y;
+        t->soma_y += y;
+        t->n++;
+        return;
+    }
+
+    // Janela cheia: a mais antiga (i = 0) sai e as demais recuam uma posição,
+    // o que subtrai Σy restante de Σi·y; a nova entra em i = N - 1.
+    q16_t antiga = t->amostras[t->inicio];
+    t->amostras[t->inicio] = y;
+    t->inicio = (t->inicio + 1) % TENDENCIA_JANELA;
+
+    t->soma_iy -= t->soma_y - antiga;
+    t->soma_iy += (int64_t)(TENDENCIA_JANELA - 1) * y;
+    t->soma_y += y - antiga;
+}
+
+bool tendencia_valida(const tendencia_t *t)
+{
+    return t->n >= TENDENCIA_MIN_AMOSTRAS;
+}
+
+// b = (n·Σiy - Σi·Σy) / (n·Σi² - (Σi)²), com Σi e Σi² fechados em n
+static void tendencia_fracao(const tendencia_t *t, int64_t *num, int64_t *den)
+{
+    int64_t n = t->n;
+    int64_t soma_i = n * (n - 1) / 2;
+    *num = n * t->soma_iy - soma_i * t->soma_y;
+    *den = n * n * (n * n - 1) / 12;
+}
+
+q16_t tendencia_inclinacao(const tendencia_t *t)
+{
+    if (t->n < 2)
+        return 0;
+
+    int64_t num, den;
+    tendencia_fracao(t, &num, &den);
+    return (q16_t)(num / den);
+}
+
+q16_t tendencia_intercepto(const tendencia_t *t)
+{
+    if (t->n == 0)
+        return 0;
+
+    int64_t n = t->n;
+    int64_t soma_i = n * (n - 1) / 2;
+    return (q16_t)((t->soma_y - (int64_t)tendencia_inclinacao(t) * soma_i) / n);
+}
+
+q16_t tendencia_atual(const tendencia_t *t)
+{
+    if (t->n == 0)
+        return 0;
+    return tendencia_intercepto(t) + tendencia_inclinacao(t) * (t->n - 1);
+}
+
+q16_t tendencia_por_dia(const tendencia_t *t)
+{
+    if (t->n < 2)
+        return 0;
+
+    // Escala antes de dividir para não perder a resolução da inclinação
+    int64_t num, den;
+    tendencia_fracao(t, &num, &den);
+    return (q16_t)(num * (MS_POR_DIA / t->periodo_ms) / den);
+}
+
+int32_t tendencia_dias_ate(const tendencia_t *t, q16_t limiar)
+{
+    if (!tendencia_valida(t))
+        return -1;
+
+    q16_t por_dia = tendencia_por_dia(t);
+    int64_t distancia = (int64_t)limiar - tendencia_atual(t);
+
+    // Reta parada ou se afastando do limiar
+    if (por_dia == 0 || (distancia > 0) != (por_dia > 0))
+        return distancia == 0 ? 0 : -1;
+
+    int64_t dias = distancia / por_dia;
+    return dias > DIAS_MAX ? DIAS_MAX : (int32_t)dias;
+}
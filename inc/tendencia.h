@@ -0,0 +1,42 @@
+#ifndef TENDENCIA_H
+#define TENDENCIA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ponto_fixo.h"
+
+// Estimador de tendência por mínimos quadrados em janela deslizante.
+// As somas Σy e Σi·y são atualizadas a cada amostra (i = 0 é a mais antiga),
+// então inclinação e intercepto saem em O(1) sem percorrer a janela.
+
+#define TENDENCIA_JANELA 96     // amostras na janela (memória constante)
+#define TENDENCIA_MIN_AMOSTRAS 8 // mínimo para considerar a estimativa válida
+
+typedef struct
+{
+    q16_t amostras[TENDENCIA_JANELA];
+    uint16_t inicio;
+    uint16_t n;
+    int64_t soma_y;
+    int64_t soma_iy;
+    uint32_t periodo_ms; // intervalo entre amostras
+} tendencia_t;
+
+void tendencia_init(tendencia_t *t, uint32_t periodo_ms);
+void tendencia_adicionar(tendencia_t *t, q16_t y);
+bool tendencia_valida(const tendencia_t *t);
+
+// Inclinação por amostra e intercepto (valor ajustado na amostra mais antiga)
+q16_t tendencia_inclinacao(const tendencia_t *t);
+q16_t tendencia_intercepto(const tendencia_t *t);
+
+// Valor ajustado na amostra mais recente
+q16_t tendencia_atual(const tendencia_t *t);
+
+// Inclinação convertida para unidades por dia (ex.: kg/dia)
+q16_t tendencia_por_dia(const tendencia_t *t);
+
+// Dias até a reta ajustada cruzar o limiar, ou -1 se ela se afasta dele
+int32_t tendencia_dias_ate(const tendencia_t *t, q16_t limiar);
+
+#endif
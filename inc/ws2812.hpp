@@ -0,0 +1,100 @@
+#ifndef WS2812_HPP
+#define WS2812_HPP
+
+extern "C"
+{
+#include "fitas_leds.h"
+}
+#include "desenho.hpp"
+
+// Matriz WS2812 com pino, tamanho e ligação fixos em compilação. A PIO, o
+// DMA e o divisor de clock continuam com o driver de fitas (inc/fitas_leds.h),
+// que transmite todas em paralelo; aqui só a escrita no framebuffer, pela
+// tabela de MapaMatriz em vez do cálculo da serpentina a cada pixel. Com x e
+// y constantes (desenhar, padrao) o índice inteiro some na compilação.
+//
+// Uma matriz sem serpentina só deve ser escrita por aqui: fitas_pixel()
+// supõe a ligação da BitDogLab.
+
+template <unsigned Pino, unsigned Largura, unsigned Altura, bool Serpentina = true>
+class Ws2812Matrix
+{
+public:
+    using Mapa = MapaMatriz<Largura, Altura, Serpentina>;
+
+    static constexpr unsigned largura = Largura;
+    static constexpr unsigned altura = Altura;
+    static constexpr unsigned leds = Mapa::leds;
+
+    // Cor no formato da fita (GRB nos 24 bits de cima)
+    static constexpr uint32_t grb(uint8_t r, uint8_t g, uint8_t b)
+    {
+        return ((uint32_t)g << 24) | ((uint32_t)r << 16) | ((uint32_t)b << 8);
+    }
+
+    // false sem máquina de estado, canal de DMA ou memória de fita livres
+    bool iniciar(PIO pio)
+    {
+        fita = fitas_adicionar(pio, Pino, Largura, Altura);
+        if (fita == FITA_INVALIDA)
+            return false;
+        buffer = fitas_buffer(fita, nullptr);
+        return true;
+    }
+
+    fita_t id() const
+    {
+        return fita;
+    }
+
+    uint sm() const
+    {
+        return fitas_sm(fita);
+    }
+
+    DESENHO_INLINE void pixel(unsigned x, unsigned y, uint32_t cor)
+    {
+        if (x < Largura && y < Altura)
+            buffer[Mapa::tabela[y * Largura + x]] = cor;
+    }
+
+    // Cor na fita (GRB) do pixel; 0 antes de iniciar
+    uint32_t cor(unsigned x, unsigned y) const
+    {
+        return buffer && x < Largura && y < Altura ? buffer[Mapa::tabela[y * Largura + x]] : 0;
+    }
+
+    void preencher(uint32_t cor)
+    {
+        for (unsigned i = 0; i < leds; i++)
+            buffer[i] = cor;
+    }
+
+    // Quadro inteiro, por linha de cima para baixo
+    void desenhar(const uint32_t (*quadro)[Largura])
+    {
+        for (unsigned y = 0; y < Altura; y++)
+            for (unsigned x = 0; x < Largura; x++)
+                buffer[Mapa::indice(x, y)] = quadro[y][x];
+    }
+
+    // Pontos acesos com a cor da sua linha, o resto apagado
+    void padrao(const bool (*pontos)[Largura], const uint32_t *cores)
+    {
+        for (unsigned y = 0; y < Altura; y++)
+            for (unsigned x = 0; x < Largura; x++)
+                buffer[Mapa::indice(x, y)] = pontos[y][x] ? cores[y] : 0;
+    }
+
+    // Todas as fitas saem juntas (fitas_atualizar)
+    void atualizar()
+    {
+        fitas_atualizar();
+    }
+
+private:
+    fita_t fita = FITA_INVALIDA;
+    uint32_t *buffer = nullptr;
+};
+
+#endif
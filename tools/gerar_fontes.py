@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+"""Gera inc/fontes_dados.c com as fontes do display, em tabelas na SRAM.
+
+- 8x8 monoespaçada: a fonte original (tools/fontes/font8x8.h). Os rótulos
+  seguem a página de código 850, mas os desenhos acima de 175 são os da 437
+  (molduras), então só os glifos comuns às duas são remapeados para Latin-1;
+  as letras acentuadas que faltam são compostas como na 5x7.
+- 5x7 proporcional: fonte clássica 5x7 com acentos do português compostos.
+- 8x16 proporcional: a 8x8 com as linhas duplicadas (valores em destaque).
+
+As tabelas vão para a SRAM (TABELA_NA_RAM, inc/sram.h): cada caractere
+desenhado as consulta, e na flash elas disputariam o cache XIP.
+
+Os glifos são colunas (LSB em cima), com ceil(altura/8) bytes por coluna e
+largura própria; colunas vazias nas bordas são removidas nas proporcionais.
+
+Uso: python3 tools/gerar_fontes.py
+"""
+import os
+import re
+
+RAIZ = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+ORIGEM_8X8 = os.path.join(RAIZ, "tools", "fontes", "font8x8.h")
+SAIDA = os.path.join(RAIZ, "inc", "fontes_dados.c")
+
+PRIMEIRO, ULTIMO = 32, 255
+
+FONTE_5X7 = [
+    [0x00, 0x00, 0x00, 0x00, 0x00], [0x00, 0x00, 0x5F, 0x00, 0x00], [0x00, 0x07, 0x00, 0x07, 0x00],
+    [0x14, 0x7F, 0x14, 0x7F, 0x14], [0x24, 0x2A, 0x7F, 0x2A, 0x12], [0x23, 0x13, 0x08, 0x64, 0x62],
+    [0x36, 0x49, 0x55, 0x22, 0x50], [0x00, 0x05, 0x03, 0x00, 0x00], [0x00, 0x1C, 0x22, 0x41, 0x00],
+    [0x00, 0x41, 0x22, 0x1C, 0x00], [0x14, 0x08, 0x3E, 0x08, 0x14], [0x08, 0x08, 0x3E, 0x08, 0x08],
+    [0x00, 0x50, 0x30, 0x00, 0x00], [0x08, 0x08, 0x08, 0x08, 0x08], [0x00, 0x60, 0x60, 0x00, 0x00],
+    [0x20, 0x10, 0x08, 0x04, 0x02], [0x3E, 0x51, 0x49, 0x45, 0x3E], [0x00, 0x42, 0x7F, 0x40, 0x00],
+    [0x42, 0x61, 0x51, 0x49, 0x46], [0x21, 0x41, 0x45, 0x4B, 0x31], [0x18, 0x14, 0x12, 0x7F, 0x10],
+    [0x27, 0x45, 0x45, 0x45, 0x39], [0x3C, 0x4A, 0x49, 0x49, 0x30], [0x01, 0x71, 0x09, 0x05, 0x03],
+    [0x36, 0x49, 0x49, 0x49, 0x36], [0x06, 0x49, 0x49, 0x29, 0x1E], [0x00, 0x36, 0x36, 0x00, 0x00],
+    [0x00, 0x56, 0x36, 0x00, 0x00], [0x08, 0x14, 0x22, 0x41, 0x00], [0x14, 0x14, 0x14, 0x14, 0x14],
+    [0x00, 0x41, 0x22, 0x14, 0x08], [0x02, 0x01, 0x51, 0x09, 0x06], [0x32, 0x49, 0x79, 0x41, 0x3E],
+    [0x7E, 0x11, 0x11, 0x11, 0x7E], [0x7F, 0x49, 0x49, 0x49, 0x36], [0x3E, 0x41, 0x41, 0x41, 0x22],
+    [0x7F, 0x41, 0x41, 0x22, 0x1C], [0x7F, 0x49, 0x49, 0x49, 0x41], [0x7F, 0x09, 0x09, 0x09, 0x01],
+    [0x3E, 0x41, 0x49, 0x49, 0x7A], [0x7F, 0x08, 0x08, 0x08, 0x7F], [0x00, 0x41, 0x7F, 0x41, 0x00],
+    [0x20, 0x40, 0x41, 0x3F, 0x01], [0x7F, 0x08, 0x14, 0x22, 0x41], [0x7F, 0x40, 0x40, 0x40, 0x40],
+    [0x7F, 0x02, 0x0C, 0x02, 0x7F], [0x7F, 0x04, 0x08, 0x10, 0x7F], [0x3E, 0x41, 0x41, 0x41, 0x3E],
+    [0x7F, 0x09, 0x09, 0x09, 0x06], [0x3E, 0x41, 0x51, 0x21, 0x5E], [0x7F, 0x09, 0x19, 0x29, 0x46],
+    [0x46, 0x49, 0x49, 0x49, 0x31], [0x01, 0x01, 0x7F, 0x01, 0x01], [0x3F, 0x40, 0x40, 0x40, 0x3F],
+    [0x1F, 0x20, 0x40, 0x20, 0x1F], [0x3F, 0x40, 0x38, 0x40, 0x3F], [0x63, 0x14, 0x08, 0x14, 0x63],
+    [0x07, 0x08, 0x70, 0x08, 0x07], [0x61, 0x51, 0x49, 0x45, 0x43], [0x00, 0x7F, 0x41, 0x41, 0x00],
+    [0x02, 0x04, 0x08, 0x10, 0x20], [0x00, 0x41, 0x41, 0x7F, 0x00], [0x04, 0x02, 0x01, 0x02, 0x04],
+    [0x40, 0x40, 0x40, 0x40, 0x40], [0x00, 0x01, 0x02, 0x04, 0x00], [0x20, 0x54, 0x54, 0x54, 0x78],
+    [0x7F, 0x48, 0x44, 0x44, 0x38], [0x38, 0x44, 0x44, 0x44, 0x20], [0x38, 0x44, 0x44, 0x48, 0x7F],
+    [0x38, 0x54, 0x54, 0x54, 0x18], [0x08, 0x7E, 0x09, 0x01, 0x02], [0x0C, 0x52, 0x52, 0x52, 0x3E],
+    [0x7F, 0x08, 0x04, 0x04, 0x78], [0x00, 0x44, 0x7D, 0x40, 0x00], [0x20, 0x40, 0x44, 0x3D, 0x00],
+    [0x7F, 0x10, 0x28, 0x44, 0x00], [0x00, 0x41, 0x7F, 0x40, 0x00], [0x7C, 0x04, 0x18, 0x04, 0x78],
+    [0x7C, 0x08, 0x04, 0x04, 0x78], [0x38, 0x44, 0x44, 0x44, 0x38], [0x7C, 0x14, 0x14, 0x14, 0x08],
+    [0x08, 0x14, 0x14, 0x18, 0x7C], [0x7C, 0x08, 0x04, 0x04, 0x08], [0x48, 0x54, 0x54, 0x54, 0x20],
+    [0x04, 0x3F, 0x44, 0x40, 0x20], [0x3C, 0x40, 0x40, 0x20, 0x7C], [0x1C, 0x20, 0x40, 0x20, 0x1C],
+    [0x3C, 0x40, 0x30, 0x40, 0x3C], [0x44, 0x28, 0x10, 0x28, 0x44], [0x0C, 0x50, 0x50, 0x50, 0x3C],
+    [0x44, 0x64, 0x54, 0x4C, 0x44], [0x00, 0x08, 0x36, 0x41, 0x00], [0x00, 0x00, 0x7F, 0x00, 0x00],
+    [0x00, 0x41, 0x36, 0x08, 0x00], [0x02, 0x01, 0x02, 0x04, 0x02],
+]
+
+# Acentos de duas linhas (bits 0-1) para minúsculas, colunas centradas em 5
+ACENTOS_5 = {
+    "agudo": [0x00, 0x00, 0x02, 0x01, 0x00],
+    "grave": [0x00, 0x01, 0x02, 0x00, 0x00],
+    "circunflexo": [0x00, 0x02, 0x01, 0x02, 0x00],
+    "til": [0x02, 0x01, 0x02, 0x01, 0x00],
+    "trema": [0x00, 0x01, 0x00, 0x01, 0x00],
+}
+ACENTOS_8 = {
+    "agudo": [0x00, 0x00, 0x00, 0x02, 0x03, 0x01, 0x00, 0x00],
+    "grave": [0x00, 0x01, 0x03, 0x02, 0x00, 0x00, 0x00, 0x00],
+    "circunflexo": [0x00, 0x00, 0x02, 0x01, 0x01, 0x02, 0x00, 0x00],
+    "til": [0x00, 0x02, 0x01, 0x01, 0x02, 0x02, 0x01, 0x00],
+    "trema": [0x00, 0x01, 0x01, 0x00, 0x01, 0x01, 0x00, 0x00],
+}
+# Códigos acima de 175 cujo desenho coincide nas páginas 437 e 850
+COMUNS_437_850 = {225, 230, 241, 246, 248, 250, 253}
+COMPOSTOS = {
+    "á": ("a", "agudo"), "à": ("a", "grave"), "â": ("a", "circunflexo"), "ã": ("a", "til"),
+    "é": ("e", "agudo"), "ê": ("e", "circunflexo"), "í": ("ı", "agudo"), "ó": ("o", "agudo"),
+    "ô": ("o", "circunflexo"), "õ": ("o", "til"), "ú": ("u", "agudo"), "ü": ("u", "trema"),
+    "Á": ("A", "agudo"), "À": ("A", "grave"), "Â": ("A", "circunflexo"), "Ã": ("A", "til"),
+    "É": ("E", "agudo"), "Ê": ("E", "circunflexo"), "Í": ("I", "agudo"), "Ó": ("O", "agudo"),
+    "Ô": ("O", "circunflexo"), "Õ": ("O", "til"), "Ú": ("U", "agudo"), "Ü": ("U", "trema"),
+}
+EXTRAS_8X8 = {
+    "ı": [0x00, 0x00, 0x44, 0x7C, 0x7C, 0x40, 0x00, 0x00],
+}
+EXTRAS_5X7 = {
+    "ı": [0x00, 0x44, 0x7C, 0x40, 0x00],
+    "ç": [0x18, 0xA4, 0x64, 0x24, 0x00],
+    "Ç": [0x1E, 0xA1, 0x61, 0x21, 0x12],
+    "°": [0x00, 0x06, 0x09, 0x09, 0x06],
+    "º": [0x00, 0x06, 0x09, 0x06, 0x00],
+    "ª": [0x00, 0x0A, 0x0D, 0x0E, 0x00],
+}
+
+
+def ler_8x8():
+    """Lê a fonte 8x8 e indexa os glifos pelo caractere do rótulo."""
+    glifos = {}
+    padrao = re.compile(r"((?:0x[0-9A-Fa-f]{2},?\s*){8})//\s*(\d+)\s*\((.)\)")
+    with open(ORIGEM_8X8, encoding="utf-8") as f:
+        for linha in f:
+            m = padrao.search(linha)
+            if not m:
+                continue
+            dados = [int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]{2}", m.group(1))]
+            codigo, rotulo = int(m.group(2)), m.group(3)
+            if codigo > 175 and codigo not in COMUNS_437_850:
+                continue
+            # Glifos ASCII pelo código (o '^' foi redesenhado como ícone de LED)
+            chave = chr(codigo) if codigo < 127 else rotulo
+            glifos.setdefault(chave, dados)
+    glifos.update(EXTRAS_8X8)
+    return compor(glifos, ACENTOS_8)
+
+
+def compor(base, acentos):
+    """Compõe as letras acentuadas que faltam a partir da letra base."""
+    for car, (letra, acento) in COMPOSTOS.items():
+        if car in base:
+            continue
+        g = base[letra]
+        marca = acentos[acento]
+        if letra.isupper():
+            # Maiúscula desce uma linha; o acento ocupa só a linha de cima
+            base[car] = [((c << 1) & 0xFF) | (1 if m else 0) for c, m in zip(g, marca)]
+        else:
+            base[car] = [(c & ~0x03) | m for c, m in zip(g, marca)]
+    return base
+
+
+def compor_5x7():
+    base = {chr(32 + i): g for i, g in enumerate(FONTE_5X7)}
+    base.update(EXTRAS_5X7)
+    return compor(base, ACENTOS_5)
+
+
+def dobrar(colunas):
+    """8 linhas -> 16 linhas: cada bit vira dois (dois bytes por coluna)."""
+    saida = []
+    for c in colunas:
+        v = 0
+        for b in range(8):
+            if c & (1 << b):
+                v |= 3 << (2 * b)
+        saida.append([v & 0xFF, v >> 8])
+    return saida
+
+
+def aparar(colunas, vazia):
+    while colunas and colunas[0] == vazia:
+        colunas = colunas[1:]
+    while colunas and colunas[-1] == vazia:
+        colunas = colunas[:-1]
+    return colunas
+
+
+def montar(nome, glifos, bytes_col, proporcional, largura_espaco):
+    """Monta offsets, larguras e bitmaps na faixa Latin-1; ausentes viram '?'."""
+    vazia = [0] * bytes_col
+    bitmaps, offsets, larguras = [], [], []
+    cache = {}
+    for cp in range(PRIMEIRO, ULTIMO + 1):
+        car = chr(cp)
+        if car not in glifos:
+            car = "?"
+        if car in cache:
+            off, larg = cache[car]
+        else:
+            colunas = glifos[car]
+            if proporcional:
+                colunas = aparar(colunas, vazia) if car != " " else [vazia] * largura_espaco
+                if not colunas:
+                    colunas = [vazia] * largura_espaco
+            off, larg = len(bitmaps) * bytes_col, len(colunas)
+            bitmaps.extend(colunas)
+            cache[car] = (off, larg)
+        offsets.append(off)
+        larguras.append(larg)
+    return nome, bitmaps, offsets, larguras
+
+
+def emitir_tabela(f, tipo, nome, valores, por_linha):
+    f.write("static const %s %s[] TABELA_NA_RAM = {\n" % (tipo, nome))
+    for i in range(0, len(valores), por_linha):
+        f.write("    " + ", ".join(valores[i:i + por_linha]) + ",\n")
+    f.write("};\n\n")
+
+
+def emitir(f, montagem, altura, bytes_col, fixa, espaco):
+    nome, bitmaps, offsets, larguras = montagem
+    planos = ["0x%02X" % b for col in bitmaps for b in col]
+    emitir_tabela(f, "uint8_t", nome + "_bitmaps", planos, 16)
+    emitir_tabela(f, "uint16_t", nome + "_offsets", [str(o) for o in offsets], 16)
+    emitir_tabela(f, "uint8_t", nome + "_larguras", [str(l) for l in larguras], 16)
+    f.write("const fonte_t %s TABELA_NA_RAM = {\n" % nome)
+    f.write("    .altura = %d,\n    .bytes_coluna = %d,\n    .largura_fixa = %d,\n    .espaco = %d,\n" %
+            (altura, bytes_col, fixa, espaco))
+    f.write("    .primeiro = %d,\n    .ultimo = %d,\n" % (PRIMEIRO, ULTIMO))
+    f.write("    .offsets = %s_offsets,\n    .larguras = %s_larguras,\n    .bitmaps = %s_bitmaps,\n};\n\n" %
+            (nome, nome, nome))
+
+
+def main():
+    g8 = {c: [[b] for b in d] for c, d in ler_8x8().items()}
+    g5 = {c: [[b] for b in d] for c, d in compor_5x7().items()}
+    g16 = {c: dobrar([col[0] for col in d]) for c, d in g8.items()}
+
+    with open(SAIDA, "w", encoding="utf-8") as f:
+        f.write("// Gerado por tools/gerar_fontes.py -- não edite à mão.\n\n")
+        f.write('#include "fontes.h"\n')
+        f.write('#include "sram.h"\n\n')
+        emitir(f, montar("fonte_8x8", g8, 1, False, 8), 8, 1, 8, 0)
+        emitir(f, montar("fonte_5x7", g5, 1, True, 3), 8, 1, 0, 1)
+        emitir(f, montar("fonte_8x16", g16, 2, True, 5), 16, 2, 0, 2)
+
+
+if __name__ == "__main__":
+    main()
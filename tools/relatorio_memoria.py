@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+"""Relatório de memória do firmware: RAM e flash por subsistema e pilha no
+pior caso.
+
+- RAM/flash: lidos do mapa do linker (beeSense.elf.map). Cada seção de
+  entrada é atribuída ao objeto que a gerou; os módulos de inc/ e o
+  beeSense.c são subsistemas próprios, o SDK é agrupado por biblioteca e
+  libc/libgcc por arquivo .a. .data e funções copiadas para a RAM contam
+  nas duas memórias (a cópia inicial fica na flash).
+- Pilha: -fstack-usage dá o quadro de cada função (.su) e
+  -fcallgraph-info=su o grafo de chamadas (.ci). O pior caso de uma função
+  é o seu quadro mais o do pior caminho de chamadas abaixo dela. Chamadas
+  por ponteiro, recursão e quadros dinâmicos não têm limite conhecido e
+  são marcados no relatório.
+- Interrupções: os tratadores registrados no código (irq_set_exclusive_handler,
+  irq_add_shared_handler, gpio_set_irq_enabled_with_callback, add_alarm_*,
+  add_repeating_timer_*) usam a mesma pilha do main; a estimativa total é
+  main + o pior tratador (as IRQs do SDK têm a mesma prioridade e não se
+  aninham).
+
+Uso: python3 tools/relatorio_memoria.py <beeSense.elf.map> <dir. de objetos>
+     [--pilha BYTES] [-o relatorio.txt]
+"""
+import argparse
+import collections
+import glob
+import os
+import re
+import sys
+
+RAIZ = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+FLASH = (0x10000000, 0x11000000)
+RAM = (0x20000000, 0x20042000)
+
+# Seções de entrada que moram na RAM mas têm a imagem inicial na flash
+COPIADAS = (".data", ".time_critical", ".ram_func", ".scratch_x", ".scratch_y")
+
+
+def subsistema(objeto):
+    objeto = objeto.replace("\\", "/")
+    arquivo = re.match(r"(.*\.a)\((.*)\)$", objeto)
+    if arquivo:
+        return os.path.basename(arquivo.group(1))
+    if "/pico-sdk/" in objeto or "/pico_sdk/" in objeto:
+        partes = objeto.split("/")
+        for marca in ("rp2_common", "common", "rp2040", "host"):
+            if marca in partes:
+                i = partes.index(marca)
+                if i + 1 < len(partes):
+                    return "sdk:" + partes[i + 1]
+        return "sdk"
+    nome = os.path.basename(objeto)
+    for sufixo in (".obj", ".o"):
+        if nome.endswith(sufixo):
+            nome = nome[: -len(sufixo)]
+    return os.path.splitext(nome)[0]
+
+
+def ler_mapa(caminho):
+    """Soma (ram, flash) por subsistema a partir do mapa do linker."""
+    uso = collections.defaultdict(lambda: [0, 0])
+    linhas = open(caminho, errors="replace").read().splitlines()
+    try:
+        inicio = next(i for i, l in enumerate(linhas) if l.startswith("Linker script and memory map"))
+    except StopIteration:
+        sys.exit("mapa do linker sem a seção 'Linker script and memory map'")
+
+    secao = None
+    for linha in linhas[inicio:]:
+        # " .text.nome 0x... 0x... objeto" ou o nome sozinho numa linha e o resto na seguinte
+        m = re.match(r"^ (\.\S+|COMMON)\s*$", linha)
+        if m:
+            secao = m.group(1)
+            continue
+        m = re.match(r"^ (\.\S+|COMMON)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$", linha)
+        if not m:
+            secao = None
+            continue
+        nome = m.group(1) or secao
+        secao = None
+        if not nome:
+            continue
+        endereco, tamanho, objeto = int(m.group(2), 16), int(m.group(3), 16), m.group(4).strip()
+        if tamanho == 0 or objeto.startswith("load address"):
+            continue
+        s = subsistema(objeto)
+        if RAM[0] <= endereco < RAM[1]:
+            uso[s][0] += tamanho
+            if nome.startswith(COPIADAS):
+                uso[s][1] += tamanho
+        elif FLASH[0] <= endereco < FLASH[1]:
+            uso[s][1] += tamanho
+    return uso
+
+
+def nome_no(titulo):
+    """Funções estáticas aparecem no grafo como "caminho:nome"."""
+    if ":" in titulo:
+        arquivo, funcao = titulo.rsplit(":", 1)
+        return os.path.basename(arquivo), funcao
+    return None, titulo
+
+
+def ler_pilha(diretorio):
+    """Quadros (.su) e arestas (.ci) de todos os objetos do diretório."""
+    quadros = {}  # (arquivo, função) -> (bytes, qualificador)
+    globais = {}  # função -> chave em quadros
+    for su in glob.glob(os.path.join(diretorio, "**", "*.su"), recursive=True):
+        for linha in open(su, errors="replace"):
+            partes = linha.rstrip("\n").split("\t")
+            if len(partes) < 3:
+                continue
+            local, tamanho, qualificador = partes[0], int(partes[1]), partes[2]
+            funcao = local.rsplit(":", 1)[-1]
+            arquivo = os.path.basename(local.split(":", 1)[0])
+            chave = (arquivo, funcao)
+            quadros[chave] = (tamanho, qualificador)
+            globais.setdefault(funcao, chave)
+
+    arestas = collections.defaultdict(set)
+    indiretas = set()
+    for ci in glob.glob(os.path.join(diretorio, "**", "*.ci"), recursive=True):
+        texto = open(ci, errors="replace").read()
+        arquivo = None
+        definidas = {}
+        for m in re.finditer(r'node:\s*\{\s*title:\s*"([^"]+)"\s*label:\s*"([^"]*)"', texto):
+            funcao, rotulo = nome_no(m.group(1))[1], m.group(2)
+            if "bytes" in rotulo:
+                origem = re.search(r"\\n([^\\:]+):\d+:\d+", rotulo)
+                if origem:
+                    arquivo = os.path.basename(origem.group(1))
+                    definidas[funcao] = (arquivo, funcao)
+        for m in re.finditer(r'edge:\s*\{\s*sourcename:\s*"([^"]+)"\s*targetname:\s*"([^"]+)"', texto):
+            origem, (arquivo_destino, destino) = nome_no(m.group(1))[1], nome_no(m.group(2))
+            chave = definidas.get(origem) or globais.get(origem)
+            if not chave:
+                continue
+            if destino == "__indirect_call":
+                indiretas.add(chave)
+                continue
+            if arquivo_destino:
+                alvo = (arquivo_destino, destino)
+            else:
+                alvo = definidas.get(destino) or globais.get(destino) or (None, destino)
+            arestas[chave].add(alvo)
+    return quadros, arestas, indiretas
+
+
+def pior_caso(quadros, arestas, indiretas):
+    """Pilha no pior caso de cada função e as marcas de incerteza."""
+    resultado = {}
+    visitando = set()
+
+    def visitar(chave):
+        if chave in resultado:
+            return resultado[chave]
+        if chave in visitando:
+            return 0, {"recursiva"}, [chave[1]]
+        visitando.add(chave)
+        tamanho, qualificador = quadros.get(chave, (0, "desconhecida"))
+        marcas = set()
+        if chave not in quadros:
+            marcas.add("sem .su")
+        elif qualificador != "static":
+            marcas.add(qualificador)
+        if chave in indiretas:
+            marcas.add("indireta")
+        melhor, caminho = 0, []
+        for alvo in arestas.get(chave, ()):
+            if alvo[0] is None and alvo not in quadros:
+                continue  # biblioteca compilada sem -fstack-usage
+            p, m, c = visitar(alvo)
+            marcas |= m
+            if p > melhor:
+                melhor, caminho = p, c
+        visitando.discard(chave)
+        resultado[chave] = (tamanho + melhor, marcas, [chave[1]] + caminho)
+        return resultado[chave]
+
+    for chave in list(quadros):
+        visitar(chave)
+    return resultado
+
+
+def tratadores():
+    """Funções registradas como tratadores de interrupção no código do projeto."""
+    padrao = re.compile(
+        r"(?:irq_set_exclusive_handler|irq_add_shared_handler)\s*\([^,]+,([^;]+?)(?:,|\)\s*;)"
+        r"|gpio_set_irq_enabled_with_callback\s*\((?:[^,]+,){3}\s*&?\s*(\w+)"
+        r"|add_alarm_\w+\s*\([^,]+,\s*&?\s*(\w+)"
+        r"|add_repeating_timer_\w+\s*\([^,]+,\s*&?\s*(\w+)")
+    nomes = set()
+    for fonte in [os.path.join(RAIZ, "beeSense.c")] + glob.glob(os.path.join(RAIZ, "inc", "*.c")):
+        for m in padrao.finditer(open(fonte, errors="replace").read()):
+            for grupo in m.groups():
+                if grupo:
+                    nomes.update(re.findall(r"[A-Za-z_]\w*", grupo))
+    return nomes
+
+
+def main():
+    parser = argparse.ArgumentParser(description="RAM, flash e pilha do firmware por subsistema")
+    parser.add_argument("mapa")
+    parser.add_argument("objetos")
+    parser.add_argument("--pilha", type=lambda v: int(v, 0), default=0x800,
+                        help="tamanho da pilha do núcleo 0 (PICO_STACK_SIZE)")
+    parser.add_argument("-o", "--saida")
+    args = parser.parse_args()
+
+    saida = []
+    uso = ler_mapa(args.mapa)
+    total_ram = sum(u[0] for u in uso.values())
+    total_flash = sum(u[1] for u in uso.values())
+    saida.append("%-28s %10s %10s" % ("subsistema", "RAM", "flash"))
+    for nome, (ram, flash) in sorted(uso.items(), key=lambda kv: (-kv[1][0], -kv[1][1])):
+        saida.append("%-28s %10d %10d" % (nome, ram, flash))
+    saida.append("%-28s %10d %10d" % ("total", total_ram, total_flash))
+
+    quadros, arestas, indiretas = ler_pilha(args.objetos)
+    if not quadros:
+        saida.append("\nsem arquivos .su em %s (compile com -fstack-usage)" % args.objetos)
+    else:
+        pior = pior_caso(quadros, arestas, indiretas)
+
+        def linha(chave):
+            p, marcas, caminho = pior[chave]
+            extra = " [%s]" % ", ".join(sorted(marcas)) if marcas else ""
+            return "%6d  %s%s" % (p, " > ".join(caminho), extra)
+
+        saida.append("\npilha no pior caso por subsistema (bytes, caminho):")
+        por_subsistema = {}
+        for chave in pior:
+            s = subsistema(chave[0])
+            if s not in por_subsistema or pior[chave][0] > pior[por_subsistema[s]][0]:
+                por_subsistema[s] = chave
+        for s, chave in sorted(por_subsistema.items(), key=lambda kv: -pior[kv[1]][0]):
+            saida.append("%-20s %s" % (s, linha(chave)))
+
+        principal = next((c for c in pior if c[1] == "main"), None)
+        registrados = tratadores()
+        irqs = [c for c in pior if c[1] in registrados]
+        saida.append("\ntratadores de interrupção:")
+        for chave in sorted(irqs, key=lambda c: -pior[c][0]):
+            saida.append("  " + linha(chave))
+        if principal:
+            total = pior[principal][0] + max((pior[c][0] for c in irqs), default=0)
+            saida.append("\nmain: %s" % linha(principal))
+            saida.append("estimativa main + pior IRQ: %d de %d bytes (%s)" %
+                         (total, args.pilha, "ok" if total <= args.pilha else "ESTOURA"))
+
+    texto = "\n".join(saida) + "\n"
+    if args.saida:
+        with open(args.saida, "w") as f:
+            f.write(texto)
+    sys.stdout.write(texto)
+
+
+if __name__ == "__main__":
+    main()